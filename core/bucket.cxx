@@ -24,7 +24,9 @@
 #include "core/document_id.hxx"
 #include "core/error_context/key_value_error_map_info.hxx"
 #include "core/error_context/key_value_status_code.hxx"
+#include "core/io/io_context_pool.hxx"
 #include "core/io/mcbp_message.hxx"
+#include "core/io/timer_wheel.hxx"
 #include "core/logger/logger.hxx"
 #include "core/mcbp/codec.hxx"
 #include "core/metrics/meter_wrapper.hxx"
@@ -33,6 +35,7 @@
 #include "core/protocol/hello_feature.hxx"
 #include "core/response_handler.hxx"
 #include "core/service_type.hxx"
+#include "core/topology/vbucket_routing_table.hxx"
 #include "core/tracing/tracer_wrapper.hxx"
 #include "core/utils/movable_function.hxx"
 #include "dispatcher.hxx"
@@ -91,6 +94,7 @@ public:
               std::vector<protocol::hello_feature> known_features,
               std::shared_ptr<impl::bootstrap_state_listener> state_listener,
               asio::io_context& ctx,
+              io::io_context_pool& io_pool,
               tls_context_provider& tls)
     : client_id_{ std::move(client_id) }
     , name_{ std::move(name) }
@@ -104,6 +108,7 @@ public:
     , origin_{ std::move(origin) }
     , codec_{ { known_features_.begin(), known_features_.end() } }
     , ctx_{ ctx }
+    , io_pool_{ io_pool }
     , tls_{ tls }
     , heartbeat_timer_(ctx_)
     , heartbeat_interval_{ origin_.options().config_poll_floor >
@@ -305,7 +310,7 @@ public:
     auto action = retry_orchestrator::should_retry(request, reason);
     auto retried = action.need_to_retry();
     if (retried) {
-      auto timer = std::make_shared<asio::steady_timer>(ctx_);
+      auto timer = std::make_shared<io::wheel_timer>(ctx_);
       timer->expires_after(action.duration());
       timer->async_wait([self = shared_from_this(), request](auto error) {
         if (error == asio::error::operation_aborted) {
@@ -335,9 +340,8 @@ public:
   [[nodiscard]] auto server_by_vbucket(std::uint16_t vbucket, std::size_t node_index)
     -> std::optional<std::size_t>
   {
-    const std::scoped_lock lock(config_mutex_);
-    if (config_) {
-      return config_->server_by_vbucket(vbucket, node_index);
+    if (const auto table = std::atomic_load(&routing_table_); table) {
+      return table->server_by_vbucket(vbucket, node_index);
     }
     return std::nullopt;
   }
@@ -345,9 +349,8 @@ public:
   [[nodiscard]] auto map_id(const document_id& id)
     -> std::pair<std::uint16_t, std::optional<std::size_t>>
   {
-    const std::scoped_lock lock(config_mutex_);
-    if (config_) {
-      return config_->map_key(id.key(), id.node_index());
+    if (const auto table = std::atomic_load(&routing_table_); table) {
+      return table->map_key(id.key(), id.node_index());
     }
     return { 0, std::nullopt };
   }
@@ -364,9 +367,8 @@ public:
   [[nodiscard]] auto map_id(const std::vector<std::byte>& key, std::size_t node_index)
     -> std::pair<std::uint16_t, std::optional<std::size_t>>
   {
-    const std::scoped_lock lock(config_mutex_);
-    if (config_) {
-      return config_->map_key(key, node_index);
+    if (const auto table = std::atomic_load(&routing_table_); table) {
+      return table->map_key(key, node_index);
     }
     return { 0, std::nullopt };
   }
@@ -390,10 +392,21 @@ public:
     const couchbase::core::origin origin(origin_.credentials(), hostname, port, origin_.options());
     io::mcbp_session session =
       origin_.options().enable_tls
-        ? io::mcbp_session(
-            client_id_, node.node_uuid, ctx_, tls_, origin, state_listener_, name_, known_features_)
-        : io::mcbp_session(
-            client_id_, node.node_uuid, ctx_, origin, state_listener_, name_, known_features_);
+        ? io::mcbp_session(client_id_,
+                           node.node_uuid,
+                           io_pool_.next(),
+                           tls_,
+                           origin,
+                           state_listener_,
+                           name_,
+                           known_features_)
+        : io::mcbp_session(client_id_,
+                           node.node_uuid,
+                           io_pool_.next(),
+                           origin,
+                           state_listener_,
+                           name_,
+                           known_features_);
     CB_LOG_DEBUG(R"({} rev={}, connect idx={}, session="{}", address="{}:{}")",
                  log_prefix_,
                  config_->rev_str(),
@@ -484,14 +497,19 @@ public:
         origin_.options().enable_tls
           ? io::mcbp_session(client_id_,
                              node.node_uuid,
-                             ctx_,
+                             io_pool_.next(),
                              tls_,
                              origin,
                              state_listener_,
                              name_,
                              known_features_)
-          : io::mcbp_session(
-              client_id_, node.node_uuid, ctx_, origin, state_listener_, name_, known_features_);
+          : io::mcbp_session(client_id_,
+                             node.node_uuid,
+                             io_pool_.next(),
+                             origin,
+                             state_listener_,
+                             name_,
+                             known_features_);
       CB_LOG_DEBUG(R"({} rev={}, restart idx={}, session="{}", address="{}:{}")",
                    log_prefix_,
                    config_->rev_str(),
@@ -551,9 +569,16 @@ public:
     }
     io::mcbp_session new_session =
       origin_.options().enable_tls
-        ? io::mcbp_session(
-            client_id_, {}, ctx_, tls_, origin_, state_listener_, name_, known_features_)
-        : io::mcbp_session(client_id_, {}, ctx_, origin_, state_listener_, name_, known_features_);
+        ? io::mcbp_session(client_id_,
+                           {},
+                           io_pool_.next(),
+                           tls_,
+                           origin_,
+                           state_listener_,
+                           name_,
+                           known_features_)
+        : io::mcbp_session(
+            client_id_, {}, io_pool_.next(), origin_, state_listener_, name_, known_features_);
     new_session.bootstrap([self = shared_from_this(), new_session, h = std::move(handler)](
                             std::error_code ec, topology::configuration cfg) mutable {
       if (ec) {
@@ -823,6 +848,10 @@ public:
       }
       config_.reset();
       config_ = std::make_shared<topology::configuration>(config);
+      std::atomic_store(&routing_table_,
+                        config_->vbmap
+                          ? std::make_shared<const topology::vbucket_routing_table>(*config_->vbmap)
+                          : nullptr);
       configured_ = true;
 
       {
@@ -878,14 +907,19 @@ public:
           origin_.options().enable_tls
             ? io::mcbp_session(client_id_,
                                node.node_uuid,
-                               ctx_,
+                               io_pool_.next(),
                                tls_,
                                origin,
                                state_listener_,
                                name_,
                                known_features_)
-            : io::mcbp_session(
-                client_id_, node.node_uuid, ctx_, origin, state_listener_, name_, known_features_);
+            : io::mcbp_session(client_id_,
+                               node.node_uuid,
+                               io_pool_.next(),
+                               origin,
+                               state_listener_,
+                               name_,
+                               known_features_);
         CB_LOG_DEBUG(R"({} rev={}, add session="{}", address="{}:{}", index={})",
                      log_prefix_,
                      config.rev_str(),
@@ -971,6 +1005,18 @@ public:
     return origin_.options().default_timeout_for(service_type::key_value);
   }
 
+  [[nodiscard]] auto command_context(const document_id& id) -> asio::io_context&
+  {
+    if (!id.use_any_session()) {
+      if (auto [partition, server] = map_id(id); server.has_value()) {
+        if (auto session = find_session_by_index(server.value()); session) {
+          return session->io_context();
+        }
+      }
+    }
+    return ctx_;
+  }
+
   [[nodiscard]] auto name() const -> const std::string&
   {
     return name_;
@@ -1080,6 +1126,7 @@ private:
   mcbp::codec codec_;
 
   asio::io_context& ctx_;
+  io::io_context_pool& io_pool_;
   tls_context_provider& tls_;
 
   asio::steady_timer heartbeat_timer_;
@@ -1090,6 +1137,8 @@ private:
   std::atomic_bool configured_{ false };
 
   std::shared_ptr<topology::configuration> config_{};
+  // published separately from config_, so that routing of the requests does not take the mutex
+  std::shared_ptr<const topology::vbucket_routing_table> routing_table_{};
   mutable std::mutex config_mutex_{};
 
   std::vector<std::shared_ptr<config_listener>> config_listeners_{};
@@ -1105,6 +1154,7 @@ private:
 
 bucket::bucket(std::string client_id,
                asio::io_context& ctx,
+               io::io_context_pool& io_pool,
                tls_context_provider& tls,
                std::shared_ptr<tracing::tracer_wrapper> tracer,
                std::shared_ptr<metrics::meter_wrapper> meter,
@@ -1126,6 +1176,7 @@ bucket::bucket(std::string client_id,
                                          std::move(known_features),
                                          std::move(state_listener),
                                          ctx,
+                                         io_pool,
                                          tls) }
 {
 }
@@ -1264,6 +1315,12 @@ bucket::default_timeout() const -> std::chrono::milliseconds
   return impl_->default_timeout();
 }
 
+auto
+bucket::command_context(const document_id& id) -> asio::io_context&
+{
+  return impl_->command_context(id);
+}
+
 auto
 bucket::find_session_by_index(std::size_t index) const -> std::optional<io::mcbp_session>
 {
@@ -23,6 +23,7 @@
 #include "tls_context_provider.hxx"
 
 #include <asio/bind_executor.hpp>
+#include <asio/dispatch.hpp>
 #include <asio/io_context.hpp>
 #include <asio/post.hpp>
 #include <asio/ssl.hpp>
@@ -55,6 +56,10 @@ namespace impl
 {
 class bootstrap_state_listener;
 } // namespace impl
+namespace io
+{
+class io_context_pool;
+} // namespace io
 
 class app_telemetry_meter;
 
@@ -68,6 +73,7 @@ class bucket
 public:
   bucket(std::string client_id,
          asio::io_context& ctx,
+         io::io_context_pool& io_pool,
          tls_context_provider& tls,
          std::shared_ptr<tracing::tracer_wrapper> tracer,
          std::shared_ptr<metrics::meter_wrapper> meter,
@@ -86,7 +92,7 @@ public:
       return;
     }
     auto cmd = std::make_shared<operations::mcbp_command<bucket, Request>>(
-      ctx_, shared_from_this(), request, default_timeout());
+      command_context(request.id), shared_from_this(), request, default_timeout());
     cmd->start([cmd, handler = std::forward<Handler>(handler)](
                  std::error_code ec, std::optional<io::mcbp_message>&& msg) mutable {
       using encoded_response_type = typename Request::encoded_response_type;
@@ -96,13 +102,17 @@ public:
       handler(cmd->request.make_response(std::move(ctx), std::move(resp)));
     });
     if (is_configured()) {
-      return map_and_send(cmd);
+      return asio::dispatch(cmd->ctx_, [self = shared_from_this(), cmd]() {
+        self->map_and_send(cmd);
+      });
     }
     return defer_command([self = shared_from_this(), cmd](std::error_code ec) {
-      if (ec == errc::common::request_canceled) {
-        return cmd->cancel(retry_reason::do_not_retry);
-      }
-      self->map_and_send(cmd);
+      asio::dispatch(cmd->ctx_, [self, cmd, ec]() {
+        if (ec == errc::common::request_canceled) {
+          return cmd->cancel(retry_reason::do_not_retry);
+        }
+        self->map_and_send(cmd);
+      });
     });
   }
 
@@ -149,10 +159,12 @@ public:
         connect_session(index);
       }
       return defer_command([self = shared_from_this(), cmd](std::error_code ec) {
-        if (ec == errc::common::request_canceled) {
-          return cmd->cancel(retry_reason::do_not_retry);
-        }
-        self->map_and_send(cmd);
+        asio::dispatch(cmd->ctx_, [self, cmd, ec]() {
+          if (ec == errc::common::request_canceled) {
+            return cmd->cancel(retry_reason::do_not_retry);
+          }
+          self->map_and_send(cmd);
+        });
       });
     }
     if (session->is_stopped()) {
@@ -231,6 +243,7 @@ public:
 
 private:
   [[nodiscard]] auto default_timeout() const -> std::chrono::milliseconds;
+  [[nodiscard]] auto command_context(const document_id& id) -> asio::io_context&;
   [[nodiscard]] auto next_session_index() -> std::size_t;
   [[nodiscard]] auto find_session_by_index(std::size_t index) const
     -> std::optional<io::mcbp_session>;
@@ -33,9 +33,11 @@
 #include "core/impl/get_replica.hxx"
 #include "core/impl/lookup_in_replica.hxx"
 #include "core/impl/observe_seqno.hxx"
+#include "core/impl/observe_seqno_coalescer.hxx"
 #include "core/io/http_command.hxx"
 #include "core/io/http_message.hxx"
 #include "core/io/http_session_manager.hxx"
+#include "core/io/io_context_pool.hxx"
 #include "core/io/mcbp_session.hxx"
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
 #include "core/io/config_tracker.hxx"
@@ -171,6 +173,7 @@
 #include <couchbase/retry_reason.hxx>
 
 #include <asio/bind_executor.hpp>
+#include <asio/dispatch.hpp>
 #include <asio/executor_work_guard.hpp>
 #include <asio/post.hpp>
 #include <asio/ssl/verify_mode.hpp>
@@ -301,18 +304,24 @@ class cluster_impl : public std::enable_shared_from_this<cluster_impl>
 {
 public:
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
-  explicit cluster_impl(asio::io_context& ctx)
+  explicit cluster_impl(asio::io_context& ctx,
+                        std::vector<std::reference_wrapper<asio::io_context>> session_contexts = {})
     : ctx_(ctx)
+    , io_pool_(ctx_, std::move(session_contexts))
     , work_(asio::make_work_guard(ctx_))
-    , session_manager_(std::make_shared<io::http_session_manager>(id_, ctx_, tls_, origin_))
+    , session_manager_(
+        std::make_shared<io::http_session_manager>(id_, ctx_, io_pool_, tls_, origin_))
     , retry_backoff_(ctx_)
   {
   }
 #else
-  explicit cluster_impl(asio::io_context& ctx)
+  explicit cluster_impl(asio::io_context& ctx,
+                        std::vector<std::reference_wrapper<asio::io_context>> session_contexts = {})
     : ctx_(ctx)
+    , io_pool_(ctx_, std::move(session_contexts))
     , work_(asio::make_work_guard(ctx_))
-    , session_manager_(std::make_shared<io::http_session_manager>(id_, ctx_, tls_, origin_))
+    , session_manager_(
+        std::make_shared<io::http_session_manager>(id_, ctx_, io_pool_, tls_, origin_))
   {
   }
 #endif
@@ -584,6 +593,7 @@ public:
 
         b = std::make_shared<bucket>(id_,
                                      ctx_,
+                                     io_pool_,
                                      tls_,
                                      tracer_,
                                      meter_,
@@ -682,6 +692,11 @@ public:
     return {};
   }
 
+  [[nodiscard]] auto default_timeout_for(service_type type) const -> std::chrono::milliseconds
+  {
+    return origin_.options().default_timeout_for(type);
+  }
+
   auto origin() const -> std::pair<std::error_code, couchbase::core::origin>
   {
     if (stopped_) {
@@ -722,6 +737,23 @@ public:
                        });
   }
 
+  /**
+   * Concurrent observers of the same vBucket copy share a single request, see
+   * impl::observe_seqno_coalescer.
+   */
+  void execute_coalesced(impl::observe_seqno_request request,
+                         utils::movable_function<void(impl::observe_seqno_response)>&& handler)
+  {
+    auto key = impl::observe_seqno_coalescer::key_for(request);
+    if (!observe_seqno_coalescer_.join(key, std::move(handler))) {
+      return;
+    }
+    return execute(std::move(request),
+                   [self = shared_from_this(), key](impl::observe_seqno_response&& response) {
+                     self->observe_seqno_coalescer_.complete(key, response);
+                   });
+  }
+
   template<class Request,
            class Handler,
            typename std::enable_if_t<
@@ -1092,6 +1124,14 @@ public:
   }
 #endif
 
+  void with_document_context(const document_id& id, utils::movable_function<void()>&& function)
+  {
+    if (auto bucket = find_bucket_by_name(id.bucket()); bucket != nullptr) {
+      return asio::dispatch(bucket->command_context(id), std::move(function));
+    }
+    return asio::dispatch(ctx_, std::move(function));
+  }
+
   void with_bucket_configuration(
     const std::string& bucket_name,
     utils::movable_function<void(std::error_code, std::shared_ptr<topology::configuration>)>&&
@@ -1401,6 +1441,7 @@ private:
 
   std::string id_{ uuid::to_string(uuid::random()) };
   asio::io_context& ctx_;
+  io::io_context_pool io_pool_;
   asio::executor_work_guard<asio::io_context::executor_type> work_;
   tls_context_provider tls_{};
   std::shared_ptr<io::http_session_manager> session_manager_;
@@ -1409,6 +1450,7 @@ private:
   std::shared_ptr<impl::dns_srv_tracker> dns_srv_tracker_{};
   std::mutex buckets_mutex_{};
   std::map<std::string, std::shared_ptr<bucket>> buckets_{};
+  impl::observe_seqno_coalescer observe_seqno_coalescer_{};
   couchbase::core::origin origin_{};
   std::shared_ptr<class cluster_label_listener> cluster_label_listener_{
     std::make_shared<class cluster_label_listener>()
@@ -1433,6 +1475,12 @@ cluster::cluster(asio::io_context& ctx)
 {
 }
 
+cluster::cluster(asio::io_context& ctx,
+                 std::vector<std::reference_wrapper<asio::io_context>> session_contexts)
+  : impl_{ std::make_shared<cluster_impl>(ctx, std::move(session_contexts)) }
+{
+}
+
 cluster::cluster(std::shared_ptr<cluster_impl> impl)
   : impl_{ std::move(impl) }
 {
@@ -1536,6 +1584,15 @@ cluster::with_bucket_configuration(
   }
 }
 
+void
+cluster::with_document_context(const document_id& id,
+                               utils::movable_function<void()>&& function) const
+{
+  if (impl_) {
+    impl_->with_document_context(id, std::move(function));
+  }
+}
+
 void
 cluster::close_bucket(const std::string& bucket_name,
                       utils::movable_function<void(std::error_code)>&& handler) const
@@ -1649,6 +1706,13 @@ void
 cluster::execute(operations::get_projected_request request,
                  utils::movable_function<void(operations::get_projected_response)>&& handler) const
 {
+  if (request.requires_split()) {
+    if (!request.timeout) {
+      // the lookups and the possible fallback to the full document share the same budget
+      request.timeout = impl_->default_timeout_for(service_type::key_value);
+    }
+    return request.execute(impl_, std::move(handler));
+  }
   return impl_->execute(std::move(request), std::move(handler));
 }
 
@@ -2382,7 +2446,7 @@ void
 cluster::execute(impl::observe_seqno_request request,
                  utils::movable_function<void(impl::observe_seqno_response)>&& handler) const
 {
-  return impl_->execute(std::move(request), std::move(handler));
+  return impl_->execute_coalesced(std::move(request), std::move(handler));
 }
 
 void
@@ -27,8 +27,10 @@
 
 #include <asio/io_context.hpp>
 #include <chrono>
+#include <functional>
 #include <optional>
 #include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -38,6 +40,7 @@ class cluster;
 namespace couchbase::core
 {
 class crud_component;
+struct document_id;
 class cluster_impl;
 class cluster_label_listener;
 class bucket;
@@ -71,6 +74,13 @@ class cluster
 {
 public:
   explicit cluster(asio::io_context& ctx);
+  /**
+   * Creates cluster that spreads KV and HTTP sessions across the given contexts in addition to the
+   * primary one. The caller owns the contexts and must keep them running until the cluster is
+   * closed.
+   */
+  cluster(asio::io_context& ctx,
+          std::vector<std::reference_wrapper<asio::io_context>> session_contexts);
   explicit cluster(std::shared_ptr<cluster_impl> impl);
 
   [[nodiscard]] auto io_context() const -> asio::io_context&;
@@ -95,6 +105,14 @@ public:
     utils::movable_function<void(std::error_code, std::shared_ptr<topology::configuration>)>&&
       handler) const;
 
+  /**
+   * Runs the function on the io_context of the KV session, that owns the document (or on the
+   * primary one, when the bucket is not open yet). The requests for that node, that are dispatched
+   * from the function, are encoded back to back, and leave in a single write.
+   */
+  void with_document_context(const document_id& id,
+                             utils::movable_function<void()>&& function) const;
+
   [[nodiscard]] auto update_credentials(const core::cluster_credentials& auth) const -> core::error;
 
   void execute(o::analytics_request request, mf<void(o::analytics_response)>&& handler) const;
@@ -20,6 +20,7 @@
 #include "core/columnar/security_options.hxx"
 #include "core/io/dns_config.hxx"
 #include "core/io/ip_protocol.hxx"
+#include "core/io/query_cache.hxx"
 #include "core/metrics/logging_meter_options.hxx"
 #include "core/orphan_reporter.hxx"
 #include "core/tracing/threshold_logging_options.hxx"
@@ -90,6 +91,7 @@ public:
     timeout_defaults::config_idle_redial_timeout;
 
   std::size_t max_http_connections{ 0 };
+  std::size_t min_http_connections_per_node{ 0 };
   std::chrono::milliseconds idle_http_connection_timeout =
     timeout_defaults::idle_http_connection_timeout;
   std::string user_agent_extra{};
@@ -114,6 +116,10 @@ public:
   bool preserve_bootstrap_nodes_order{ false };
   bool allow_enterprise_analytics{ false };
   bool enable_lazy_connections{ false };
+  std::size_t write_coalescing_threshold{ 0 };
+  std::chrono::microseconds write_coalescing_delay{ 0 };
+  std::size_t query_cache_max_entries{ query_cache::default_max_entries };
+  std::size_t query_cache_max_bytes{ query_cache::default_max_bytes };
 };
 
 } // namespace couchbase::core
@@ -20,6 +20,7 @@
 #include "collection_id_cache_entry.hxx"
 #include "collections_component_unit_test_api.hxx"
 #include "core/collections_options.hxx"
+#include "core/io/timer_wheel.hxx"
 #include "core/logger/logger.hxx"
 #include "core/mcbp/big_endian.hxx"
 #include "core/pending_operation.hxx"
@@ -41,7 +42,6 @@
 
 #include <asio/error.hpp>
 #include <asio/io_context.hpp>
-#include <asio/steady_timer.hpp>
 #include <spdlog/fmt/bundled/core.h>
 #include <tao/json/value.hpp>
 #include <tao/pegtl/parse_error.hpp>
@@ -220,7 +220,7 @@ public:
       retry_orchestrator::should_retry(request, retry_reason::key_value_collection_outdated);
     auto retried = action.need_to_retry();
     if (retried) {
-      auto timer = std::make_shared<asio::steady_timer>(io_);
+      auto timer = std::make_shared<io::wheel_timer>(io_);
       timer->expires_after(action.duration());
       timer->async_wait([self = shared_from_this(), request](auto error) {
         if (error == asio::error::operation_aborted) {
@@ -283,7 +283,7 @@ public:
     }
 
     if (options.timeout != std::chrono::milliseconds::zero()) {
-      auto timer = std::make_shared<asio::steady_timer>(io_);
+      auto timer = std::make_shared<io::wheel_timer>(io_);
       timer->expires_after(options.timeout);
       timer->async_wait([req](auto error) {
         if (error == asio::error::operation_aborted) {
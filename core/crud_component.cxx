@@ -19,6 +19,7 @@
 
 #include "collections_component.hxx"
 #include "core/error_context/key_value_status_code.hxx"
+#include "core/io/timer_wheel.hxx"
 #include "core/mcbp/buffer_writer.hxx"
 #include "core/pending_operation.hxx"
 #include "core/protocol/client_opcode.hxx"
@@ -38,7 +39,6 @@
 
 #include <asio/error.hpp>
 #include <asio/io_context.hpp>
-#include <asio/steady_timer.hpp>
 #include <gsl/span>
 #include <gsl/span_ext>
 #include <gsl/util>
@@ -282,7 +282,7 @@ public:
     }
 
     if (options.timeout != std::chrono::milliseconds::zero()) {
-      auto timer = std::make_shared<asio::steady_timer>(io_);
+      auto timer = std::make_shared<io::wheel_timer>(io_);
       timer->expires_after(options.timeout);
       timer->async_wait([req](auto error) {
         if (error == asio::error::operation_aborted) {
@@ -349,7 +349,7 @@ public:
     req->vbucket_ = vbucket_id;
 
     if (options.timeout != std::chrono::milliseconds::zero()) {
-      auto timer = std::make_shared<asio::steady_timer>(io_);
+      auto timer = std::make_shared<io::wheel_timer>(io_);
       timer->expires_after(options.timeout);
       timer->async_wait([req](auto error) {
         if (error == asio::error::operation_aborted) {
@@ -399,7 +399,7 @@ public:
     }
 
     if (options.timeout != std::chrono::milliseconds::zero()) {
-      auto timer = std::make_shared<asio::steady_timer>(io_);
+      auto timer = std::make_shared<io::wheel_timer>(io_);
       timer->expires_after(options.timeout);
       timer->async_wait([req](auto error) {
         if (error == asio::error::operation_aborted) {
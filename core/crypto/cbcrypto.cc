@@ -18,6 +18,9 @@
 #include "cbcrypto.h"
 #include <couchbase/build_config.hxx>
 
+// OPENSSL_cleanse() wipes the keys on every platform, the library always links OpenSSL for TLS
+#include "include_ssl/crypto.h"
+
 #include <memory>
 #include <stdexcept>
 
@@ -809,14 +812,10 @@ struct EVP_CIPHER_CTX_Deleter {
 using unique_EVP_CIPHER_CTX_ptr = std::unique_ptr<EVP_CIPHER_CTX, EVP_CIPHER_CTX_Deleter>;
 
 /**
- * Get the OpenSSL Cipher to use for the encryption, and validate
- * the input key and iv sizes
+ * Get the OpenSSL Cipher to use for the encryption
  */
-
 auto
-getCipher(const couchbase::core::crypto::Cipher cipher,
-          std::string_view key,
-          std::string_view iv) -> const EVP_CIPHER*
+getCipher(const couchbase::core::crypto::Cipher cipher) -> const EVP_CIPHER*
 {
   const EVP_CIPHER* cip = nullptr;
 
@@ -830,6 +829,20 @@ getCipher(const couchbase::core::crypto::Cipher cipher,
     throw std::invalid_argument("couchbase::core::crypto::getCipher: Unknown Cipher " +
                                 std::to_string(static_cast<int>(cipher)));
   }
+  return cip;
+}
+
+/**
+ * Get the OpenSSL Cipher to use for the encryption, and validate
+ * the input key and iv sizes
+ */
+
+auto
+getCipher(const couchbase::core::crypto::Cipher cipher,
+          std::string_view key,
+          std::string_view iv) -> const EVP_CIPHER*
+{
+  const auto* cip = getCipher(cipher);
 #ifdef COUCHBASE_CXX_CLIENT_STATIC_BORINGSSL
   auto key_size = key.size();
   auto iv_size = iv.size();
@@ -935,6 +948,242 @@ decrypt(const couchbase::core::crypto::Cipher cipher,
   return ret;
 }
 
+struct EVP_MD_CTX_Deleter {
+  void operator()(EVP_MD_CTX* ctx)
+  {
+    if (ctx != nullptr) {
+      EVP_MD_CTX_free(ctx);
+    }
+  }
+};
+
+using unique_EVP_MD_CTX_ptr = std::unique_ptr<EVP_MD_CTX, EVP_MD_CTX_Deleter>;
+
+auto
+getDigest(const couchbase::core::crypto::Algorithm algorithm) -> const EVP_MD*
+{
+  switch (algorithm) {
+    case couchbase::core::crypto::Algorithm::ALG_SHA1:
+      return EVP_sha1();
+    case couchbase::core::crypto::Algorithm::ALG_SHA256:
+      return EVP_sha256();
+    case couchbase::core::crypto::Algorithm::ALG_SHA512:
+      return EVP_sha512();
+  }
+  throw std::invalid_argument("couchbase::core::crypto::getDigest: Unknown Algorithm " +
+                              std::to_string(static_cast<int>(algorithm)));
+}
+
+/**
+ * The cipher contexts keep the expanded key, so that only the IV is reset for every message.
+ *
+ * The HMAC is computed as described in RFC 2104 from the digest states, that have already absorbed
+ * the inner and the outer padded keys, which is what HMAC_CTX does internally, but without the API
+ * deprecated by OpenSSL 3.
+ */
+class cipher_context_impl
+{
+public:
+  cipher_context_impl(const couchbase::core::crypto::Cipher cipher,
+                      std::string_view cipher_key,
+                      const couchbase::core::crypto::Algorithm algorithm,
+                      std::string_view hmac_key)
+    : cipher_{ getCipher(cipher) }
+    , cipher_key_{ cipher_key }
+    , digest_{ getDigest(algorithm) }
+  {
+    if (static_cast<int>(cipher_key.size()) != EVP_CIPHER_key_length(cipher_)) {
+      throw std::invalid_argument("couchbase::core::crypto::cipher_context: Cipher requires a key "
+                                  "length of " +
+                                  std::to_string(EVP_CIPHER_key_length(cipher_)) +
+                                  " provided key with length " + std::to_string(cipher_key.size()));
+    }
+    const auto block_size = static_cast<std::size_t>(EVP_MD_block_size(digest_));
+    std::string key{ hmac_key };
+    if (key.size() > block_size) {
+      key.resize(static_cast<std::size_t>(EVP_MAX_MD_SIZE));
+      unsigned int key_size = 0;
+      if (EVP_Digest(hmac_key.data(),
+                     hmac_key.size(),
+                     reinterpret_cast<std::uint8_t*>(key.data()),
+                     &key_size,
+                     digest_,
+                     nullptr) != 1) {
+        throw std::runtime_error("couchbase::core::crypto::cipher_context: EVP_Digest failed");
+      }
+      key.resize(key_size);
+    }
+    key.resize(block_size, '\0');
+
+    std::string pad(block_size, '\0');
+    for (std::size_t i = 0; i < block_size; ++i) {
+      pad[i] = static_cast<char>(key[i] ^ 0x36);
+    }
+    init_digest(inner_, pad);
+    for (std::size_t i = 0; i < block_size; ++i) {
+      pad[i] = static_cast<char>(key[i] ^ 0x5c);
+    }
+    init_digest(outer_, pad);
+    OPENSSL_cleanse(key.data(), key.size());
+    OPENSSL_cleanse(pad.data(), pad.size());
+  }
+
+  cipher_context_impl(const cipher_context_impl&) = delete;
+  cipher_context_impl(cipher_context_impl&&) = delete;
+  auto operator=(const cipher_context_impl&) -> cipher_context_impl& = delete;
+  auto operator=(cipher_context_impl&&) -> cipher_context_impl& = delete;
+
+  ~cipher_context_impl()
+  {
+    OPENSSL_cleanse(cipher_key_.data(), cipher_key_.size());
+  }
+
+  auto encrypt(std::string_view iv, std::string_view data) -> std::string
+  {
+    if (!encrypt_ctx_) {
+      encrypt_ctx_ = init_cipher(true);
+    }
+    if (EVP_EncryptInit_ex(encrypt_ctx_.get(),
+                           nullptr,
+                           nullptr,
+                           nullptr,
+                           reinterpret_cast<const std::uint8_t*>(iv.data())) != 1) {
+      throw std::runtime_error(
+        "couchbase::core::crypto::cipher_context::encrypt: EVP_EncryptInit_ex failed");
+    }
+
+    std::string ret;
+    ret.resize(data.size() +
+               static_cast<std::size_t>(EVP_CIPHER_CTX_block_size(encrypt_ctx_.get())));
+    auto len1 = static_cast<int>(ret.size());
+    if (EVP_EncryptUpdate(encrypt_ctx_.get(),
+                          reinterpret_cast<std::uint8_t*>(ret.data()),
+                          &len1,
+                          reinterpret_cast<const std::uint8_t*>(data.data()),
+                          static_cast<int>(data.size())) != 1) {
+      throw std::runtime_error(
+        "couchbase::core::crypto::cipher_context::encrypt: EVP_EncryptUpdate failed");
+    }
+
+    int len2 = static_cast<int>(ret.size()) - len1;
+    if (EVP_EncryptFinal_ex(
+          encrypt_ctx_.get(), reinterpret_cast<std::uint8_t*>(ret.data()) + len1, &len2) != 1) {
+      throw std::runtime_error(
+        "couchbase::core::crypto::cipher_context::encrypt: EVP_EncryptFinal_ex failed");
+    }
+
+    ret.resize(static_cast<std::size_t>(len1) + static_cast<std::size_t>(len2));
+    return ret;
+  }
+
+  auto decrypt(std::string_view iv, std::string_view data) -> std::string
+  {
+    if (!decrypt_ctx_) {
+      decrypt_ctx_ = init_cipher(false);
+    }
+    if (EVP_DecryptInit_ex(decrypt_ctx_.get(),
+                           nullptr,
+                           nullptr,
+                           nullptr,
+                           reinterpret_cast<const std::uint8_t*>(iv.data())) != 1) {
+      throw std::runtime_error(
+        "couchbase::core::crypto::cipher_context::decrypt: EVP_DecryptInit_ex failed");
+    }
+
+    std::string ret;
+    ret.resize(data.size());
+    int len1 = static_cast<int>(ret.size());
+    if (EVP_DecryptUpdate(decrypt_ctx_.get(),
+                          reinterpret_cast<std::uint8_t*>(ret.data()),
+                          &len1,
+                          reinterpret_cast<const std::uint8_t*>(data.data()),
+                          static_cast<int>(data.size())) != 1) {
+      throw std::runtime_error(
+        "couchbase::core::crypto::cipher_context::decrypt: EVP_DecryptUpdate failed");
+    }
+
+    int len2 = static_cast<int>(data.size()) - len1;
+    if (EVP_DecryptFinal_ex(
+          decrypt_ctx_.get(), reinterpret_cast<std::uint8_t*>(ret.data()) + len1, &len2) != 1) {
+      throw std::runtime_error(
+        "couchbase::core::crypto::cipher_context::decrypt: EVP_DecryptFinal_ex failed");
+    }
+
+    ret.resize(static_cast<std::size_t>(len1) + static_cast<std::size_t>(len2));
+    return ret;
+  }
+
+  auto hmac(std::initializer_list<std::string_view> parts) -> std::string
+  {
+    std::string ret;
+    ret.resize(static_cast<std::size_t>(EVP_MAX_MD_SIZE));
+    unsigned int len = 0;
+
+    if (EVP_MD_CTX_copy_ex(work_.get(), inner_.get()) != 1) {
+      throw std::runtime_error("couchbase::core::crypto::cipher_context::hmac: "
+                               "EVP_MD_CTX_copy_ex failed");
+    }
+    for (const auto& part : parts) {
+      if (EVP_DigestUpdate(work_.get(), part.data(), part.size()) != 1) {
+        throw std::runtime_error("couchbase::core::crypto::cipher_context::hmac: "
+                                 "EVP_DigestUpdate failed");
+      }
+    }
+    if (EVP_DigestFinal_ex(work_.get(), reinterpret_cast<std::uint8_t*>(ret.data()), &len) != 1) {
+      throw std::runtime_error("couchbase::core::crypto::cipher_context::hmac: "
+                               "EVP_DigestFinal_ex failed");
+    }
+
+    if (EVP_MD_CTX_copy_ex(work_.get(), outer_.get()) != 1 ||
+        EVP_DigestUpdate(work_.get(), ret.data(), len) != 1 ||
+        EVP_DigestFinal_ex(work_.get(), reinterpret_cast<std::uint8_t*>(ret.data()), &len) != 1) {
+      throw std::runtime_error("couchbase::core::crypto::cipher_context::hmac: "
+                               "outer digest failed");
+    }
+    ret.resize(len);
+    return ret;
+  }
+
+private:
+  auto init_cipher(bool encrypt) -> unique_EVP_CIPHER_CTX_ptr
+  {
+    unique_EVP_CIPHER_CTX_ptr ctx(EVP_CIPHER_CTX_new());
+    if (!ctx) {
+      throw std::runtime_error(
+        "couchbase::core::crypto::cipher_context: EVP_CIPHER_CTX_new failed");
+    }
+    if (EVP_CipherInit_ex(ctx.get(),
+                          cipher_,
+                          nullptr,
+                          reinterpret_cast<const std::uint8_t*>(cipher_key_.data()),
+                          nullptr,
+                          encrypt ? 1 : 0) != 1) {
+      throw std::runtime_error(
+        "couchbase::core::crypto::cipher_context: EVP_CipherInit_ex failed");
+    }
+    return ctx;
+  }
+
+  void init_digest(unique_EVP_MD_CTX_ptr& ctx, std::string_view padded_key)
+  {
+    ctx.reset(EVP_MD_CTX_new());
+    if (!ctx || EVP_DigestInit_ex(ctx.get(), digest_, nullptr) != 1 ||
+        EVP_DigestUpdate(ctx.get(), padded_key.data(), padded_key.size()) != 1) {
+      throw std::runtime_error(
+        "couchbase::core::crypto::cipher_context: failed to initialize HMAC");
+    }
+  }
+
+  const EVP_CIPHER* cipher_;
+  std::string cipher_key_;
+  const EVP_MD* digest_;
+  unique_EVP_CIPHER_CTX_ptr encrypt_ctx_{};
+  unique_EVP_CIPHER_CTX_ptr decrypt_ctx_{};
+  unique_EVP_MD_CTX_ptr inner_{};
+  unique_EVP_MD_CTX_ptr outer_{};
+  unique_EVP_MD_CTX_ptr work_{ EVP_MD_CTX_new() };
+};
+
 #endif
 
 inline void
@@ -949,6 +1198,73 @@ verifyLegalAlgorithm(const couchbase::core::crypto::Algorithm al)
   throw std::invalid_argument("verifyLegalAlgorithm: Unknown Algorithm: " +
                               std::to_string(static_cast<int>(al)));
 }
+
+#if defined(_MSC_VER) || defined(__APPLE__)
+/**
+ * The platform implementations do not keep reusable state yet, so the context only remembers the
+ * keys and delegates to the one-shot functions.
+ */
+class cipher_context_impl
+{
+public:
+  cipher_context_impl(const couchbase::core::crypto::Cipher cipher,
+                      std::string_view cipher_key,
+                      const couchbase::core::crypto::Algorithm algorithm,
+                      std::string_view hmac_key)
+    : cipher_{ cipher }
+    , cipher_key_{ cipher_key }
+    , algorithm_{ algorithm }
+    , hmac_key_{ hmac_key }
+  {
+  }
+
+  cipher_context_impl(const cipher_context_impl&) = delete;
+  cipher_context_impl(cipher_context_impl&&) = delete;
+  auto operator=(const cipher_context_impl&) -> cipher_context_impl& = delete;
+  auto operator=(cipher_context_impl&&) -> cipher_context_impl& = delete;
+
+  ~cipher_context_impl()
+  {
+    OPENSSL_cleanse(cipher_key_.data(), cipher_key_.size());
+    OPENSSL_cleanse(hmac_key_.data(), hmac_key_.size());
+  }
+
+  auto encrypt(std::string_view iv, std::string_view data) -> std::string
+  {
+    return internal::encrypt(cipher_, cipher_key_, iv, data);
+  }
+
+  auto decrypt(std::string_view iv, std::string_view data) -> std::string
+  {
+    return internal::decrypt(cipher_, cipher_key_, iv, data);
+  }
+
+  auto hmac(std::initializer_list<std::string_view> parts) -> std::string
+  {
+    std::string data;
+    for (const auto& part : parts) {
+      data.append(part);
+    }
+    switch (algorithm_) {
+      case couchbase::core::crypto::Algorithm::ALG_SHA1:
+        return HMAC_SHA1(hmac_key_, data);
+      case couchbase::core::crypto::Algorithm::ALG_SHA256:
+        return HMAC_SHA256(hmac_key_, data);
+      case couchbase::core::crypto::Algorithm::ALG_SHA512:
+        return HMAC_SHA512(hmac_key_, data);
+    }
+    throw std::invalid_argument(
+      "couchbase::core::crypto::cipher_context::hmac: Unknown Algorithm: " +
+      std::to_string(static_cast<int>(algorithm_)));
+  }
+
+private:
+  couchbase::core::crypto::Cipher cipher_;
+  std::string cipher_key_;
+  couchbase::core::crypto::Algorithm algorithm_;
+  std::string hmac_key_;
+};
+#endif
 } // namespace internal
 
 namespace couchbase::core::crypto
@@ -1060,6 +1376,66 @@ decrypt(const Cipher cipher, std::string_view key, std::string_view iv, std::str
   return internal::decrypt(cipher, key, iv, data);
 }
 
+struct cipher_context::impl : internal::cipher_context_impl {
+  using internal::cipher_context_impl::cipher_context_impl;
+};
+
+cipher_context::cipher_context(const Cipher cipher,
+                               std::string_view cipher_key,
+                               const Algorithm algorithm,
+                               std::string_view hmac_key)
+{
+  if (cipher != Cipher::AES_256_cbc) {
+    throw std::invalid_argument("couchbase::core::crypto::cipher_context(): Unsupported cipher");
+  }
+
+  if (cipher_key.size() != 32) {
+    throw std::invalid_argument("couchbase::core::crypto::cipher_context(): Invalid key size: " +
+                                std::to_string(cipher_key.size()) + " (expected 32)");
+  }
+
+  internal::verifyLegalAlgorithm(algorithm);
+
+  impl_ = std::make_unique<impl>(cipher, cipher_key, algorithm, hmac_key);
+}
+
+cipher_context::cipher_context(cipher_context&&) noexcept = default;
+
+auto
+cipher_context::operator=(cipher_context&&) noexcept -> cipher_context& = default;
+
+cipher_context::~cipher_context() = default;
+
+auto
+cipher_context::encrypt(std::string_view iv, std::string_view data) -> std::string
+{
+  if (iv.size() != 16) {
+    throw std::invalid_argument(
+      "couchbase::core::crypto::cipher_context::encrypt(): Invalid iv size: " +
+      std::to_string(iv.size()) + " (expected 16)");
+  }
+
+  return impl_->encrypt(iv, data);
+}
+
+auto
+cipher_context::decrypt(std::string_view iv, std::string_view data) -> std::string
+{
+  if (iv.size() != 16) {
+    throw std::invalid_argument(
+      "couchbase::core::crypto::cipher_context::decrypt(): Invalid iv size: " +
+      std::to_string(iv.size()) + " (expected 16)");
+  }
+
+  return impl_->decrypt(iv, data);
+}
+
+auto
+cipher_context::hmac(std::initializer_list<std::string_view> parts) -> std::string
+{
+  return impl_->hmac(parts);
+}
+
 auto
 to_cipher(const std::string& str) -> couchbase::core::crypto::Cipher
 {
@@ -17,7 +17,10 @@
 #pragma once
 
 #include <cstdint>
+#include <initializer_list>
+#include <memory>
 #include <string>
+#include <string_view>
 
 namespace couchbase::core::crypto
 {
@@ -96,4 +99,49 @@ auto
 decrypt(Cipher cipher, std::string_view key, std::string_view iv, std::string_view data)
   -> std::string;
 
+/**
+ * Cipher and HMAC state, that is prepared once for a pair of keys and reused for many messages.
+ *
+ * Expanding the cipher key and hashing the padded HMAC key costs more than processing a short
+ * message, so encrypting all fields of a document through the same context is considerably
+ * cheaper than calling encrypt() and CBC_HMAC() for each of them.
+ *
+ * The context is not thread-safe.
+ *
+ * @throws std::invalid_argument - unsupported cipher or algorithm, invalid key
+ *         std::runtime_error - failures initializing the contexts
+ */
+class cipher_context
+{
+public:
+  cipher_context(Cipher cipher,
+                 std::string_view cipher_key,
+                 Algorithm algorithm,
+                 std::string_view hmac_key);
+  cipher_context(const cipher_context&) = delete;
+  cipher_context(cipher_context&&) noexcept;
+  auto operator=(const cipher_context&) -> cipher_context& = delete;
+  auto operator=(cipher_context&&) noexcept -> cipher_context&;
+  ~cipher_context();
+
+  /**
+   * Same as the encrypt() function, but with the key of the context.
+   */
+  auto encrypt(std::string_view iv, std::string_view data) -> std::string;
+
+  /**
+   * Same as the decrypt() function, but with the key of the context.
+   */
+  auto decrypt(std::string_view iv, std::string_view data) -> std::string;
+
+  /**
+   * Generate a HMAC digest of the concatenated parts with the key of the context.
+   */
+  auto hmac(std::initializer_list<std::string_view> parts) -> std::string;
+
+private:
+  struct impl;
+  std::unique_ptr<impl> impl_;
+};
+
 } // namespace couchbase::core::crypto
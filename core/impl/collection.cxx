@@ -96,10 +96,14 @@
 
 #include <spdlog/fmt/bundled/core.h>
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdint>
 #include <future>
+#include <limits>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <string_view>
 #include <system_error>
@@ -111,6 +115,12 @@
 
 namespace couchbase
 {
+namespace
+{
+using upsert_multi_document =
+  std::pair<std::string, std::variant<codec::encoded_value, std::function<codec::encoded_value()>>>;
+} // namespace
+
 class collection_impl : public std::enable_shared_from_this<collection_impl>
 {
 public:
@@ -862,6 +872,45 @@ public:
       });
   }
 
+  void get_multi(std::vector<std::string> document_keys,
+                 get_options::built options,
+                 get_multi_handler&& handler) const
+  {
+    return execute_multi<get_result>(
+      std::move(document_keys),
+      [options](const collection_impl& self, std::string&& key, get_handler&& item_handler) {
+        self.get(std::move(key), options, std::move(item_handler));
+      },
+      std::move(handler));
+  }
+
+  void upsert_multi(std::vector<upsert_multi_document> documents,
+                    upsert_options::built options,
+                    upsert_multi_handler&& handler) const
+  {
+    return execute_multi<mutation_result>(
+      std::move(documents),
+      [options](const collection_impl& self, auto&& document, upsert_handler&& item_handler) {
+        self.upsert(std::move(document.first),
+                    std::move(document.second),
+                    options,
+                    std::move(item_handler));
+      },
+      std::move(handler));
+  }
+
+  void remove_multi(std::vector<std::string> document_keys,
+                    remove_options::built options,
+                    remove_multi_handler&& handler) const
+  {
+    return execute_multi<mutation_result>(
+      std::move(document_keys),
+      [options](const collection_impl& self, std::string&& key, remove_handler&& item_handler) {
+        self.remove(std::move(key), options, std::move(item_handler));
+      },
+      std::move(handler));
+  }
+
   void insert(std::string document_key,
               std::variant<codec::encoded_value, std::function<codec::encoded_value()>> value,
               insert_options::built options,
@@ -1057,6 +1106,7 @@ public:
     if (options.concurrency.has_value()) {
       orchestrator_opts.concurrency = options.concurrency.value();
     }
+    orchestrator_opts.adaptive_concurrency = options.adaptive_concurrency;
     if (options.timeout.has_value()) {
       orchestrator_opts.timeout = options.timeout.value();
     } else {
@@ -1178,6 +1228,102 @@ public:
   }
 
 private:
+  static auto multi_document_key(const std::string& key) -> const std::string&
+  {
+    return key;
+  }
+
+  template<typename Value>
+  static auto multi_document_key(const std::pair<std::string, Value>& document)
+    -> const std::string&
+  {
+    return document.first;
+  }
+
+  /**
+   * Dispatches one operation per item, and invokes the handler once all of them have completed.
+   *
+   * The items are grouped by the node that owns the document, and every group is submitted from a
+   * single task on the context of the KV session of that node. The session cannot start writing
+   * while the task runs, so the requests of the group leave in one write, whether or not write
+   * coalescing is enabled. The results are passed to the handler in the order of the items.
+   */
+  template<typename Result, typename Item, typename Submit, typename Handler>
+  void execute_multi(std::vector<Item> items, Submit&& submit, Handler&& handler) const
+  {
+    using multi_result = std::vector<std::pair<error, Result>>;
+
+    if (items.empty()) {
+      return handler(multi_result{});
+    }
+
+    struct multi_state {
+      multi_state(std::vector<Item>&& all_items, Submit&& submit_item, Handler&& on_complete)
+        : items{ std::move(all_items) }
+        , submit{ std::move(submit_item) }
+        , results(items.size())
+        , remaining{ items.size() }
+        , handler{ std::move(on_complete) }
+      {
+      }
+
+      std::vector<Item> items;
+      Submit submit;
+      multi_result results;
+      std::atomic_size_t remaining;
+      Handler handler;
+    };
+
+    core_.with_bucket_configuration(
+      bucket_name_,
+      [self = shared_from_this(),
+       items = std::move(items),
+       submit = std::forward<Submit>(submit),
+       handler = std::forward<Handler>(handler)](
+        std::error_code ec, const std::shared_ptr<core::topology::configuration>& config) mutable {
+        std::vector<std::size_t> order(items.size());
+        std::iota(order.begin(), order.end(), std::size_t{ 0 });
+        std::vector<std::size_t> nodes(items.size(), std::numeric_limits<std::size_t>::max());
+        if (!ec && config && config->vbmap.has_value()) {
+          for (std::size_t i = 0; i < items.size(); ++i) {
+            if (auto [_, node] = config->map_key(multi_document_key(items[i]), 0); node) {
+              nodes[i] = node.value();
+            }
+          }
+          std::stable_sort(order.begin(), order.end(), [&nodes](auto lhs, auto rhs) {
+            return nodes[lhs] < nodes[rhs];
+          });
+        }
+
+        auto state =
+          std::make_shared<multi_state>(std::move(items), std::move(submit), std::move(handler));
+        auto group_begin = order.begin();
+        while (group_begin != order.end()) {
+          auto group_end = std::find_if(group_begin, order.end(), [&](auto index) {
+            return nodes[index] != nodes[*group_begin];
+          });
+          std::vector<std::size_t> group(group_begin, group_end);
+          group_begin = group_end;
+
+          core::document_id id{ self->bucket_name_,
+                                self->scope_name_,
+                                self->name_,
+                                multi_document_key(state->items[group.front()]) };
+          self->core_.with_document_context(id, [self, state, group = std::move(group)]() {
+            for (auto index : group) {
+              state->submit(
+                *self, std::move(state->items[index]), [state, index](error err, Result result) {
+                  state->results[index] = { std::move(err), std::move(result) };
+                  if (state->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                    state->handler(std::move(state->results));
+                  }
+                });
+            }
+          });
+        }
+      });
+  }
+
   static auto get_encoded_value(
     std::variant<codec::encoded_value, std::function<codec::encoded_value()>> value,
     const std::unique_ptr<core::impl::observability_recorder>& obs_rec) -> codec::encoded_value
@@ -1285,6 +1431,26 @@ collection::get(std::string document_id, const get_options& options) const
   return future;
 }
 
+void
+collection::get_multi(std::vector<std::string> document_ids,
+                      const get_options& options,
+                      get_multi_handler&& handler) const
+{
+  return impl_->get_multi(std::move(document_ids), options.build(), std::move(handler));
+}
+
+auto
+collection::get_multi(std::vector<std::string> document_ids, const get_options& options) const
+  -> std::future<get_multi_result>
+{
+  auto barrier = std::make_shared<std::promise<get_multi_result>>();
+  auto future = barrier->get_future();
+  get_multi(std::move(document_ids), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
 void
 collection::get_and_touch(std::string document_id,
                           std::chrono::seconds duration,
@@ -1447,6 +1613,26 @@ collection::remove(std::string document_id, const remove_options& options) const
   return future;
 }
 
+void
+collection::remove_multi(std::vector<std::string> document_ids,
+                         const remove_options& options,
+                         remove_multi_handler&& handler) const
+{
+  return impl_->remove_multi(std::move(document_ids), options.build(), std::move(handler));
+}
+
+auto
+collection::remove_multi(std::vector<std::string> document_ids,
+                         const remove_options& options) const -> std::future<remove_multi_result>
+{
+  auto barrier = std::make_shared<std::promise<remove_multi_result>>();
+  auto future = barrier->get_future();
+  remove_multi(std::move(document_ids), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
 void
 collection::mutate_in(std::string document_id,
                       const mutate_in_specs& specs,
@@ -1656,6 +1842,66 @@ collection::upsert(std::string document_id,
   return future;
 }
 
+namespace
+{
+template<typename Document>
+auto
+to_upsert_values(std::vector<std::pair<std::string, Document>> documents)
+  -> std::vector<upsert_multi_document>
+{
+  std::vector<upsert_multi_document> values;
+  values.reserve(documents.size());
+  for (auto& [document_id, document] : documents) {
+    values.emplace_back(std::move(document_id), std::move(document));
+  }
+  return values;
+}
+} // namespace
+
+void
+collection::upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                         const upsert_options& options,
+                         upsert_multi_handler&& handler) const
+{
+  return impl_->upsert_multi(
+    to_upsert_values(std::move(documents)), options.build(), std::move(handler));
+}
+
+auto
+collection::upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                         const upsert_options& options) const -> std::future<upsert_multi_result>
+{
+  auto barrier = std::make_shared<std::promise<upsert_multi_result>>();
+  auto future = barrier->get_future();
+  upsert_multi(std::move(documents), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
+void
+collection::upsert_multi(
+  std::vector<std::pair<std::string, std::function<codec::encoded_value()>>> documents,
+  const upsert_options& options,
+  upsert_multi_handler&& handler) const
+{
+  return impl_->upsert_multi(
+    to_upsert_values(std::move(documents)), options.build(), std::move(handler));
+}
+
+auto
+collection::upsert_multi(
+  std::vector<std::pair<std::string, std::function<codec::encoded_value()>>> documents,
+  const upsert_options& options) const -> std::future<upsert_multi_result>
+{
+  auto barrier = std::make_shared<std::promise<upsert_multi_result>>();
+  auto future = barrier->get_future();
+  upsert_multi(std::move(documents), options, [barrier](auto results) {
+    barrier->set_value(std::move(results));
+  });
+  return future;
+}
+
 void
 collection::insert(std::string document_id,
                    codec::encoded_value document,
@@ -26,72 +26,87 @@
 #include "include_ssl/rand.h"
 #include <spdlog/fmt/bundled/format.h>
 
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+
 namespace couchbase::crypto::internal
 {
+namespace
+{
+constexpr std::size_t max_cached_keys{ 16 };
+
 auto
-generate_initialization_vector() -> std::pair<error, std::vector<std::byte>>
+as_string_view(const std::vector<std::byte>& data) -> std::string_view
 {
+  return { reinterpret_cast<const char*>(data.data()), data.size() };
+}
 
-  std::vector<std::byte> iv{ 16 };
-#ifdef COUCHBASE_CXX_CLIENT_STATIC_BORINGSSL
-  auto iv_size = iv.size();
-#else
-  auto iv_size = static_cast<int>(iv.size());
-#endif
-  if (RAND_bytes(reinterpret_cast<unsigned char*>(iv.data()), iv_size) != 1) {
-    return { error{ errc::field_level_encryption::encryption_failure,
-                    "Failed to generate random initialization vector" },
-             {} };
+/**
+ * Returns the cipher context of the 64-byte key for the current thread.
+ *
+ * The first half of the key is used for the HMAC, and the second one for AES. Usually the
+ * application works with a handful of keys, so the cache is simply dropped when it grows too big.
+ * The contexts are looked up by the SHA-256 digest of the key, so that the cache does not keep
+ * copies of the raw keys, and the contexts wipe their own copies when they are destroyed.
+ */
+auto
+context_for(const std::vector<std::byte>& key) -> core::crypto::cipher_context&
+{
+  thread_local std::map<std::string, core::crypto::cipher_context> contexts{};
+
+  const auto bytes = as_string_view(key);
+  auto key_digest = core::crypto::digest(core::crypto::Algorithm::ALG_SHA256, bytes);
+  if (auto it = contexts.find(key_digest); it != contexts.end()) {
+    return it->second;
   }
-  return { {}, iv };
+  if (contexts.size() >= max_cached_keys) {
+    contexts.clear();
+  }
+  return contexts
+    .try_emplace(std::move(key_digest),
+                 core::crypto::Cipher::AES_256_cbc,
+                 bytes.substr(32),
+                 core::crypto::Algorithm::ALG_SHA512,
+                 bytes.substr(0, 32))
+    .first->second;
 }
 
 auto
-aead_aes_256_cbc_hmac_sha512::encrypt(std::vector<std::byte> key,
-                                      std::vector<std::byte> iv,
-                                      std::vector<std::byte> plaintext,
-                                      std::vector<std::byte> associated_data)
-  -> std::pair<error, std::vector<std::byte>>
+associated_data_length(const std::vector<std::byte>& associated_data) -> std::vector<std::byte>
 {
-  if (key.size() != 64) {
-    return {
-      error{ errc::field_level_encryption::invalid_crypto_key, "Key must be 64 bytes long." }, {}
-    };
-  }
+  std::vector<std::byte> length{ sizeof(std::uint64_t) };
+  core::mcbp::big_endian::put_uint64(length, associated_data.size() * 8); // In bits
+  return length;
+}
 
-  std::vector<std::byte> ciphertext;
+auto
+encrypt_with(core::crypto::cipher_context& context,
+             const std::vector<std::byte>& iv,
+             const std::vector<std::byte>& plaintext,
+             const std::vector<std::byte>& associated_data)
+  -> std::pair<error, std::vector<std::byte>>
+{
+  std::string ciphertext;
   try {
-    auto aes_key = std::vector<std::byte>{ key.begin() + 32, key.end() };
-    ciphertext = core::utils::to_binary(
-      core::crypto::encrypt(core::crypto::Cipher::AES_256_cbc,
-                            { reinterpret_cast<char*>(aes_key.data()), aes_key.size() },
-                            { reinterpret_cast<char*>(iv.data()), iv.size() },
-                            { reinterpret_cast<char*>(plaintext.data()), plaintext.size() }));
+    ciphertext = context.encrypt(as_string_view(iv), as_string_view(plaintext));
   } catch (const std::exception& e) {
     return { error{ errc::field_level_encryption::encryption_failure,
                     fmt::format("Encryption failed: {}", e.what()) },
              {} };
   }
 
-  ciphertext.insert(ciphertext.begin(), iv.begin(), iv.end());
-
-  std::vector<std::byte> associated_data_length{ sizeof(std::uint64_t) };
-  core::mcbp::big_endian::put_uint64(associated_data_length, associated_data.size() * 8); // In bits
-
-  std::vector<std::byte> digest_data;
-  digest_data.reserve(associated_data.size() + ciphertext.size() + sizeof(std::uint64_t));
-  digest_data.insert(digest_data.end(), associated_data.begin(), associated_data.end());
-  digest_data.insert(digest_data.end(), ciphertext.begin(), ciphertext.end());
-  digest_data.insert(
-    digest_data.end(), associated_data_length.begin(), associated_data_length.end());
-
-  std::vector<std::byte> auth_tag;
+  std::string auth_tag;
   try {
-    auto hmac_key = std::vector<std::byte>{ key.begin(), key.begin() + 32 };
-    auth_tag = core::utils::to_binary(
-      core::crypto::CBC_HMAC(core::crypto::Algorithm::ALG_SHA512,
-                             { reinterpret_cast<char*>(hmac_key.data()), hmac_key.size() },
-                             { reinterpret_cast<char*>(digest_data.data()), digest_data.size() }));
+    auth_tag = context.hmac({
+      as_string_view(associated_data),
+      as_string_view(iv),
+      ciphertext,
+      as_string_view(associated_data_length(associated_data)),
+    });
   } catch (const std::exception& e) {
     return { error{ errc::field_level_encryption::encryption_failure,
                     fmt::format("Generating the HMAC SHA-512 auth tag failed: {}", e.what()) },
@@ -105,17 +120,23 @@ aead_aes_256_cbc_hmac_sha512::encrypt(std::vector<std::byte> key,
              {} };
   }
 
-  // We append the first 32 bytes of the auth tag to the ciphertext to get the authenticated
-  // ciphertext
-  ciphertext.insert(ciphertext.end(), auth_tag.begin(), auth_tag.begin() + 32);
+  // The authenticated ciphertext consists of the IV, the ciphertext and the first 32 bytes of the
+  // auth tag
+  std::vector<std::byte> authenticated_ciphertext;
+  authenticated_ciphertext.reserve(iv.size() + ciphertext.size() + 32);
+  authenticated_ciphertext.insert(authenticated_ciphertext.end(), iv.begin(), iv.end());
+  core::utils::to_binary(
+    ciphertext.begin(), ciphertext.end(), std::back_inserter(authenticated_ciphertext));
+  core::utils::to_binary(
+    auth_tag.begin(), auth_tag.begin() + 32, std::back_inserter(authenticated_ciphertext));
 
-  return { {}, ciphertext };
+  return { {}, authenticated_ciphertext };
 }
 
 auto
-aead_aes_256_cbc_hmac_sha512::decrypt(std::vector<std::byte> key,
-                                      std::vector<std::byte> ciphertext,
-                                      std::vector<std::byte> associated_data)
+decrypt_with(core::crypto::cipher_context& context,
+             const std::vector<std::byte>& ciphertext,
+             const std::vector<std::byte>& associated_data)
   -> std::pair<error, std::vector<std::byte>>
 {
   if (ciphertext.size() < 48) {
@@ -123,32 +144,19 @@ aead_aes_256_cbc_hmac_sha512::decrypt(std::vector<std::byte> key,
                     "ciphertext is not long enough to include auth tag and IV." },
              {} };
   }
-  if (key.size() != 64) {
-    return {
-      error{ errc::field_level_encryption::invalid_crypto_key, "key must be 64 bytes long." }, {}
-    };
-  }
-
-  std::vector<std::byte> associated_data_length{ sizeof(std::uint64_t) };
-  core::mcbp::big_endian::put_uint64(associated_data_length, associated_data.size() * 8); // In bits
 
-  const auto expected_auth_tag = std::vector<std::byte>{ ciphertext.end() - 32, ciphertext.end() };
-  ciphertext.erase(ciphertext.end() - 32, ciphertext.end());
+  const auto bytes = as_string_view(ciphertext);
+  const auto iv = bytes.substr(0, 16);
+  const auto encrypted = bytes.substr(16, bytes.size() - 48);
+  const auto expected_auth_tag = bytes.substr(bytes.size() - 32);
 
-  std::vector<std::byte> digest_data;
-  digest_data.reserve(associated_data.size() + ciphertext.size() + sizeof(std::uint64_t));
-  digest_data.insert(digest_data.end(), associated_data.begin(), associated_data.end());
-  digest_data.insert(digest_data.end(), ciphertext.begin(), ciphertext.end());
-  digest_data.insert(
-    digest_data.end(), associated_data_length.begin(), associated_data_length.end());
-
-  std::vector<std::byte> auth_tag;
+  std::string auth_tag;
   try {
-    auto hmac_key = std::vector<std::byte>{ key.begin(), key.begin() + 32 };
-    auth_tag = core::utils::to_binary(
-      core::crypto::CBC_HMAC(core::crypto::Algorithm::ALG_SHA512,
-                             { reinterpret_cast<char*>(hmac_key.data()), hmac_key.size() },
-                             { reinterpret_cast<char*>(digest_data.data()), digest_data.size() }));
+    auth_tag = context.hmac({
+      as_string_view(associated_data),
+      bytes.substr(0, bytes.size() - 32),
+      as_string_view(associated_data_length(associated_data)),
+    });
   } catch (const std::exception& e) {
     return { error{ errc::field_level_encryption::decryption_failure,
                     fmt::format("Generating the HMAC SHA-512 auth tag failed: {}.", e.what()) },
@@ -165,7 +173,7 @@ aead_aes_256_cbc_hmac_sha512::decrypt(std::vector<std::byte> key,
   // Time-constant comparison of auth_tag and expected_auth_tag
   bool auth_tag_matches = true;
   for (std::size_t i = 0; i < expected_auth_tag.size(); ++i) {
-    auth_tag_matches &= auth_tag.at(i) == expected_auth_tag.at(i);
+    auth_tag_matches &= auth_tag[i] == expected_auth_tag[i];
   }
   if (!auth_tag_matches) {
     return { error{ errc::field_level_encryption::invalid_ciphertext,
@@ -175,15 +183,7 @@ aead_aes_256_cbc_hmac_sha512::decrypt(std::vector<std::byte> key,
 
   std::vector<std::byte> plaintext;
   try {
-    auto iv = std::vector<std::byte>{ ciphertext.begin(), ciphertext.begin() + 16 };
-    ciphertext.erase(ciphertext.begin(), ciphertext.begin() + 16);
-
-    auto aes_key = std::vector<std::byte>{ key.begin() + 32, key.end() };
-    plaintext = core::utils::to_binary(
-      core::crypto::decrypt(core::crypto::Cipher::AES_256_cbc,
-                            { reinterpret_cast<char*>(aes_key.data()), aes_key.size() },
-                            { reinterpret_cast<char*>(iv.data()), iv.size() },
-                            { reinterpret_cast<char*>(ciphertext.data()), ciphertext.size() }));
+    plaintext = core::utils::to_binary(context.decrypt(iv, encrypted));
   } catch (const std::exception& e) {
     return { error{ errc::field_level_encryption::decryption_failure,
                     fmt::format("Decryption failed: {}", e.what()) },
@@ -191,4 +191,140 @@ aead_aes_256_cbc_hmac_sha512::decrypt(std::vector<std::byte> key,
   }
   return { {}, plaintext };
 }
+} // namespace
+
+auto
+generate_initialization_vector() -> std::pair<error, std::vector<std::byte>>
+{
+
+  std::vector<std::byte> iv{ 16 };
+#ifdef COUCHBASE_CXX_CLIENT_STATIC_BORINGSSL
+  auto iv_size = iv.size();
+#else
+  auto iv_size = static_cast<int>(iv.size());
+#endif
+  if (RAND_bytes(reinterpret_cast<unsigned char*>(iv.data()), iv_size) != 1) {
+    return { error{ errc::field_level_encryption::encryption_failure,
+                    "Failed to generate random initialization vector" },
+             {} };
+  }
+  return { {}, iv };
+}
+
+auto
+aead_aes_256_cbc_hmac_sha512::encrypt(std::vector<std::byte> key,
+                                      std::vector<std::byte> iv,
+                                      std::vector<std::byte> plaintext,
+                                      std::vector<std::byte> associated_data)
+  -> std::pair<error, std::vector<std::byte>>
+{
+  if (key.size() != 64) {
+    return {
+      error{ errc::field_level_encryption::invalid_crypto_key, "Key must be 64 bytes long." }, {}
+    };
+  }
+
+  core::crypto::cipher_context* context{ nullptr };
+  try {
+    context = &context_for(key);
+  } catch (const std::exception& e) {
+    return { error{ errc::field_level_encryption::encryption_failure,
+                    fmt::format("Encryption failed: {}", e.what()) },
+             {} };
+  }
+  return encrypt_with(*context, iv, plaintext, associated_data);
+}
+
+auto
+aead_aes_256_cbc_hmac_sha512::decrypt(std::vector<std::byte> key,
+                                      std::vector<std::byte> ciphertext,
+                                      std::vector<std::byte> associated_data)
+  -> std::pair<error, std::vector<std::byte>>
+{
+  if (ciphertext.size() < 48) {
+    return { error{ errc::field_level_encryption::invalid_ciphertext,
+                    "ciphertext is not long enough to include auth tag and IV." },
+             {} };
+  }
+  if (key.size() != 64) {
+    return {
+      error{ errc::field_level_encryption::invalid_crypto_key, "key must be 64 bytes long." }, {}
+    };
+  }
+
+  core::crypto::cipher_context* context{ nullptr };
+  try {
+    context = &context_for(key);
+  } catch (const std::exception& e) {
+    return { error{ errc::field_level_encryption::decryption_failure,
+                    fmt::format("Decryption failed: {}", e.what()) },
+             {} };
+  }
+  return decrypt_with(*context, ciphertext, associated_data);
+}
+
+auto
+aead_aes_256_cbc_hmac_sha512::encrypt_fields(const std::vector<std::byte>& key,
+                                             const std::vector<plaintext_field>& fields)
+  -> std::pair<error, std::vector<std::vector<std::byte>>>
+{
+  if (key.size() != 64) {
+    return {
+      error{ errc::field_level_encryption::invalid_crypto_key, "Key must be 64 bytes long." }, {}
+    };
+  }
+
+  core::crypto::cipher_context* context{ nullptr };
+  try {
+    context = &context_for(key);
+  } catch (const std::exception& e) {
+    return { error{ errc::field_level_encryption::encryption_failure,
+                    fmt::format("Encryption failed: {}", e.what()) },
+             {} };
+  }
+
+  std::vector<std::vector<std::byte>> ciphertexts;
+  ciphertexts.reserve(fields.size());
+  for (const auto& field : fields) {
+    auto [err, ciphertext] =
+      encrypt_with(*context, field.iv, field.plaintext, field.associated_data);
+    if (err) {
+      return { err, {} };
+    }
+    ciphertexts.emplace_back(std::move(ciphertext));
+  }
+  return { {}, ciphertexts };
+}
+
+auto
+aead_aes_256_cbc_hmac_sha512::decrypt_fields(const std::vector<std::byte>& key,
+                                             const std::vector<ciphertext_field>& fields)
+  -> std::pair<error, std::vector<std::vector<std::byte>>>
+{
+  if (key.size() != 64) {
+    return {
+      error{ errc::field_level_encryption::invalid_crypto_key, "key must be 64 bytes long." }, {}
+    };
+  }
+
+  core::crypto::cipher_context* context{ nullptr };
+  try {
+    context = &context_for(key);
+  } catch (const std::exception& e) {
+    return { error{ errc::field_level_encryption::decryption_failure,
+                    fmt::format("Decryption failed: {}", e.what()) },
+             {} };
+  }
+
+  std::vector<std::vector<std::byte>> plaintexts;
+  plaintexts.reserve(fields.size());
+  for (const auto& field : fields) {
+    auto [err, plaintext] = decrypt_with(*context, field.ciphertext, field.associated_data);
+    if (err) {
+      return { err, {} };
+    }
+    plaintexts.emplace_back(std::move(plaintext));
+  }
+  return { {}, plaintexts };
+}
 } // namespace couchbase::crypto::internal
@@ -0,0 +1,97 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <couchbase/query_row_stream.hxx>
+
+#include "core/io/http_message.hxx"
+#include "core/utils/json_stream_control.hxx"
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+
+namespace couchbase
+{
+/**
+ * Buffers the rows between the IO thread that parses the query response, and the consumer.
+ *
+ * Reading of the socket is paused when the buffer reaches the high watermark, and resumed when the
+ * consumer drains it to the low watermark.
+ */
+class internal_query_row_stream : public std::enable_shared_from_this<internal_query_row_stream>
+{
+public:
+  static constexpr std::size_t default_high_watermark{ 1024 };
+
+  explicit internal_query_row_stream(std::size_t high_watermark = default_high_watermark);
+  internal_query_row_stream(const internal_query_row_stream&) = delete;
+  internal_query_row_stream(internal_query_row_stream&&) = delete;
+  auto operator=(const internal_query_row_stream&) -> internal_query_row_stream& = delete;
+  auto operator=(internal_query_row_stream&&) -> internal_query_row_stream& = delete;
+  ~internal_query_row_stream();
+
+  /**
+   * The handler is invoked once, on the first row or on completion of the query. Until then the
+   * stream keeps itself alive, afterwards it is owned by the consumer only, and the query is
+   * cancelled when the consumer drops it.
+   */
+  void on_open(query_stream_handler&& handler);
+  auto on_row(std::string&& row) -> core::utils::json::stream_control;
+  void on_complete(error err, query_meta_data meta_data);
+
+  [[nodiscard]] auto flow_control() const -> const std::shared_ptr<core::io::stream_flow_control>&;
+
+  void next_rows(std::size_t max_rows, query_rows_handler&& handler);
+  [[nodiscard]] auto meta_data() const -> std::optional<query_meta_data>;
+  void cancel();
+
+private:
+  /**
+   * Invokes the open handler, if it has not been invoked yet. The lock is released while the
+   * handler runs.
+   */
+  void open(std::unique_lock<std::mutex>& lock, const error& err);
+
+  /**
+   * Hands the buffered rows over to the pending consumer. Releases the lock.
+   */
+  void deliver(std::unique_lock<std::mutex>& lock);
+
+  const std::size_t high_watermark_;
+  const std::size_t low_watermark_;
+  std::shared_ptr<core::io::stream_flow_control> flow_control_{
+    std::make_shared<core::io::stream_flow_control>()
+  };
+
+  mutable std::mutex mutex_{};
+  std::deque<codec::binary> rows_{};
+  bool paused_{ false };
+  bool cancelled_{ false };
+  bool complete_{ false };
+  error error_{};
+  std::optional<query_meta_data> meta_data_{};
+  query_stream_handler open_handler_{};
+  std::shared_ptr<internal_query_row_stream> self_{};
+  query_rows_handler pending_handler_{};
+  std::size_t pending_max_rows_{ 0 };
+};
+} // namespace couchbase
@@ -24,6 +24,7 @@
 
 #include <asio/steady_timer.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <system_error>
@@ -218,6 +219,12 @@ public:
     return status_.token().partition_uuid();
   }
 
+  [[nodiscard]] auto make_request(document_id id, bool active, std::uint16_t partition) const
+    -> observe_seqno_request
+  {
+    return { std::move(id), active, partition_uuid(), timeout_, partition };
+  }
+
   [[nodiscard]] auto timeout() const -> const std::optional<std::chrono::milliseconds>&
   {
     return timeout_;
@@ -278,6 +285,7 @@ public:
       } else if (expect_number_of_responses_ == 0) {
         if (auto on_last_response = std::move(on_last_response_); on_last_response) {
           poll_backoff_.expires_after(poll_backoff_interval_);
+          poll_backoff_interval_ = next_observe_poll_interval(poll_backoff_interval_);
           return poll_backoff_.async_wait(std::move(on_last_response));
         }
       }
@@ -325,7 +333,7 @@ private:
   std::mutex handler_mutex_{};
   observe_handler handler_{};
   utils::movable_function<void(std::error_code)> on_last_response_{};
-  std::chrono::milliseconds poll_backoff_interval_{ 500 };
+  std::chrono::microseconds poll_backoff_interval_{ observe_poll_initial_interval };
   std::chrono::milliseconds poll_deadline_interval_{ 5'000 };
 };
 
@@ -346,9 +354,10 @@ observe_poll(const cluster& core, std::shared_ptr<observe_context> ctx)
         return ctx->finish(err);
       }
 
+      // the partition lets concurrent observers of the same vBucket share requests
+      const auto partition = config->map_key(ctx->id().key(), 0).first;
       if (ctx->persist_to() != persist_to::none) {
-        ctx->add_request(
-          observe_seqno_request{ ctx->id(), true, ctx->partition_uuid(), ctx->timeout() });
+        ctx->add_request(ctx->make_request(ctx->id(), true, partition));
       }
 
       if (touches_replica(ctx->persist_to(), ctx->replicate_to())) {
@@ -356,8 +365,7 @@ observe_poll(const cluster& core, std::shared_ptr<observe_context> ctx)
              ++replica_index) {
           auto replica_id = ctx->id();
           replica_id.node_index(replica_index);
-          ctx->add_request(
-            observe_seqno_request{ replica_id, false, ctx->partition_uuid(), ctx->timeout() });
+          ctx->add_request(ctx->make_request(std::move(replica_id), false, partition));
         }
       }
       ctx->execute(core);
@@ -365,6 +373,12 @@ observe_poll(const cluster& core, std::shared_ptr<observe_context> ctx)
 }
 } // namespace
 
+auto
+next_observe_poll_interval(std::chrono::microseconds interval) -> std::chrono::microseconds
+{
+  return std::min(interval * 2, observe_poll_max_interval);
+}
+
 void
 initiate_observe_poll(const cluster& core,
                       document_id id,
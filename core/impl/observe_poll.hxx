@@ -35,6 +35,14 @@ namespace impl
 {
 using observe_handler = utils::movable_function<void(std::error_code)>;
 
+// Replication and persistence usually complete within milliseconds, so the polling starts with
+// short intervals, and backs off exponentially while the nodes are catching up.
+constexpr std::chrono::microseconds observe_poll_initial_interval{ 100 };
+constexpr std::chrono::microseconds observe_poll_max_interval{ 100'000 };
+
+auto
+next_observe_poll_interval(std::chrono::microseconds interval) -> std::chrono::microseconds;
+
 void
 initiate_observe_poll(const cluster& core,
                       document_id id,
@@ -0,0 +1,74 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "observe_seqno_coalescer.hxx"
+
+#include <tuple>
+#include <utility>
+
+namespace couchbase::core::impl
+{
+auto
+observe_seqno_coalescer::key::operator<(const key& other) const -> bool
+{
+  return std::tie(bucket_name, partition, node_index, partition_uuid) <
+         std::tie(other.bucket_name, other.partition, other.node_index, other.partition_uuid);
+}
+
+auto
+observe_seqno_coalescer::key_for(const observe_seqno_request& request) -> key
+{
+  return {
+    request.id.bucket(),
+    request.partition,
+    request.id.node_index(),
+    request.partition_uuid,
+  };
+}
+
+auto
+observe_seqno_coalescer::join(const key& k, handler_type&& handler) -> bool
+{
+  const std::scoped_lock lock(mutex_);
+  auto [it, inserted] = pending_.try_emplace(k);
+  it->second.emplace_back(std::move(handler));
+  return inserted;
+}
+
+void
+observe_seqno_coalescer::complete(const key& k, const observe_seqno_response& response)
+{
+  std::vector<handler_type> handlers{};
+  {
+    const std::scoped_lock lock(mutex_);
+    if (auto it = pending_.find(k); it != pending_.end()) {
+      handlers = std::move(it->second);
+      pending_.erase(it);
+    }
+  }
+  for (auto& handler : handlers) {
+    handler(response);
+  }
+}
+
+auto
+observe_seqno_coalescer::number_of_pending_requests() const -> std::size_t
+{
+  const std::scoped_lock lock(mutex_);
+  return pending_.size();
+}
+} // namespace couchbase::core::impl
@@ -0,0 +1,74 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "observe_seqno.hxx"
+
+#include "core/utils/movable_function.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace couchbase::core::impl
+{
+/**
+ * Shares observe_seqno round trips between concurrent durable writes.
+ *
+ * The response describes the state of the whole vBucket copy on the node, so while one request for
+ * the copy is in flight, every other observer of the same copy joins it instead of sending its
+ * own request.
+ */
+class observe_seqno_coalescer
+{
+public:
+  using handler_type = utils::movable_function<void(observe_seqno_response)>;
+
+  struct key {
+    std::string bucket_name;
+    std::uint16_t partition;
+    std::size_t node_index;
+    std::uint64_t partition_uuid;
+
+    auto operator<(const key& other) const -> bool;
+  };
+
+  [[nodiscard]] static auto key_for(const observe_seqno_request& request) -> key;
+
+  /**
+   * Registers the handler for the response of the given vBucket copy.
+   *
+   * @return true if the caller has to send the request, and pass the response to complete()
+   */
+  [[nodiscard]] auto join(const key& k, handler_type&& handler) -> bool;
+
+  /**
+   * Hands the response over to all handlers, that have joined the request.
+   */
+  void complete(const key& k, const observe_seqno_response& response);
+
+  [[nodiscard]] auto number_of_pending_requests() const -> std::size_t;
+
+private:
+  mutable std::mutex mutex_{};
+  std::map<key, std::vector<handler_type>> pending_{};
+};
+} // namespace couchbase::core::impl
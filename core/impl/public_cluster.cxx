@@ -32,6 +32,7 @@
 #include "core/utils/movable_function.hxx"
 #include "diagnostics.hxx"
 #include "error.hxx"
+#include "internal_query_row_stream.hxx"
 #include "internal_search_result.hxx"
 #include "observability_recorder.hxx"
 #include "query.hxx"
@@ -63,6 +64,7 @@
 #include <asio/bind_executor.hpp>
 #include <asio/detail/concurrency_hint.hpp>
 #include <asio/execution_context.hpp>
+#include <asio/executor_work_guard.hpp>
 #include <asio/post.hpp>
 
 #include <functional>
@@ -71,7 +73,9 @@
 #include <string>
 #include <string_view>
 #include <system_error>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -150,7 +154,10 @@ options_to_origin(const std::string& connection_string, cluster_options::built o
   user_options.tcp_keep_alive_interval = opts.network.tcp_keep_alive_interval;
   user_options.config_poll_interval = opts.network.config_poll_interval;
   user_options.idle_http_connection_timeout = opts.network.idle_http_connection_timeout;
+  user_options.min_http_connections_per_node = opts.network.min_http_connections_per_node;
   user_options.enable_lazy_connections = opts.network.enable_lazy_connections;
+  user_options.write_coalescing_threshold = opts.network.write_coalescing_threshold;
+  user_options.write_coalescing_delay = opts.network.write_coalescing_delay;
   if (opts.network.max_http_connections) {
     user_options.max_http_connections = opts.network.max_http_connections.value();
   }
@@ -224,6 +231,48 @@ fork_event_to_asio(fork_event event) -> asio::execution_context::fork_event
   return asio::execution_context::fork_prepare;
 }
 
+/*
+ * The primary io_context is always created by the cluster_impl, so only N-1 extra contexts are
+ * needed to reach the requested number of I/O threads.
+ */
+auto
+make_session_io_contexts(std::size_t io_threads) -> std::vector<std::unique_ptr<asio::io_context>>
+{
+  std::vector<std::unique_ptr<asio::io_context>> contexts;
+  for (std::size_t i = 1; i < io_threads; ++i) {
+    contexts.emplace_back(std::make_unique<asio::io_context>(ASIO_CONCURRENCY_HINT_SAFE));
+  }
+  return contexts;
+}
+
+auto
+as_references(const std::vector<std::unique_ptr<asio::io_context>>& contexts)
+  -> std::vector<std::reference_wrapper<asio::io_context>>
+{
+  std::vector<std::reference_wrapper<asio::io_context>> references;
+  references.reserve(contexts.size());
+  for (const auto& ctx : contexts) {
+    references.emplace_back(*ctx);
+  }
+  return references;
+}
+
+auto
+spawn_session_io_threads(const std::vector<std::unique_ptr<asio::io_context>>& contexts)
+  -> std::vector<std::thread>
+{
+  std::vector<std::thread> threads;
+  threads.reserve(contexts.size());
+  for (const auto& ctx : contexts) {
+    // sessions are attached lazily, so the context must not run out of work before that
+    threads.emplace_back([&io = *ctx] {
+      auto guard = asio::make_work_guard(io);
+      io.run();
+    });
+  }
+  return threads;
+}
+
 } // namespace
 
 class cluster_impl : public std::enable_shared_from_this<cluster_impl>
@@ -339,6 +388,30 @@ public:
       });
   }
 
+  void query_stream(std::string statement,
+                    query_options::built options,
+                    query_stream_handler&& handler) const
+  {
+    auto obs_rec = create_observability_recorder(
+      core::tracing::operation::query, core::service_type::query, options.parent_span);
+    obs_rec->with_query_statement(statement, options);
+
+    auto request = core::impl::build_query_request(
+      std::move(statement), {}, std::move(options), obs_rec->operation_span());
+    auto stream = std::make_shared<internal_query_row_stream>();
+    stream->on_open(std::move(handler));
+    core::impl::attach_row_stream(request, stream);
+
+    return core_.execute(
+      std::move(request),
+      [obs_rec = std::move(obs_rec), stream = std::weak_ptr(stream)](auto resp) {
+        obs_rec->finish(resp.ctx.retry_attempts, resp.ctx.ec);
+        if (auto self = stream.lock(); self) {
+          self->on_complete(core::impl::make_error(resp.ctx), core::impl::build_meta_data(resp));
+        }
+      });
+  }
+
   void analytics_query(std::string statement,
                        analytics_options::built options,
                        analytics_handler&& handler) const
@@ -417,14 +490,22 @@ public:
     if (event == fork_event::prepare) {
       io_.stop();
       io_thread_.join();
+      stop_session_io_threads();
     } else {
       // TODO(SA): close all sockets in fork_event::child
       io_.restart();
       io_thread_ = std::thread{ [&io = io_] {
         io.run();
       } };
+      for (const auto& ctx : session_io_) {
+        ctx->restart();
+      }
+      session_io_threads_ = spawn_session_io_threads(session_io_);
     }
     io_.notify_fork(fork_event_to_asio(event));
+    for (const auto& ctx : session_io_) {
+      ctx->notify_fork(fork_event_to_asio(event));
+    }
 
     if (event != fork_event::child && transactions_) {
       transactions_->notify_fork(event);
@@ -467,6 +548,20 @@ private:
     if (io_thread_.joinable()) {
       io_thread_.join();
     }
+    stop_session_io_threads();
+  }
+
+  void stop_session_io_threads()
+  {
+    for (const auto& ctx : session_io_) {
+      ctx->stop();
+    }
+    for (auto& thread : session_io_threads_) {
+      if (thread.joinable()) {
+        thread.join();
+      }
+    }
+    session_io_threads_.clear();
   }
 
   [[nodiscard]] auto create_observability_recorder(
@@ -486,11 +581,14 @@ private:
   std::string connection_string_;
   cluster_options::built options_;
   asio::io_context io_{ ASIO_CONCURRENCY_HINT_SAFE };
-  core::cluster core_{ io_ };
+  std::vector<std::unique_ptr<asio::io_context>> session_io_{ make_session_io_contexts(
+    options_.network.io_threads) };
+  core::cluster core_{ io_, as_references(session_io_) };
   std::shared_ptr<couchbase::core::transactions::transactions> transactions_{ nullptr };
   std::thread io_thread_{ [&io = io_] {
     io.run();
   } };
+  std::vector<std::thread> session_io_threads_{ spawn_session_io_threads(session_io_) };
 };
 
 /*
@@ -526,6 +624,26 @@ cluster::query(std::string statement, const query_options& options) const
   return future;
 }
 
+void
+cluster::query_stream(std::string statement,
+                      const query_options& options,
+                      query_stream_handler&& handler) const
+{
+  return impl_->query_stream(std::move(statement), options.build(), std::move(handler));
+}
+
+auto
+cluster::query_stream(std::string statement, const query_options& options) const
+  -> std::future<std::pair<error, query_row_stream>>
+{
+  auto barrier = std::make_shared<std::promise<std::pair<error, query_row_stream>>>();
+  auto future = barrier->get_future();
+  query_stream(std::move(statement), options, [barrier](auto err, auto stream) {
+    barrier->set_value({ std::move(err), std::move(stream) });
+  });
+  return future;
+}
+
 void
 cluster::analytics_query(std::string statement,
                          const analytics_options& options,
@@ -0,0 +1,238 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include <couchbase/error_codes.hxx>
+#include <couchbase/query_row_stream.hxx>
+
+#include "core/utils/binary.hxx"
+
+#include "internal_query_row_stream.hxx"
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace couchbase
+{
+internal_query_row_stream::internal_query_row_stream(std::size_t high_watermark)
+  : high_watermark_{ std::max(high_watermark, std::size_t{ 1 }) }
+  , low_watermark_{ high_watermark_ / 2 }
+{
+}
+
+internal_query_row_stream::~internal_query_row_stream()
+{
+  // the consumer has lost interest, there is no point to keep the connection busy
+  flow_control_->cancel();
+}
+
+void
+internal_query_row_stream::on_open(query_stream_handler&& handler)
+{
+  const std::scoped_lock lock(mutex_);
+  open_handler_ = std::move(handler);
+  self_ = shared_from_this();
+}
+
+auto
+internal_query_row_stream::on_row(std::string&& row) -> core::utils::json::stream_control
+{
+  std::unique_lock lock(mutex_);
+  if (cancelled_) {
+    return core::utils::json::stream_control::stop;
+  }
+  rows_.emplace_back(core::utils::to_binary(row));
+  if (!paused_ && rows_.size() >= high_watermark_) {
+    paused_ = true;
+    flow_control_->pause();
+  }
+  open(lock, {});
+  deliver(lock);
+  return core::utils::json::stream_control::next_row;
+}
+
+void
+internal_query_row_stream::on_complete(error err, query_meta_data meta_data)
+{
+  std::unique_lock lock(mutex_);
+  complete_ = true;
+  error_ = std::move(err);
+  meta_data_.emplace(std::move(meta_data));
+  open(lock, error_);
+  deliver(lock);
+}
+
+auto
+internal_query_row_stream::flow_control() const
+  -> const std::shared_ptr<core::io::stream_flow_control>&
+{
+  return flow_control_;
+}
+
+void
+internal_query_row_stream::next_rows(std::size_t max_rows, query_rows_handler&& handler)
+{
+  std::unique_lock lock(mutex_);
+  if (cancelled_) {
+    lock.unlock();
+    return handler(error{ errc::common::request_canceled, "the stream has been cancelled" }, {});
+  }
+  if (pending_handler_) {
+    lock.unlock();
+    return handler(
+      error{ errc::common::invalid_argument, "another request for rows is already in progress" },
+      {});
+  }
+  pending_handler_ = std::move(handler);
+  pending_max_rows_ = std::max(max_rows, std::size_t{ 1 });
+  deliver(lock);
+}
+
+auto
+internal_query_row_stream::meta_data() const -> std::optional<query_meta_data>
+{
+  const std::scoped_lock lock(mutex_);
+  return meta_data_;
+}
+
+void
+internal_query_row_stream::cancel()
+{
+  std::unique_lock lock(mutex_);
+  if (cancelled_) {
+    return;
+  }
+  cancelled_ = true;
+  paused_ = false;
+  rows_.clear();
+  flow_control_->cancel();
+  // the rows will never arrive, so the waiting consumer has to be completed here
+  query_rows_handler handler{};
+  std::swap(handler, pending_handler_);
+  lock.unlock();
+  if (handler) {
+    handler(error{ errc::common::request_canceled, "the stream has been cancelled" }, {});
+  }
+}
+
+void
+internal_query_row_stream::open(std::unique_lock<std::mutex>& lock, const error& err)
+{
+  if (!open_handler_) {
+    return;
+  }
+  query_stream_handler handler{};
+  std::swap(handler, open_handler_);
+  auto self = std::move(self_);
+  lock.unlock();
+  handler(err, query_row_stream{ std::move(self) });
+  lock.lock();
+}
+
+void
+internal_query_row_stream::deliver(std::unique_lock<std::mutex>& lock)
+{
+  if (!pending_handler_ || (rows_.empty() && !complete_)) {
+    return lock.unlock();
+  }
+  std::vector<codec::binary> rows{};
+  const auto number_of_rows = std::min(pending_max_rows_, rows_.size());
+  rows.reserve(number_of_rows);
+  for (std::size_t i = 0; i < number_of_rows; ++i) {
+    rows.emplace_back(std::move(rows_.front()));
+    rows_.pop_front();
+  }
+  if (paused_ && rows_.size() <= low_watermark_) {
+    paused_ = false;
+    flow_control_->resume();
+  }
+  // the error is reported after all rows have been taken
+  auto err = rows.empty() ? error_ : error{};
+  query_rows_handler handler{};
+  std::swap(handler, pending_handler_);
+  lock.unlock();
+  handler(std::move(err), std::move(rows));
+}
+
+query_row_stream::query_row_stream(std::shared_ptr<internal_query_row_stream> internal)
+  : internal_{ std::move(internal) }
+{
+}
+
+void
+query_row_stream::next_row(query_row_handler&& handler) const
+{
+  return next_rows(
+    1, [handler = std::move(handler)](error err, std::vector<codec::binary> rows) {
+      if (rows.empty()) {
+        return handler(std::move(err), {});
+      }
+      handler(std::move(err), std::move(rows.front()));
+    });
+}
+
+auto
+query_row_stream::next_row() const -> std::future<std::pair<error, std::optional<codec::binary>>>
+{
+  auto barrier = std::make_shared<std::promise<std::pair<error, std::optional<codec::binary>>>>();
+  next_row([barrier](auto err, auto row) mutable {
+    barrier->set_value({ std::move(err), std::move(row) });
+  });
+  return barrier->get_future();
+}
+
+void
+query_row_stream::next_rows(std::size_t max_rows, query_rows_handler&& handler) const
+{
+  if (!internal_) {
+    // the stream has not been opened, e.g. because the query has failed
+    return handler(error{ errc::common::request_canceled, "the stream is not open" }, {});
+  }
+  return internal_->next_rows(max_rows, std::move(handler));
+}
+
+auto
+query_row_stream::next_rows(std::size_t max_rows) const
+  -> std::future<std::pair<error, std::vector<codec::binary>>>
+{
+  auto barrier = std::make_shared<std::promise<std::pair<error, std::vector<codec::binary>>>>();
+  next_rows(max_rows, [barrier](auto err, auto rows) mutable {
+    barrier->set_value({ std::move(err), std::move(rows) });
+  });
+  return barrier->get_future();
+}
+
+auto
+query_row_stream::meta_data() const -> std::optional<query_meta_data>
+{
+  if (!internal_) {
+    return {};
+  }
+  return internal_->meta_data();
+}
+
+void
+query_row_stream::cancel()
+{
+  if (internal_) {
+    return internal_->cancel();
+  }
+}
+} // namespace couchbase
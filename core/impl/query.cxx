@@ -25,6 +25,8 @@
 #include "core/operations/document_query.hxx"
 #include "core/utils/binary.hxx"
 
+#include "internal_query_row_stream.hxx"
+
 namespace couchbase::core::impl
 {
 namespace
@@ -147,23 +149,42 @@ build_context(operations::query_response& resp) -> query_error_context
 }
 } // namespace
 
+auto
+build_meta_data(operations::query_response& resp) -> query_meta_data
+{
+  return {
+    std::move(resp.meta.request_id),
+    std::move(resp.meta.client_context_id),
+    map_status(resp.meta.status),
+    map_warnings(resp),
+    map_metrics(resp),
+    map_signature(resp),
+    map_profile(resp),
+  };
+}
+
 auto
 build_result(operations::query_response& resp) -> query_result
 {
   return {
-    query_meta_data{
-      std::move(resp.meta.request_id),
-      std::move(resp.meta.client_context_id),
-      map_status(resp.meta.status),
-      map_warnings(resp),
-      map_metrics(resp),
-      map_signature(resp),
-      map_profile(resp),
-    },
+    build_meta_data(resp),
     map_rows(resp),
   };
 }
 
+void
+attach_row_stream(operations::query_request& request,
+                  const std::shared_ptr<internal_query_row_stream>& stream)
+{
+  request.flow_control = stream->flow_control();
+  request.row_callback = [stream = std::weak_ptr(stream)](std::string row) {
+    if (auto self = stream.lock(); self) {
+      return self->on_row(std::move(row));
+    }
+    return utils::json::stream_control::stop;
+  };
+}
+
 auto
 build_query_request(std::string statement,
                     std::optional<std::string> query_context,
@@ -21,6 +21,13 @@
 
 #include <couchbase/query_options.hxx>
 
+#include <memory>
+
+namespace couchbase
+{
+class internal_query_row_stream;
+} // namespace couchbase
+
 namespace couchbase::core::impl
 {
 auto
@@ -30,6 +37,17 @@ build_query_request(std::string statement,
                     std::shared_ptr<couchbase::tracing::request_span> op_span)
   -> core::operations::query_request;
 
+auto
+build_meta_data(operations::query_response& resp) -> query_meta_data;
+
 auto
 build_result(operations::query_response& resp) -> query_result;
+
+/**
+ * Delivers the rows of the request to the stream instead of collecting them in the response, and
+ * lets the stream pause reading of the response.
+ */
+void
+attach_row_stream(operations::query_request& request,
+                  const std::shared_ptr<internal_query_row_stream>& stream);
 } // namespace couchbase::core::impl
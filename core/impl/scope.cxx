@@ -22,6 +22,7 @@
 #include "error.hxx"
 #include "internal_search_error_context.hxx"
 #include "internal_search_meta_data.hxx"
+#include "internal_query_row_stream.hxx"
 #include "internal_search_result.hxx"
 #include "internal_search_row.hxx"
 #include "internal_search_row_location.hxx"
@@ -92,6 +93,30 @@ public:
       });
   }
 
+  void query_stream(std::string statement,
+                    query_options::built options,
+                    query_stream_handler&& handler) const
+  {
+    auto obs_rec = create_observability_recorder(
+      core::tracing::operation::query, core::service_type::query, options.parent_span);
+    obs_rec->with_query_statement(statement, options);
+
+    auto request = core::impl::build_query_request(
+      std::move(statement), query_context_, std::move(options), obs_rec->operation_span());
+    auto stream = std::make_shared<internal_query_row_stream>();
+    stream->on_open(std::move(handler));
+    core::impl::attach_row_stream(request, stream);
+
+    return core_.execute(
+      std::move(request),
+      [obs_rec = std::move(obs_rec), stream = std::weak_ptr(stream)](auto resp) {
+        obs_rec->finish(resp.ctx.retry_attempts, resp.ctx.ec);
+        if (auto self = stream.lock(); self) {
+          self->on_complete(core::impl::make_error(resp.ctx), core::impl::build_meta_data(resp));
+        }
+      });
+  }
+
   void analytics_query(std::string statement,
                        analytics_options::built options,
                        analytics_handler&& handler) const
@@ -205,6 +230,26 @@ scope::query(std::string statement, const query_options& options) const
   return future;
 }
 
+void
+scope::query_stream(std::string statement,
+                    const query_options& options,
+                    query_stream_handler&& handler) const
+{
+  return impl_->query_stream(std::move(statement), options.build(), std::move(handler));
+}
+
+auto
+scope::query_stream(std::string statement, const query_options& options) const
+  -> std::future<std::pair<error, query_row_stream>>
+{
+  auto barrier = std::make_shared<std::promise<std::pair<error, query_row_stream>>>();
+  auto future = barrier->get_future();
+  query_stream(std::move(statement), options, [barrier](auto err, auto stream) {
+    barrier->set_value({ std::move(err), std::move(stream) });
+  });
+  return future;
+}
+
 void
 scope::analytics_query(std::string statement,
                        const analytics_options& options,
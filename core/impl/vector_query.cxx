@@ -17,10 +17,46 @@
 
 #include "encoded_search_query.hxx"
 
+#include "core/platform/base64.h"
+#include "core/utils/byteswap.hxx"
+
 #include <couchbase/vector_query.hxx>
 
+#include <gsl/span>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+
 namespace couchbase
 {
+namespace
+{
+/**
+ * Encodes the vector as base64 of little-endian IEEE 754 floats, as expected in "vector_base64".
+ */
+auto
+encode_base64_vector(const std::vector<float>& vector) -> std::string
+{
+  static_assert(std::numeric_limits<float>::is_iec559 && sizeof(float) == sizeof(std::uint32_t));
+
+  std::string encoded;
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+  std::vector<std::uint32_t> little_endian(vector.size());
+  for (std::size_t i = 0; i < vector.size(); ++i) {
+    std::uint32_t bits{};
+    std::memcpy(&bits, &vector[i], sizeof(bits));
+    little_endian[i] = core::utils::byte_swap(bits);
+  }
+  core::base64::encode_to(gsl::as_bytes(gsl::span{ little_endian.data(), little_endian.size() }),
+                          encoded);
+#else
+  core::base64::encode_to(gsl::as_bytes(gsl::span{ vector.data(), vector.size() }), encoded);
+#endif
+  return encoded;
+}
+} // namespace
+
 auto
 vector_query::encode() const -> encoded_search_query
 {
@@ -45,6 +81,8 @@ vector_query::encode() const -> encoded_search_query
       vector_values.push_back(value);
     }
     built.query["vector"] = vector_values;
+  } else if (float_vector_query_.has_value()) {
+    built.query["vector_base64"] = encode_base64_vector(float_vector_query_.value());
   } else if (base64_vector_query_.has_value()) {
     built.query["vector_base64"] = base64_vector_query_.value();
   }
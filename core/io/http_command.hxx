@@ -28,9 +28,12 @@
 #include "core/utils/movable_function.hxx"
 #include "http_session.hxx"
 #include "http_traits.hxx"
+#include "timer_wheel.hxx"
 
 #include <couchbase/tracing/request_tracer.hxx>
 
+#include <asio/dispatch.hpp>
+
 #include <utility>
 
 namespace couchbase::core::operations
@@ -43,7 +46,13 @@ struct http_command : public std::enable_shared_from_this<http_command<Request>>
   using response_type = typename Request::response_type;
   using handler_type = utils::movable_function<void(response_type&&)>;
 
-  asio::steady_timer deadline;
+  /**
+   * The context that owns the state of the command: its timers fire here, and the completions
+   * of the sessions (that might run on other contexts of the pool) are dispatched here, so the
+   * deadline never races with a response.
+   */
+  asio::io_context& ctx_;
+  io::wheel_timer deadline;
   Request request;
   encoded_request_type encoded;
   std::shared_ptr<tracing::tracer_wrapper> tracer_;
@@ -59,7 +68,7 @@ struct http_command : public std::enable_shared_from_this<http_command<Request>>
   std::shared_ptr<couchbase::tracing::request_span> parent_span_{ nullptr };
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
   std::chrono::milliseconds dispatch_timeout_{};
-  asio::steady_timer dispatch_deadline_;
+  io::wheel_timer dispatch_deadline_;
 
   http_command(asio::io_context& ctx,
                Request req,
@@ -68,7 +77,8 @@ struct http_command : public std::enable_shared_from_this<http_command<Request>>
                std::shared_ptr<core::app_telemetry_meter> app_telemetry_meter,
                std::chrono::milliseconds default_timeout,
                std::chrono::milliseconds dispatch_timeout)
-    : deadline(ctx)
+    : ctx_(ctx)
+    , deadline(ctx)
     , request(req)
     , tracer_(std::move(tracer))
     , meter_(std::move(meter))
@@ -87,7 +97,8 @@ struct http_command : public std::enable_shared_from_this<http_command<Request>>
                std::shared_ptr<metrics::meter_wrapper> meter,
                std::shared_ptr<core::app_telemetry_meter> app_telemetry_meter,
                std::chrono::milliseconds default_timeout)
-    : deadline(ctx)
+    : ctx_(ctx)
+    , deadline(ctx)
     , request(req)
     , tracer_(std::move(tracer))
     , meter_(std::move(meter))
@@ -271,9 +282,10 @@ private:
 
     session_->write_and_subscribe(
       encoded,
-      [self = this->shared_from_this(),
-       dispatch_span = std::move(dispatch_span),
-       start = std::chrono::steady_clock::now()](std::error_code ec, io::http_response&& msg) {
+      on_command_context([self = this->shared_from_this(),
+                          dispatch_span = std::move(dispatch_span),
+                          start = std::chrono::steady_clock::now()](std::error_code ec,
+                                                                    io::http_response&& msg) {
         if (ec == asio::error::operation_aborted) {
           dispatch_span->end();
           return self->invoke_handler(errc::common::ambiguous_timeout, std::move(msg));
@@ -315,7 +327,29 @@ private:
         } catch (const priv::retry_http_request&) {
           self->send();
         }
-      });
+      }));
+  }
+
+  /**
+   * Wraps a session completion, so that it runs on the context of the command rather than on the
+   * context of the session. When both are the same, the completion runs inline.
+   */
+  template<typename Handler>
+  auto on_command_context(Handler&& handler)
+    -> utils::movable_function<void(std::error_code, io::http_response&&)>
+  {
+    return [self = this->shared_from_this(), handler = std::forward<Handler>(handler)](
+             std::error_code ec, io::http_response&& msg) mutable {
+      asio::dispatch(self->ctx_,
+                     [self, handler = std::move(handler), ec, msg = std::move(msg)]() mutable {
+                       if (!self->handler_) {
+                         // the command has been completed by the deadline while the response
+                         // was on its way to this context
+                         return;
+                       }
+                       handler(ec, std::move(msg));
+                     });
+    };
   }
 
   [[nodiscard]] auto create_dispatch_span() const
@@ -23,16 +23,83 @@
 
 #include <chrono>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 
 namespace couchbase::core::io
 {
 
+/**
+ * Lets the consumer of the streamed rows suspend reading of the socket.
+ *
+ * The session asks for capacity before reading the next chunk of the response. When the consumer
+ * has paused the stream, the session parks the continuation, and the consumer runs it on resume.
+ */
+class stream_flow_control
+{
+public:
+  /**
+   * @return true if reading might continue immediately, otherwise the continuation will be invoked
+   * once the stream is resumed or cancelled
+   */
+  auto wait_for_capacity(utils::movable_function<void()>&& continuation) -> bool
+  {
+    const std::scoped_lock lock(mutex_);
+    if (!paused_ || cancelled_) {
+      return true;
+    }
+    continuation_ = std::move(continuation);
+    return false;
+  }
+
+  void pause()
+  {
+    const std::scoped_lock lock(mutex_);
+    paused_ = true;
+  }
+
+  void resume()
+  {
+    utils::movable_function<void()> continuation{};
+    {
+      const std::scoped_lock lock(mutex_);
+      paused_ = false;
+      std::swap(continuation, continuation_);
+    }
+    if (continuation) {
+      continuation();
+    }
+  }
+
+  void cancel()
+  {
+    {
+      const std::scoped_lock lock(mutex_);
+      cancelled_ = true;
+    }
+    resume();
+  }
+
+  [[nodiscard]] auto is_cancelled() const -> bool
+  {
+    const std::scoped_lock lock(mutex_);
+    return cancelled_;
+  }
+
+private:
+  mutable std::mutex mutex_{};
+  bool paused_{ false };
+  bool cancelled_{ false };
+  utils::movable_function<void()> continuation_{};
+};
+
 struct streaming_settings {
   std::string pointer_expression;
   std::uint32_t depth;
   std::function<utils::json::stream_control(std::string&& row)> row_handler;
+  std::shared_ptr<stream_flow_control> flow_control{};
 };
 
 struct http_request {
@@ -313,6 +313,12 @@ http_session::on_stop(std::function<void()> handler)
   on_stop_handler_ = std::move(handler);
 }
 
+void
+http_session::on_idle_timeout(std::function<bool()> handler)
+{
+  on_idle_timeout_handler_ = std::move(handler);
+}
+
 void
 http_session::cancel_current_response(std::error_code ec)
 {
@@ -466,10 +472,22 @@ void
 http_session::set_idle(std::chrono::milliseconds timeout)
 {
   idle_timer_.expires_after(timeout);
-  return idle_timer_.async_wait([self = shared_from_this()](std::error_code ec) {
+  return idle_timer_.async_wait([self = shared_from_this(), timeout](std::error_code ec) {
     if (ec == asio::error::operation_aborted) {
       return;
     }
+    if (self->on_idle_timeout_handler_) {
+      // the timer is armed again before asking, so that a concurrent check-out still finds it
+      // pending, and the handler sees the session as busy then
+      self->set_idle(timeout);
+      if (!self->on_idle_timeout_handler_()) {
+        CB_LOG_TRACE("{} idle timeout expired, keeping session: \"{}:{}\"",
+                     self->info_.log_prefix(),
+                     self->hostname_,
+                     self->service_);
+        return;
+      }
+    }
     CB_LOG_DEBUG("{} idle timeout expired, stopping session: \"{}:{}\"",
                  self->info_.log_prefix(),
                  self->hostname_,
@@ -778,10 +796,40 @@ http_session::do_read()
         return;
       }
       self->reading_ = false;
-      return self->do_read();
+      return self->read_when_consumer_ready();
     });
 }
 
+void
+http_session::read_when_consumer_ready()
+{
+  std::shared_ptr<stream_flow_control> flow_control{};
+  {
+    const std::scoped_lock lock(current_response_mutex_);
+    flow_control = current_response_.flow_control;
+  }
+  if (!flow_control) {
+    return do_read();
+  }
+  if (flow_control->is_cancelled()) {
+    // the rest of the response is not needed, and the connection cannot be reused without reading
+    // it
+    return stop();
+  }
+  // the continuation must not own the session, as the flow control is referenced by the response
+  // context of the session
+  const bool ready = flow_control->wait_for_capacity([weak_self = weak_from_this()]() {
+    if (auto self = weak_self.lock(); self) {
+      asio::post(self->ctx_, [self]() {
+        self->read_when_consumer_ready();
+      });
+    }
+  });
+  if (ready) {
+    return do_read();
+  }
+}
+
 void
 http_session::do_write()
 {
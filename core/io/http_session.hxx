@@ -110,6 +110,11 @@ public:
 
   void connect(utils::movable_function<void()>&& callback);
   void on_stop(std::function<void()> handler);
+  /**
+   * The handler decides whether the session is stopped, when its idle timer expires. The timer is
+   * armed again before the handler is invoked, so when it returns false, the session simply stays.
+   */
+  void on_idle_timeout(std::function<bool()> handler);
   void stop();
 
   auto keep_alive() const -> bool;
@@ -124,6 +129,7 @@ public:
     {
       response_context ctx{ std::forward<Handler>(handler) };
       if (request.streaming) {
+        ctx.flow_control = request.streaming->flow_control;
         ctx.parser.response.body.use_json_streaming(std::move(request.streaming.value()));
       }
       std::scoped_lock lock(current_response_mutex_);
@@ -191,6 +197,7 @@ private:
   struct response_context {
     utils::movable_function<void(std::error_code, io::http_response&&)> handler{};
     http_parser parser{};
+    std::shared_ptr<stream_flow_control> flow_control{};
   };
 
   void on_resolve(std::error_code ec, const asio::ip::tcp::resolver::results_type& endpoints);
@@ -198,6 +205,7 @@ private:
   void on_connect(const std::error_code& ec, asio::ip::tcp::resolver::results_type::iterator it);
   void initiate_connect();
   void do_read();
+  void read_when_consumer_ready();
   void do_write();
   void write(const std::vector<std::uint8_t>& buf);
   void write(const std::string_view& buf);
@@ -229,6 +237,7 @@ private:
   utils::movable_function<void()> connect_callback_{};
   std::mutex connect_callback_mutex_{};
   std::function<void()> on_stop_handler_{ nullptr };
+  std::function<bool()> on_idle_timeout_handler_{ nullptr };
 
   response_context current_response_{};
   streaming_response_context current_streaming_response_{};
@@ -34,11 +34,17 @@
 #include "http_command.hxx"
 #include "http_context.hxx"
 #include "http_session.hxx"
+#include "http_session_pool.hxx"
 #include "http_traits.hxx"
+#include "io_context_pool.hxx"
 
+#include <asio/dispatch.hpp>
 #include <gsl/narrow>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <iterator>
 #include <optional>
 #include <queue>
 #include <random>
@@ -61,13 +67,25 @@ class http_session_manager
 public:
   http_session_manager(std::string client_id,
                        asio::io_context& ctx,
+                       io_context_pool& io_pool,
                        tls_context_provider& tls,
                        origin& origin)
     : client_id_(std::move(client_id))
     , ctx_(ctx)
+    , io_pool_(io_pool)
     , tls_(tls)
     , origin_(origin)
   {
+    for (auto type : {
+           service_type::query,
+           service_type::analytics,
+           service_type::search,
+           service_type::view,
+           service_type::management,
+           service_type::eventing,
+         }) {
+      pools_.try_emplace(type);
+    }
   }
 
   void set_tracer(std::shared_ptr<tracing::tracer_wrapper> tracer)
@@ -78,6 +96,7 @@ public:
   void set_meter(std::shared_ptr<metrics::meter_wrapper> meter)
   {
     meter_ = std::move(meter);
+    query_cache_.set_meter(meter_ ? meter_->wrapped() : nullptr);
   }
 
   void set_app_telemetry_meter(std::shared_ptr<core::app_telemetry_meter> app_telemetry_meter)
@@ -118,25 +137,34 @@ public:
 
   void update_config(topology::configuration config) override
   {
+    std::vector<std::shared_ptr<http_session>> removed{};
     {
-      std::scoped_lock config_lock(config_mutex_, sessions_mutex_, next_index_mutex_);
+      std::scoped_lock config_lock(config_mutex_, next_index_mutex_);
       config_ = std::move(config);
       if (!config_.nodes.empty() && next_index_ >= config_.nodes.size()) {
         next_index_ = 0;
       }
-      for (auto& [type, sessions] : idle_sessions_) {
-        sessions.remove_if([&opts = options_, &cfg = config_](const auto& session) {
-          return session && !cfg.has_node(opts.network,
-                                          session->type(),
-                                          opts.enable_tls,
-                                          session->hostname(),
-                                          session->port());
-        });
+      for (auto& [type, sessions] : pools_) {
+        auto not_in_config =
+          sessions.remove_idle_if([&opts = options_, &cfg = config_](const auto& session) {
+            return !cfg.has_node(opts.network,
+                                 session.type(),
+                                 opts.enable_tls,
+                                 session.hostname(),
+                                 session.port());
+          });
+        std::move(not_in_config.begin(), not_in_config.end(), std::back_inserter(removed));
       }
     }
+    for (const auto& session : removed) {
+      asio::post(session->get_executor(), [session]() {
+        session->stop();
+      });
+    }
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
     drain_deferred_queue({});
 #endif
+    warm_up();
   }
 
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
@@ -155,6 +183,7 @@ public:
       std::uniform_int_distribution<std::size_t> dis(0, config.nodes.size() - 1);
       next_index = dis(gen);
     }
+    query_cache_.set_limits(options.query_cache_max_entries, options.query_cache_max_bytes);
     {
       std::scoped_lock lock(config_mutex_, next_index_mutex_);
       options_ = options;
@@ -172,25 +201,17 @@ public:
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
     drain_deferred_queue({});
 #endif
+    warm_up();
   }
 
   void export_diag_info(diag::diagnostics_result& res)
   {
-    std::scoped_lock lock(sessions_mutex_);
-
-    for (const auto& [type, sessions] : busy_sessions_) {
-      for (const auto& session : sessions) {
-        if (session) {
-          res.services[type].emplace_back(session->diag_info());
-        }
-      }
-    }
-    for (const auto& [type, sessions] : idle_sessions_) {
-      for (const auto& session : sessions) {
-        if (session) {
-          res.services[type].emplace_back(session->diag_info());
+    for (const auto& [type, sessions] : pools_) {
+      sessions.for_each([&endpoints = res.services[type]](http_session& session) {
+        if (session.is_connected()) {
+          endpoints.emplace_back(session.diag_info());
         }
-      }
+      });
     }
   }
 
@@ -227,8 +248,7 @@ public:
                                           canonical_port,
                                         });
           if (session->is_connected()) {
-            std::scoped_lock lock(sessions_mutex_);
-            busy_sessions_[type].push_back(session);
+            pool(type).set_busy(session);
           }
           operations::http_noop_request request{};
           request.type = type;
@@ -333,65 +353,28 @@ public:
       }
     }
 
-    const std::scoped_lock lock(sessions_mutex_);
-    idle_sessions_[type].remove_if([](const auto& s) {
-      return !s;
-    });
-    busy_sessions_[type].remove_if([](const auto& s) {
-      return !s;
-    });
-    pending_sessions_[type].remove_if([](const auto& s) {
-      return !s;
-    });
+    auto& sessions = pool(type);
     std::shared_ptr<http_session> session{};
-    while (!idle_sessions_[type].empty()) {
-      if (preferred_node_address.empty()) {
-        session = idle_sessions_[type].front();
-        idle_sessions_[type].pop_front();
-        if (session->reset_idle()) {
-          break;
-        }
-      } else {
-        auto ptr = std::find_if(idle_sessions_[type].begin(),
-                                idle_sessions_[type].end(),
-                                [&preferred_node_address,
-                                 &h = preferred_node.hostname,
-                                 &p = preferred_node.port](const auto& s) {
-                                  // Check for a match using both the unresolved hostname & IP
-                                  // address
-                                  return (s->remote_address() == preferred_node_address ||
-                                          (s->hostname() == h && s->port() == std::to_string(p)));
-                                });
-        if (ptr != idle_sessions_[type].end()) {
-          session = *ptr;
-          idle_sessions_[type].erase(ptr);
-          if (session->reset_idle()) {
-            break;
-          }
-        } else {
-          session = create_session(type, preferred_node);
-          break;
-        }
+    if (preferred_node_address.empty()) {
+      session = sessions.check_out_idle();
+    } else {
+      session = sessions.check_out_idle(http_session_pool::node_address(
+        preferred_node.hostname, std::to_string(preferred_node.port)));
+      if (!session) {
+        session = create_session(type, preferred_node);
       }
-      CB_LOG_TRACE(
-        "{} Idle timer has expired for \"{}:{}\".  Attempting to select another session.",
-        session->log_prefix(),
-        session->hostname(),
-        session->port());
-      session.reset();
     }
     if (!session) {
-      auto node = preferred_node_address.empty() ? next_node(type)
-                                                 : lookup_node(type, preferred_node_address);
+      auto node = next_node(type);
       if (node.port == 0) {
         return { errc::common::service_not_available, nullptr };
       }
       session = create_session(type, node);
     }
     if (session->is_connected()) {
-      busy_sessions_[type].push_back(session);
+      sessions.set_busy(session);
     } else {
-      pending_sessions_[type].push_back(session);
+      sessions.set_pending(session);
     }
     return { {}, session };
   }
@@ -402,14 +385,7 @@ public:
       return;
     }
     if (!session->is_connected()) {
-      {
-        std::scoped_lock lock(sessions_mutex_);
-        if (auto pend_it = pending_sessions_.find(type); pend_it != pending_sessions_.end()) {
-          pend_it->second.remove_if([id = session->id()](const auto& s) {
-            return !s || s->id() == id;
-          });
-        }
-      }
+      pool(type).remove(session->id());
       CB_LOG_DEBUG("{} HTTP session never connected.  Ensured session is not in pending.",
                    session->log_prefix());
       return;
@@ -435,22 +411,11 @@ public:
     }
     if (!session->is_stopped()) {
       // set_idle() arms the idle timer via async_wait — it never calls stop() inline,
-      // so on_stop cannot re-enter sessions_mutex_ here. It must precede publication to
-      // idle_sessions_ so a concurrent check_out's reset_idle() finds a pending timer.
+      // so on_stop cannot re-enter the pool here. It must precede publication to
+      // the idle sessions so a concurrent check_out's reset_idle() finds a pending timer.
       session->set_idle(idle_timeout);
       CB_LOG_DEBUG("{} put HTTP session back to idle connections", session->log_prefix());
-      std::scoped_lock lock(sessions_mutex_);
-      idle_sessions_[type].push_back(session);
-      if (auto busy_it = busy_sessions_.find(type); busy_it != busy_sessions_.end()) {
-        busy_it->second.remove_if([id = session->id()](const auto& s) -> bool {
-          return !s || s->id() == id;
-        });
-      }
-      if (auto pend_it = pending_sessions_.find(type); pend_it != pending_sessions_.end()) {
-        pend_it->second.remove_if([id = session->id()](const auto& s) -> bool {
-          return !s || s->id() == id;
-        });
-      }
+      pool(type).set_idle(session);
     }
   }
 
@@ -459,34 +424,14 @@ public:
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
     drain_deferred_queue(errc::common::request_canceled);
 #endif
-    std::map<service_type, std::list<std::shared_ptr<http_session>>> busy_sessions, idle_sessions,
-      pending_sessions;
-    {
-      const std::scoped_lock lock(sessions_mutex_);
-      busy_sessions = std::move(busy_sessions_);
-      idle_sessions = std::move(idle_sessions_);
-      pending_sessions = std::move(pending_sessions_);
-    }
-    for (auto& [type, sessions] : idle_sessions) {
-      for (auto& s : sessions) {
-        if (s) {
-          s->reset_idle();
-          s.reset();
-        }
+    for (auto& [type, sessions] : pools_) {
+      auto [idle, active] = sessions.drain();
+      for (auto& s : idle) {
+        s->reset_idle();
+        s.reset();
       }
-    }
-    for (auto& [type, sessions] : busy_sessions) {
-      for (auto& s : sessions) {
-        if (s) {
-          s->stop();
-        }
-      }
-    }
-    for (auto& [type, sessions] : pending_sessions) {
-      for (auto& s : sessions) {
-        if (s) {
-          s->stop();
-        }
+      for (auto& s : active) {
+        s->stop();
       }
     }
   }
@@ -601,17 +546,11 @@ public:
         }
         auto new_session = self->create_session(session->type(), node);
         if (new_session->is_connected()) {
-          {
-            const std::scoped_lock inner_lock(self->sessions_mutex_);
-            self->busy_sessions_[new_session->type()].push_back(new_session);
-          }
+          self->pool(new_session->type()).set_busy(new_session);
           cb({}, new_session);
         } else {
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
-          {
-            const std::scoped_lock inner_lock(self->sessions_mutex_);
-            self->pending_sessions_[new_session->type()].push_back(new_session);
-          }
+          self->pool(new_session->type()).set_pending(new_session);
           self->connect_then_send_pending_op(
             new_session, preferred_node, dispatch_deadline, deadline, cb);
 #else
@@ -633,14 +572,7 @@ public:
           return;
         }
 #endif
-        {
-          const std::scoped_lock inner_lock(self->sessions_mutex_);
-          self->busy_sessions_[session->type()].push_back(session);
-          self->pending_sessions_[session->type()].remove_if(
-            [id = session->id()](const auto& s) -> bool {
-              return !s || s->id() == id;
-            });
-        }
+        self->pool(session->type()).set_busy(session);
         cb({}, session);
       }
     });
@@ -676,51 +608,57 @@ private:
                          const std::string& preferred_node,
                          bool reuse_session = false)
   {
-    session->connect([self = shared_from_this(),
-                      session,
-                      cmd,
-                      preferred_node = std::move(preferred_node),
-                      reuse_session]() mutable {
-      if (!session->is_connected()) {
+    // the session connects on its own context, but the command is only touched on its own
+    session->connect([self = shared_from_this(), session, cmd, preferred_node, reuse_session]() {
+      asio::dispatch(cmd->ctx_, [self, session, cmd, preferred_node, reuse_session]() {
+        self->send_after_connect(session, cmd, preferred_node, reuse_session);
+      });
+    });
+  }
+
+  template<typename Request>
+  void send_after_connect(const std::shared_ptr<http_session>& session,
+                          const std::shared_ptr<operations::http_command<Request>>& cmd,
+                          const std::string& preferred_node,
+                          bool reuse_session)
+  {
+    if (!session->is_connected()) {
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
-        auto now = std::chrono::steady_clock::now();
-        if (cmd->dispatch_deadline_expiry() < now || cmd->deadline_expiry() < now) {
-          // The http command will stop its session when the deadline expires.
-          return;
-        }
+      auto now = std::chrono::steady_clock::now();
+      if (cmd->dispatch_deadline_expiry() < now || cmd->deadline_expiry() < now) {
+        // The http command will stop its session when the deadline expires.
+        return;
+      }
 #else
-        if (cmd->deadline_expiry() < std::chrono::steady_clock::now()) {
-          // The http command will stop its session when the deadline expires.
-          return;
-        }
+      if (cmd->deadline_expiry() < std::chrono::steady_clock::now()) {
+        // The http command will stop its session when the deadline expires.
+        return;
+      }
 #endif
-        if (reuse_session) {
-          return self->connect_then_send(session, cmd, preferred_node, reuse_session);
-        }
-        // stop this session and create a new one w/ new hostname + port
-        session->stop();
-        const auto node = preferred_node.empty()
-                            ? self->next_node(session->type())
-                            : self->lookup_node(session->type(), preferred_node);
-        if (node.port == 0) {
-          cmd->invoke_handler(errc::common::service_not_available, {});
-          return;
-        }
-        auto new_session = self->create_session(session->type(), node);
-        cmd->set_command_session(new_session);
-        if (new_session->is_connected()) {
-          std::scoped_lock inner_lock(self->sessions_mutex_);
-          self->busy_sessions_[new_session->type()].push_back(new_session);
-          cmd->send_to();
-        } else {
-          self->connect_then_send(new_session, cmd, preferred_node);
-        }
-      } else {
-        std::scoped_lock inner_lock(self->sessions_mutex_);
-        self->busy_sessions_[session->type()].push_back(session);
+      if (reuse_session) {
+        return connect_then_send(session, cmd, preferred_node, reuse_session);
+      }
+      // stop this session and create a new one w/ new hostname + port
+      session->stop();
+      const auto node = preferred_node.empty()
+                          ? next_node(session->type())
+                          : lookup_node(session->type(), preferred_node);
+      if (node.port == 0) {
+        cmd->invoke_handler(errc::common::service_not_available, {});
+        return;
+      }
+      auto new_session = create_session(session->type(), node);
+      cmd->set_command_session(new_session);
+      if (new_session->is_connected()) {
+        pool(new_session->type()).set_busy(new_session);
         cmd->send_to();
+      } else {
+        connect_then_send(new_session, cmd, preferred_node);
       }
-    });
+    } else {
+      pool(session->type()).set_busy(session);
+      cmd->send_to();
+    }
   }
 
   auto create_session(service_type type, const node_details& node) -> std::shared_ptr<http_session>
@@ -730,7 +668,7 @@ private:
       session = std::make_shared<http_session>(type,
                                                client_id_,
                                                node.node_uuid,
-                                               ctx_,
+                                               io_pool_.next(),
                                                tls_,
                                                origin_,
                                                node.hostname,
@@ -748,7 +686,7 @@ private:
       session = std::make_shared<http_session>(type,
                                                client_id_,
                                                node.node_uuid,
-                                               ctx_,
+                                               io_pool_.next(),
                                                origin_,
                                                node.hostname,
                                                std::to_string(node.port),
@@ -764,32 +702,95 @@ private:
     }
 
     session->on_stop([type, id = session->id(), self = this->shared_from_this()]() {
-      // Declared outside the lock so destructors run after sessions_mutex_ is released.
-      // cppcheck-suppress variableScope
-      std::vector<std::shared_ptr<http_session>> dropped;
-      {
-        const std::scoped_lock inner_lock(self->sessions_mutex_);
-        for (auto* map :
-             { &self->busy_sessions_, &self->idle_sessions_, &self->pending_sessions_ }) {
-          auto map_it = map->find(type);
-          if (map_it == map->end()) {
-            continue;
-          }
-          auto& list = map_it->second;
-          for (auto it = list.begin(); it != list.end();) {
-            if (!*it || (*it)->id() == id) {
-              if (*it) {
-                dropped.push_back(std::move(*it));
-              }
-              it = list.erase(it);
-            } else {
-              ++it;
-            }
+      // The pool returns the session, so its destructor runs after the pool lock is released.
+      self->pool(type).remove(id);
+    });
+    session->on_idle_timeout([type, id = session->id(), self = this->shared_from_this()]() {
+      // the warm sessions of the node are exempt from the idle timeout
+      return self->pool(type).expire_idle(id, self->minimum_sessions(type));
+    });
+    return session;
+  }
+
+  /**
+   * @return the number of sessions, that are kept open for every node of the service
+   */
+  auto minimum_sessions(service_type type) -> std::size_t
+  {
+    if (std::find(warm_service_types.begin(), warm_service_types.end(), type) ==
+        warm_service_types.end()) {
+      return 0;
+    }
+    const std::scoped_lock lock(config_mutex_);
+    return options_.min_http_connections_per_node;
+  }
+
+  auto pool(service_type type) -> http_session_pool&
+  {
+    // the pools are created in the constructor, so the map itself is never modified
+    return pools_.at(type);
+  }
+
+  /**
+   * Opens connections in the background, so that every node has at least the configured number of
+   * sessions for the query, search and analytics services.
+   */
+  void warm_up()
+  {
+    std::size_t minimum{};
+    std::vector<std::pair<service_type, node_details>> nodes{};
+    {
+      const std::scoped_lock lock(config_mutex_);
+      minimum = options_.min_http_connections_per_node;
+      if (minimum == 0) {
+        return;
+      }
+      for (const auto& node : config_.nodes) {
+        for (auto type : warm_service_types) {
+          if (auto port = node.port_or(options_.network, type, options_.enable_tls, 0); port != 0) {
+            nodes.emplace_back(type,
+                               node_details{
+                                 node.hostname_for(options_.network),
+                                 port,
+                                 node.node_uuid,
+                                 node.hostname,
+                                 node.port_or(type, options_.enable_tls, 0),
+                               });
           }
         }
       }
-    });
-    return session;
+    }
+
+    // serialize warm-ups, so that concurrent configuration updates do not overshoot the minimum
+    const std::scoped_lock lock(warm_up_mutex_);
+    for (const auto& [type, node] : nodes) {
+      auto& sessions = pool(type);
+      const auto address =
+        http_session_pool::node_address(node.hostname, std::to_string(node.port));
+      for (auto n = sessions.number_of_sessions(address); n < minimum; ++n) {
+        auto session = create_session(type, node);
+        sessions.set_pending(session);
+        session->connect([self = shared_from_this(), session]() {
+          self->park_warm_session(session);
+        });
+      }
+    }
+  }
+
+  void park_warm_session(const std::shared_ptr<http_session>& session)
+  {
+    if (!session->is_connected() || session->is_stopped()) {
+      // stopping the session also removes it from the pool
+      return session->stop();
+    }
+    std::chrono::milliseconds idle_timeout{};
+    {
+      const std::scoped_lock lock(config_mutex_);
+      idle_timeout = options_.idle_http_connection_timeout;
+    }
+    CB_LOG_DEBUG("{} warm HTTP session is ready", session->log_prefix());
+    session->set_idle(idle_timeout);
+    pool(session->type()).set_idle(session);
   }
 
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
@@ -823,33 +824,36 @@ private:
                  cmd->request.type,
                  cmd->client_context_id_);
     add_to_deferred_queue([self = shared_from_this(), cmd, request](error_union err) mutable {
-      if (!std::holds_alternative<std::monostate>(err)) {
-        using response_type = typename Request::encoded_response_type;
-        return cmd->invoke_handler(err, response_type{});
-      }
+      // the queue is drained from the thread that reports the bootstrap, not from the command's
+      asio::dispatch(cmd->ctx_, [self, cmd, request = std::move(request), err]() mutable {
+        if (!std::holds_alternative<std::monostate>(err)) {
+          using response_type = typename Request::encoded_response_type;
+          return cmd->invoke_handler(err, response_type{});
+        }
 
-      // don't do anything if the command wasn't dispatched or has already timed out
-      auto now = std::chrono::steady_clock::now();
-      if (cmd->dispatch_deadline_expiry() < now || cmd->deadline_expiry() < now) {
-        return;
-      }
-      std::string preferred_node;
-      if constexpr (http_traits::supports_sticky_node_v<Request>) {
-        if (request.send_to_node) {
-          preferred_node = *request.send_to_node;
+        // don't do anything if the command wasn't dispatched or has already timed out
+        auto now = std::chrono::steady_clock::now();
+        if (cmd->dispatch_deadline_expiry() < now || cmd->deadline_expiry() < now) {
+          return;
         }
-      }
-      auto [error, session] = self->check_out(request.type, preferred_node);
-      if (error) {
-        using response_type = typename Request::encoded_response_type;
-        return cmd->invoke_handler(error, response_type{});
-      }
-      cmd->set_command_session(session);
-      if (!session->is_connected()) {
-        self->connect_then_send(session, cmd, preferred_node);
-      } else {
-        cmd->send_to();
-      }
+        std::string preferred_node;
+        if constexpr (http_traits::supports_sticky_node_v<Request>) {
+          if (request.send_to_node) {
+            preferred_node = *request.send_to_node;
+          }
+        }
+        auto [error, session] = self->check_out(request.type, preferred_node);
+        if (error) {
+          using response_type = typename Request::encoded_response_type;
+          return cmd->invoke_handler(error, response_type{});
+        }
+        cmd->set_command_session(session);
+        if (!session->is_connected()) {
+          self->connect_then_send(session, cmd, preferred_node);
+        } else {
+          cmd->send_to();
+        }
+      });
     });
   }
 
@@ -951,8 +955,15 @@ private:
     };
   }
 
+  static constexpr std::array warm_service_types{
+    service_type::query,
+    service_type::search,
+    service_type::analytics,
+  };
+
   std::string client_id_;
   asio::io_context& ctx_;
+  io_context_pool& io_pool_;
   tls_context_provider& tls_;
   origin& origin_;
   std::shared_ptr<tracing::tracer_wrapper> tracer_{ nullptr };
@@ -962,12 +973,10 @@ private:
 
   topology::configuration config_{};
   mutable std::mutex config_mutex_{};
-  std::map<service_type, std::list<std::shared_ptr<http_session>>> busy_sessions_{};
-  std::map<service_type, std::list<std::shared_ptr<http_session>>> idle_sessions_{};
-  std::map<service_type, std::list<std::shared_ptr<http_session>>> pending_sessions_{};
+  std::map<service_type, http_session_pool> pools_{};
   std::size_t next_index_{ 0 };
   std::mutex next_index_mutex_{};
-  std::mutex sessions_mutex_{};
+  std::mutex warm_up_mutex_{};
   query_cache query_cache_{};
 #ifdef COUCHBASE_CXX_CLIENT_COLUMNAR
   std::atomic_bool configured_{ false };
@@ -0,0 +1,241 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "http_session_pool.hxx"
+
+#include "core/logger/logger.hxx"
+#include "http_session.hxx"
+
+#include <iterator>
+#include <utility>
+
+namespace couchbase::core::io
+{
+auto
+http_session_pool::node_address(const std::string& hostname, const std::string& port)
+  -> std::string
+{
+  std::string address;
+  address.reserve(hostname.size() + 1 + port.size());
+  address.append(hostname).append(1, ':').append(port);
+  return address;
+}
+
+auto
+http_session_pool::check_out_idle(const std::string& node_address) -> std::shared_ptr<http_session>
+{
+  const std::scoped_lock lock(mutex_);
+  if (!node_address.empty()) {
+    auto node = nodes_.find(node_address);
+    if (node == nodes_.end()) {
+      return {};
+    }
+    return take_idle(node->second);
+  }
+  while (!ring_.empty()) {
+    auto* node = ring_.front();
+    // move the node to the end of the ring, so that the next check-out starts from another one
+    ring_.splice(ring_.end(), ring_, ring_.begin());
+    if (auto session = take_idle(*node); session) {
+      return session;
+    }
+  }
+  return {};
+}
+
+void
+http_session_pool::set_busy(const std::shared_ptr<http_session>& session)
+{
+  const std::scoped_lock lock(mutex_);
+  set_state(session, session_state::busy);
+}
+
+void
+http_session_pool::set_pending(const std::shared_ptr<http_session>& session)
+{
+  const std::scoped_lock lock(mutex_);
+  set_state(session, session_state::pending);
+}
+
+void
+http_session_pool::set_idle(const std::shared_ptr<http_session>& session)
+{
+  const std::scoped_lock lock(mutex_);
+  set_state(session, session_state::idle);
+}
+
+auto
+http_session_pool::remove(const std::string& session_id) -> std::shared_ptr<http_session>
+{
+  const std::scoped_lock lock(mutex_);
+  auto it = sessions_.find(session_id);
+  if (it == sessions_.end()) {
+    return {};
+  }
+  auto session = std::move(it->second.session);
+  erase(it);
+  return session;
+}
+
+auto
+http_session_pool::remove_idle_if(const std::function<bool(const http_session&)>& predicate)
+  -> std::vector<std::shared_ptr<http_session>>
+{
+  std::vector<std::shared_ptr<http_session>> removed{};
+  const std::scoped_lock lock(mutex_);
+  for (auto it = sessions_.begin(); it != sessions_.end();) {
+    auto current = it++;
+    if (current->second.state == session_state::idle && predicate(*current->second.session)) {
+      removed.emplace_back(std::move(current->second.session));
+      erase(current);
+    }
+  }
+  return removed;
+}
+
+auto
+http_session_pool::expire_idle(const std::string& session_id, std::size_t minimum) -> bool
+{
+  std::shared_ptr<http_session> removed{};
+  {
+    const std::scoped_lock lock(mutex_);
+    auto it = sessions_.find(session_id);
+    if (it == sessions_.end()) {
+      return true;
+    }
+    if (it->second.state != session_state::idle ||
+        it->second.node->number_of_sessions <= minimum) {
+      return false;
+    }
+    removed = std::move(it->second.session);
+    erase(it);
+  }
+  return true;
+}
+
+auto
+http_session_pool::number_of_sessions(const std::string& node_address) const -> std::size_t
+{
+  const std::scoped_lock lock(mutex_);
+  if (auto node = nodes_.find(node_address); node != nodes_.end()) {
+    return node->second.number_of_sessions;
+  }
+  return 0;
+}
+
+void
+http_session_pool::for_each(const std::function<void(http_session&)>& handler) const
+{
+  const std::scoped_lock lock(mutex_);
+  for (const auto& [id, entry] : sessions_) {
+    handler(*entry.session);
+  }
+}
+
+auto
+http_session_pool::drain() -> drained_sessions
+{
+  drained_sessions drained{};
+  const std::scoped_lock lock(mutex_);
+  for (auto& [id, entry] : sessions_) {
+    if (entry.state == session_state::idle) {
+      drained.idle.emplace_back(std::move(entry.session));
+    } else {
+      drained.active.emplace_back(std::move(entry.session));
+    }
+  }
+  ring_.clear();
+  nodes_.clear();
+  sessions_.clear();
+  return drained;
+}
+
+void
+http_session_pool::set_state(const std::shared_ptr<http_session>& session, session_state state)
+{
+  auto [it, inserted] = sessions_.try_emplace(session->id(), session_entry{ session, nullptr });
+  auto& entry = it->second;
+  if (inserted) {
+    auto address = node_address(session->hostname(), session->port());
+    auto node = nodes_.try_emplace(address, node_sessions{ address }).first;
+    entry.node = &node->second;
+    ++entry.node->number_of_sessions;
+  } else if (entry.state == session_state::idle) {
+    leave_idle(entry);
+  }
+  entry.state = state;
+  if (state != session_state::idle) {
+    return;
+  }
+  auto& node = *entry.node;
+  entry.idle_position = node.idle.insert(node.idle.end(), session);
+  if (!node.in_ring) {
+    node.ring_position = ring_.insert(ring_.end(), &node);
+    node.in_ring = true;
+  }
+}
+
+auto
+http_session_pool::take_idle(node_sessions& node) -> std::shared_ptr<http_session>
+{
+  while (!node.idle.empty()) {
+    auto it = sessions_.find(node.idle.back()->id());
+    auto& entry = it->second;
+    if (entry.session->reset_idle()) {
+      leave_idle(entry);
+      entry.state = session_state::busy;
+      return entry.session;
+    }
+    CB_LOG_TRACE(
+      "{} Idle timer has expired for \"{}:{}\".  Attempting to select another session.",
+      entry.session->log_prefix(),
+      entry.session->hostname(),
+      entry.session->port());
+    const bool last_session_of_node = node.number_of_sessions == 1;
+    erase(it);
+    if (last_session_of_node) {
+      // the node has been removed together with its last session
+      break;
+    }
+  }
+  return {};
+}
+
+void
+http_session_pool::leave_idle(session_entry& entry)
+{
+  auto& node = *entry.node;
+  node.idle.erase(entry.idle_position);
+  if (node.idle.empty() && node.in_ring) {
+    ring_.erase(node.ring_position);
+    node.in_ring = false;
+  }
+}
+
+void
+http_session_pool::erase(std::unordered_map<std::string, session_entry>::iterator it)
+{
+  auto& entry = it->second;
+  if (entry.state == session_state::idle) {
+    leave_idle(entry);
+  }
+  if (auto& node = *entry.node; --node.number_of_sessions == 0) {
+    nodes_.erase(nodes_.find(node.address));
+  }
+  sessions_.erase(it);
+}
+} // namespace couchbase::core::io
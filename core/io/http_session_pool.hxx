@@ -0,0 +1,136 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace couchbase::core::io
+{
+class http_session;
+
+/**
+ * Sessions of a single service, grouped by node ("hostname:port").
+ *
+ * Every operation is constant time: the sessions are indexed by their identifiers, and each node
+ * keeps its own list of idle sessions. The nodes that have idle sessions form a ring, so that
+ * check-outs without preferred node are spread over the nodes.
+ */
+class http_session_pool
+{
+public:
+  http_session_pool() = default;
+  http_session_pool(const http_session_pool&) = delete;
+  http_session_pool(http_session_pool&&) = delete;
+  auto operator=(const http_session_pool&) -> http_session_pool& = delete;
+  auto operator=(http_session_pool&&) -> http_session_pool& = delete;
+  ~http_session_pool() = default;
+
+  [[nodiscard]] static auto node_address(const std::string& hostname, const std::string& port)
+    -> std::string;
+
+  /**
+   * Takes the most recently used idle session, either of the given node, or of the next node in
+   * the ring when the address is empty. The session is marked as busy.
+   *
+   * The session is removed from the pool when its idle timer has already fired, and the next one
+   * is tried.
+   *
+   * @return nullptr if there is no usable idle session
+   */
+  auto check_out_idle(const std::string& node_address = {}) -> std::shared_ptr<http_session>;
+
+  void set_busy(const std::shared_ptr<http_session>& session);
+  void set_pending(const std::shared_ptr<http_session>& session);
+  void set_idle(const std::shared_ptr<http_session>& session);
+
+  /**
+   * @return the removed session, so that the caller could destroy it after the lock is released
+   */
+  auto remove(const std::string& session_id) -> std::shared_ptr<http_session>;
+
+  /**
+   * Removes the idle sessions, that satisfy the predicate.
+   */
+  auto remove_idle_if(const std::function<bool(const http_session&)>& predicate)
+    -> std::vector<std::shared_ptr<http_session>>;
+
+  /**
+   * Decides, whether the session, which idle timer has expired, should be stopped. An idle session
+   * is removed, unless its node would be left with fewer than the minimum number of sessions. The
+   * sessions that are in use are kept, and the ones that have already left the pool are stopped.
+   *
+   * @return true if the session should be stopped
+   */
+  auto expire_idle(const std::string& session_id, std::size_t minimum) -> bool;
+
+  /**
+   * @return number of idle, busy and pending sessions of the node
+   */
+  [[nodiscard]] auto number_of_sessions(const std::string& node_address) const -> std::size_t;
+
+  void for_each(const std::function<void(http_session&)>& handler) const;
+
+  struct drained_sessions {
+    std::vector<std::shared_ptr<http_session>> idle{};
+    std::vector<std::shared_ptr<http_session>> active{};
+  };
+
+  auto drain() -> drained_sessions;
+
+private:
+  enum class session_state {
+    idle,
+    busy,
+    pending,
+  };
+
+  struct node_sessions;
+
+  struct session_entry {
+    std::shared_ptr<http_session> session;
+    node_sessions* node;
+    session_state state{ session_state::pending };
+    std::list<std::shared_ptr<http_session>>::iterator idle_position{};
+  };
+
+  struct node_sessions {
+    std::string address;
+    std::list<std::shared_ptr<http_session>> idle{};
+    std::size_t number_of_sessions{ 0 };
+    bool in_ring{ false };
+    std::list<node_sessions*>::iterator ring_position{};
+  };
+
+  void set_state(const std::shared_ptr<http_session>& session, session_state state);
+  auto take_idle(node_sessions& node) -> std::shared_ptr<http_session>;
+  void leave_idle(session_entry& entry);
+  void erase(std::unordered_map<std::string, session_entry>::iterator it);
+
+  mutable std::mutex mutex_{};
+  std::unordered_map<std::string, session_entry> sessions_{};
+  std::unordered_map<std::string, node_sessions> nodes_{};
+  std::list<node_sessions*> ring_{};
+};
+} // namespace couchbase::core::io
@@ -0,0 +1,84 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <asio/io_context.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace couchbase::core::io
+{
+/**
+ * Non-owning set of I/O contexts that network sessions are spread across.
+ *
+ * The first context is the primary one: it drives bootstrap, configuration polling and the
+ * cluster-wide timers. KV and HTTP sessions are assigned to all contexts in round-robin order, so
+ * that every context (and the thread running it) carries its share of the socket traffic. The
+ * owner of the pool is responsible for keeping the contexts alive and running.
+ */
+class io_context_pool
+{
+public:
+  explicit io_context_pool(asio::io_context& primary,
+                           std::vector<std::reference_wrapper<asio::io_context>> secondary = {})
+  {
+    contexts_.reserve(secondary.size() + 1);
+    contexts_.emplace_back(primary);
+    contexts_.insert(contexts_.end(), secondary.begin(), secondary.end());
+  }
+
+  io_context_pool(const io_context_pool&) = delete;
+  io_context_pool(io_context_pool&&) = delete;
+  auto operator=(const io_context_pool&) -> io_context_pool& = delete;
+  auto operator=(io_context_pool&&) -> io_context_pool& = delete;
+  ~io_context_pool() = default;
+
+  [[nodiscard]] auto primary() const -> asio::io_context&
+  {
+    return contexts_.front();
+  }
+
+  [[nodiscard]] auto size() const -> std::size_t
+  {
+    return contexts_.size();
+  }
+
+  [[nodiscard]] auto at(std::size_t index) const -> asio::io_context&
+  {
+    return contexts_[index % contexts_.size()];
+  }
+
+  /**
+   * @return the context that should host the next network session
+   */
+  auto next() -> asio::io_context&
+  {
+    if (contexts_.size() == 1) {
+      return contexts_.front();
+    }
+    return at(next_index_.fetch_add(1, std::memory_order_relaxed));
+  }
+
+private:
+  std::vector<std::reference_wrapper<asio::io_context>> contexts_{};
+  std::atomic_size_t next_index_{ 0 };
+};
+} // namespace couchbase::core::io
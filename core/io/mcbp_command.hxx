@@ -33,11 +33,13 @@
 #include "mcbp_session.hxx"
 #include "mcbp_traits.hxx"
 #include "retry_orchestrator.hxx"
+#include "timer_wheel.hxx"
 
 #include <couchbase/durability_level.hxx>
 #include <couchbase/error_codes.hxx>
 
-#include <asio/steady_timer.hpp>
+#include <asio/dispatch.hpp>
+#include <asio/post.hpp>
 #include <spdlog/fmt/bundled/chrono.h>
 
 #include <functional>
@@ -55,8 +57,13 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
 
   using encoded_request_type = typename Request::encoded_request_type;
   using encoded_response_type = typename Request::encoded_response_type;
-  asio::steady_timer deadline;
-  asio::steady_timer retry_backoff;
+  /**
+   * The context that owns the state of the command: its timers fire here, and the completions
+   * of the sessions are dispatched here, so the deadline never races with a response.
+   */
+  asio::io_context& ctx_;
+  io::wheel_timer deadline;
+  io::wheel_timer retry_backoff;
   Request request;
   encoded_request_type encoded;
   std::optional<std::uint32_t> opaque_{};
@@ -80,7 +87,8 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
                std::shared_ptr<Manager> manager,
                Request req,
                std::chrono::milliseconds default_timeout)
-    : deadline(ctx)
+    : ctx_(ctx)
+    , deadline(ctx)
     , retry_backoff(ctx)
     , request(req)
     , manager_(manager)
@@ -125,7 +133,9 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
     if constexpr (is_cancellable_operation_v<Request>) {
       request.cancel_token->setup([weak_self = this->weak_from_this()] {
         if (auto self = weak_self.lock()) {
-          self->cancel(retry_reason::do_not_retry, false);
+          asio::post(self->ctx_, [self]() {
+            self->cancel(retry_reason::do_not_retry, false);
+          });
         }
       });
     }
@@ -194,11 +204,11 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
     session_->write_and_subscribe(
       req.opaque(),
       req.data(session_->supports_feature(protocol::hello_feature::snappy)),
-      [self = this->shared_from_this()](
-        std::error_code ec,
-        retry_reason /* reason */,
-        io::mcbp_message&& msg,
-        std::optional<key_value_error_map_info> /* error_info */) mutable {
+      on_command_context([self = this->shared_from_this()](
+                           std::error_code ec,
+                           retry_reason /* reason */,
+                           io::mcbp_message&& msg,
+                           std::optional<key_value_error_map_info> /* error_info */) mutable {
         if (ec == asio::error::operation_aborted) {
           return self->invoke_handler(errc::common::ambiguous_timeout);
         }
@@ -216,7 +226,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
                                               resp.body().collection_uid());
         self->request.id.collection_uid(resp.body().collection_uid());
         return self->send();
-      });
+      }));
   }
 
   void handle_unknown_collection()
@@ -283,13 +293,13 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
     session_->write_and_subscribe(
       request.opaque,
       encoded.data(session_->supports_feature(protocol::hello_feature::snappy)),
-      [self = this->shared_from_this(),
-       start = std::chrono::steady_clock::now(),
-       dispatch_span = std::move(dispatch_span)](
-        std::error_code ec,
-        retry_reason reason,
-        io::mcbp_message&& msg,
-        std::optional<key_value_error_map_info> /* error_info */) mutable {
+      on_command_context([self = this->shared_from_this(),
+                          start = std::chrono::steady_clock::now(),
+                          dispatch_span = std::move(dispatch_span)](
+                           std::error_code ec,
+                           retry_reason reason,
+                           io::mcbp_message&& msg,
+                           std::optional<key_value_error_map_info> /* error_info */) mutable {
         {
           const auto server_duration_us =
             static_cast<std::uint64_t>(protocol::parse_server_duration_us(msg));
@@ -411,7 +421,7 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
         } else {
           io::retry_orchestrator::maybe_retry(self->manager_, self, reason, ec);
         }
-      });
+      }));
   }
 
   void send_to(io::mcbp_session session)
@@ -431,6 +441,36 @@ struct mcbp_command : public std::enable_shared_from_this<mcbp_command<Manager,
   }
 
 private:
+  /**
+   * Wraps a session completion, so that it runs on the context of the command rather than on the
+   * context of the session. When both are the same (or when the session completes the command
+   * from cancel()), the completion runs inline.
+   */
+  template<typename Handler>
+  auto on_command_context(Handler&& handler) -> io::command_handler
+  {
+    return [self = this->shared_from_this(), handler = std::forward<Handler>(handler)](
+             std::error_code ec,
+             retry_reason reason,
+             io::mcbp_message&& msg,
+             std::optional<key_value_error_map_info> error_info) mutable {
+      asio::dispatch(self->ctx_,
+                     [self,
+                      handler = std::move(handler),
+                      ec,
+                      reason,
+                      msg = std::move(msg),
+                      error_info = std::move(error_info)]() mutable {
+                       if (!self->handler_) {
+                         // the command has been completed by the deadline or cancellation
+                         // while the response was on its way to this context
+                         return;
+                       }
+                       handler(ec, reason, std::move(msg), std::move(error_info));
+                     });
+    };
+  }
+
   [[nodiscard]] auto create_orphan_attributes() -> orphan_attributes
   {
     orphan_attributes attrs;
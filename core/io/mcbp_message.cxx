@@ -17,8 +17,12 @@
 
 #include "mcbp_message.hxx"
 
+#include "core/protocol/datatype.hxx"
+#include "core/protocol/magic.hxx"
 #include "core/utils/byteswap.hxx"
 
+#include <snappy.h>
+
 #include <cstring>
 
 namespace couchbase::core::io
@@ -29,6 +33,18 @@ binary_header::status() const -> std::uint16_t
   return utils::byte_swap(specific);
 }
 
+auto
+binary_header::prefix_size() const -> std::uint32_t
+{
+  if (magic == static_cast<std::uint8_t>(protocol::magic::alt_client_response)) {
+    const std::uint8_t framing_extras_size = keylen & 0xffU;
+    const auto key_size = static_cast<std::uint32_t>(keylen >> 8U);
+    return static_cast<std::uint32_t>(framing_extras_size) + static_cast<std::uint32_t>(extlen) +
+           key_size;
+  }
+  return static_cast<std::uint32_t>(extlen) + utils::byte_swap(keylen);
+}
+
 auto
 mcbp_message::header_data() const -> protocol::header_buffer
 {
@@ -36,4 +52,34 @@ mcbp_message::header_data() const -> protocol::header_buffer
   std::memcpy(buf.data(), &header, sizeof(header));
   return buf;
 }
+
+auto
+mcbp_message::is_compressed() const -> bool
+{
+  return (header.datatype & static_cast<std::uint8_t>(protocol::datatype::snappy)) != 0;
+}
+
+auto
+decompress_snappy_value(const std::byte* prefix,
+                        std::size_t prefix_size,
+                        const std::byte* compressed_value,
+                        std::size_t compressed_size,
+                        std::vector<std::byte>& output) -> std::optional<std::size_t>
+{
+  const auto* compressed = reinterpret_cast<const char*>(compressed_value);
+  std::size_t value_size{ 0 };
+  if (!snappy::GetUncompressedLength(compressed, compressed_size, &value_size)) {
+    return {};
+  }
+  output.resize(prefix_size + value_size);
+  if (prefix_size > 0) {
+    std::memcpy(output.data(), prefix, prefix_size);
+  }
+  if (!snappy::RawUncompress(
+        compressed, compressed_size, reinterpret_cast<char*>(output.data() + prefix_size))) {
+    output.clear();
+    return {};
+  }
+  return value_size;
+}
 } // namespace couchbase::core::io
@@ -18,7 +18,9 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <optional>
 #include <vector>
 
 namespace couchbase::core
@@ -43,6 +45,11 @@ struct binary_header {
   std::uint64_t cas;
 
   [[nodiscard]] auto status() const -> std::uint16_t;
+
+  /**
+   * @return size of framing extras, extras and key, that precede the value in the body
+   */
+  [[nodiscard]] auto prefix_size() const -> std::uint32_t;
 };
 
 struct mcbp_message {
@@ -56,6 +63,28 @@ struct mcbp_message {
   auto operator=(mcbp_message&& other) -> mcbp_message& = default;
 
   [[nodiscard]] auto header_data() const -> protocol::header_buffer;
+
+  /**
+   * @return true if the value is snappy-compressed, which only happens for the frames, that the
+   * parser could not decompress.
+   */
+  [[nodiscard]] auto is_compressed() const -> bool;
 };
+
+/**
+ * Inflates snappy-compressed value of the frame into output buffer.
+ *
+ * The buffer is sized once using the length recorded in the compressed stream, the prefix
+ * (framing extras, extras and key) is copied verbatim, and the value is decompressed directly
+ * after it, so that no intermediate buffer is necessary.
+ *
+ * @return size of the decompressed value, or empty optional if the value cannot be decompressed
+ */
+auto
+decompress_snappy_value(const std::byte* prefix,
+                        std::size_t prefix_size,
+                        const std::byte* compressed_value,
+                        std::size_t compressed_size,
+                        std::vector<std::byte>& output) -> std::optional<std::size_t>;
 } // namespace io
 } // namespace couchbase::core
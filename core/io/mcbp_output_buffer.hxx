@@ -0,0 +1,125 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::io
+{
+/**
+ * Outgoing data of the KV session.
+ *
+ * Encoded requests are packed back to back into pooled chunks, so that a burst of small requests
+ * is written to the socket as a handful of buffers, and the chunks are reused once the write
+ * completes. Requests that are large on their own (e.g. mutations of big documents) keep their
+ * buffers to avoid copying.
+ *
+ * The class is not thread-safe, the session guards it with a mutex.
+ */
+class mcbp_output_buffer
+{
+public:
+  static constexpr std::size_t chunk_size{ 16 * 1024 };
+  static constexpr std::size_t max_spare_chunks{ 8 };
+
+  void append(std::vector<std::byte>&& data)
+  {
+    if (data.empty()) {
+      return;
+    }
+    pending_bytes_ += data.size();
+    if (!pending_.empty()) {
+      if (auto& last = pending_.back(); last.capacity() - last.size() >= data.size()) {
+        last.insert(last.end(), data.begin(), data.end());
+        return;
+      }
+    }
+    if (data.size() >= chunk_size / 2) {
+      pending_.emplace_back(std::move(data));
+      return;
+    }
+    auto chunk = acquire_chunk();
+    chunk.insert(chunk.end(), data.begin(), data.end());
+    pending_.emplace_back(std::move(chunk));
+  }
+
+  [[nodiscard]] auto pending_bytes() const -> std::size_t
+  {
+    return pending_bytes_;
+  }
+
+  /**
+   * Moves pending data to the in-flight list. The in-flight buffers must not be touched until
+   * complete_write() is called.
+   *
+   * @return false if the previous write is still in progress or there is nothing to write
+   */
+  auto start_write() -> bool
+  {
+    if (!in_flight_.empty() || pending_.empty()) {
+      return false;
+    }
+    std::swap(in_flight_, pending_);
+    pending_bytes_ = 0;
+    return true;
+  }
+
+  [[nodiscard]] auto in_flight() const -> const std::vector<std::vector<std::byte>>&
+  {
+    return in_flight_;
+  }
+
+  void complete_write()
+  {
+    for (auto& buffer : in_flight_) {
+      if (spare_.size() < max_spare_chunks && buffer.capacity() >= chunk_size &&
+          buffer.capacity() < 2 * chunk_size) {
+        buffer.clear();
+        spare_.emplace_back(std::move(buffer));
+      }
+    }
+    in_flight_.clear();
+  }
+
+  void clear_pending()
+  {
+    pending_.clear();
+    pending_bytes_ = 0;
+  }
+
+private:
+  auto acquire_chunk() -> std::vector<std::byte>
+  {
+    if (spare_.empty()) {
+      std::vector<std::byte> chunk;
+      chunk.reserve(chunk_size);
+      return chunk;
+    }
+    auto chunk = std::move(spare_.back());
+    spare_.pop_back();
+    return chunk;
+  }
+
+  std::vector<std::vector<std::byte>> pending_{};
+  std::vector<std::vector<std::byte>> in_flight_{};
+  std::vector<std::vector<std::byte>> spare_{};
+  std::size_t pending_bytes_{ 0 };
+};
+} // namespace couchbase::core::io
@@ -22,7 +22,6 @@
 #include "core/protocol/magic.hxx"
 #include "core/utils/byteswap.hxx"
 
-#include <snappy.h>
 #include <spdlog/fmt/bin_to_hex.h>
 
 #include <algorithm>
@@ -34,16 +33,15 @@ auto
 mcbp_parser::next(mcbp_message& msg) -> mcbp_parser::result
 {
   static const std::size_t header_size = 24;
-  if (buf.size() < header_size) {
+  if (pending() < header_size) {
     return result::need_data;
   }
-  std::memcpy(&msg.header, buf.data(), header_size);
+  const std::byte* frame = buf.data() + offset;
+  std::memcpy(&msg.header, frame, header_size);
   std::uint32_t body_size = utils::byte_swap(msg.header.bodylen);
-  if (body_size > 0 && buf.size() - header_size < body_size) {
+  if (body_size > 0 && pending() - header_size < body_size) {
     return result::need_data;
   }
-  msg.body.clear();
-  msg.body.reserve(body_size);
   std::uint32_t key_size = utils::byte_swap(msg.header.keylen);
   std::uint32_t prefix_size = static_cast<std::uint32_t>(msg.header.extlen) + key_size;
   if (msg.header.magic == static_cast<std::uint8_t>(protocol::magic::alt_client_response)) {
@@ -69,34 +67,29 @@ mcbp_parser::next(mcbp_message& msg) -> mcbp_parser::result
     reset();
     return result::failure;
   }
-  msg.body.insert(
-    msg.body.end(), buf.begin() + header_size, buf.begin() + header_size + prefix_size);
+  const std::byte* body = frame + header_size;
 
-  const bool is_compressed =
-    (msg.header.datatype & static_cast<std::uint8_t>(protocol::datatype::snappy)) != 0;
   bool use_raw_value = true;
-  if (is_compressed) {
-    std::string uncompressed;
-    const std::size_t offset = header_size + prefix_size;
-    if (snappy::Uncompress(reinterpret_cast<const char*>(buf.data() + offset),
-                           body_size - prefix_size,
-                           &uncompressed)) {
-      msg.body.insert(msg.body.end(),
-                      reinterpret_cast<std::byte*>(uncompressed.data()),
-                      reinterpret_cast<std::byte*>(uncompressed.data() + uncompressed.size()));
+  if (msg.is_compressed()) {
+    if (auto value_size = decompress_snappy_value(
+          body, prefix_size, body + prefix_size, body_size - prefix_size, msg.body);
+        value_size) {
       use_raw_value = false;
-      // patch header with new body size
+      // patch header with new body size, the value is not compressed anymore
+      msg.header.datatype &=
+        static_cast<std::uint8_t>(~static_cast<std::uint8_t>(protocol::datatype::snappy));
       msg.header.bodylen =
-        utils::byte_swap(static_cast<std::uint32_t>(prefix_size + uncompressed.size()));
+        utils::byte_swap(static_cast<std::uint32_t>(prefix_size + value_size.value()));
     }
   }
   if (use_raw_value) {
-    msg.body.insert(msg.body.end(),
-                    buf.begin() + header_size + prefix_size,
-                    buf.begin() + header_size + body_size);
+    msg.body.assign(body, body + body_size);
   }
-  buf.erase(buf.begin(), buf.begin() + header_size + body_size);
-  if (!buf.empty() && !protocol::is_valid_magic(std::to_integer<std::uint8_t>(buf[0]))) {
+  offset += header_size + body_size;
+  if (offset == buf.size()) {
+    // everything has been consumed, no need to keep the bytes around until the next feed()
+    reset();
+  } else if (!protocol::is_valid_magic(std::to_integer<std::uint8_t>(buf[offset]))) {
     CB_LOG_WARNING("parsed frame for magic={:x}, opcode={:x}, opaque={}, body_len={}. Invalid "
                    "magic of the next frame: {:x}, {} "
                    "bytes to parse{}",
@@ -104,9 +97,9 @@ mcbp_parser::next(mcbp_message& msg) -> mcbp_parser::result
                    msg.header.opcode,
                    msg.header.opaque,
                    body_size,
-                   buf[0],
-                   buf.size(),
-                   spdlog::to_hex(buf));
+                   buf[offset],
+                   pending(),
+                   spdlog::to_hex(buf.begin() + static_cast<std::ptrdiff_t>(offset), buf.end()));
     reset();
   }
   return result::ok;
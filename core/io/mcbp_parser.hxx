@@ -19,7 +19,9 @@
 
 #include "mcbp_message.hxx"
 
+#include <cstddef>
 #include <iterator>
+#include <vector>
 
 namespace couchbase::core::io
 {
@@ -33,6 +35,7 @@ struct mcbp_parser {
   template<typename Iterator>
   void feed(Iterator begin, Iterator end)
   {
+    compact();
     buf.reserve(buf.size() + static_cast<std::size_t>(std::distance(begin, end)));
     buf.insert(buf.end(), begin, end);
   }
@@ -40,10 +43,38 @@ struct mcbp_parser {
   void reset()
   {
     buf.clear();
+    offset = 0;
+  }
+
+  /**
+   * @return number of received bytes, that have not been consumed by next() yet
+   */
+  [[nodiscard]] auto pending() const -> std::size_t
+  {
+    return buf.size() - offset;
   }
 
   auto next(mcbp_message& msg) -> result;
 
+  /**
+   * Frames are consumed by advancing the read offset rather than erasing them from the front of
+   * the buffer, so the whole batch of responses received by a single read is parsed without moving
+   * the remaining bytes after every frame. The consumed prefix is dropped once, on the next feed().
+   */
+  void compact()
+  {
+    if (offset == 0) {
+      return;
+    }
+    if (offset >= buf.size()) {
+      buf.clear();
+    } else {
+      buf.erase(buf.begin(), buf.begin() + static_cast<std::ptrdiff_t>(offset));
+    }
+    offset = 0;
+  }
+
   std::vector<std::byte> buf;
+  std::size_t offset{ 0 };
 };
 } // namespace couchbase::core::io
@@ -50,8 +50,10 @@
 #include "core/sasl/error_fmt.h"
 #include "core/topology/capabilities_fmt.hxx"
 #include "core/topology/configuration_fmt.hxx"
+#include "core/utils/concurrent_opaque_table.hxx"
 #include "mcbp_context.hxx"
 #include "mcbp_message.hxx"
+#include "mcbp_output_buffer.hxx"
 #include "mcbp_parser.hxx"
 #include "retry_orchestrator.hxx"
 #include "streams.hxx"
@@ -883,6 +885,7 @@ public:
     , reauth_deadline_(ctx_)
     , retry_backoff_(ctx_)
     , ping_timeout_(ctx_)
+    , flush_timer_(ctx_)
     , origin_{ std::move(origin) }
     , bucket_name_{ std::move(bucket_name) }
     , supported_features_{ std::move(known_features) }
@@ -913,6 +916,7 @@ public:
     , reauth_deadline_(ctx_)
     , retry_backoff_(ctx_)
     , ping_timeout_(ctx_)
+    , flush_timer_(ctx_)
     , origin_(std::move(origin))
     , bucket_name_(std::move(bucket_name))
     , supported_features_(std::move(known_features))
@@ -1356,6 +1360,11 @@ public:
     return id_;
   }
 
+  [[nodiscard]] auto io_context() const -> asio::io_context&
+  {
+    return ctx_;
+  }
+
   [[nodiscard]] auto node_uuid() const -> const std::string&
   {
     return node_uuid_;
@@ -1418,6 +1427,7 @@ public:
       self->reauth_deadline_.cancel();
       self->retry_backoff_.cancel();
       self->ping_timeout_.cancel();
+      self->flush_timer_.cancel();
       self->resolver_.cancel();
       if (auto h = std::move(self->bootstrap_handler_); h) {
         h->stop();
@@ -1434,19 +1444,14 @@ public:
         h(ec, {});
       }
     }
-    {
-      const std::scoped_lock lock(command_handlers_mutex_);
-      for (auto& [opaque, handler] : command_handlers_) {
-        if (handler) {
-          CB_LOG_DEBUG("{} MCBP cancel operation during session close, opaque={}, ec={}",
-                       stop_log_prefix,
-                       opaque,
-                       ec.message());
-          auto fun = std::move(handler);
-          fun(ec, reason, {}, {});
-        }
+    for (auto& [opaque, handler] : command_handlers_.take_all()) {
+      if (handler) {
+        CB_LOG_DEBUG("{} MCBP cancel operation during session close, opaque={}, ec={}",
+                     stop_log_prefix,
+                     opaque,
+                     ec.message());
+        handler(ec, reason, {}, {});
       }
-      command_handlers_.clear();
     }
     {
       const std::scoped_lock lock(operations_mutex_);
@@ -1486,7 +1491,7 @@ public:
     }
     CB_LOG_TRACE("{} MCBP send {}", log_prefix_, mcbp_header_view(buf));
     const std::scoped_lock lock(output_buffer_mutex_);
-    output_buffer_.emplace_back(std::move(buf));
+    output_buffer_.append(std::move(buf));
   }
 
   void flush()
@@ -1494,6 +1499,33 @@ public:
     if (stopped_) {
       return;
     }
+    if (const auto delay = origin_.options().write_coalescing_delay;
+        delay > std::chrono::microseconds::zero()) {
+      std::size_t pending_bytes{};
+      {
+        const std::scoped_lock lock(output_buffer_mutex_);
+        pending_bytes = output_buffer_.pending_bytes();
+      }
+      if (pending_bytes < origin_.options().write_coalescing_threshold) {
+        if (!flush_timer_armed_.exchange(true)) {
+          asio::post(asio::bind_executor(ctx_, [self = shared_from_this(), delay]() {
+            self->flush_timer_.expires_after(delay);
+            self->flush_timer_.async_wait([self](std::error_code ec) {
+              self->flush_timer_armed_ = false;
+              if (ec == asio::error::operation_aborted) {
+                return;
+              }
+              self->do_write();
+            });
+          }));
+        }
+        return;
+      }
+    }
+    // at most one write task is queued, requests written in the meantime are picked up by it
+    if (write_scheduled_.exchange(true)) {
+      return;
+    }
     asio::post(asio::bind_executor(ctx_, [self = shared_from_this()]() {
       self->do_write();
     }));
@@ -1531,15 +1563,7 @@ public:
                       mcbp_message&& msg) -> bool
   {
     // handle request old style
-    command_handler fun{};
-    {
-      const std::scoped_lock lock(command_handlers_mutex_);
-      if (auto handler = command_handlers_.find(opaque);
-          handler != command_handlers_.end() && handler->second) {
-        fun = std::move(handler->second);
-        command_handlers_.erase(handler);
-      }
-    }
+    auto fun = command_handlers_.take(opaque).value_or(command_handler{});
 
     auto reason = status == static_cast<std::uint16_t>(key_value_status_code::not_my_vbucket)
                     ? retry_reason::key_value_not_my_vbucket
@@ -1626,10 +1650,7 @@ public:
       handler(errc::common::request_canceled, retry_reason::socket_closed_while_in_flight, {}, {});
       return;
     }
-    {
-      const std::scoped_lock lock(command_handlers_mutex_);
-      command_handlers_.try_emplace(opaque, std::move(handler));
-    }
+    command_handlers_.try_emplace(opaque, std::move(handler));
     if (bootstrapped_ && stream_->is_open()) {
       write_and_flush(std::move(data));
     } else {
@@ -1650,22 +1671,17 @@ public:
     if (stopped_) {
       return false;
     }
-    command_handlers_mutex_.lock();
-    if (auto handler = command_handlers_.find(opaque); handler != command_handlers_.end()) {
+    if (auto handler = command_handlers_.take(opaque); handler) {
       CB_LOG_DEBUG("{} MCBP cancel operation, opaque={}, ec={} ({})",
                    log_prefix_,
                    opaque,
                    ec.value(),
                    ec.message());
-      if (handler->second) {
-        auto fun = std::move(handler->second);
-        command_handlers_.erase(handler);
-        command_handlers_mutex_.unlock();
-        fun(ec, reason, {}, {});
+      if (*handler) {
+        (*handler)(ec, reason, {}, {});
         return true;
       }
     }
-    command_handlers_mutex_.unlock();
     return false;
   }
 
@@ -2125,7 +2141,7 @@ private:
       parser_.reset();
       {
         const std::scoped_lock lock(output_buffer_mutex_);
-        output_buffer_.clear();
+        output_buffer_.clear_pending();
       }
       // cppcheck-suppress knownConditionTrueFalse
       if (stopped_) {
@@ -2238,27 +2254,27 @@ private:
 
   void do_write()
   {
+    write_scheduled_ = false;
     if (stopped_ || !stream_->is_open()) {
       return;
     }
-    const std::scoped_lock lock(writing_buffer_mutex_, output_buffer_mutex_);
-    if (!writing_buffer_.empty() || output_buffer_.empty()) {
+    const std::scoped_lock lock(output_buffer_mutex_);
+    if (!output_buffer_.start_write()) {
       return;
     }
-    std::swap(writing_buffer_, output_buffer_);
-    std::vector<asio::const_buffer> buffers;
-    buffers.reserve(writing_buffer_.size());
-    for (auto& buf : writing_buffer_) {
+    write_buffers_.clear();
+    for (const auto& buf : output_buffer_.in_flight()) {
       CB_LOG_PROTOCOL("[MCBP, OUT] host=\"{}\", sport={}, dport={}, buffer_size={}{:a}",
                       connection_endpoints_.remote_address,
                       connection_endpoints_.local.port(),
                       connection_endpoints_.remote.port(),
                       buf.size(),
                       spdlog::to_hex(buf));
-      buffers.emplace_back(asio::buffer(buf));
+      write_buffers_.emplace_back(asio::buffer(buf));
     }
     stream_->async_write(
-      buffers, [self = shared_from_this()](std::error_code ec, std::size_t bytes_transferred) {
+      write_buffers_,
+      [self = shared_from_this()](std::error_code ec, std::size_t bytes_transferred) {
         CB_LOG_PROTOCOL("[MCBP, OUT] host=\"{}\", sport={}, dport={}, rc={}, bytes_sent={}",
                         self->connection_endpoints_.remote_address,
                         self->connection_endpoints_.local.port(),
@@ -2279,8 +2295,8 @@ private:
           return self->stop(retry_reason::socket_closed_while_in_flight);
         }
         {
-          const std::scoped_lock inner_lock(self->writing_buffer_mutex_);
-          self->writing_buffer_.clear();
+          const std::scoped_lock inner_lock(self->output_buffer_mutex_);
+          self->output_buffer_.complete_write();
         }
         asio::post(asio::bind_executor(self->ctx_, [self]() {
           self->do_write();
@@ -2301,6 +2317,7 @@ private:
   asio::steady_timer reauth_deadline_;
   asio::steady_timer retry_backoff_;
   asio::steady_timer ping_timeout_;
+  asio::steady_timer flush_timer_;
   couchbase::core::origin origin_;
   std::optional<std::string> bucket_name_;
   mcbp_parser parser_;
@@ -2309,8 +2326,7 @@ private:
   std::shared_ptr<message_handler> handler_{ nullptr };
   utils::movable_function<void(std::error_code, const topology::configuration&)>
     bootstrap_callback_{};
-  std::mutex command_handlers_mutex_{};
-  std::map<std::uint32_t, command_handler> command_handlers_{};
+  utils::concurrent_opaque_table<command_handler> command_handlers_{};
   std::vector<std::shared_ptr<config_listener>> config_listeners_{};
   utils::movable_function<void()> on_stop_handler_{};
 
@@ -2325,12 +2341,13 @@ private:
   std::atomic<std::uint32_t> opaque_{ 0 };
 
   std::array<std::byte, 16384> input_buffer_{};
-  std::vector<std::vector<std::byte>> output_buffer_{};
+  mcbp_output_buffer output_buffer_{};
+  std::vector<asio::const_buffer> write_buffers_{};
   std::vector<std::vector<std::byte>> pending_buffer_{};
-  std::vector<std::vector<std::byte>> writing_buffer_{};
   std::mutex output_buffer_mutex_{};
   std::mutex pending_buffer_mutex_{};
-  std::mutex writing_buffer_mutex_{};
+  std::atomic_bool write_scheduled_{ false };
+  std::atomic_bool flush_timer_armed_{ false };
   std::string bootstrap_hostname_{};
   std::string bootstrap_port_{};
   std::string bootstrap_address_{};
@@ -2453,6 +2470,12 @@ mcbp_session::context() const -> mcbp_context
   return impl_->context();
 }
 
+auto
+mcbp_session::io_context() const -> asio::io_context&
+{
+  return impl_->io_context();
+}
+
 auto
 mcbp_session::supports_feature(protocol::hello_feature feature) -> bool
 {
@@ -132,6 +132,7 @@ public:
   [[nodiscard]] auto get_collection_uid(const std::string& collection_path)
     -> std::optional<std::uint32_t>;
   [[nodiscard]] auto context() const -> mcbp_context;
+  [[nodiscard]] auto io_context() const -> asio::io_context&;
   [[nodiscard]] auto supports_feature(protocol::hello_feature feature) -> bool;
   [[nodiscard]] auto supported_features() const -> std::vector<protocol::hello_feature>;
   [[nodiscard]] auto id() const -> const std::string&;
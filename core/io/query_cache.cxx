@@ -0,0 +1,232 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "query_cache.hxx"
+
+#include "core/metrics/constants.hxx"
+#include "core/tracing/constants.hxx"
+
+#include <couchbase/metrics/meter.hxx>
+
+#include <functional>
+#include <map>
+#include <string_view>
+#include <utility>
+
+namespace couchbase::core
+{
+namespace
+{
+auto
+statement_hash(const std::string& statement) -> std::uint64_t
+{
+  return std::hash<std::string_view>{}(statement);
+}
+
+auto
+entry_size(const std::string& statement, const query_cache::entry& value) -> std::size_t
+{
+  return statement.size() + value.name.size() + (value.plan ? value.plan->size() : 0);
+}
+
+auto
+per_shard_limit(std::size_t limit) -> std::size_t
+{
+  if (limit == 0) {
+    return 0;
+  }
+  return (limit + query_cache::number_of_shards - 1) / query_cache::number_of_shards;
+}
+} // namespace
+
+query_cache::query_cache()
+  : query_cache(default_max_entries, default_max_bytes)
+{
+}
+
+query_cache::query_cache(std::size_t max_entries, std::size_t max_bytes)
+{
+  set_limits(max_entries, max_bytes);
+}
+
+void
+query_cache::set_limits(std::size_t max_entries, std::size_t max_bytes)
+{
+  std::size_t evicted{ 0 };
+  for (auto& s : shards_) {
+    const std::scoped_lock lock(s.mutex);
+    s.max_entries = per_shard_limit(max_entries);
+    s.max_bytes = per_shard_limit(max_bytes);
+    evict(s, evicted);
+  }
+  record_evictions(evicted);
+}
+
+void
+query_cache::set_meter(const std::shared_ptr<couchbase::metrics::meter>& meter)
+{
+  if (!meter) {
+    std::atomic_store(&recorders_, std::shared_ptr<const recorders>{});
+    return;
+  }
+  const std::map<std::string, std::string> tags{
+    { tracing::attributes::common::system, "couchbase" },
+    { tracing::attributes::op::service, tracing::service::query },
+  };
+  auto resolved = std::make_shared<recorders>();
+  resolved->hits = meter->get_value_recorder(metrics::query_cache_hits_meter_name, tags);
+  resolved->misses = meter->get_value_recorder(metrics::query_cache_misses_meter_name, tags);
+  resolved->evictions = meter->get_value_recorder(metrics::query_cache_evictions_meter_name, tags);
+  std::atomic_store(&recorders_, std::shared_ptr<const recorders>{ std::move(resolved) });
+}
+
+void
+query_cache::erase(const std::string& statement)
+{
+  const auto hash = statement_hash(statement);
+  auto& s = shard_for(hash);
+  const std::scoped_lock lock(s.mutex);
+  auto it = s.index.find(hash);
+  if (it == s.index.end() || it->second->statement != statement) {
+    return;
+  }
+  s.bytes -= it->second->size;
+  s.lru.erase(it->second);
+  s.index.erase(it);
+}
+
+void
+query_cache::put(const std::string& statement, const std::string& prepared)
+{
+  store(statement, entry{ prepared });
+}
+
+void
+query_cache::put(const std::string& statement,
+                 const std::string& name,
+                 const std::string& encoded_plan)
+{
+  store(statement, entry{ name, encoded_plan });
+}
+
+auto
+query_cache::get(const std::string& statement) -> std::optional<entry>
+{
+  const auto hash = statement_hash(statement);
+  std::optional<entry> result{};
+  {
+    auto& s = shard_for(hash);
+    const std::scoped_lock lock(s.mutex);
+    if (auto it = s.index.find(hash);
+        it != s.index.end() && it->second->statement == statement) {
+      s.lru.splice(s.lru.begin(), s.lru, it->second);
+      result = it->second->value;
+    }
+  }
+  const auto rec = std::atomic_load(&recorders_);
+  if (result) {
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    if (rec) {
+      rec->hits->record_value(1);
+    }
+  } else {
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    if (rec) {
+      rec->misses->record_value(1);
+    }
+  }
+  return result;
+}
+
+auto
+query_cache::collect_stats() const -> stats
+{
+  stats result{
+    hits_.load(std::memory_order_relaxed),
+    misses_.load(std::memory_order_relaxed),
+    evictions_.load(std::memory_order_relaxed),
+  };
+  for (const auto& s : shards_) {
+    const std::scoped_lock lock(s.mutex);
+    result.entries += s.lru.size();
+    result.bytes += s.bytes;
+  }
+  return result;
+}
+
+void
+query_cache::store(const std::string& statement, entry value)
+{
+  const auto hash = statement_hash(statement);
+  const auto size = entry_size(statement, value);
+  std::size_t evicted{ 0 };
+  {
+    auto& s = shard_for(hash);
+    const std::scoped_lock lock(s.mutex);
+    if (s.max_bytes > 0 && size > s.max_bytes) {
+      return;
+    }
+    if (auto it = s.index.find(hash); it != s.index.end()) {
+      if (it->second->statement == statement) {
+        s.lru.splice(s.lru.begin(), s.lru, it->second);
+        return;
+      }
+      // different statement with the same hash, the newer one wins
+      s.bytes -= it->second->size;
+      s.lru.erase(it->second);
+      s.index.erase(it);
+    }
+    s.lru.push_front(node{ hash, statement, std::move(value), size });
+    s.index.emplace(hash, s.lru.begin());
+    s.bytes += size;
+    evict(s, evicted);
+  }
+  record_evictions(evicted);
+}
+
+void
+query_cache::evict(shard& s, std::size_t& evicted)
+{
+  while (!s.lru.empty() && ((s.max_entries > 0 && s.lru.size() > s.max_entries) ||
+                            (s.max_bytes > 0 && s.bytes > s.max_bytes))) {
+    const auto& victim = s.lru.back();
+    s.bytes -= victim.size;
+    s.index.erase(victim.hash);
+    s.lru.pop_back();
+    ++evicted;
+  }
+}
+
+void
+query_cache::record_evictions(std::size_t evicted)
+{
+  if (evicted == 0) {
+    return;
+  }
+  evictions_.fetch_add(evicted, std::memory_order_relaxed);
+  if (const auto rec = std::atomic_load(&recorders_); rec) {
+    rec->evictions->record_value(static_cast<std::int64_t>(evicted));
+  }
+}
+
+auto
+query_cache::shard_for(std::uint64_t hash) -> shard&
+{
+  // the lower bits select the bucket of the index, so mix them into the upper ones for the shard
+  return shards_[((hash * 0x9e3779b97f4a7c15ULL) >> 32U) % number_of_shards];
+}
+} // namespace couchbase::core
@@ -17,55 +17,108 @@
 
 #pragma once
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
+
+namespace couchbase::metrics
+{
+class meter;
+class value_recorder;
+} // namespace couchbase::metrics
 
 namespace couchbase::core
 {
+/**
+ * Cache of prepared N1QL statements.
+ *
+ * The statements are distributed over independent shards by their hash, so that concurrent
+ * queries do not contend on a single lock. Every shard is an LRU list bounded by its share of the
+ * entry and byte limits, and the least recently used statements are evicted when the limits are
+ * exceeded.
+ */
 class query_cache
 {
 public:
+  static constexpr std::size_t default_max_entries{ 5'000 };
+  static constexpr std::size_t default_max_bytes{ 32 * 1024 * 1024 };
+  static constexpr std::size_t number_of_shards{ 16 };
+
   struct entry {
     std::string name;
     std::optional<std::string> plan{};
   };
 
-  void erase(const std::string& statement)
-  {
-    std::scoped_lock lock(store_mutex_);
-    auto it = store_.find(statement);
-    if (it == store_.end()) {
-      return;
-    }
-    store_.erase(it);
-  }
-
-  void put(const std::string& statement, const std::string& prepared)
-  {
-    std::scoped_lock lock(store_mutex_);
-    store_.try_emplace(statement, entry{ prepared });
-  }
-
-  void put(const std::string& statement, const std::string& name, const std::string& encoded_plan)
-  {
-    std::scoped_lock lock(store_mutex_);
-    store_.try_emplace(statement, entry{ name, encoded_plan });
-  }
-
-  auto get(const std::string& statement) -> std::optional<entry>
-  {
-    std::scoped_lock lock(store_mutex_);
-    auto it = store_.find(statement);
-    if (it == store_.end()) {
-      return {};
-    }
-    return it->second;
-  }
+  struct stats {
+    std::uint64_t hits{ 0 };
+    std::uint64_t misses{ 0 };
+    std::uint64_t evictions{ 0 };
+    std::size_t entries{ 0 };
+    std::size_t bytes{ 0 };
+  };
+
+  query_cache();
+  query_cache(std::size_t max_entries, std::size_t max_bytes);
+
+  /**
+   * Updates the limits, and evicts the statements that do not fit anymore.
+   *
+   * Limits are split evenly between the shards, zero disables the corresponding limit.
+   */
+  void set_limits(std::size_t max_entries, std::size_t max_bytes);
+
+  /**
+   * Hits, misses and evictions will be recorded as values of the "db.couchbase.query_cache.*"
+   * recorders of the meter.
+   */
+  void set_meter(const std::shared_ptr<couchbase::metrics::meter>& meter);
+
+  void erase(const std::string& statement);
+  void put(const std::string& statement, const std::string& prepared);
+  void put(const std::string& statement, const std::string& name, const std::string& encoded_plan);
+  auto get(const std::string& statement) -> std::optional<entry>;
+
+  [[nodiscard]] auto collect_stats() const -> stats;
 
 private:
-  std::map<std::string, entry> store_;
-  std::mutex store_mutex_{};
+  struct node {
+    std::uint64_t hash;
+    std::string statement;
+    entry value;
+    std::size_t size;
+  };
+
+  struct shard {
+    mutable std::mutex mutex{};
+    std::list<node> lru{};
+    std::unordered_map<std::uint64_t, std::list<node>::iterator> index{};
+    std::size_t bytes{ 0 };
+    std::size_t max_entries{ 0 };
+    std::size_t max_bytes{ 0 };
+  };
+
+  struct recorders {
+    std::shared_ptr<couchbase::metrics::value_recorder> hits{};
+    std::shared_ptr<couchbase::metrics::value_recorder> misses{};
+    std::shared_ptr<couchbase::metrics::value_recorder> evictions{};
+  };
+
+  void store(const std::string& statement, entry value);
+  void evict(shard& s, std::size_t& evicted);
+  void record_evictions(std::size_t evicted);
+  auto shard_for(std::uint64_t hash) -> shard&;
+
+  std::array<shard, number_of_shards> shards_{};
+  std::atomic_uint64_t hits_{ 0 };
+  std::atomic_uint64_t misses_{ 0 };
+  std::atomic_uint64_t evictions_{ 0 };
+  std::shared_ptr<const recorders> recorders_{};
 };
 } // namespace couchbase::core
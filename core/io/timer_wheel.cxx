@@ -0,0 +1,291 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "timer_wheel.hxx"
+
+#include <asio/error.hpp>
+#include <asio/post.hpp>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::io
+{
+namespace
+{
+constexpr std::size_t slot_mask{ timer_wheel::number_of_slots - 1 };
+static_assert((timer_wheel::number_of_slots & slot_mask) == 0,
+              "number of slots must be a power of two");
+
+auto
+slot_of(std::int64_t tick) -> std::size_t
+{
+  return static_cast<std::size_t>(tick) & slot_mask;
+}
+} // namespace
+
+asio::io_context::id timer_wheel::id;
+
+wheel_timer::wheel_timer(asio::io_context& ctx)
+  : wheel_{ timer_wheel::of(ctx) }
+{
+}
+
+wheel_timer::~wheel_timer()
+{
+  wheel_.cancel(*this);
+}
+
+void
+wheel_timer::expires_after(clock_type::duration duration)
+{
+  expires_at(clock_type::now() + duration);
+}
+
+void
+wheel_timer::expires_at(time_point expiry)
+{
+  cancel();
+  expiry_ = expiry;
+}
+
+auto
+wheel_timer::expiry() const -> time_point
+{
+  return expiry_;
+}
+
+void
+wheel_timer::async_wait(handler_type&& handler)
+{
+  wheel_.schedule(*this, std::move(handler));
+}
+
+auto
+wheel_timer::cancel() -> std::size_t
+{
+  return wheel_.cancel(*this);
+}
+
+timer_wheel::timer_wheel(asio::io_context& ctx)
+  : asio::io_context::service(ctx)
+  , ctx_{ ctx }
+  , driver_{ ctx }
+{
+}
+
+auto
+timer_wheel::size() const -> std::size_t
+{
+  const std::scoped_lock lock(mutex_);
+  return size_;
+}
+
+void
+timer_wheel::shutdown()
+{
+  std::vector<wheel_timer::handler_type> abandoned;
+  {
+    const std::scoped_lock lock(mutex_);
+    shutdown_ = true;
+    for (auto& head : slots_) {
+      while (head != nullptr) {
+        auto* timer = head;
+        unlink(*timer);
+        abandoned.emplace_back(std::move(timer->handler_));
+      }
+    }
+    driver_.cancel();
+    armed_tick_.reset();
+  }
+}
+
+void
+timer_wheel::schedule(wheel_timer& timer, wheel_timer::handler_type&& handler)
+{
+  // the timer holds only one handler, so the previous wait (if any) is aborted
+  cancel(timer);
+
+  const std::scoped_lock lock(mutex_);
+  if (shutdown_) {
+    return;
+  }
+  if (size_ == 0) {
+    cursor_ = std::max(cursor_, tick_of(wheel_timer::clock_type::now(), false));
+  }
+  timer.handler_ = std::move(handler);
+  timer.tick_ = std::max(tick_of(timer.expiry_, true), cursor_ + 1);
+  link(timer);
+  if (!armed_tick_ || timer.tick_ < armed_tick_.value()) {
+    arm(timer.tick_);
+  }
+}
+
+auto
+timer_wheel::cancel(wheel_timer& timer) -> std::size_t
+{
+  wheel_timer::handler_type handler{};
+  {
+    const std::scoped_lock lock(mutex_);
+    if (!timer.linked_) {
+      return 0;
+    }
+    unlink(timer);
+    handler = std::move(timer.handler_);
+    if (size_ == 0 && armed_tick_) {
+      // do not keep the io_context busy when nothing is waiting
+      driver_.cancel();
+      armed_tick_.reset();
+    }
+  }
+  asio::post(ctx_, [handler = std::move(handler)]() mutable {
+    handler(asio::error::operation_aborted);
+  });
+  return 1;
+}
+
+void
+timer_wheel::on_tick(std::error_code ec)
+{
+  if (ec == asio::error::operation_aborted) {
+    return;
+  }
+
+  std::vector<wheel_timer::handler_type> expired;
+  {
+    const std::scoped_lock lock(mutex_);
+    if (shutdown_) {
+      return;
+    }
+    armed_tick_.reset();
+
+    const auto now_tick = tick_of(wheel_timer::clock_type::now(), false);
+    const auto number_of_ticks = std::min<std::int64_t>(
+      now_tick - cursor_, static_cast<std::int64_t>(number_of_slots));
+    for (std::int64_t i = 1; i <= number_of_ticks; ++i) {
+      const auto slot = slot_of(cursor_ + i);
+      if ((occupied_[slot / 64] & (std::uint64_t{ 1 } << (slot % 64))) == 0) {
+        continue;
+      }
+      auto* timer = slots_[slot];
+      while (timer != nullptr) {
+        auto* next = timer->next_;
+        if (timer->tick_ <= now_tick) {
+          unlink(*timer);
+          expired.emplace_back(std::move(timer->handler_));
+        }
+        timer = next;
+      }
+    }
+    cursor_ = std::max(cursor_, now_tick);
+
+    if (auto next_tick = next_occupied_tick(); next_tick) {
+      arm(next_tick.value());
+    }
+  }
+
+  for (auto& handler : expired) {
+    handler({});
+  }
+}
+
+void
+timer_wheel::link(wheel_timer& timer)
+{
+  const auto slot = slot_of(timer.tick_);
+  timer.prev_ = nullptr;
+  timer.next_ = slots_[slot];
+  if (timer.next_ != nullptr) {
+    timer.next_->prev_ = &timer;
+  }
+  slots_[slot] = &timer;
+  occupied_[slot / 64] |= std::uint64_t{ 1 } << (slot % 64);
+  timer.linked_ = true;
+  ++size_;
+}
+
+void
+timer_wheel::unlink(wheel_timer& timer)
+{
+  const auto slot = slot_of(timer.tick_);
+  if (timer.prev_ != nullptr) {
+    timer.prev_->next_ = timer.next_;
+  } else {
+    slots_[slot] = timer.next_;
+  }
+  if (timer.next_ != nullptr) {
+    timer.next_->prev_ = timer.prev_;
+  }
+  if (slots_[slot] == nullptr) {
+    occupied_[slot / 64] &= ~(std::uint64_t{ 1 } << (slot % 64));
+  }
+  timer.prev_ = nullptr;
+  timer.next_ = nullptr;
+  timer.linked_ = false;
+  --size_;
+}
+
+void
+timer_wheel::arm(std::int64_t tick)
+{
+  armed_tick_ = tick;
+  driver_.expires_at(epoch_ + tick * tick_duration);
+  driver_.async_wait([this](std::error_code ec) {
+    on_tick(ec);
+  });
+}
+
+auto
+timer_wheel::next_occupied_tick() const -> std::optional<std::int64_t>
+{
+  if (size_ == 0) {
+    return {};
+  }
+  // scan the occupancy bitmap for the first slot after the cursor, wrapping around once
+  const auto start = slot_of(cursor_ + 1);
+  for (std::size_t distance = 0; distance < number_of_slots;) {
+    const auto slot = (start + distance) & slot_mask;
+    const auto word = occupied_[slot / 64] >> (slot % 64);
+    if (word == 0) {
+      distance += 64 - (slot % 64);
+      continue;
+    }
+    std::size_t offset = 0;
+    while ((word & (std::uint64_t{ 1 } << offset)) == 0) {
+      ++offset;
+    }
+    distance += offset;
+    if (distance >= number_of_slots) {
+      break;
+    }
+    return cursor_ + 1 + static_cast<std::int64_t>(distance);
+  }
+  return cursor_ + static_cast<std::int64_t>(number_of_slots);
+}
+
+auto
+timer_wheel::tick_of(wheel_timer::time_point time, bool round_up) const -> std::int64_t
+{
+  const auto elapsed = time - epoch_;
+  std::int64_t tick = std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+  if (round_up && elapsed > std::chrono::milliseconds{ tick }) {
+    ++tick;
+  }
+  return tick;
+}
+} // namespace couchbase::core::io
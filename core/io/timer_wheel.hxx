@@ -0,0 +1,146 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/utils/movable_function.hxx"
+
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <system_error>
+
+namespace couchbase::core::io
+{
+class timer_wheel;
+
+/**
+ * Timer for operation deadlines and retry backoffs.
+ *
+ * It mirrors the subset of asio::steady_timer interface used by the commands, but instead of
+ * inserting every deadline into the timer queue of the io_context, it registers with the
+ * timer_wheel of that io_context. Just like asio::steady_timer, the handler is invoked with
+ * asio::error::operation_aborted when the wait is cancelled, and the object itself is not
+ * thread-safe.
+ */
+class wheel_timer
+{
+public:
+  using clock_type = std::chrono::steady_clock;
+  using time_point = clock_type::time_point;
+  using handler_type = utils::movable_function<void(std::error_code)>;
+
+  explicit wheel_timer(asio::io_context& ctx);
+  wheel_timer(const wheel_timer&) = delete;
+  wheel_timer(wheel_timer&&) = delete;
+  auto operator=(const wheel_timer&) -> wheel_timer& = delete;
+  auto operator=(wheel_timer&&) -> wheel_timer& = delete;
+  ~wheel_timer();
+
+  /**
+   * Sets the expiry time relative to now, and cancels the pending wait.
+   */
+  void expires_after(clock_type::duration duration);
+
+  /**
+   * Sets the expiry time, and cancels the pending wait.
+   */
+  void expires_at(time_point expiry);
+
+  [[nodiscard]] auto expiry() const -> time_point;
+
+  void async_wait(handler_type&& handler);
+
+  /**
+   * @return number of the waits that have been cancelled (zero or one)
+   */
+  auto cancel() -> std::size_t;
+
+private:
+  friend class timer_wheel;
+
+  timer_wheel& wheel_;
+  time_point expiry_{};
+  std::int64_t tick_{ 0 };
+  wheel_timer* prev_{ nullptr };
+  wheel_timer* next_{ nullptr };
+  bool linked_{ false };
+  handler_type handler_{};
+};
+
+/**
+ * Hashed timer wheel, one per io_context.
+ *
+ * The wheel consists of slots that represent consecutive ticks of one millisecond. Each waiting
+ * timer is linked into the slot of its expiry tick (modulo the number of slots), so that insertion
+ * and cancellation are constant time and do not allocate. A single asio::steady_timer wakes the
+ * wheel up on the next occupied slot, and the timers that have expired by that moment are invoked.
+ * Timers further than one revolution away stay in their slot until the wheel comes around again.
+ */
+class timer_wheel : public asio::io_context::service
+{
+public:
+  static asio::io_context::id id;
+
+  static constexpr std::chrono::milliseconds tick_duration{ 1 };
+  static constexpr std::size_t number_of_slots{ 4096 };
+
+  explicit timer_wheel(asio::io_context& ctx);
+
+  static auto of(asio::io_context& ctx) -> timer_wheel&
+  {
+    return asio::use_service<timer_wheel>(ctx);
+  }
+
+  /**
+   * @return number of the timers that are waiting
+   */
+  [[nodiscard]] auto size() const -> std::size_t;
+
+private:
+  friend class wheel_timer;
+
+  void shutdown() override;
+
+  void schedule(wheel_timer& timer, wheel_timer::handler_type&& handler);
+  auto cancel(wheel_timer& timer) -> std::size_t;
+  void on_tick(std::error_code ec);
+
+  void link(wheel_timer& timer);
+  void unlink(wheel_timer& timer);
+  void arm(std::int64_t tick);
+  [[nodiscard]] auto next_occupied_tick() const -> std::optional<std::int64_t>;
+  [[nodiscard]] auto tick_of(wheel_timer::time_point time, bool round_up) const -> std::int64_t;
+
+  asio::io_context& ctx_;
+  asio::steady_timer driver_;
+  const wheel_timer::time_point epoch_{ wheel_timer::clock_type::now() };
+  mutable std::mutex mutex_{};
+  std::array<wheel_timer*, number_of_slots> slots_{};
+  std::array<std::uint64_t, number_of_slots / 64> occupied_{};
+  std::size_t size_{ 0 };
+  std::int64_t cursor_{ 0 };
+  std::optional<std::int64_t> armed_tick_{};
+  bool shutdown_{ false };
+};
+} // namespace couchbase::core::io
@@ -96,7 +96,7 @@ queue_request::is_cancelled() const -> bool
 namespace
 {
 inline void
-cancel_timer(std::shared_ptr<asio::steady_timer> timer)
+cancel_timer(std::shared_ptr<io::wheel_timer> timer)
 {
   if (auto t = std::move(timer); t) {
     t->cancel();
@@ -139,14 +139,14 @@ queue_request::cancel(std::error_code error)
 }
 
 void
-queue_request::set_deadline(std::shared_ptr<asio::steady_timer> timer)
+queue_request::set_deadline(std::shared_ptr<io::wheel_timer> timer)
 {
   const std::scoped_lock lock(processing_mutex_);
   deadline_ = std::move(timer);
 }
 
 void
-queue_request::set_retry_backoff(std::shared_ptr<asio::steady_timer> timer)
+queue_request::set_retry_backoff(std::shared_ptr<io::wheel_timer> timer)
 {
   const std::scoped_lock lock(processing_mutex_);
   retry_backoff_ = std::move(timer);
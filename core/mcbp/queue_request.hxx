@@ -17,6 +17,7 @@
 
 #pragma once
 
+#include "core/io/timer_wheel.hxx"
 #include "core/pending_operation.hxx"
 #include "packet.hxx"
 #include "queue_callback.hxx"
@@ -24,8 +25,6 @@
 
 #include <couchbase/retry_strategy.hxx>
 
-#include <asio/steady_timer.hpp>
-
 #include <atomic>
 #include <memory>
 #include <mutex>
@@ -72,8 +71,8 @@ public:
   void try_callback(std::shared_ptr<queue_response> response, std::error_code error);
   auto internal_cancel() -> bool;
 
-  void set_deadline(std::shared_ptr<asio::steady_timer> timer);
-  void set_retry_backoff(std::shared_ptr<asio::steady_timer> timer);
+  void set_deadline(std::shared_ptr<io::wheel_timer> timer);
+  void set_retry_backoff(std::shared_ptr<io::wheel_timer> timer);
 
   std::string collection_name_{};
   std::string scope_name_{};
@@ -127,8 +126,8 @@ private:
   queue_request_connection_info connection_info_{};
   mutable std::mutex connection_info_mutex_{};
 
-  std::shared_ptr<asio::steady_timer> deadline_{};
-  std::shared_ptr<asio::steady_timer> retry_backoff_{};
+  std::shared_ptr<io::wheel_timer> deadline_{};
+  std::shared_ptr<io::wheel_timer> retry_backoff_{};
 
   friend operation_queue;
 };
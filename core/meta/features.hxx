@@ -158,6 +158,11 @@
  */
 #define COUCHBASE_CXX_CLIENT_SUPPORTS_BASE64_VECTOR_TYPES
 
+/**
+ * Support for single-precision vectors in the public API, that are sent to the server as base64
+ */
+#define COUCHBASE_CXX_CLIENT_SUPPORTS_FLOAT_VECTOR_TYPES
+
 /**
  * Supports binary objects in transactions
  */
@@ -275,3 +280,39 @@
  * couchbase::core::transactions::transactions does not implement the Public API.
  */
 #define COUCHBASE_CXX_CLIENT_TRANSACTIONS_PUBLIC_CORE_IMPL_SEPARATION 1
+
+/**
+ * couchbase::network_options has io_threads() option to spread KV and HTTP connections across
+ * multiple I/O threads.
+ */
+#define COUCHBASE_CXX_CLIENT_HAS_IO_THREADS_OPTION 1
+
+/**
+ * couchbase::network_options has write_coalescing() option to hold outgoing KV requests for a
+ * short time and send them with fewer system calls.
+ */
+#define COUCHBASE_CXX_CLIENT_HAS_WRITE_COALESCING_OPTION 1
+
+/**
+ * couchbase::collection has get_multi(), upsert_multi() and remove_multi() to dispatch batches of
+ * KV operations with a single completion.
+ */
+#define COUCHBASE_CXX_CLIENT_HAS_COLLECTION_BULK_OPERATIONS 1
+
+/**
+ * couchbase::network_options has min_http_connections_per_node() option to pre-connect HTTP
+ * sessions to the query, search and analytics services.
+ */
+#define COUCHBASE_CXX_CLIENT_HAS_MIN_HTTP_CONNECTIONS_OPTION 1
+
+/**
+ * couchbase::cluster and couchbase::scope have query_stream() to receive the rows of the query as
+ * they arrive, with reading of the response paused while the consumer falls behind.
+ */
+#define COUCHBASE_CXX_CLIENT_HAS_QUERY_ROW_STREAM 1
+
+/**
+ * couchbase::scan_options has adaptive_concurrency() option to size the number of concurrent
+ * partition scans of each node from the observed batch latency and throughput.
+ */
+#define COUCHBASE_CXX_CLIENT_HAS_SCAN_ADAPTIVE_CONCURRENCY 1
@@ -20,4 +20,7 @@
 namespace couchbase::core::metrics
 {
 constexpr auto operation_meter_name = "db.client.operation.duration";
+constexpr auto query_cache_hits_meter_name = "db.couchbase.query_cache.hits";
+constexpr auto query_cache_misses_meter_name = "db.couchbase.query_cache.misses";
+constexpr auto query_cache_evictions_meter_name = "db.couchbase.query_cache.evictions";
 } // namespace couchbase::core::metrics
@@ -27,28 +27,107 @@
 
 #include <gsl/assert>
 #include <hdr/hdr_histogram.h>
+#include <hdr/hdr_interval_recorder.h>
 #include <tao/json/value.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
 #include <memory>
+#include <string_view>
 #include <utility>
 
 namespace couchbase::core::metrics
 {
+namespace
+{
+constexpr std::size_t max_histogram_shards{ 16 };
+
+auto
+this_thread_shard() -> std::size_t
+{
+  static std::atomic_size_t next_shard{ 0 };
+  thread_local const std::size_t shard{ next_shard.fetch_add(1, std::memory_order_relaxed) %
+                                        max_histogram_shards };
+  return shard;
+}
+
+constexpr std::int64_t lowest_trackable_value{ 1 };                 // 1 ns
+constexpr std::int64_t highest_trackable_value{ 30'000'000'000LL }; // 30 s
+constexpr int significant_figures{ 3 };
+
+auto
+create_histogram() -> hdr_histogram*
+{
+  hdr_histogram* histogram{ nullptr };
+  hdr_init(lowest_trackable_value, highest_trackable_value, significant_figures, &histogram);
+  Expects(histogram != nullptr);
+  return histogram;
+}
+
+auto
+create_interval_recorder() -> hdr_interval_recorder*
+{
+  auto recorder = std::make_unique<hdr_interval_recorder>();
+  const auto rc = hdr_interval_recorder_init_all(
+    recorder.get(), lowest_trackable_value, highest_trackable_value, significant_figures);
+  Expects(rc == 0);
+  return recorder.release();
+}
+
+void
+destroy_interval_recorder(hdr_interval_recorder* recorder)
+{
+  hdr_interval_recorder_destroy(recorder);
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  delete recorder;
+}
+
+/**
+ * The meters that the SDK updates by itself and that the logging meter reports as counters.
+ */
+constexpr std::array<std::string_view, 3> counter_names{
+  query_cache_hits_meter_name,
+  query_cache_misses_meter_name,
+  query_cache_evictions_meter_name,
+};
+
+auto
+recorder_hash(std::string_view service, std::string_view operation) -> std::size_t
+{
+  const auto hash = std::hash<std::string_view>{}(service);
+  return hash ^ (std::hash<std::string_view>{}(operation) + 0x9e3779b9 + (hash << 6) + (hash >> 2));
+}
+} // namespace
+
+/**
+ * Every thread records into its own shard (threads share the shard only when there are more of
+ * them than shards), so that the I/O threads do not contend on the same counters. The shards are
+ * allocated on first use. Each one is an HDR interval recorder: when the report is emitted, the
+ * active histogram of the shard is swapped with an idle one, and the swapped-out histogram is
+ * merged only after the writer-reader phaser confirms that no thread is still recording into it.
+ */
 class logging_value_recorder : public couchbase::metrics::value_recorder
 {
 private:
   std::string name_;
   std::map<std::string, std::string> tags_;
-  hdr_histogram* histogram_{ nullptr };
+  std::array<std::atomic<hdr_interval_recorder*>, max_histogram_shards> shards_{};
 
-  void initialize_histogram()
+  auto this_thread_recorder() -> hdr_interval_recorder*
   {
-    histogram_ = nullptr;
-    hdr_init(/* minimum - 1 ns*/ 1,
-             /* maximum - 30 s*/ 30'000'000'000LL,
-             /* significant figures */ 3,
-             /* pointer */ &histogram_);
-    Expects(histogram_ != nullptr);
+    auto& shard = shards_[this_thread_shard()];
+    auto* recorder = shard.load(std::memory_order_acquire);
+    if (recorder != nullptr) {
+      return recorder;
+    }
+    auto* created = create_interval_recorder();
+    if (shard.compare_exchange_strong(recorder, created, std::memory_order_acq_rel)) {
+      return created;
+    }
+    destroy_interval_recorder(created);
+    return recorder;
   }
 
 public:
@@ -57,73 +136,49 @@ public:
     , name_(std::move(name))
     , tags_(std::move(tags))
   {
-    initialize_histogram();
-  }
-
-  logging_value_recorder(const logging_value_recorder& other)
-    : value_recorder()
-    , name_(other.name_)
-    , tags_(other.tags_)
-  {
-    initialize_histogram();
-  }
-
-  logging_value_recorder(logging_value_recorder&& other) noexcept
-    : value_recorder()
-    , name_(std::move(other.name_))
-    , tags_(std::move(other.tags_))
-  {
-    initialize_histogram();
   }
 
-  auto operator=(const logging_value_recorder& other) -> logging_value_recorder&
-  {
-    if (this == &other) {
-      return *this;
-    }
-    name_ = other.name_;
-    tags_ = other.tags_;
-    initialize_histogram();
-    return *this;
-  }
-
-  auto operator=(logging_value_recorder&& other) noexcept -> logging_value_recorder&
-  {
-    if (this == &other) {
-      return *this;
-    }
-    name_ = std::move(other.name_);
-    tags_ = std::move(other.tags_);
-    initialize_histogram();
-    return *this;
-  }
+  logging_value_recorder(const logging_value_recorder& other) = delete;
+  logging_value_recorder(logging_value_recorder&& other) noexcept = delete;
+  auto operator=(const logging_value_recorder& other) -> logging_value_recorder& = delete;
+  auto operator=(logging_value_recorder&& other) noexcept -> logging_value_recorder& = delete;
 
   ~logging_value_recorder() override
   {
-    if (histogram_ != nullptr) {
-      hdr_close(histogram_);
-      histogram_ = nullptr;
+    for (auto& shard : shards_) {
+      if (auto* recorder = shard.exchange(nullptr); recorder != nullptr) {
+        destroy_interval_recorder(recorder);
+      }
     }
   }
 
   void record_value(std::int64_t value) override
   {
-    if (histogram_ == nullptr) {
-      return;
-    }
-    hdr_record_value_atomic(histogram_, value);
+    hdr_interval_recorder_record_value_atomic(this_thread_recorder(), value);
   }
 
-  [[nodiscard]] auto emit() const -> tao::json::value
+  /**
+   * Takes the values recorded since the previous call. Must not be called concurrently with
+   * itself, the meter serializes it with the recorders mutex.
+   */
+  [[nodiscard]] auto emit() -> tao::json::value
   {
-    auto total_count = histogram_->total_count;
-    auto val_50_0 = hdr_value_at_percentile(histogram_, 50.0);
-    auto val_90_0 = hdr_value_at_percentile(histogram_, 90.0);
-    auto val_99_0 = hdr_value_at_percentile(histogram_, 99.0);
-    auto val_99_9 = hdr_value_at_percentile(histogram_, 99.9);
-    auto val_100_0 = hdr_value_at_percentile(histogram_, 100.0);
+    auto* merged = create_histogram();
+    for (auto& shard : shards_) {
+      if (auto* recorder = shard.load(std::memory_order_acquire); recorder != nullptr) {
+        // the sampled histogram belongs to the recorder and is reset by the next sample
+        hdr_add(merged, hdr_interval_recorder_sample(recorder));
+      }
+    }
+
+    auto total_count = merged->total_count;
+    auto val_50_0 = hdr_value_at_percentile(merged, 50.0);
+    auto val_90_0 = hdr_value_at_percentile(merged, 90.0);
+    auto val_99_0 = hdr_value_at_percentile(merged, 99.0);
+    auto val_99_9 = hdr_value_at_percentile(merged, 99.9);
+    auto val_100_0 = hdr_value_at_percentile(merged, 100.0);
 
-    hdr_reset(histogram_);
+    hdr_close(merged);
 
     return {
       { "total_count", total_count },
@@ -139,8 +194,28 @@ public:
   }
 };
 
-void
-logging_meter::log_report() const
+/**
+ * Sums the recorded values, and reports the sum of the interval.
+ */
+class logging_counter : public couchbase::metrics::value_recorder
+{
+public:
+  void record_value(std::int64_t value) override
+  {
+    value_.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto emit() -> std::int64_t
+  {
+    return value_.exchange(0, std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<std::int64_t> value_{ 0 };
+};
+
+auto
+logging_meter::flush_and_create_output() -> std::optional<std::string>
 {
   tao::json::value report{
     {
@@ -155,13 +230,28 @@ logging_meter::log_report() const
       },
     },
   };
-  for (const auto& [service, operations] : recorders_) {
-    for (const auto& [operation, recorder] : operations) {
-      report["operations"][service][operation] = recorder->emit();
+  {
+    const std::scoped_lock lock(recorders_mutex_);
+    for (const auto& [service, operations] : recorders_) {
+      for (const auto& [operation, recorder] : operations) {
+        report["operations"][service][operation] = recorder->emit();
+      }
     }
+    for (const auto& [name, counter] : counters_) {
+      report["counters"][name] = counter->emit();
+    }
+  }
+  if (report.find("operations") == nullptr && report.find("counters") == nullptr) {
+    return {};
   }
-  if (report.find("operations") != nullptr) {
-    CB_LOG_INFO("Metrics: {}", utils::json::generate(report));
+  return utils::json::generate(report);
+}
+
+void
+logging_meter::log_report()
+{
+  if (auto output = flush_and_create_output(); output) {
+    CB_LOG_INFO("Metrics: {}", output.value());
   }
 }
 
@@ -211,6 +301,15 @@ logging_meter::get_value_recorder(const std::string& name,
     std::make_shared<noop_value_recorder>()
   };
 
+  if (std::find(counter_names.begin(), counter_names.end(), name) != counter_names.end()) {
+    const std::scoped_lock lock(recorders_mutex_);
+    auto& counter = counters_[name];
+    if (!counter) {
+      counter = std::make_shared<logging_counter>();
+    }
+    return counter;
+  }
+
   if (name != operation_meter_name) {
     return noop_recorder;
   }
@@ -225,11 +324,79 @@ logging_meter::get_value_recorder(const std::string& name,
     return noop_recorder;
   }
 
+  const auto hash = recorder_hash(service->second, operation->second);
+  if (const auto* entry = find_recorder(hash, service->second, operation->second);
+      entry != nullptr) {
+    return entry->recorder;
+  }
+  return create_recorder(hash, service->second, operation->second, tags).recorder;
+}
+
+auto
+logging_meter::operation_recorder(std::string_view service, std::string_view operation)
+  -> couchbase::metrics::value_recorder&
+{
+  const auto hash = recorder_hash(service, operation);
+  if (const auto* entry = find_recorder(hash, service, operation); entry != nullptr) {
+    return *entry->recorder;
+  }
+  const std::map<std::string, std::string> tags{
+    { tracing::attributes::op::service, std::string{ service } },
+    { tracing::attributes::op::operation_name, std::string{ operation } },
+  };
+  return *create_recorder(hash, service, operation, tags).recorder;
+}
+
+auto
+logging_meter::find_recorder(std::size_t hash,
+                             std::string_view service,
+                             std::string_view operation) const -> const recorder_entry*
+{
+  for (std::size_t i = 0; i < number_of_index_slots; ++i) {
+    const auto* entry = index_[(hash + i) % number_of_index_slots].load(std::memory_order_acquire);
+    if (entry == nullptr) {
+      return nullptr;
+    }
+    if (entry->hash == hash && entry->service == service && entry->operation == operation) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+auto
+logging_meter::create_recorder(std::size_t hash,
+                               std::string_view service,
+                               std::string_view operation,
+                               const std::map<std::string, std::string>& tags)
+  -> const recorder_entry&
+{
   const std::scoped_lock lock(recorders_mutex_);
-  auto& service_recorders = recorders_[service->second];
+  for (const auto& entry : index_entries_) {
+    if (entry->hash == hash && entry->service == service && entry->operation == operation) {
+      return *entry;
+    }
+  }
+
+  auto& service_recorders = recorders_[std::string{ service }];
+  auto it = service_recorders.find(std::string{ operation });
+  if (it == service_recorders.end()) {
+    it = service_recorders
+           .try_emplace(std::string{ operation },
+                        std::make_shared<logging_value_recorder>(std::string{ operation }, tags))
+           .first;
+  }
+  const auto& entry = index_entries_.emplace_back(std::make_unique<recorder_entry>(
+    recorder_entry{ hash, std::string{ service }, std::string{ operation }, it->second }));
 
-  auto [it, _] = service_recorders.try_emplace(
-    operation->second, std::make_shared<logging_value_recorder>(operation->second, tags));
-  return it->second;
+  // publish the entry in the first free slot, the index is only written under the lock
+  for (std::size_t i = 0; i < number_of_index_slots; ++i) {
+    auto& slot = index_[(hash + i) % number_of_index_slots];
+    if (slot.load(std::memory_order_relaxed) == nullptr) {
+      slot.store(entry.get(), std::memory_order_release);
+      break;
+    }
+  }
+  return *entry;
 }
 } // namespace couchbase::core::metrics
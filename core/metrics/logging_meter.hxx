@@ -23,28 +23,60 @@
 
 #include <asio/steady_timer.hpp>
 
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace couchbase::core::metrics
 {
 class logging_value_recorder;
+class logging_counter;
 
 class logging_meter
   : public couchbase::metrics::meter
   , public std::enable_shared_from_this<logging_meter>
 {
 private:
+  struct recorder_entry {
+    std::size_t hash;
+    std::string service;
+    std::string operation;
+    std::shared_ptr<logging_value_recorder> recorder;
+  };
+
+  static constexpr std::size_t number_of_index_slots{ 512 };
+
   asio::steady_timer emit_report_;
   logging_meter_options options_;
   std::mutex recorders_mutex_{};
   // service name -> operation name -> recorder
   std::map<std::string, std::map<std::string, std::shared_ptr<logging_value_recorder>>>
     recorders_{};
+  // open addressing index of the recorders for the lookups without the lock, the entries are
+  // published once and never removed, they are owned by index_entries_
+  std::array<std::atomic<const recorder_entry*>, number_of_index_slots> index_{};
+  std::vector<std::unique_ptr<recorder_entry>> index_entries_{};
+  // meter name -> counter, for the counters of the SDK itself (e.g. the query cache)
+  std::map<std::string, std::shared_ptr<logging_counter>, std::less<>> counters_{};
 
-  void log_report() const;
+  void log_report();
 
   void rearm_reporter();
 
+  auto find_recorder(std::size_t hash, std::string_view service, std::string_view operation) const
+    -> const recorder_entry*;
+  auto create_recorder(std::size_t hash,
+                       std::string_view service,
+                       std::string_view operation,
+                       const std::map<std::string, std::string>& tags) -> const recorder_entry&;
+
 public:
   logging_meter(asio::io_context& ctx, logging_meter_options options);
 
@@ -56,6 +88,21 @@ public:
 
   auto get_value_recorder(const std::string& name, const std::map<std::string, std::string>& tags)
     -> std::shared_ptr<couchbase::metrics::value_recorder> override;
+
+  /**
+   * Returns the recorder of the operation, the same one that get_value_recorder() returns for the
+   * operation meter. Once the recorder has been created, the lookup neither takes locks nor
+   * allocates. The reference stays valid for the lifetime of the meter.
+   */
+  auto operation_recorder(std::string_view service, std::string_view operation)
+    -> couchbase::metrics::value_recorder&;
+
+  /**
+   * Builds the report of the values recorded since the previous report, or returns nothing if
+   * neither operation nor counter has been recorded yet. This is what the meter logs on every emit
+   * interval.
+   */
+  auto flush_and_create_output() -> std::optional<std::string>;
 };
 
 } // namespace couchbase::core::metrics
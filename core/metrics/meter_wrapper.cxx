@@ -20,6 +20,8 @@
 #include <couchbase/error_codes.hxx>
 
 #include "core/metrics/constants.hxx"
+#include "core/metrics/logging_meter.hxx"
+#include "core/metrics/noop_meter.hxx"
 #include "core/tracing/constants.hxx"
 
 #include <map>
@@ -135,6 +137,8 @@ meter_wrapper::meter_wrapper(std::shared_ptr<couchbase::metrics::meter> meter,
                              std::shared_ptr<cluster_label_listener> label_listener)
   : meter_{ std::move(meter) }
   , cluster_label_listener_{ std::move(label_listener) }
+  , logging_meter_{ std::dynamic_pointer_cast<logging_meter>(meter_) }
+  , noop_{ std::dynamic_pointer_cast<noop_meter>(meter_) != nullptr }
 {
 }
 
@@ -161,6 +165,18 @@ void
 meter_wrapper::record_value(metric_attributes attrs,
                             std::chrono::steady_clock::time_point start_time)
 {
+  if (noop_) {
+    return;
+  }
+  if (logging_meter_) {
+    // the logging meter aggregates by service and operation, the other attributes are not used
+    logging_meter_->operation_recorder(attrs.service, attrs.operation)
+      .record_value(std::chrono::duration_cast<std::chrono::microseconds>(
+                      std::chrono::steady_clock::now() - start_time)
+                      .count());
+    return;
+  }
+
   auto [cluster_name, cluster_uuid] = cluster_label_listener_->cluster_labels();
   if (cluster_name) {
     attrs.internal.cluster_name = cluster_name;
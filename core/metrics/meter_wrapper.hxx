@@ -33,6 +33,8 @@
 
 namespace couchbase::core::metrics
 {
+class logging_meter;
+
 struct metric_attributes {
   std::string service;
   std::string operation;
@@ -71,5 +73,8 @@ public:
 private:
   std::shared_ptr<couchbase::metrics::meter> meter_;
   std::shared_ptr<cluster_label_listener> cluster_label_listener_;
+  // set when the wrapped meter is the built-in one, which only needs the service and operation
+  std::shared_ptr<logging_meter> logging_meter_{};
+  bool noop_{ false };
 };
 } // namespace couchbase::core::metrics
@@ -20,21 +20,40 @@
 #include "core/logger/logger.hxx"
 #include "core/utils/duration_parser.hxx"
 #include "core/utils/json.hxx"
+#include "core/utils/json_streaming_writer.hxx"
 
 #include <couchbase/error_codes.hxx>
 
 #include <gsl/assert>
 #include <tao/json/value.hpp>
 
+#include <string>
+#include <string_view>
+
 namespace couchbase::core::operations
 {
 auto
 analytics_request::encode_to(analytics_request::encoded_request_type& encoded,
                              http_context& context) -> std::error_code
 {
-  tao::json::value body{ { "statement", statement },
-                         { "client_context_id", encoded.client_context_id },
-                         { "timeout", fmt::format("{}ms", encoded.timeout.count()) } };
+  encoded.body.clear();
+  encoded.body.reserve(statement.size() + 256);
+  utils::json::streaming_writer body{ encoded.body };
+  body.begin_object();
+  std::size_t statement_begin{ 0 };
+  std::size_t statement_end{ 0 };
+  if (!utils::json::has_member(raw, "statement")) {
+    body.key("statement");
+    statement_begin = body.size();
+    body.value(statement);
+    statement_end = body.size();
+  }
+  if (!utils::json::has_member(raw, "client_context_id")) {
+    body.member("client_context_id", encoded.client_context_id);
+  }
+  if (!utils::json::has_member(raw, "timeout")) {
+    body.member("timeout", fmt::format("{}ms", encoded.timeout.count()));
+  }
 
   for (const auto& [name, value] : named_parameters) {
     Expects(name.empty() == false);
@@ -42,37 +61,45 @@ analytics_request::encode_to(analytics_request::encoded_request_type& encoded,
     if (key[0] != '$') {
       key.insert(key.begin(), '$');
     }
-    body[key] = utils::json::parse(value);
+    if (!utils::json::has_member(raw, key)) {
+      body.key(key);
+      body.raw_value(value);
+    }
   }
-  if (!positional_parameters.empty()) {
-    std::vector<tao::json::value> parameters;
-    parameters.reserve(positional_parameters.size());
+  if (!positional_parameters.empty() && !utils::json::has_member(raw, "args")) {
+    body.key("args");
+    body.begin_array();
     for (const auto& value : positional_parameters) {
-      parameters.emplace_back(utils::json::parse(value));
+      body.raw_value(value);
     }
-    body["args"] = std::move(parameters);
+    body.end_array();
   }
-  if (readonly) {
-    body["readonly"] = true;
+  if (readonly && !utils::json::has_member(raw, "readonly")) {
+    body.member("readonly", true);
   }
-  if (scan_consistency) {
+  if (scan_consistency && !utils::json::has_member(raw, "scan_consistency")) {
     switch (scan_consistency.value()) {
       case couchbase::core::analytics_scan_consistency::not_bounded:
-        body["scan_consistency"] = "not_bounded";
+        body.member("scan_consistency", "not_bounded");
         break;
       case couchbase::core::analytics_scan_consistency::request_plus:
-        body["scan_consistency"] = "request_plus";
+        body.member("scan_consistency", "request_plus");
         break;
     }
   }
-  if (scope_qualifier) {
-    body["query_context"] = scope_qualifier;
-  } else if (scope_name && bucket_name) {
-    body["query_context"] = fmt::format("default:`{}`.`{}`", *bucket_name, *scope_name);
+  if (!utils::json::has_member(raw, "query_context")) {
+    if (scope_qualifier) {
+      body.member("query_context", scope_qualifier.value());
+    } else if (scope_name && bucket_name) {
+      body.member("query_context", fmt::format("default:`{}`.`{}`", *bucket_name, *scope_name));
+    }
   }
   for (const auto& [name, value] : raw) {
-    body[name] = utils::json::parse(value);
+    body.key(name);
+    body.raw_value(value);
   }
+  body.end_object();
+
   encoded.type = type;
   encoded.headers["content-type"] = "application/json";
   if (priority) {
@@ -80,22 +107,28 @@ analytics_request::encode_to(analytics_request::encoded_request_type& encoded,
   }
   encoded.method = "POST";
   encoded.path = "/query/service";
-  body_str = utils::json::generate(body);
-  encoded.body = body_str;
-  if (context.options.show_queries) {
-    CB_LOG_INFO("ANALYTICS: client_context_id=\"{}\", {}",
-                encoded.client_context_id,
-                utils::json::generate(body["statement"]));
-  } else {
-    CB_LOG_DEBUG("ANALYTICS: client_context_id=\"{}\", {}",
-                 encoded.client_context_id,
-                 utils::json::generate(body["statement"]));
+  // the error context of the response reports the body
+  body_str = encoded.body;
+  if (context.options.show_queries || logger::should_log(logger::level::debug)) {
+    // the statement is logged from the body, unless it has been overridden by the raw options
+    auto stmt = std::string_view{ encoded.body }.substr(statement_begin,
+                                                        statement_end - statement_begin);
+    std::string encoded_statement{};
+    if (stmt.empty()) {
+      utils::json::streaming_writer{ encoded_statement }.value(statement);
+      stmt = encoded_statement;
+    }
+    if (context.options.show_queries) {
+      CB_LOG_INFO("ANALYTICS: client_context_id=\"{}\", {}", encoded.client_context_id, stmt);
+    } else {
+      CB_LOG_DEBUG("ANALYTICS: client_context_id=\"{}\", {}", encoded.client_context_id, stmt);
+    }
   }
   if (row_callback) {
     encoded.streaming.emplace(couchbase::core::io::streaming_settings{
       "/results/^",
       4,
-      std::move(row_callback.value()),
+      row_callback.value(),
     });
   }
   return {};
@@ -18,6 +18,7 @@
 #include "document_get_projected.hxx"
 
 #include "core/impl/subdoc/command_bundle.hxx"
+#include "core/utils/binary.hxx"
 #include "core/utils/json.hxx"
 
 #include <couchbase/error_codes.hxx>
@@ -142,6 +143,37 @@ subdoc_apply_projection(tao::json::value& root,
     offset = idx + 1;
   }
 }
+
+/**
+ * Builds the projected document from the values of the projections, that start at the offset.
+ */
+auto
+project_fields(const std::vector<std::string>& projections,
+               const std::vector<protocol::lookup_in_response_body::lookup_in_field>& fields,
+               std::size_t offset,
+               bool preserve_array_indexes,
+               std::vector<std::byte>& projected_document) -> std::error_code
+{
+  tao::json::value new_doc = tao::json::empty_object;
+  for (const auto& projection : projections) {
+    const auto& field = fields[offset];
+    ++offset;
+    if (field.status == key_value_status_code::success && !field.value.empty()) {
+      tao::json::value value_to_apply{};
+      try {
+        value_to_apply = utils::json::parse(field.value);
+      } catch (const tao::pegtl::parse_error&) {
+        return errc::common::parsing_failure;
+      }
+      subdoc_apply_projection(new_doc, projection, value_to_apply, preserve_array_indexes);
+    } else if (field.status != key_value_status_code::subdoc_path_not_found) {
+      return protocol::map_status_code(protocol::client_opcode::subdoc_multi_lookup,
+                                       static_cast<std::uint16_t>(field.status));
+    }
+  }
+  projected_document = utils::json::generate_binary(new_doc);
+  return {};
+}
 } // namespace
 
 auto
@@ -158,8 +190,8 @@ get_projected_request::encode_to(get_projected_request::encoded_request_type& en
   if (with_expiry) {
     num_projections++;
   }
-  if (num_projections > 16) {
-    // too many subdoc operations, better fetch full document
+  if (num_projections > max_lookup_specs) {
+    // too many subdoc operations, better fetch full document (see also execute())
     effective_projections.clear();
   }
 
@@ -220,30 +252,86 @@ get_projected_request::make_response(key_value_error_context&& ctx,
         }
         response.value = utils::json::generate_binary(new_doc);
       }
-    } else {
-      tao::json::value new_doc = tao::json::empty_object;
-      std::size_t offset = with_expiry ? 2 : 1;
-      for (const auto& projection : projections) {
-        const auto& field = encoded.body().fields()[offset];
-        ++offset;
-        if (field.status == key_value_status_code::success && !field.value.empty()) {
-          tao::json::value value_to_apply{};
-          try {
-            value_to_apply = utils::json::parse(field.value);
-          } catch (const tao::pegtl::parse_error&) {
-            response.ctx.override_ec(errc::common::parsing_failure);
-            return response;
-          }
-          subdoc_apply_projection(new_doc, projection, value_to_apply, preserve_array_indexes);
-        } else if (field.status != key_value_status_code::subdoc_path_not_found) {
-          response.ctx.override_ec(
-            protocol::map_status_code(protocol::client_opcode::subdoc_multi_lookup,
-                                      static_cast<std::uint16_t>(field.status)));
-          return response;
-        }
+    } else if (auto ec = project_fields(projections,
+                                        encoded.body().fields(),
+                                        with_expiry ? 2 : 1,
+                                        preserve_array_indexes,
+                                        response.value);
+               ec) {
+      response.ctx.override_ec(ec);
+    }
+  }
+  return response;
+}
+
+auto
+get_projected_request::requires_split() const -> bool
+{
+  return projections.size() + (with_expiry ? 2 : 1) > max_lookup_specs;
+}
+
+auto
+get_projected_request::split_lookups() const -> std::vector<lookup_in_request>
+{
+  std::vector<lookup_in_request> lookups{};
+  auto path = projections.begin();
+  while (path != projections.end()) {
+    couchbase::lookup_in_specs specs{};
+    if (lookups.empty()) {
+      specs.push_back(couchbase::lookup_in_specs::get(subdoc::lookup_in_macro::flags).xattr());
+      if (with_expiry) {
+        specs.push_back(
+          couchbase::lookup_in_specs::get(subdoc::lookup_in_macro::expiry_time).xattr());
       }
-      response.value = utils::json::generate_binary(new_doc);
     }
+    for (auto size = specs.specs().size(); size < max_lookup_specs && path != projections.end();
+         ++size, ++path) {
+      specs.push_back(couchbase::lookup_in_specs::get(*path));
+    }
+    lookups.emplace_back(lookup_in_request{
+      id,
+      {},
+      {},
+      false,
+      specs.specs(),
+      timeout,
+      { retries.strategy() },
+      parent_span,
+    });
+  }
+  return lookups;
+}
+
+auto
+get_projected_request::merge_lookups(const std::vector<lookup_in_response>& responses) const
+  -> std::optional<get_projected_response>
+{
+  for (const auto& lookup : responses) {
+    if (lookup.ctx.ec()) {
+      return get_projected_response{ lookup.ctx };
+    }
+    if (lookup.cas != responses.front().cas) {
+      return {};
+    }
+  }
+
+  std::vector<protocol::lookup_in_response_body::lookup_in_field> fields{};
+  for (const auto& lookup : responses) {
+    for (const auto& entry : lookup.fields) {
+      fields.push_back({ entry.status, utils::to_string(entry.value) });
+    }
+  }
+
+  get_projected_response response{ responses.front().ctx };
+  response.cas = responses.front().cas;
+  response.flags = gsl::narrow_cast<std::uint32_t>(std::stoul(fields[0].value));
+  if (with_expiry && !fields[1].value.empty()) {
+    response.expiry = gsl::narrow_cast<std::uint32_t>(std::stoul(fields[1].value));
+  }
+  if (auto ec = project_fields(
+        projections, fields, with_expiry ? 2 : 1, preserve_array_indexes, response.value);
+      ec) {
+    response.ctx.override_ec(ec);
   }
   return response;
 }
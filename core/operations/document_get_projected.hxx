@@ -21,10 +21,21 @@
 #include "core/io/mcbp_context.hxx"
 #include "core/io/mcbp_traits.hxx"
 #include "core/io/retry_context.hxx"
+#include "core/operations/document_lookup_in.hxx"
 #include "core/protocol/client_request.hxx"
 #include "core/protocol/cmd_lookup_in.hxx"
 #include "core/public_fwd.hxx"
 #include "core/timeout_defaults.hxx"
+#include "core/utils/movable_function.hxx"
+
+#include <couchbase/error_codes.hxx>
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 namespace couchbase::core::operations
 {
@@ -44,6 +55,11 @@ struct get_projected_request {
 
   static const inline std::string observability_identifier = "get";
 
+  /**
+   * The server does not allow more paths in the single sub-document lookup.
+   */
+  static constexpr std::size_t max_lookup_specs{ 16 };
+
   document_id id;
   std::uint16_t partition{};
   std::uint32_t opaque{};
@@ -61,5 +77,82 @@ struct get_projected_request {
   [[nodiscard]] auto make_response(key_value_error_context&& ctx,
                                    const encoded_response_type& encoded) const
     -> get_projected_response;
+
+  /**
+   * @return true if the projections along with flags and expiry do not fit into the single
+   * lookup, and have to be fetched with execute().
+   */
+  [[nodiscard]] auto requires_split() const -> bool;
+
+  /**
+   * Splits the projections into lookups of at most max_lookup_specs paths. The first lookup also
+   * fetches flags and expiry of the document. The lookups inherit timeout and retry strategy of
+   * the request.
+   */
+  [[nodiscard]] auto split_lookups() const -> std::vector<lookup_in_request>;
+
+  /**
+   * Builds projected document from the responses to the lookups returned by split_lookups().
+   *
+   * @return empty optional if the document has been modified between the lookups.
+   */
+  [[nodiscard]] auto merge_lookups(const std::vector<lookup_in_response>& responses) const
+    -> std::optional<get_projected_response>;
+
+  /**
+   * Fetches the projections, that do not fit into the single lookup, with several lookups instead
+   * of the full document. All lookups are sent at once to the same vBucket, so they are pipelined
+   * over the same connection. If the document has been modified in the meantime, the projection
+   * is built from the full document, which is given only the time that is left of the timeout.
+   */
+  template<typename Core, typename Handler>
+  void execute(Core core, Handler handler)
+  {
+    using handler_type = utils::movable_function<void(response_type)>;
+
+    struct split_context {
+      split_context(get_projected_request request, handler_type&& handler, std::size_t lookups)
+        : request_{ std::move(request) }
+        , handler_{ std::move(handler) }
+        , responses_(lookups)
+        , expected_responses_{ lookups }
+      {
+      }
+
+      get_projected_request request_;
+      handler_type handler_;
+      std::vector<lookup_in_response> responses_;
+      std::size_t expected_responses_;
+      std::mutex mutex_{};
+      std::chrono::steady_clock::time_point started_{ std::chrono::steady_clock::now() };
+    };
+
+    auto lookups = split_lookups();
+    auto ctx = std::make_shared<split_context>(*this, std::move(handler), lookups.size());
+    for (std::size_t i = 0; i < lookups.size(); ++i) {
+      core->execute(std::move(lookups[i]), [core, ctx, i](lookup_in_response&& resp) mutable {
+        {
+          const std::scoped_lock lock(ctx->mutex_);
+          ctx->responses_[i] = std::move(resp);
+          if (--ctx->expected_responses_ > 0) {
+            return;
+          }
+        }
+        if (auto response = ctx->request_.merge_lookups(ctx->responses_); response) {
+          return ctx->handler_(std::move(response.value()));
+        }
+        if (ctx->request_.timeout) {
+          const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - ctx->started_);
+          if (elapsed >= ctx->request_.timeout.value()) {
+            return ctx->handler_(get_projected_response{ make_key_value_error_context(
+              errc::common::unambiguous_timeout, ctx->request_.id) });
+          }
+          ctx->request_.timeout = ctx->request_.timeout.value() - elapsed;
+        }
+        return core->execute(std::move(ctx->request_), std::move(ctx->handler_));
+      });
+    }
+  }
 };
 } // namespace couchbase::core::operations
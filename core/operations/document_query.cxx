@@ -22,36 +22,95 @@
 #include "core/operations/management/error_utils.hxx"
 #include "core/utils/duration_parser.hxx"
 #include "core/utils/json.hxx"
+#include "core/utils/json_streaming_lexer.hxx"
+#include "core/utils/json_streaming_writer.hxx"
 
 #include <couchbase/error_codes.hxx>
 
 #include <gsl/assert>
 #include <tao/json/value.hpp>
 
+#include <map>
+#include <optional>
 #include <regex>
+#include <string_view>
 
 namespace couchbase::core::operations
 {
+namespace
+{
+/**
+ * Splits the response body into rows and metadata without building a DOM for the whole payload.
+ *
+ * The lexer copies every row into its own string, and returns the metadata (everything except the
+ * rows) as a separate, small JSON object, that is the only part that needs a full parse. The body
+ * is fed to the lexer in chunks, so that it only buffers the part of the body it has not consumed
+ * yet, instead of a copy of the whole payload.
+ */
+auto
+split_rows_and_metadata(std::string_view body,
+                        std::vector<std::string>& rows,
+                        std::string& meta) -> std::error_code
+{
+  static constexpr std::size_t chunk_size{ 64 * 1024 };
+
+  utils::json::streaming_lexer lexer("/results/^", 4);
+  lexer.on_row([&rows](std::string&& row) {
+    rows.emplace_back(std::move(row));
+    return utils::json::stream_control::next_row;
+  });
+  bool complete{ false };
+  std::error_code error{};
+  lexer.on_complete([&complete, &error, &meta](
+                      std::error_code ec, std::size_t /* number_of_rows */, std::string&& trailer) {
+    complete = true;
+    error = ec;
+    meta = std::move(trailer);
+  });
+  for (std::size_t offset = 0; offset < body.size() && !complete; offset += chunk_size) {
+    lexer.feed(body.substr(offset, chunk_size));
+  }
+  if (error) {
+    return error;
+  }
+  if (!complete) {
+    // the root object has not been closed, or it was not an object at all
+    return errc::common::parsing_failure;
+  }
+  return {};
+}
+} // namespace
+
 auto
 query_request::encode_to(query_request::encoded_request_type& encoded,
                          http_context& context) -> std::error_code
 {
   ctx_.emplace(context);
-  tao::json::value body{
-    { "client_context_id", encoded.client_context_id },
-  };
+  encoded.body.clear();
+  encoded.body.reserve(statement.size() + 512);
+  utils::json::streaming_writer body{ encoded.body };
+  // statement and prepared name are written last, so that the rest of the body could be logged
+  // as options without them
+  std::optional<std::string> statement_to_write{};
+  std::optional<std::string> prepared_to_write{};
+  body.begin_object();
+  if (!utils::json::has_member(raw, "client_context_id")) {
+    body.member("client_context_id", encoded.client_context_id);
+  }
   if (adhoc) {
-    body["statement"] = statement;
+    statement_to_write = statement;
   } else {
     if (auto entry = ctx_->cache.get(statement)) {
-      body["prepared"] = entry->name;
-      if (entry->plan) {
-        body["encoded_plan"] = entry->plan.value();
+      prepared_to_write = entry->name;
+      if (entry->plan && !utils::json::has_member(raw, "encoded_plan")) {
+        body.member("encoded_plan", entry->plan.value());
       }
     } else {
-      body["statement"] = "PREPARE " + statement;
+      statement_to_write = "PREPARE " + statement;
       if (context.config.capabilities.supports_enhanced_prepared_statements()) {
-        body["auto_execute"] = true;
+        if (!utils::json::has_member(raw, "auto_execute")) {
+          body.member("auto_execute", true);
+        }
       } else {
         extract_encoded_plan_ = true;
       }
@@ -63,7 +122,9 @@ query_request::encode_to(query_request::encoded_request_type& encoded,
      * sure we will always get response */
     timeout_for_service -= std::chrono::milliseconds(500);
   }
-  body["timeout"] = fmt::format("{}ms", timeout_for_service.count());
+  if (!utils::json::has_member(raw, "timeout")) {
+    body.member("timeout", fmt::format("{}ms", timeout_for_service.count()));
+  }
 
   for (const auto& [name, value] : named_parameters) {
     Expects(name.empty() == false);
@@ -71,138 +132,179 @@ query_request::encode_to(query_request::encoded_request_type& encoded,
     if (key[0] != '$') {
       key.insert(key.begin(), '$');
     }
-    body[key] = utils::json::parse(value);
+    if (!utils::json::has_member(raw, key)) {
+      body.key(key);
+      body.raw_value(value);
+    }
   }
-  if (!positional_parameters.empty()) {
-    std::vector<tao::json::value> parameters;
-    parameters.reserve(positional_parameters.size());
+  if (!positional_parameters.empty() && !utils::json::has_member(raw, "args")) {
+    body.key("args");
+    body.begin_array();
     for (const auto& value : positional_parameters) {
-      parameters.emplace_back(utils::json::parse(value));
+      body.raw_value(value);
     }
-    body["args"] = std::move(parameters);
+    body.end_array();
   }
-  if (profile.has_value()) {
+  if (profile.has_value() && !utils::json::has_member(raw, "profile")) {
     switch (profile.value()) {
       case couchbase::query_profile::phases:
-        body["profile"] = "phases";
+        body.member("profile", "phases");
         break;
       case couchbase::query_profile::timings:
-        body["profile"] = "timings";
+        body.member("profile", "timings");
         break;
       case couchbase::query_profile::off:
-        body["profile"] = "off";
+        body.member("profile", "off");
         break;
     }
   }
   if (use_replica.has_value()) {
     if (context.config.capabilities.supports_read_from_replica()) {
-      if (use_replica.value()) {
-        body["use_replica"] = "on";
-      } else {
-        body["use_replica"] = "off";
+      if (!utils::json::has_member(raw, "use_replica")) {
+        body.member("use_replica", use_replica.value() ? "on" : "off");
       }
     } else {
       return errc::common::feature_not_available;
     }
   }
-  if (max_parallelism) {
-    body["max_parallelism"] = std::to_string(max_parallelism.value());
+  if (max_parallelism && !utils::json::has_member(raw, "max_parallelism")) {
+    body.member("max_parallelism", std::to_string(max_parallelism.value()));
   }
-  if (pipeline_cap) {
-    body["pipeline_cap"] = std::to_string(pipeline_cap.value());
+  if (pipeline_cap && !utils::json::has_member(raw, "pipeline_cap")) {
+    body.member("pipeline_cap", std::to_string(pipeline_cap.value()));
   }
-  if (pipeline_batch) {
-    body["pipeline_batch"] = std::to_string(pipeline_batch.value());
+  if (pipeline_batch && !utils::json::has_member(raw, "pipeline_batch")) {
+    body.member("pipeline_batch", std::to_string(pipeline_batch.value()));
   }
-  if (scan_cap) {
-    body["scan_cap"] = std::to_string(scan_cap.value());
+  if (scan_cap && !utils::json::has_member(raw, "scan_cap")) {
+    body.member("scan_cap", std::to_string(scan_cap.value()));
   }
-  if (!metrics) {
-    body["metrics"] = false;
+  if (!metrics && !utils::json::has_member(raw, "metrics")) {
+    body.member("metrics", false);
   }
-  if (readonly) {
-    body["readonly"] = true;
+  if (readonly && !utils::json::has_member(raw, "readonly")) {
+    body.member("readonly", true);
   }
-  if (flex_index) {
-    body["use_fts"] = true;
+  if (flex_index && !utils::json::has_member(raw, "use_fts")) {
+    body.member("use_fts", true);
   }
-  if (preserve_expiry) {
-    body["preserve_expiry"] = true;
+  if (preserve_expiry && !utils::json::has_member(raw, "preserve_expiry")) {
+    body.member("preserve_expiry", true);
   }
   bool check_scan_wait = false;
+  std::string_view consistency_level{};
   if (scan_consistency) {
     switch (scan_consistency.value()) {
       case query_scan_consistency::not_bounded:
-        body["scan_consistency"] = "not_bounded";
+        consistency_level = "not_bounded";
         break;
       case query_scan_consistency::request_plus:
         check_scan_wait = true;
-        body["scan_consistency"] = "request_plus";
+        consistency_level = "request_plus";
         break;
     }
   } else if (!mutation_state.empty()) {
     check_scan_wait = true;
-    body["scan_consistency"] = "at_plus";
-    tao::json::value scan_vectors = tao::json::empty_object;
-    for (const auto& token : mutation_state) {
-      auto* bucket = scan_vectors.find(token.bucket_name());
-      if (bucket == nullptr) {
-        scan_vectors[token.bucket_name()] = tao::json::empty_object;
-        bucket = scan_vectors.find(token.bucket_name());
+    consistency_level = "at_plus";
+    if (!utils::json::has_member(raw, "scan_vectors")) {
+      // the latest token for the partition wins
+      std::map<std::string, std::map<std::uint16_t, const mutation_token*>> scan_vectors{};
+      for (const auto& token : mutation_state) {
+        scan_vectors[token.bucket_name()][token.partition_id()] = &token;
+      }
+      body.key("scan_vectors");
+      body.begin_object();
+      for (const auto& [bucket_name, partitions] : scan_vectors) {
+        body.key(bucket_name);
+        body.begin_object();
+        for (const auto& [partition_id, token] : partitions) {
+          body.key(std::to_string(partition_id));
+          body.begin_array();
+          body.value(token->sequence_number());
+          body.value(std::to_string(token->partition_uuid()));
+          body.end_array();
+        }
+        body.end_object();
       }
-      auto& bucket_obj = bucket->get_object();
-      bucket_obj[std::to_string(token.partition_id())] =
-        std::vector<tao::json::value>{ token.sequence_number(),
-                                       std::to_string(token.partition_uuid()) };
+      body.end_object();
     }
-    body["scan_vectors"] = scan_vectors;
   }
-  if (check_scan_wait && scan_wait) {
-    body["scan_wait"] = fmt::format("{}ms", scan_wait.value().count());
+  if (!consistency_level.empty() && !utils::json::has_member(raw, "scan_consistency")) {
+    body.member("scan_consistency", consistency_level);
+  }
+  if (check_scan_wait && scan_wait && !utils::json::has_member(raw, "scan_wait")) {
+    body.member("scan_wait", fmt::format("{}ms", scan_wait.value().count()));
   }
 
-  if (query_context) {
-    body["query_context"] = query_context.value();
+  if (query_context && !utils::json::has_member(raw, "query_context")) {
+    body.member("query_context", query_context.value());
   }
   for (const auto& [name, value] : raw) {
-    body[name] = utils::json::parse(value);
+    body.key(name);
+    body.raw_value(value);
+  }
+
+  // everything before the statement is logged as options
+  const auto options_end = body.size();
+  std::size_t prepared_begin{ 0 };
+  std::size_t prepared_end{ 0 };
+  if (prepared_to_write && !utils::json::has_member(raw, "prepared")) {
+    body.key("prepared");
+    prepared_begin = body.size();
+    body.value(prepared_to_write.value());
+    prepared_end = body.size();
+  }
+  std::size_t statement_begin{ 0 };
+  std::size_t statement_end{ 0 };
+  if (statement_to_write && !utils::json::has_member(raw, "statement")) {
+    body.key("statement");
+    statement_begin = body.size();
+    body.value(statement_to_write.value());
+    statement_end = body.size();
   }
+  body.end_object();
+
   encoded.type = type;
   encoded.headers["connection"] = "keep-alive";
   encoded.headers["content-type"] = "application/json";
   encoded.method = "POST";
   encoded.path = "/query/service";
-  body_str = utils::json::generate(body);
-  encoded.body = body_str;
+  // the error context of the response reports the body
+  body_str = encoded.body;
 
-  tao::json::value stmt = body["statement"];
-  tao::json::value prep = body["prepared"];
-  if (!stmt.is_string()) {
-    stmt = statement;
-  }
-  if (!prep.is_string()) {
-    prep = false;
-  }
-  body.erase("statement");
-  body.erase("prepared");
-  if (ctx_->options.show_queries) {
-    CB_LOG_INFO("QUERY: client_context_id=\"{}\", prep={}, {}, options={}",
-                encoded.client_context_id,
-                utils::json::generate(prep),
-                utils::json::generate(stmt),
-                utils::json::generate(body));
-  } else {
-    CB_LOG_DEBUG("QUERY: client_context_id=\"{}\", prep={}, {}, options={}",
-                 encoded.client_context_id,
-                 utils::json::generate(prep),
-                 utils::json::generate(stmt),
-                 utils::json::generate(body));
+  if (ctx_->options.show_queries || logger::should_log(logger::level::debug)) {
+    // the message refers to the parts of the body that have been written above
+    const std::string_view written{ encoded.body };
+    const auto prep = prepared_end > prepared_begin
+                        ? written.substr(prepared_begin, prepared_end - prepared_begin)
+                        : std::string_view{ "false" };
+    auto stmt = written.substr(statement_begin, statement_end - statement_begin);
+    std::string encoded_statement{};
+    if (stmt.empty()) {
+      utils::json::streaming_writer{ encoded_statement }.value(statement);
+      stmt = encoded_statement;
+    }
+    const auto options = written.substr(0, options_end);
+    if (ctx_->options.show_queries) {
+      CB_LOG_INFO("QUERY: client_context_id=\"{}\", prep={}, {}, options={}}}",
+                  encoded.client_context_id,
+                  prep,
+                  stmt,
+                  options);
+    } else {
+      CB_LOG_DEBUG("QUERY: client_context_id=\"{}\", prep={}, {}, options={}}}",
+                   encoded.client_context_id,
+                   prep,
+                   stmt,
+                   options);
+    }
   }
   if (row_callback) {
     encoded.streaming.emplace(couchbase::core::io::streaming_settings{
       "/results/^",
       4,
-      std::move(row_callback.value()),
+      row_callback.value(),
+      flow_control,
     });
   }
   return {};
@@ -230,9 +332,15 @@ query_request::make_response(error_context::query&& ctx,
       }
       return response;
     }
+    std::string meta;
+    if (auto ec = split_rows_and_metadata(encoded.body.data(), response.rows, meta); ec) {
+      CB_LOG_DEBUG("unable to split query response into rows and metadata: {}", ec.message());
+      response.ctx.ec = errc::common::parsing_failure;
+      return response;
+    }
     tao::json::value payload;
     try {
-      payload = utils::json::parse(encoded.body.data());
+      payload = utils::json::parse(meta);
     } catch (const tao::pegtl::parse_error&) {
       response.ctx.ec = errc::common::parsing_failure;
       return response;
@@ -302,13 +410,6 @@ query_request::make_response(error_context::query&& ctx,
       response.meta.warnings.emplace(problems);
     }
 
-    if (const auto* r = payload.find("results"); r != nullptr) {
-      response.rows.reserve(r->get_array().size());
-      for (const auto& row : r->get_array()) {
-        response.rows.emplace_back(couchbase::core::utils::json::generate(row));
-      }
-    }
-
     if (response.meta.status == "success") {
       if (response.prepared) {
         if (ctx_.has_value()) {
@@ -108,6 +108,7 @@ struct query_request {
   std::vector<couchbase::core::json_string> positional_parameters{};
   std::map<std::string, couchbase::core::json_string, std::less<>> named_parameters{};
   std::optional<std::function<utils::json::stream_control(std::string)>> row_callback{};
+  std::shared_ptr<io::stream_flow_control> flow_control{};
   std::optional<std::string> send_to_node{};
 
   [[nodiscard]] auto encode_to(encoded_request_type& encoded,
@@ -20,109 +20,157 @@
 #include "core/cluster_options.hxx"
 #include "core/logger/logger.hxx"
 #include "core/utils/json.hxx"
+#include "core/utils/json_streaming_writer.hxx"
 
 #include <couchbase/error_codes.hxx>
 
 #include <tao/json/contrib/traits.hpp>
 
+#include <algorithm>
+#include <map>
+
 namespace couchbase::core::operations
 {
 auto
 search_request::encode_to(search_request::encoded_request_type& encoded,
                           http_context& context) -> std::error_code
 {
-  auto body = tao::json::value{
-    { "query", utils::json::parse(query) },
-    { "ctl", { { "timeout", encoded.timeout.count() } } },
-  };
+  encoded.body.clear();
+  encoded.body.reserve(query.str().size() + query.bytes().size() + 512);
+  utils::json::streaming_writer body{ encoded.body };
+  body.begin_object();
+  if (!utils::json::has_member(raw, "query")) {
+    body.key("query");
+    body.raw_value(query);
+  }
+  if (!utils::json::has_member(raw, "ctl")) {
+    body.key("ctl");
+    body.begin_object();
+    body.member("timeout", encoded.timeout.count());
+    if (!mutation_state.empty()) {
+      // the highest sequence number for the partition wins
+      std::map<std::string, std::uint64_t> scan_vectors{};
+      for (const auto& token : mutation_state) {
+        auto& sequence_number =
+          scan_vectors[fmt::format("{}/{}", token.partition_id(), token.partition_uuid())];
+        sequence_number = std::max(sequence_number, token.sequence_number());
+      }
+      body.key("consistency");
+      body.begin_object();
+      body.member("level", "at_plus");
+      body.key("vectors");
+      body.begin_object();
+      body.key(index_name);
+      body.begin_object();
+      for (const auto& [key, sequence_number] : scan_vectors) {
+        body.member(key, sequence_number);
+      }
+      body.end_object();
+      body.end_object();
+      body.end_object();
+    }
+    body.end_object();
+  }
 
-  if (show_request.has_value()) {
-    body["showrequest"] = show_request.value();
+  if (show_request.has_value() && !utils::json::has_member(raw, "showrequest")) {
+    body.member("showrequest", show_request.value());
   }
 
   if (vector_search.has_value()) {
-    body["knn"] = utils::json::parse(vector_search.value());
-    if (vector_query_combination.has_value()) {
+    if (!utils::json::has_member(raw, "knn")) {
+      body.key("knn");
+      body.raw_value(vector_search.value());
+    }
+    if (vector_query_combination.has_value() && !utils::json::has_member(raw, "knn_operator")) {
       switch (*vector_query_combination) {
         case couchbase::core::vector_query_combination::combination_or:
-          body["knn_operator"] = "or";
+          body.member("knn_operator", "or");
           break;
         case couchbase::core::vector_query_combination::combination_and:
-          body["knn_operator"] = "and";
+          body.member("knn_operator", "and");
           break;
       }
     }
   }
 
-  if (explain) {
-    body["explain"] = *explain;
+  if (explain && !utils::json::has_member(raw, "explain")) {
+    body.member("explain", *explain);
   }
-  if (limit) {
-    body["size"] = *limit;
+  if (limit && !utils::json::has_member(raw, "size")) {
+    body.member("size", *limit);
   }
-  if (skip) {
-    body["from"] = *skip;
+  if (skip && !utils::json::has_member(raw, "from")) {
+    body.member("from", *skip);
   }
-  if (disable_scoring) {
-    body["score"] = "none";
+  if (disable_scoring && !utils::json::has_member(raw, "score")) {
+    body.member("score", "none");
   }
-  if (include_locations) {
-    body["includeLocations"] = true;
+  if (include_locations && !utils::json::has_member(raw, "includeLocations")) {
+    body.member("includeLocations", true);
   }
-  if (highlight_style || !highlight_fields.empty()) {
-    tao::json::value highlight;
+  if ((highlight_style || !highlight_fields.empty()) &&
+      !utils::json::has_member(raw, "highlight")) {
+    body.key("highlight");
+    body.begin_object();
     if (highlight_style) {
       switch (*highlight_style) {
         case couchbase::core::search_highlight_style::html:
-          highlight["style"] = "html";
+          body.member("style", "html");
           break;
         case couchbase::core::search_highlight_style::ansi:
-          highlight["style"] = "ansi";
+          body.member("style", "ansi");
           break;
       }
     }
     if (!highlight_fields.empty()) {
-      highlight["fields"] = highlight_fields;
+      body.key("fields");
+      body.begin_array();
+      for (const auto& field : highlight_fields) {
+        body.value(field);
+      }
+      body.end_array();
     }
-    body["highlight"] = highlight;
+    body.end_object();
   }
-  if (!fields.empty()) {
-    body["fields"] = fields;
+  if (!fields.empty() && !utils::json::has_member(raw, "fields")) {
+    body.key("fields");
+    body.begin_array();
+    for (const auto& field : fields) {
+      body.value(field);
+    }
+    body.end_array();
   }
-  if (!sort_specs.empty()) {
-    body["sort"] = tao::json::empty_array;
+  if (!sort_specs.empty() && !utils::json::has_member(raw, "sort")) {
+    body.key("sort");
+    body.begin_array();
     for (const auto& spec : sort_specs) {
-      body["sort"].get_array().push_back(utils::json::parse(spec));
+      body.raw_value(spec);
     }
+    body.end_array();
   }
-  if (!facets.empty()) {
-    body["facets"] = tao::json::empty_object;
+  if (!facets.empty() && !utils::json::has_member(raw, "facets")) {
+    body.key("facets");
+    body.begin_object();
     for (const auto& [name, facet] : facets) {
-      body["facets"][name] = utils::json::parse(facet);
+      body.key(name);
+      body.raw_value(facet);
     }
+    body.end_object();
   }
-  if (!mutation_state.empty()) {
-    tao::json::value scan_vectors = tao::json::empty_object;
-    for (const auto& token : mutation_state) {
-      auto key = fmt::format("{}/{}", token.partition_id(), token.partition_uuid());
-      const auto* old_val = scan_vectors.find(key);
-      if (old_val == nullptr ||
-          (old_val->is_integer() && old_val->get_unsigned() < token.sequence_number())) {
-        scan_vectors[key] = token.sequence_number();
-      }
+  if (!collections.empty() && !utils::json::has_member(raw, "collections")) {
+    body.key("collections");
+    body.begin_array();
+    for (const auto& collection : collections) {
+      body.value(collection);
     }
-    body["ctl"]["consistency"] = tao::json::value{
-      { "level", "at_plus" },
-      { "vectors", { { index_name, scan_vectors } } },
-    };
-  }
-  if (!collections.empty()) {
-    body["collections"] = collections;
+    body.end_array();
   }
 
   for (const auto& [key, value] : raw) {
-    body[key] = utils::json::parse(value);
+    body.key(key);
+    body.raw_value(value);
   }
+  body.end_object();
 
   if (bucket_name.has_value() && scope_name.has_value()) {
     encoded.path = fmt::format("/api/bucket/{}/scope/{}/index/{}/query",
@@ -136,18 +184,17 @@ search_request::encode_to(search_request::encoded_request_type& encoded,
   encoded.type = type;
   encoded.headers["content-type"] = "application/json";
   encoded.method = "POST";
-  body_str = utils::json::generate(body);
-  encoded.body = body_str;
+  body_str = encoded.body;
   if (context.options.show_queries || (log_request.has_value() && log_request.value())) {
-    CB_LOG_INFO("SEARCH: {}", utils::json::generate(body));
+    CB_LOG_INFO("SEARCH: {}", body_str);
   } else {
-    CB_LOG_DEBUG("SEARCH: {}", utils::json::generate(body));
+    CB_LOG_DEBUG("SEARCH: {}", body_str);
   }
   if (row_callback) {
     encoded.streaming.emplace(couchbase::core::io::streaming_settings{
       "/hits/^",
       4,
-      std::move(row_callback.value()),
+      row_callback.value(),
     });
   }
   return {};
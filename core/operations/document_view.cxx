@@ -137,7 +137,7 @@ document_view_request::encode_to(document_view_request::encoded_request_type& en
     encoded.streaming.emplace(couchbase::core::io::streaming_settings{
       "/rows/^",
       4,
-      std::move(row_callback.value()),
+      row_callback.value(),
     });
   }
   return {};
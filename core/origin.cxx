@@ -42,6 +42,15 @@ struct traits<std::chrono::milliseconds> {
   }
 };
 
+template<>
+struct traits<std::chrono::microseconds> {
+  template<template<typename...> class Traits>
+  static void assign(tao::json::basic_value<Traits>& v, const std::chrono::microseconds& o)
+  {
+    v = fmt::format("{}", o);
+  }
+};
+
 template<>
 struct traits<std::chrono::nanoseconds> {
   template<template<typename...> class Traits>
@@ -191,6 +200,7 @@ struct traits<couchbase::transactions::transactions_config::built> {
     v = {
       { "timeout", o.timeout },
       { "durability_level", o.level },
+      { "unstaging_window", o.unstaging_window },
       {
         "query_config",
         {
@@ -291,7 +301,12 @@ origin::to_json() const -> std::string
         { "tcp_keep_alive_interval", options_.tcp_keep_alive_interval },
         { "config_idle_redial_timeout", options_.config_idle_redial_timeout },
         { "max_http_connections", options_.max_http_connections },
+        { "min_http_connections_per_node", options_.min_http_connections_per_node },
         { "idle_http_connection_timeout", options_.idle_http_connection_timeout },
+        { "write_coalescing_threshold", options_.write_coalescing_threshold },
+        { "write_coalescing_delay", options_.write_coalescing_delay },
+        { "query_cache_max_entries", options_.query_cache_max_entries },
+        { "query_cache_max_bytes", options_.query_cache_max_bytes },
         { "metrics_options", options_.metrics_options },
         { "tracing_options", options_.tracing_options },
         { "orphan_reporter_options", options_.orphan_options },
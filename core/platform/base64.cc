@@ -34,6 +34,14 @@
 #include <string_view>
 #include <vector>
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define COUCHBASE_CXX_CLIENT_BASE64_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+#define COUCHBASE_CXX_CLIENT_BASE64_NEON 1
+#include <arm_neon.h>
+#endif
+
 namespace
 {
 /**
@@ -162,6 +170,102 @@ decode_quad(const char* s, std::vector<std::byte>& d) -> int
 
   return ret;
 }
+
+#if defined(COUCHBASE_CXX_CLIENT_BASE64_SSE2)
+/**
+ * Maps 6-bit values in every byte to the characters of the alphabet.
+ */
+auto
+to_alphabet(__m128i indexes) -> __m128i
+{
+  // 'A'..'Z' for 0..25, then shift to 'a'..'z', '0'..'9', '+' and '/' for the upper ranges
+  __m128i result = _mm_add_epi8(indexes, _mm_set1_epi8('A'));
+  result = _mm_add_epi8(
+    result, _mm_and_si128(_mm_cmpgt_epi8(indexes, _mm_set1_epi8(25)), _mm_set1_epi8(6)));
+  result = _mm_sub_epi8(
+    result, _mm_and_si128(_mm_cmpgt_epi8(indexes, _mm_set1_epi8(51)), _mm_set1_epi8(75)));
+  result = _mm_sub_epi8(
+    result, _mm_and_si128(_mm_cmpgt_epi8(indexes, _mm_set1_epi8(61)), _mm_set1_epi8(15)));
+  result = _mm_add_epi8(
+    result, _mm_and_si128(_mm_cmpeq_epi8(indexes, _mm_set1_epi8(63)), _mm_set1_epi8(3)));
+  return result;
+}
+
+/**
+ * Extracts 6-bit values from the lanes, where every lane holds 3 input bytes in the lowest bytes
+ * (in memory order). The values are placed into the bytes of the lane in the output order.
+ */
+auto
+to_indexes(__m128i lanes) -> __m128i
+{
+  const auto bits = [lanes](__m128i shifted, int mask) {
+    return _mm_and_si128(shifted, _mm_set1_epi32(mask));
+  };
+  return _mm_or_si128(
+    _mm_or_si128(bits(_mm_srli_epi32(lanes, 2), 0x0000003f),
+                 _mm_or_si128(bits(_mm_slli_epi32(lanes, 12), 0x00003000),
+                              bits(_mm_srli_epi32(lanes, 4), 0x00000f00))),
+    _mm_or_si128(_mm_or_si128(bits(_mm_slli_epi32(lanes, 10), 0x003c0000),
+                              bits(_mm_srli_epi32(lanes, 6), 0x00030000)),
+                 bits(_mm_slli_epi32(lanes, 8), 0x3f000000)));
+}
+
+/**
+ * Encodes the input in blocks of 12 bytes into 16 characters.
+ *
+ * @return number of bytes consumed from the input
+ */
+auto
+encode_blocks(const std::byte* in, std::size_t size, char* out) -> std::size_t
+{
+  std::size_t consumed = 0;
+  // the block is loaded as 16 bytes, but only 12 of them are encoded
+  for (; consumed + 16 <= size; consumed += 12, out += 16) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + consumed));
+    const __m128i lanes =
+      _mm_unpacklo_epi64(_mm_unpacklo_epi32(chunk, _mm_srli_si128(chunk, 3)),
+                         _mm_unpacklo_epi32(_mm_srli_si128(chunk, 6), _mm_srli_si128(chunk, 9)));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), to_alphabet(to_indexes(lanes)));
+  }
+  return consumed;
+}
+#elif defined(COUCHBASE_CXX_CLIENT_BASE64_NEON)
+/**
+ * Encodes the input in blocks of 48 bytes into 64 characters.
+ *
+ * @return number of bytes consumed from the input
+ */
+auto
+encode_blocks(const std::byte* in, std::size_t size, char* out) -> std::size_t
+{
+  const auto* alphabet = reinterpret_cast<const std::uint8_t*>(codemap.data());
+  const uint8x16x4_t table{ { vld1q_u8(alphabet),
+                              vld1q_u8(alphabet + 16),
+                              vld1q_u8(alphabet + 32),
+                              vld1q_u8(alphabet + 48) } };
+  const uint8x16_t mask = vdupq_n_u8(0x3f);
+
+  std::size_t consumed = 0;
+  for (; consumed + 48 <= size; consumed += 48, out += 64) {
+    const uint8x16x3_t chunk = vld3q_u8(reinterpret_cast<const std::uint8_t*>(in + consumed));
+    uint8x16x4_t chars{};
+    chars.val[0] = vqtbl4q_u8(table, vshrq_n_u8(chunk.val[0], 2));
+    chars.val[1] = vqtbl4q_u8(
+      table, vandq_u8(vorrq_u8(vshlq_n_u8(chunk.val[0], 4), vshrq_n_u8(chunk.val[1], 4)), mask));
+    chars.val[2] = vqtbl4q_u8(
+      table, vandq_u8(vorrq_u8(vshlq_n_u8(chunk.val[1], 2), vshrq_n_u8(chunk.val[2], 6)), mask));
+    chars.val[3] = vqtbl4q_u8(table, vandq_u8(chunk.val[2], mask));
+    vst4q_u8(reinterpret_cast<std::uint8_t*>(out), chars);
+  }
+  return consumed;
+}
+#else
+auto
+encode_blocks(const std::byte* /* in */, std::size_t /* size */, char* /* out */) -> std::size_t
+{
+  return 0;
+}
+#endif
 } // namespace
 
 namespace couchbase::core::base64
@@ -169,6 +273,12 @@ namespace couchbase::core::base64
 auto
 encode(gsl::span<const std::byte> blob, bool pretty_print) -> std::string
 {
+  if (!pretty_print) {
+    std::string result;
+    encode_to(blob, result);
+    return result;
+  }
+
   // base64 encodes up to 3 input characters to 4 output
   // characters in the alphabet above.
   auto triplets = blob.size() / 3;
@@ -210,6 +320,46 @@ encode(gsl::span<const std::byte> blob, bool pretty_print) -> std::string
   return result;
 }
 
+// TODO(CXXCBC-549): clang-tidy-19 reports subscript with non-const index
+// NOLINTBEGIN(cppcoreguidelines-pro-bounds-constant-array-index)
+void
+encode_to(gsl::span<const std::byte> blob, std::string& output)
+{
+  const auto triplets = blob.size() / 3;
+  const auto rest = blob.size() % 3;
+  const auto offset = output.size();
+  output.resize(offset + ((triplets + (rest != 0 ? 1 : 0)) * 4));
+
+  const auto* in = blob.data();
+  auto* out = output.data() + offset;
+  const auto consumed = encode_blocks(in, blob.size(), out);
+  in += consumed;
+  out += consumed / 3 * 4;
+
+  for (auto ii = consumed / 3; ii < triplets; ++ii) {
+    const auto val = (static_cast<std::uint32_t>(in[0]) << 16U) |
+                     (static_cast<std::uint32_t>(in[1]) << 8U) | static_cast<std::uint32_t>(in[2]);
+    out[0] = codemap[(val >> 18U) & 63];
+    out[1] = codemap[(val >> 12U) & 63];
+    out[2] = codemap[(val >> 6U) & 63];
+    out[3] = codemap[val & 63];
+    in += 3;
+    out += 4;
+  }
+
+  if (rest > 0) {
+    std::uint32_t val = static_cast<std::uint32_t>(in[0]) << 16U;
+    if (rest == 2) {
+      val |= static_cast<std::uint32_t>(in[1]) << 8U;
+    }
+    out[0] = codemap[(val >> 18U) & 63];
+    out[1] = codemap[(val >> 12U) & 63];
+    out[2] = rest == 2 ? codemap[(val >> 6U) & 63] : '=';
+    out[3] = '=';
+  }
+}
+// NOLINTEND(cppcoreguidelines-pro-bounds-constant-array-index)
+
 auto
 decode(std::string_view blob) -> std::vector<std::byte>
 {
@@ -36,6 +36,15 @@ encode(gsl::span<const std::byte> blob, bool pretty_print = false) -> std::strin
 auto
 encode(std::string_view blob, bool pretty_print = false) -> std::string;
 
+/**
+ * Base64 encode data and append it to the output (without line breaks)
+ *
+ * @param blob the data to encode
+ * @param output the string to append the encoded value to
+ */
+void
+encode_to(gsl::span<const std::byte> blob, std::string& output);
+
 /**
  * Decode a base64 encoded blob (which may be pretty-printed to avoid
  * super-long lines)
@@ -0,0 +1,99 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ * Copyright 2026 Couchbase, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ * except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#include "range_scan_concurrency_controller.hxx"
+
+#include <algorithm>
+
+namespace couchbase::core
+{
+range_scan_concurrency_controller::range_scan_concurrency_controller(std::uint16_t initial_limit,
+                                                                     std::uint16_t max_limit)
+  : limit_{ std::clamp<std::uint16_t>(initial_limit, 1, std::max<std::uint16_t>(max_limit, 1)) }
+  , max_limit_{ std::max<std::uint16_t>(max_limit, 1) }
+{
+}
+
+void
+range_scan_concurrency_controller::record_batch(std::chrono::steady_clock::duration latency,
+                                                std::size_t items)
+{
+  ++round_batches_;
+  round_items_ += items;
+  round_latency_ += latency;
+  if (round_batches_ >= limit_) {
+    end_round();
+  }
+}
+
+void
+range_scan_concurrency_controller::record_busy()
+{
+  limit_ = static_cast<std::uint16_t>(std::max(1, limit_ / 2));
+  probing_ = false;
+  hold_rounds_ = rounds_to_hold;
+  previous_throughput_ = 0;
+  round_batches_ = 0;
+  round_items_ = 0;
+  round_latency_ = {};
+}
+
+auto
+range_scan_concurrency_controller::limit() const -> std::uint16_t
+{
+  return limit_;
+}
+
+void
+range_scan_concurrency_controller::end_round()
+{
+  const auto batches = static_cast<double>(round_batches_);
+  const auto latency = std::chrono::duration<double>(round_latency_).count() / batches;
+  // all streams of the node run in parallel, so it delivers a batch per stream every latency period
+  const auto throughput =
+    latency > 0 ? static_cast<double>(round_items_) / batches * limit_ / latency : 0;
+  round_batches_ = 0;
+  round_items_ = 0;
+  round_latency_ = {};
+
+  if (!min_latency_ || latency < min_latency_.value()) {
+    min_latency_ = latency;
+  }
+  if (latency > 0 && min_latency_.value() / latency < congestion_gradient) {
+    const auto decrease = std::max(1, limit_ / 4);
+    limit_ = static_cast<std::uint16_t>(std::max(1, limit_ - decrease));
+    probing_ = false;
+    previous_throughput_ = throughput;
+    return;
+  }
+  if (probing_ && throughput < previous_throughput_ * min_throughput_gain) {
+    --limit_;
+    probing_ = false;
+    hold_rounds_ = rounds_to_hold;
+    previous_throughput_ = throughput;
+    return;
+  }
+  probing_ = false;
+  previous_throughput_ = throughput;
+  if (hold_rounds_ > 0) {
+    --hold_rounds_;
+    return;
+  }
+  if (limit_ < max_limit_) {
+    ++limit_;
+    probing_ = true;
+  }
+}
+} // namespace couchbase::core
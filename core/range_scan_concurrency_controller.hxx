@@ -0,0 +1,70 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ * Copyright 2026 Couchbase, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file
+ * except in compliance with the License. You may obtain a copy of the License at
+ *
+ *     https://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software distributed under
+ * the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF
+ * ANY KIND, either express or implied. See the License for the specific language governing
+ * permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace couchbase::core
+{
+/**
+ * Sizes the number of concurrent range scan streams of a single node.
+ *
+ * The batches are grouped into rounds of as many batches as there are allowed streams. After each
+ * round the controller compares the average batch latency with the lowest one observed so far, and
+ * the throughput of the node with the one of the previous round:
+ *
+ * - when the latency has grown a lot, the node is queueing the requests, and the limit is lowered;
+ * - when the previous increase of the limit has not improved the throughput, it is reverted, and
+ *   the limit stays for a few rounds;
+ * - otherwise the limit is raised by one stream, up to the maximum.
+ *
+ * A busy response from the node halves the limit.
+ *
+ * The controller is not thread-safe, the owner has to serialize the calls.
+ */
+class range_scan_concurrency_controller
+{
+public:
+  range_scan_concurrency_controller(std::uint16_t initial_limit, std::uint16_t max_limit);
+
+  void record_batch(std::chrono::steady_clock::duration latency, std::size_t items);
+  void record_busy();
+
+  [[nodiscard]] auto limit() const -> std::uint16_t;
+
+private:
+  void end_round();
+
+  static constexpr double congestion_gradient{ 0.5 };
+  static constexpr double min_throughput_gain{ 1.05 };
+  static constexpr std::size_t rounds_to_hold{ 4 };
+
+  std::uint16_t limit_;
+  std::uint16_t max_limit_;
+
+  std::size_t round_batches_{ 0 };
+  std::size_t round_items_{ 0 };
+  std::chrono::steady_clock::duration round_latency_{};
+
+  std::optional<double> min_latency_{};
+  double previous_throughput_{ 0 };
+  bool probing_{ false };
+  std::size_t hold_rounds_{ 0 };
+};
+} // namespace couchbase::core
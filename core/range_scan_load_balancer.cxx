@@ -74,6 +74,50 @@ range_scan_node_state::pending_vbucket_count() -> std::size_t
   return pending_vbuckets_.size();
 }
 
+void
+range_scan_node_state::enable_adaptive_concurrency(std::uint16_t initial_limit,
+                                                   std::uint16_t max_limit)
+{
+  const std::scoped_lock<std::mutex> lock{ mutex_ };
+  controller_.emplace(initial_limit, max_limit);
+}
+
+void
+range_scan_node_state::notify_batch_completed(std::chrono::steady_clock::duration latency,
+                                              std::size_t items)
+{
+  const std::scoped_lock<std::mutex> lock{ mutex_ };
+  if (controller_) {
+    controller_->record_batch(latency, items);
+  }
+}
+
+void
+range_scan_node_state::notify_busy()
+{
+  const std::scoped_lock<std::mutex> lock{ mutex_ };
+  if (controller_) {
+    controller_->record_busy();
+  }
+}
+
+auto
+range_scan_node_state::has_capacity() -> bool
+{
+  const std::scoped_lock<std::mutex> lock{ mutex_ };
+  return !controller_ || active_stream_count_ < controller_->limit();
+}
+
+auto
+range_scan_node_state::concurrency_limit() -> std::optional<std::uint16_t>
+{
+  const std::scoped_lock<std::mutex> lock{ mutex_ };
+  if (controller_) {
+    return controller_->limit();
+  }
+  return {};
+}
+
 range_scan_load_balancer::range_scan_load_balancer(
   const topology::configuration::vbucket_map& vbucket_map,
   std::optional<std::uint64_t> seed)
@@ -116,7 +160,8 @@ range_scan_load_balancer::select_vbucket() -> std::optional<std::uint16_t>
     auto& [node_id, node_status] = *it; // cppcheck-suppress variableScope
     auto stream_count = node_status.active_stream_count();
 
-    if (stream_count < min_stream_count && node_status.pending_vbucket_count() > 0) {
+    if (stream_count < min_stream_count && node_status.pending_vbucket_count() > 0 &&
+        node_status.has_capacity()) {
       min_stream_count = stream_count;
       selected_node_id = node_id;
     }
@@ -140,4 +185,39 @@ range_scan_load_balancer::enqueue_vbucket(std::int16_t node_id, std::uint16_t vb
 {
   nodes_.at(node_id).enqueue_vbucket(vbucket_id);
 }
+
+void
+range_scan_load_balancer::enable_adaptive_concurrency(std::uint16_t initial_stream_count,
+                                                      std::uint16_t max_streams_per_node)
+{
+  if (nodes_.empty()) {
+    return;
+  }
+  const auto number_of_nodes = nodes_.size();
+  const auto initial_limit = gsl::narrow_cast<std::uint16_t>(
+    (std::size_t{ initial_stream_count } + number_of_nodes - 1) / number_of_nodes);
+  for (auto& [node_id, node_status] : nodes_) {
+    node_status.enable_adaptive_concurrency(initial_limit, max_streams_per_node);
+  }
+}
+
+void
+range_scan_load_balancer::notify_batch_completed(std::int16_t node_id,
+                                                 std::chrono::steady_clock::duration latency,
+                                                 std::size_t items)
+{
+  nodes_.at(node_id).notify_batch_completed(latency, items);
+}
+
+void
+range_scan_load_balancer::notify_busy(std::int16_t node_id)
+{
+  nodes_.at(node_id).notify_busy();
+}
+
+auto
+range_scan_load_balancer::concurrency_limit(std::int16_t node_id) -> std::optional<std::uint16_t>
+{
+  return nodes_.at(node_id).concurrency_limit();
+}
 } // namespace couchbase::core
@@ -15,9 +15,12 @@
  *   limitations under the License.
  */
 
+#include "core/range_scan_concurrency_controller.hxx"
 #include "core/topology/configuration.hxx"
 
+#include <chrono>
 #include <mutex>
+#include <optional>
 #include <queue>
 
 namespace couchbase::core
@@ -33,9 +36,19 @@ public:
   auto active_stream_count() -> std::uint16_t;
   auto pending_vbucket_count() -> std::size_t;
 
+  void enable_adaptive_concurrency(std::uint16_t initial_limit, std::uint16_t max_limit);
+  void notify_batch_completed(std::chrono::steady_clock::duration latency, std::size_t items);
+  void notify_busy();
+  /**
+   * Returns false if the node already runs as many streams as its concurrency controller allows.
+   */
+  auto has_capacity() -> bool;
+  auto concurrency_limit() -> std::optional<std::uint16_t>;
+
 private:
   std::uint16_t active_stream_count_{ 0 };
   std::queue<std::uint16_t> pending_vbuckets_{};
+  std::optional<range_scan_concurrency_controller> controller_{};
   std::mutex mutex_{};
 };
 
@@ -56,6 +69,19 @@ public:
   void notify_stream_ended(std::int16_t node_id);
   void enqueue_vbucket(std::int16_t node_id, std::uint16_t vbucket_id);
 
+  /**
+   * Limits the number of streams of each node by a controller, that follows the observed batch
+   * latency and throughput of the node. The initial number of streams is spread across the nodes.
+   * Without adaptive concurrency, the streams are only balanced across the nodes.
+   */
+  void enable_adaptive_concurrency(std::uint16_t initial_stream_count,
+                                   std::uint16_t max_streams_per_node);
+  void notify_batch_completed(std::int16_t node_id,
+                              std::chrono::steady_clock::duration latency,
+                              std::size_t items);
+  void notify_busy(std::int16_t node_id);
+  auto concurrency_limit(std::int16_t node_id) -> std::optional<std::uint16_t>;
+
 private:
   std::map<std::int16_t, range_scan_node_state> nodes_{};
   std::mutex select_vbucket_mutex_{};
@@ -275,6 +275,8 @@ private:
     }
 
     asio::post(asio::bind_executor(io_, [self = shared_from_this()]() mutable {
+      self->batch_start_ = std::chrono::steady_clock::now();
+      self->batch_items_ = 0;
       self->agent_.range_scan_continue(
         self->uuid(),
         self->vbucket_id_,
@@ -285,6 +287,7 @@ private:
             return;
           }
           self->last_seen_key_ = item.key;
+          ++self->batch_items_;
           if (auto mgr = self->stream_manager_.lock(); mgr != nullptr) {
             mgr->stream_received_item(std::move(item));
           }
@@ -293,6 +296,11 @@ private:
           if (ec) {
             return self->fail(ec);
           }
+          if (auto mgr = self->stream_manager_.lock(); mgr != nullptr) {
+            mgr->stream_batch_completed(self->node_id_,
+                                        std::chrono::steady_clock::now() - self->batch_start_,
+                                        self->batch_items_);
+          }
           if (res.complete) {
             return self->complete();
           }
@@ -347,6 +355,8 @@ private:
   std::variant<std::monostate, failed, running, completed> state_{};
   std::atomic<bool> should_cancel_{ false };
   std::optional<std::chrono::time_point<std::chrono::steady_clock>> first_attempt_timestamp_{};
+  std::chrono::steady_clock::time_point batch_start_{};
+  std::size_t batch_items_{ 0 };
 };
 
 class range_scan_orchestrator_impl
@@ -390,6 +400,9 @@ public:
         load_balancer_.seed(s.seed.value());
       }
     }
+    if (options_.adaptive_concurrency) {
+      load_balancer_.enable_adaptive_concurrency(concurrency_, options_.max_concurrency_per_node);
+    }
   }
 
   void scan(scan_callback&& cb)
@@ -442,7 +455,7 @@ public:
             std::static_pointer_cast<scan_stream_manager>(self));
           self->streams_[vbucket] = stream;
         }
-        self->start_streams(self->concurrency_);
+        self->start_streams(self->stream_budget(self->concurrency_));
         // Transferring ownership of the range_scan_orchestrator impl to the scan_result
         return cb({}, scan_result(std::move(self)));
       });
@@ -533,7 +546,8 @@ public:
     while (counter < stream_count) {
       auto vbucket_id = load_balancer_.select_vbucket();
       if (!vbucket_id.has_value()) {
-        CB_LOG_TRACE("no more scans, all vbuckets have been scanned");
+        CB_LOG_TRACE("no more scans, all vbuckets have been scanned or the nodes are at their "
+                     "concurrency limits");
         return;
       }
 
@@ -595,12 +609,25 @@ public:
           "unexpected error while sending to scan item channel: {} ({})", ec.value(), ec.message());
       }
     });
-    return start_streams(1);
+    return start_streams(stream_budget(1));
+  }
+
+  void stream_batch_completed(std::int16_t node_id,
+                              std::chrono::steady_clock::duration latency,
+                              std::size_t items) override
+  {
+    if (!options_.adaptive_concurrency) {
+      return;
+    }
+    load_balancer_.notify_batch_completed(node_id, latency, items);
+    // the limit of the node might have been raised
+    return start_streams(stream_budget(0));
   }
 
   void stream_start_failed_awaiting_retry(std::int16_t node_id, std::uint16_t vbucket_id) override
   {
     load_balancer_.notify_stream_ended(node_id);
+    load_balancer_.notify_busy(node_id);
     active_stream_count_--;
 
     load_balancer_.enqueue_vbucket(node_id, vbucket_id);
@@ -610,6 +637,18 @@ public:
   }
 
 private:
+  /**
+   * With adaptive concurrency the load balancer decides how many streams to run, otherwise the
+   * given number of streams is started.
+   */
+  [[nodiscard]] auto stream_budget(std::uint16_t stream_count) const -> std::uint16_t
+  {
+    if (options_.adaptive_concurrency) {
+      return std::numeric_limits<std::uint16_t>::max();
+    }
+    return stream_count;
+  }
+
   asio::io_context& io_;
   agent agent_;
   topology::configuration::vbucket_map vbucket_map_;
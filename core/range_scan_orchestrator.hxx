@@ -22,6 +22,8 @@
 
 #include <tl/expected.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <system_error>
 
@@ -47,6 +49,9 @@ public:
                              std::error_code ec,
                              bool fatal) = 0;
   virtual void stream_completed(std::int16_t node_id, std::uint16_t vbucket_id) = 0;
+  virtual void stream_batch_completed(std::int16_t node_id,
+                                      std::chrono::steady_clock::duration latency,
+                                      std::size_t items) = 0;
 };
 
 using scan_callback = utils::movable_function<void(std::error_code, scan_result result)>;
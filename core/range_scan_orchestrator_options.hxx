@@ -45,12 +45,16 @@ struct mutation_state {
 
 struct range_scan_orchestrator_options {
   static constexpr std::uint16_t default_concurrency{ 1 };
+  static constexpr std::uint16_t default_max_concurrency_per_node{ 16 };
 
   bool ids_only{ false };
   std::optional<mutation_state> consistent_with{};
   std::uint32_t batch_item_limit{ range_scan_continue_options::default_batch_item_limit };
   std::uint32_t batch_byte_limit{ range_scan_continue_options::default_batch_byte_limit };
   std::uint16_t concurrency{ default_concurrency };
+  // when set, concurrency is only the initial number of streams, see range_scan_load_balancer
+  bool adaptive_concurrency{ false };
+  std::uint16_t max_concurrency_per_node{ default_max_concurrency_per_node };
 
   std::shared_ptr<couchbase::retry_strategy> retry_strategy{ make_best_effort_retry_strategy() };
   std::chrono::milliseconds timeout{ timeout_defaults::key_value_scan_timeout };
@@ -0,0 +1,91 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "salted_password_cache.h"
+
+#include <utility>
+
+namespace couchbase::core::sasl::mechanism::scram
+{
+auto
+derive_keys(couchbase::core::crypto::Algorithm algorithm,
+            const std::string& password,
+            const std::string& salt,
+            unsigned int iteration_count) -> derived_keys
+{
+  derived_keys keys;
+  keys.salted_password =
+    couchbase::core::crypto::PBKDF2_HMAC(algorithm, password, salt, iteration_count);
+  keys.client_key =
+    couchbase::core::crypto::CBC_HMAC(algorithm, keys.salted_password, "Client Key");
+  keys.stored_key = couchbase::core::crypto::digest(algorithm, keys.client_key);
+  keys.server_key =
+    couchbase::core::crypto::CBC_HMAC(algorithm, keys.salted_password, "Server Key");
+  return keys;
+}
+
+auto
+salted_password_cache::instance() -> salted_password_cache&
+{
+  static salted_password_cache cache{};
+  return cache;
+}
+
+auto
+salted_password_cache::get(Mechanism mechanism,
+                           couchbase::core::crypto::Algorithm algorithm,
+                           const std::string& username,
+                           const std::string& password,
+                           const std::string& salt,
+                           unsigned int iteration_count) -> std::shared_ptr<const derived_keys>
+{
+  key k{ mechanism, username, salt, iteration_count };
+  auto password_digest = couchbase::core::crypto::digest(algorithm, password);
+  {
+    const std::scoped_lock lock(mutex_);
+    if (auto it = entries_.find(k);
+        it != entries_.end() && it->second.password_digest == password_digest) {
+      return it->second.keys;
+    }
+  }
+
+  // derive the keys without the lock, so that the users do not wait for each other
+  auto keys = std::make_shared<const derived_keys>(
+    derive_keys(algorithm, password, salt, iteration_count));
+
+  const std::scoped_lock lock(mutex_);
+  if (entries_.size() >= max_entries) {
+    entries_.clear();
+  }
+  entries_.insert_or_assign(std::move(k), entry{ std::move(password_digest), keys });
+  return keys;
+}
+
+void
+salted_password_cache::clear()
+{
+  const std::scoped_lock lock(mutex_);
+  entries_.clear();
+}
+
+auto
+salted_password_cache::size() const -> std::size_t
+{
+  const std::scoped_lock lock(mutex_);
+  return entries_.size();
+}
+} // namespace couchbase::core::sasl::mechanism::scram
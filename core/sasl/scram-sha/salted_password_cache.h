@@ -0,0 +1,105 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+#pragma once
+
+#include "core/crypto/cbcrypto.h"
+#include "core/sasl/mechanism.h"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+
+namespace couchbase::core::sasl::mechanism::scram
+{
+
+/**
+ * Keys derived from the password of the user, that do not depend on the nonces of the
+ * conversation (https://www.ietf.org/rfc/rfc5802.txt section 3):
+ *
+ * SaltedPassword  := Hi(Normalize(password), salt, i)
+ * ClientKey       := HMAC(SaltedPassword, "Client Key")
+ * StoredKey       := H(ClientKey)
+ * ServerKey       := HMAC(SaltedPassword, "Server Key")
+ */
+struct derived_keys {
+  std::string salted_password;
+  std::string client_key;
+  std::string stored_key;
+  std::string server_key;
+};
+
+/**
+ * Derive the keys of the user from the password.
+ *
+ * @throws std::runtime_error if the crypto library fails
+ */
+auto
+derive_keys(couchbase::core::crypto::Algorithm algorithm,
+            const std::string& password,
+            const std::string& salt,
+            unsigned int iteration_count) -> derived_keys;
+
+/**
+ * Process-wide cache of the derived keys.
+ *
+ * The server uses the same salt and iteration count for all connections of the user, but
+ * Hi() (PBKDF2) runs thousands of HMAC iterations, so without the cache every connection of
+ * every bucket re-derives the same keys when the SDK reconnects to the cluster.
+ *
+ * The entries are keyed by mechanism, user, salt and iteration count. Each entry also remembers
+ * the digest of the password, so that the entry is derived again when the credentials of the
+ * cluster have been updated.
+ */
+class salted_password_cache
+{
+public:
+  static constexpr std::size_t max_entries{ 1024 };
+
+  static auto instance() -> salted_password_cache&;
+
+  /**
+   * Returns the keys of the user, derives them on cache miss.
+   *
+   * @throws std::runtime_error if the crypto library fails
+   */
+  auto get(Mechanism mechanism,
+           couchbase::core::crypto::Algorithm algorithm,
+           const std::string& username,
+           const std::string& password,
+           const std::string& salt,
+           unsigned int iteration_count) -> std::shared_ptr<const derived_keys>;
+
+  void clear();
+
+  [[nodiscard]] auto size() const -> std::size_t;
+
+private:
+  using key = std::tuple<Mechanism, std::string, std::string, unsigned int>;
+
+  struct entry {
+    std::string password_digest;
+    std::shared_ptr<const derived_keys> keys;
+  };
+
+  mutable std::mutex mutex_{};
+  std::map<key, entry> entries_{};
+};
+
+} // namespace couchbase::core::sasl::mechanism::scram
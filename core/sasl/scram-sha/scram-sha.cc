@@ -205,9 +205,8 @@ ScramShaBackend::addAttribute(std::ostream& out, char key, int value, bool more)
 auto
 ScramShaBackend::getServerSignature() -> std::string
 {
-  auto serverKey = couchbase::core::crypto::CBC_HMAC(algorithm, getSaltedPassword(), "Server Key");
-
-  return couchbase::core::crypto::CBC_HMAC(algorithm, serverKey, getAuthMessage());
+  return couchbase::core::crypto::CBC_HMAC(
+    algorithm, getDerivedKeys().server_key, getAuthMessage());
 }
 
 /**
@@ -225,10 +224,10 @@ ScramShaBackend::getServerSignature() -> std::string
 auto
 ScramShaBackend::getClientProof() -> std::string
 {
-  auto clientKey = couchbase::core::crypto::CBC_HMAC(algorithm, getSaltedPassword(), "Client Key");
-  auto storedKey = couchbase::core::crypto::digest(algorithm, clientKey);
+  const auto& keys = getDerivedKeys();
+  const auto& clientKey = keys.client_key;
   const std::string authMessage = getAuthMessage();
-  auto clientSignature = couchbase::core::crypto::CBC_HMAC(algorithm, storedKey, authMessage);
+  auto clientSignature = couchbase::core::crypto::CBC_HMAC(algorithm, keys.stored_key, authMessage);
 
   // Client Proof is ClientKey XOR ClientSignature
   const auto* ck = clientKey.data();
@@ -370,7 +369,8 @@ auto
 ClientBackend::generateSaltedPassword(const std::string& secret) -> bool
 {
   try {
-    saltedPassword = couchbase::core::crypto::PBKDF2_HMAC(algorithm, secret, salt, iterationCount);
+    derivedKeys = salted_password_cache::instance().get(
+      mechanism, algorithm, usernameCallback(), secret, salt, iterationCount);
     return true;
   } catch (...) {
     return false;
@@ -30,9 +30,11 @@
 
 #include "core/sasl/client.h"
 #include "core/sasl/mechanism.h"
+#include "salted_password_cache.h"
 
 #include <array>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 namespace couchbase::core::sasl::mechanism::scram
@@ -84,7 +86,7 @@ protected:
 
   std::string getClientProof();
 
-  virtual std::string getSaltedPassword() = 0;
+  virtual const derived_keys& getDerivedKeys() = 0;
 
   /**
    * Get the AUTH message (as specified in the RFC)
@@ -126,15 +128,15 @@ public:
 protected:
   bool generateSaltedPassword(const std::string& secret);
 
-  std::string getSaltedPassword() override
+  const derived_keys& getDerivedKeys() override
   {
-    if (saltedPassword.empty()) {
-      throw std::logic_error("getSaltedPassword called before salted password is initialized");
+    if (!derivedKeys) {
+      throw std::logic_error("getDerivedKeys called before salted password is initialized");
     }
-    return saltedPassword;
+    return *derivedKeys;
   }
 
-  std::string saltedPassword;
+  std::shared_ptr<const derived_keys> derivedKeys;
   std::string salt;
   unsigned int iterationCount = 4096;
 };
@@ -0,0 +1,77 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "vbucket_routing_table.hxx"
+
+#include "core/utils/crc32.hxx"
+
+#include <algorithm>
+
+namespace couchbase::core::topology
+{
+vbucket_routing_table::vbucket_routing_table(const std::vector<std::vector<std::int16_t>>& vbmap)
+  : number_of_vbuckets_{ vbmap.size() }
+{
+  for (const auto& servers : vbmap) {
+    entries_per_vbucket_ = std::max(entries_per_vbucket_, servers.size());
+  }
+  // rows shorter than the widest one are padded with -1 (no server)
+  servers_.resize(number_of_vbuckets_ * entries_per_vbucket_, -1);
+  auto row = servers_.begin();
+  for (const auto& servers : vbmap) {
+    std::copy(servers.begin(), servers.end(), row);
+    row += static_cast<std::ptrdiff_t>(entries_per_vbucket_);
+  }
+}
+
+auto
+vbucket_routing_table::server_by_vbucket(std::uint16_t vbucket, std::size_t index) const
+  -> std::optional<std::size_t>
+{
+  if (vbucket >= number_of_vbuckets_ || index >= entries_per_vbucket_) {
+    return {};
+  }
+  if (auto server_index = servers_[vbucket * entries_per_vbucket_ + index]; server_index >= 0) {
+    return static_cast<std::size_t>(server_index);
+  }
+  return {};
+}
+
+auto
+vbucket_routing_table::map_key(const std::string& key, std::size_t index) const
+  -> std::pair<std::uint16_t, std::optional<std::size_t>>
+{
+  if (number_of_vbuckets_ == 0) {
+    return { 0, {} };
+  }
+  const std::uint32_t crc = utils::hash_crc32(key.data(), key.size());
+  auto vbucket = static_cast<std::uint16_t>(crc % number_of_vbuckets_);
+  return { vbucket, server_by_vbucket(vbucket, index) };
+}
+
+auto
+vbucket_routing_table::map_key(const std::vector<std::byte>& key, std::size_t index) const
+  -> std::pair<std::uint16_t, std::optional<std::size_t>>
+{
+  if (number_of_vbuckets_ == 0) {
+    return { 0, {} };
+  }
+  const std::uint32_t crc = utils::hash_crc32(key.data(), key.size());
+  auto vbucket = static_cast<std::uint16_t>(crc % number_of_vbuckets_);
+  return { vbucket, server_by_vbucket(vbucket, index) };
+}
+} // namespace couchbase::core::topology
@@ -0,0 +1,75 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::topology
+{
+/**
+ * Immutable snapshot of the partition map used to route KV requests.
+ *
+ * The servers are stored in a single contiguous array of "vbuckets x (1 + replicas)" entries, so
+ * that routing a key costs one hash and one array lookup. The bucket publishes new snapshot
+ * atomically on every configuration update, while requests in flight keep using the snapshot they
+ * have already loaded.
+ */
+class vbucket_routing_table
+{
+public:
+  /**
+   * @param vbmap partition map of the configuration (see configuration::vbmap)
+   */
+  explicit vbucket_routing_table(const std::vector<std::vector<std::int16_t>>& vbmap);
+
+  [[nodiscard]] auto number_of_vbuckets() const -> std::size_t
+  {
+    return number_of_vbuckets_;
+  }
+
+  /**
+   * @return number of servers for each vbucket (active and replicas)
+   */
+  [[nodiscard]] auto entries_per_vbucket() const -> std::size_t
+  {
+    return entries_per_vbucket_;
+  }
+
+  /**
+   * @param index 0 for the active node, 1..N for the replicas
+   */
+  [[nodiscard]] auto server_by_vbucket(std::uint16_t vbucket, std::size_t index) const
+    -> std::optional<std::size_t>;
+
+  [[nodiscard]] auto map_key(const std::string& key, std::size_t index) const
+    -> std::pair<std::uint16_t, std::optional<std::size_t>>;
+
+  [[nodiscard]] auto map_key(const std::vector<std::byte>& key, std::size_t index) const
+    -> std::pair<std::uint16_t, std::optional<std::size_t>>;
+
+private:
+  std::size_t number_of_vbuckets_{ 0 };
+  std::size_t entries_per_vbucket_{ 0 };
+  std::vector<std::int16_t> servers_{};
+};
+} // namespace couchbase::core::topology
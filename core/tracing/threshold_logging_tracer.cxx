@@ -26,12 +26,18 @@
 #include "core/service_type_fmt.hxx"
 #include "core/utils/concurrent_fixed_priority_queue.hxx"
 #include "core/utils/json.hxx"
+#include "core/utils/thread_local_pool_allocator.hxx"
 
 #include <asio/steady_timer.hpp>
 #include <memory>
 #include <tao/json/value.hpp>
 
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <utility>
 
 namespace couchbase::core::tracing
@@ -51,6 +57,153 @@ struct reported_span {
   }
 };
 
+namespace
+{
+/**
+ * The attributes that the threshold logging tracer keeps, all others are ignored.
+ */
+enum class span_attribute : std::uint8_t {
+  service,
+  server_duration,
+  local_id,
+  operation_id,
+  peer_address,
+  peer_port,
+};
+
+/**
+ * The attributes of one value type, indexed by the length of their names. The names of the same
+ * type have distinct lengths, so the length selects the only candidate, and a single comparison
+ * confirms it.
+ */
+template<std::size_t N>
+class attribute_index
+{
+public:
+  static constexpr std::size_t max_name_length{ 32 };
+
+  constexpr explicit attribute_index(
+    const std::array<std::pair<std::string_view, span_attribute>, N>& attributes)
+    : attributes_{ attributes }
+  {
+    for (auto& slot : by_length_) {
+      slot = N;
+    }
+    for (std::size_t i = 0; i < N; ++i) {
+      by_length_[attributes_[i].first.size()] = i;
+    }
+  }
+
+  [[nodiscard]] constexpr auto has_distinct_lengths() const -> bool
+  {
+    std::size_t indexed{ 0 };
+    for (const auto slot : by_length_) {
+      if (slot != N) {
+        ++indexed;
+      }
+    }
+    return indexed == N;
+  }
+
+  [[nodiscard]] constexpr auto find(std::string_view name) const -> std::optional<span_attribute>
+  {
+    if (name.size() > max_name_length) {
+      return {};
+    }
+    const auto slot = by_length_[name.size()];
+    if (slot == N || attributes_[slot].first != name) {
+      return {};
+    }
+    return attributes_[slot].second;
+  }
+
+private:
+  std::array<std::pair<std::string_view, span_attribute>, N> attributes_;
+  std::array<std::size_t, max_name_length + 1> by_length_{};
+};
+
+constexpr attribute_index<4> string_attributes{ { {
+  { attributes::op::service, span_attribute::service },
+  { attributes::dispatch::local_id, span_attribute::local_id },
+  { attributes::dispatch::operation_id, span_attribute::operation_id },
+  { attributes::dispatch::peer_address, span_attribute::peer_address },
+} } };
+static_assert(string_attributes.has_distinct_lengths());
+
+constexpr attribute_index<2> number_attributes{ { {
+  { attributes::dispatch::server_duration, span_attribute::server_duration },
+  { attributes::dispatch::peer_port, span_attribute::peer_port },
+} } };
+static_assert(number_attributes.has_distinct_lengths());
+
+/**
+ * The value of a string tag, kept inside the span. The ids and addresses fit into the inline
+ * buffer, so recording them does not allocate, and the strings of the report are only built for
+ * the spans over the threshold.
+ */
+class span_tag
+{
+public:
+  void assign(std::string_view value)
+  {
+    if (value.size() <= inline_value_.size()) {
+      std::copy(value.begin(), value.end(), inline_value_.begin());
+      inline_size_ = value.size();
+      overflow_.clear();
+    } else {
+      overflow_.assign(value);
+    }
+    has_value_ = true;
+  }
+
+  [[nodiscard]] auto value() const -> std::optional<std::string_view>
+  {
+    if (!has_value_) {
+      return {};
+    }
+    if (!overflow_.empty()) {
+      return overflow_;
+    }
+    return std::string_view{ inline_value_.data(), inline_size_ };
+  }
+
+private:
+  std::array<char, 48> inline_value_{};
+  std::size_t inline_size_{ 0 };
+  std::string overflow_{};
+  bool has_value_{ false };
+};
+
+auto
+to_service_type(std::string_view name) -> std::optional<service_type>
+{
+  if (name == tracing::service::key_value) {
+    return service_type::key_value;
+  }
+  if (name == tracing::service::query) {
+    return service_type::query;
+  }
+  if (name == tracing::service::view) {
+    return service_type::view;
+  }
+  if (name == tracing::service::search) {
+    return service_type::search;
+  }
+  if (name == tracing::service::analytics) {
+    return service_type::analytics;
+  }
+  if (name == tracing::service::management) {
+    return service_type::management;
+  }
+  return {};
+}
+} // namespace
+
+/**
+ * The span keeps only the attributes that might end up in the threshold report, and does not
+ * format anything until the operation has exceeded the threshold. The storage of the spans comes
+ * from the per-thread pool (see threshold_logging_tracer::start_span).
+ */
 class threshold_logging_span
   : public couchbase::tracing::request_span
   , public std::enable_shared_from_this<threshold_logging_span>
@@ -61,11 +214,13 @@ private:
 
   std::uint64_t last_server_duration_us_{ 0 };
   std::uint64_t total_server_duration_us_{ 0 };
-  std::optional<std::string> operation_id_{};
-  std::optional<std::string> last_local_id_{};
-  std::optional<std::string> service_{};
-  std::optional<std::string> peer_hostname_{};
+  span_tag operation_id_{};
+  span_tag last_local_id_{};
+  span_tag peer_hostname_{};
   std::optional<std::uint16_t> peer_port_{};
+  std::optional<service_type> service_{};
+  bool has_service_tag_{ false };
+  bool is_dispatch_;
 
   std::shared_ptr<threshold_logging_tracer> tracer_{};
 
@@ -74,54 +229,72 @@ public:
                          std::shared_ptr<threshold_logging_tracer> tracer,
                          std::shared_ptr<request_span> parent = nullptr)
     : request_span(std::move(name), std::move(parent))
+    , is_dispatch_{ this->name() == tracing::operation::step_dispatch }
     , tracer_{ std::move(tracer) }
   {
   }
 
   void add_tag(const std::string& tag_name, std::uint64_t value) override
   {
-    if (tag_name == tracing::attributes::dispatch::server_duration) {
-      last_server_duration_us_ = value;
-      if (name() != tracing::operation::step_dispatch) {
-        total_server_duration_us_ += value;
-      }
+    const auto attribute = number_attributes.find(tag_name);
+    if (!attribute) {
+      return;
     }
-    if (tag_name == tracing::attributes::dispatch::peer_port) {
-      peer_port_ = static_cast<std::uint16_t>(value);
+    switch (attribute.value()) {
+      case span_attribute::server_duration:
+        last_server_duration_us_ = value;
+        if (!is_dispatch_) {
+          total_server_duration_us_ += value;
+        }
+        break;
+      case span_attribute::peer_port:
+        peer_port_ = static_cast<std::uint16_t>(value);
+        break;
+      default:
+        break;
     }
   }
 
   void add_tag(const std::string& tag_name, const std::string& value) override
   {
-    if (tag_name == tracing::attributes::op::service) {
-      service_ = value;
-    }
-    if (tag_name == tracing::attributes::dispatch::local_id) {
-      last_local_id_ = value;
-    }
-    if (tag_name == tracing::attributes::dispatch::operation_id) {
-      operation_id_ = value;
+    const auto attribute = string_attributes.find(tag_name);
+    if (!attribute) {
+      return;
     }
-    if (tag_name == tracing::attributes::dispatch::peer_address) {
-      peer_hostname_ = value;
+    switch (attribute.value()) {
+      case span_attribute::service:
+        has_service_tag_ = true;
+        service_ = to_service_type(value);
+        break;
+      case span_attribute::local_id:
+        last_local_id_.assign(value);
+        break;
+      case span_attribute::operation_id:
+        operation_id_.assign(value);
+        break;
+      case span_attribute::peer_address:
+        peer_hostname_.assign(value);
+        break;
+      default:
+        break;
     }
   }
 
   void end() override;
 
-  void set_last_local_id(const std::string& id)
+  void set_last_local_id(std::string_view id)
   {
-    last_local_id_ = id;
+    last_local_id_.assign(id);
   }
 
-  void set_operation_id(const std::string& id)
+  void set_operation_id(std::string_view id)
   {
-    operation_id_ = id;
+    operation_id_.assign(id);
   }
 
-  void set_peer_hostname(const std::string& hostname)
+  void set_peer_hostname(std::string_view hostname)
   {
-    peer_hostname_ = hostname;
+    peer_hostname_.assign(hostname);
   }
 
   void set_peer_port(const std::uint16_t port)
@@ -131,8 +304,8 @@ public:
 
   [[nodiscard]] auto last_remote_socket() const -> std::optional<std::string>
   {
-    if (peer_hostname_.has_value() && peer_port_.has_value()) {
-      return fmt::format("{}:{}", peer_hostname_.value(), peer_port_.value());
+    if (const auto hostname = peer_hostname_.value(); hostname && peer_port_.has_value()) {
+      return fmt::format("{}:{}", hostname.value(), peer_port_.value());
     }
     return {};
   }
@@ -158,46 +331,24 @@ public:
     return total_server_duration_us_;
   }
 
-  [[nodiscard]] auto operation_id() const -> std::optional<std::string>
+  [[nodiscard]] auto operation_id() const -> std::optional<std::string_view>
   {
-    return operation_id_;
+    return operation_id_.value();
   }
 
-  [[nodiscard]] auto last_local_id() const -> std::optional<std::string>
+  [[nodiscard]] auto last_local_id() const -> std::optional<std::string_view>
   {
-    return last_local_id_;
+    return last_local_id_.value();
   }
 
   [[nodiscard]] auto is_key_value() const -> bool
   {
-    return service_.has_value() && service_.value() == tracing::service::key_value;
+    return service_ == service_type::key_value;
   }
 
   [[nodiscard]] auto service() const -> std::optional<service_type>
   {
-    if (!service_.has_value()) {
-      return {};
-    }
-    const auto& service_name = service_.value();
-    if (service_name == tracing::service::key_value) {
-      return service_type::key_value;
-    }
-    if (service_name == tracing::service::query) {
-      return service_type::query;
-    }
-    if (service_name == tracing::service::view) {
-      return service_type::view;
-    }
-    if (service_name == tracing::service::search) {
-      return service_type::search;
-    }
-    if (service_name == tracing::service::analytics) {
-      return service_type::analytics;
-    }
-    if (service_name == tracing::service::management) {
-      return service_type::management;
-    }
-    return {};
+    return service_;
   }
 };
 
@@ -216,16 +367,16 @@ convert(const std::shared_ptr<threshold_logging_span>& span) -> reported_span
     entry["total_server_duration_us"] = span->total_server_duration_us();
   }
 
-  if (span->operation_id().has_value()) {
-    entry["last_operation_id"] = span->operation_id().value();
+  if (const auto operation_id = span->operation_id(); operation_id.has_value()) {
+    entry["last_operation_id"] = std::string{ operation_id.value() };
   }
 
-  if (span->last_local_id().has_value()) {
-    entry["last_local_id"] = span->last_local_id().value();
+  if (const auto local_id = span->last_local_id(); local_id.has_value()) {
+    entry["last_local_id"] = std::string{ local_id.value() };
   }
 
-  if (span->last_remote_socket().has_value()) {
-    entry["last_remote_socket"] = span->last_remote_socket().value();
+  if (auto remote_socket = span->last_remote_socket(); remote_socket.has_value()) {
+    entry["last_remote_socket"] = std::move(remote_socket.value());
   }
 
   return { span->total_duration(), std::move(entry) };
@@ -283,21 +434,9 @@ public:
     }
   }
 
-private:
-  void rearm_threshold_reporter()
-  {
-    emit_threshold_report_.expires_after(options_.threshold_emit_interval);
-    emit_threshold_report_.async_wait([self = shared_from_this()](std::error_code ec) -> void {
-      if (ec == asio::error::operation_aborted) {
-        return;
-      }
-      self->log_threshold_report();
-      self->rearm_threshold_reporter();
-    });
-  }
-
-  void log_threshold_report()
+  auto flush_and_create_output() -> std::vector<std::string>
   {
+    std::vector<std::string> reports{};
     for (auto& [service, threshold_queue] : threshold_queues_) {
       if (threshold_queue.empty()) {
         continue;
@@ -321,7 +460,28 @@ private:
         queue.pop();
       }
       report["top"] = entries;
-      CB_LOG_WARNING("Operations over threshold: {}", utils::json::generate(report));
+      reports.emplace_back(utils::json::generate(report));
+    }
+    return reports;
+  }
+
+private:
+  void rearm_threshold_reporter()
+  {
+    emit_threshold_report_.expires_after(options_.threshold_emit_interval);
+    emit_threshold_report_.async_wait([self = shared_from_this()](std::error_code ec) -> void {
+      if (ec == asio::error::operation_aborted) {
+        return;
+      }
+      self->log_threshold_report();
+      self->rearm_threshold_reporter();
+    });
+  }
+
+  void log_threshold_report()
+  {
+    for (const auto& report : flush_and_create_output()) {
+      CB_LOG_WARNING("Operations over threshold: {}", report);
     }
   }
 
@@ -336,7 +496,11 @@ threshold_logging_tracer::start_span(std::string name,
                                      std::shared_ptr<couchbase::tracing::request_span> parent)
   -> std::shared_ptr<couchbase::tracing::request_span>
 {
-  return std::make_shared<threshold_logging_span>(std::move(name), shared_from_this(), parent);
+  return std::allocate_shared<threshold_logging_span>(
+    utils::thread_local_pool_allocator<threshold_logging_span>{},
+    std::move(name),
+    shared_from_this(),
+    std::move(parent));
 }
 
 void
@@ -352,6 +516,12 @@ threshold_logging_tracer::threshold_logging_tracer(asio::io_context& ctx,
 {
 }
 
+auto
+threshold_logging_tracer::flush_and_create_output() -> std::vector<std::string>
+{
+  return impl_->flush_and_create_output();
+}
+
 void
 threshold_logging_tracer::start()
 {
@@ -369,20 +539,20 @@ threshold_logging_span::end()
 {
   total_duration_ = std::chrono::duration_cast<std::chrono::microseconds>(
     std::chrono::system_clock::now() - start_);
-  if (service_.has_value()) {
+  if (has_service_tag_) {
     tracer_->report(shared_from_this());
   }
-  if (name() == tracing::operation::step_dispatch) {
-    // Transfer the relevant attributes to the operation-level span
+  if (is_dispatch_) {
+    // Transfer the relevant attributes to the operation-level span, into its inline slots.
     if (const auto p = std::dynamic_pointer_cast<threshold_logging_span>(parent()); p) {
-      if (last_local_id_.has_value()) {
-        p->set_last_local_id(last_local_id_.value());
+      if (const auto local_id = last_local_id_.value(); local_id.has_value()) {
+        p->set_last_local_id(local_id.value());
       }
-      if (operation_id_.has_value()) {
-        p->set_operation_id(operation_id_.value());
+      if (const auto operation_id = operation_id_.value(); operation_id.has_value()) {
+        p->set_operation_id(operation_id.value());
       }
-      if (peer_hostname_.has_value()) {
-        p->set_peer_hostname(peer_hostname_.value());
+      if (const auto hostname = peer_hostname_.value(); hostname.has_value()) {
+        p->set_peer_hostname(hostname.value());
       }
       if (peer_port_.has_value()) {
         p->set_peer_port(peer_port_.value());
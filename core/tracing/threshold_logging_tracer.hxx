@@ -25,6 +25,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace couchbase::core::tracing
 {
@@ -41,6 +42,13 @@ public:
   auto start_span(std::string name, std::shared_ptr<couchbase::tracing::request_span> parent)
     -> std::shared_ptr<couchbase::tracing::request_span> override;
   void report(const std::shared_ptr<threshold_logging_span>& span);
+
+  /**
+   * Builds a report for every service with operations over threshold since the previous report.
+   * This is what the tracer logs on every emit interval.
+   */
+  auto flush_and_create_output() -> std::vector<std::string>;
+
   void start() override;
   void stop() override;
 
@@ -19,6 +19,7 @@
 
 #include "constants.hxx"
 #include "core/logger/logger.hxx"
+#include "threshold_logging_tracer.hxx"
 
 namespace couchbase::core::tracing
 {
@@ -26,6 +27,7 @@ tracer_wrapper::tracer_wrapper(std::shared_ptr<couchbase::tracing::request_trace
                                std::shared_ptr<cluster_label_listener> label_listener)
   : tracer_{ std::move(tracer) }
   , cluster_label_listener_{ std::move(label_listener) }
+  , threshold_logging_{ std::dynamic_pointer_cast<threshold_logging_tracer>(tracer_) != nullptr }
 {
 }
 
@@ -47,7 +49,9 @@ tracer_wrapper::create_span(std::string span_name,
   -> std::shared_ptr<couchbase::tracing::request_span>
 {
   auto span = tracer_->start_span(std::move(span_name), std::move(parent_span));
-  if (!span->uses_tags()) {
+  if (threshold_logging_ || !span->uses_tags()) {
+    // the threshold logging tracer does not report the common attributes, so there is no need to
+    // look up the cluster labels for every span
     return span;
   }
 
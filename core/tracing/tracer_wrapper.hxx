@@ -51,5 +51,6 @@ public:
 private:
   std::shared_ptr<couchbase::tracing::request_tracer> tracer_;
   std::shared_ptr<couchbase::core::cluster_label_listener> cluster_label_listener_;
+  bool threshold_logging_{ false };
 };
 } // namespace couchbase::core::tracing
@@ -37,8 +37,9 @@ public:
   static auto get_atr(const core::cluster& cluster,
                       const core::document_id& atr_id) -> std::optional<active_transaction_record>;
 
-  active_transaction_record(core::document_id id, std::uint64_t, std::vector<atr_entry> entries)
+  active_transaction_record(core::document_id id, std::uint64_t cas, std::vector<atr_entry> entries)
     : id_(std::move(id))
+    , cas_(cas)
     , entries_(std::move(entries))
   {
   }
@@ -48,8 +49,14 @@ public:
     return entries_;
   }
 
+  [[nodiscard]] auto cas() const -> std::uint64_t
+  {
+    return cas_;
+  }
+
 private:
   core::document_id id_;
+  std::uint64_t cas_;
   std::vector<atr_entry> entries_;
 };
 
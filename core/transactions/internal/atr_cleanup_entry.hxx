@@ -93,6 +93,12 @@ public:
 
   void clean(transactions_cleanup_attempt* result = nullptr);
   [[nodiscard]] auto ready() const -> bool;
+
+  // how long to wait after an attempt is expired before cleaning it
+  [[nodiscard]] static auto safety_margin_ms() -> std::uint32_t
+  {
+    return safety_margin_ms_;
+  }
   [[nodiscard]] auto atr_id() const -> couchbase::core::document_id
   {
     return atr_id_;
@@ -79,6 +79,26 @@ public:
     return false;
   }
 
+  /**
+   * @return time left until has_expired() returns true, or empty optional if the entry never
+   * expires (it has no start timestamp)
+   */
+  [[nodiscard]] std::optional<std::chrono::milliseconds> time_until_expired(
+    std::uint32_t safety_margin = 0) const
+  {
+    if (!timestamp_start_ms_) {
+      return {};
+    }
+    const std::uint64_t cas_ms = cas_ / 1000000;
+    const std::uint64_t expires_at_ms =
+      *timestamp_start_ms_ + expires_after_ms_.value_or(0) + safety_margin;
+    if (cas_ms > expires_at_ms) {
+      return std::chrono::milliseconds::zero();
+    }
+    return std::chrono::milliseconds(
+      static_cast<std::chrono::milliseconds::rep>(expires_at_ms - cas_ms + 1));
+  }
+
   [[nodiscard]] std::uint32_t age_ms() const
   {
     return static_cast<std::uint32_t>((cas_ / 1000000) - timestamp_start_ms_.value_or(0));
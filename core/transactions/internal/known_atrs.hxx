@@ -0,0 +1,81 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace couchbase::core::transactions
+{
+/**
+ * ATRs of the collection without lost attempts, which the lost attempts cleanup has already read.
+ *
+ * Such ATR cannot contain attempts that become lost before its earliest pending attempt expires,
+ * as long as its CAS does not change. Until then, the next pass only compares the CAS, and does not
+ * read the attempts again.
+ */
+class known_atrs
+{
+public:
+  using clock = std::chrono::steady_clock;
+
+  /**
+   * @param recheck_in time left until the earliest pending attempt expires, or empty optional if
+   * the ATR has no attempts that might expire
+   */
+  void remember(const std::string& atr_key,
+                std::uint64_t cas,
+                std::optional<std::chrono::milliseconds> recheck_in,
+                clock::time_point now)
+  {
+    atrs_.insert_or_assign(
+      atr_key,
+      entry{ cas, recheck_in ? now + recheck_in.value() : clock::time_point::max() });
+  }
+
+  void forget(const std::string& atr_key)
+  {
+    atrs_.erase(atr_key);
+  }
+
+  /**
+   * @return the CAS, that the ATR must still have to be skipped, or empty optional if the ATR has
+   * to be read
+   */
+  [[nodiscard]] auto cas_to_probe(const std::string& atr_key, clock::time_point now) const
+    -> std::optional<std::uint64_t>
+  {
+    const auto it = atrs_.find(atr_key);
+    if (it == atrs_.end() || it->second.recheck_after <= now) {
+      return {};
+    }
+    return it->second.cas;
+  }
+
+private:
+  struct entry {
+    std::uint64_t cas;
+    clock::time_point recheck_after;
+  };
+
+  std::unordered_map<std::string, entry> atrs_{};
+};
+} // namespace couchbase::core::transactions
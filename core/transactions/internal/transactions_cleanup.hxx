@@ -19,12 +19,21 @@
 #include "atr_cleanup_entry.hxx"
 #include "client_record.hxx"
 #include "core/cluster.hxx"
+#include "core/transactions/active_transaction_record.hxx"
+#include "core/utils/movable_function.hxx"
 
 #include <couchbase/transactions/transactions_config.hxx>
 
 #include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <exception>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <unordered_set>
 
 namespace couchbase::core
 {
@@ -131,21 +140,48 @@ public:
                          std::vector<transactions_cleanup_attempt>& results) -> atr_cleanup_stats;
   auto get_active_clients(const couchbase::transactions::transaction_keyspace& keyspace,
                           const std::string& uuid) -> client_record_details;
+  void get_active_clients(
+    const couchbase::transactions::transaction_keyspace& keyspace,
+    const std::string& uuid,
+    utils::movable_function<void(std::exception_ptr, std::optional<client_record_details>)>&&
+      callback);
   void remove_client_record_from_all_buckets(const std::string& uuid);
   void start();
   void stop();
   void close();
 
 private:
+  // state of the lost attempts cleanup of a single collection, see clean_collection()
+  struct collection_cleanup;
+
+  // lets asynchronous callbacks detect, that the cleanup has been stopped in the meantime
+  struct lifetime {
+    std::recursive_mutex mutex{};
+    bool alive{ true };
+  };
+
+  struct lost_attempt {
+    atr_entry entry;
+    core::document_id atr_id;
+  };
+
   core::cluster cluster_;
   couchbase::transactions::transactions_config::built config_;
   const std::chrono::milliseconds cleanup_loop_delay_{ 100 };
+  const std::size_t max_concurrent_atr_fetches_{ 16 };
 
   std::thread cleanup_thr_;
   atr_cleanup_queue atr_queue_;
   mutable std::condition_variable cv_;
   mutable std::mutex mutex_;
-  std::list<std::thread> lost_attempt_cleanup_workers_;
+
+  std::shared_ptr<lifetime> lifetime_{};
+  std::list<std::shared_ptr<collection_cleanup>> collection_cleanups_;
+  std::thread lost_attempts_thr_;
+  std::deque<lost_attempt> lost_attempts_;
+  // IDs of the attempts in lost_attempts_ or being cleaned up, guarded by mutex_
+  std::unordered_set<std::string> queued_attempts_;
+  std::condition_variable lost_attempts_cv_;
 
   const std::string client_uuid_;
   std::list<couchbase::transactions::transaction_keyspace> collections_;
@@ -161,9 +197,21 @@ private:
   template<class R, class P>
   auto interruptable_wait(std::chrono::duration<R, P> time) -> bool;
 
+  template<typename Handler>
+  auto guarded(Handler&& handler);
+
   void lost_attempts_loop();
   void clean_collection(const couchbase::transactions::transaction_keyspace& keyspace);
-  void create_client_record(const couchbase::transactions::transaction_keyspace& keyspace);
+  void start_pass(const std::shared_ptr<collection_cleanup>& cleanup);
+  void schedule_pass(const std::shared_ptr<collection_cleanup>& cleanup,
+                     std::chrono::steady_clock::time_point at);
+  void dispatch_atr_fetches(const std::shared_ptr<collection_cleanup>& cleanup);
+  void fetch_atr(const std::shared_ptr<collection_cleanup>& cleanup, const std::string& atr_key);
+  void on_atr_fetched(const std::shared_ptr<collection_cleanup>& cleanup,
+                      const std::string& atr_key,
+                      std::error_code ec,
+                      std::optional<active_transaction_record> atr);
+  void on_atr_done(const std::shared_ptr<collection_cleanup>& cleanup);
   auto handle_atr_cleanup(const core::document_id& atr_id,
                           std::vector<transactions_cleanup_attempt>* result = nullptr)
     -> atr_cleanup_stats;
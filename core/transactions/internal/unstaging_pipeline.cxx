@@ -0,0 +1,141 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "unstaging_pipeline.hxx"
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <utility>
+
+namespace couchbase::core::transactions
+{
+auto
+unstaging_lanes(const std::vector<unstaging_placement>& placements)
+  -> std::vector<std::vector<std::size_t>>
+{
+  std::vector<std::size_t> order(placements.size());
+  std::iota(order.begin(), order.end(), std::size_t{ 0 });
+  std::stable_sort(order.begin(), order.end(), [&placements](auto lhs, auto rhs) {
+    const auto& l = placements[lhs];
+    const auto& r = placements[rhs];
+    return std::tie(l.bucket, l.node, l.vbucket) < std::tie(r.bucket, r.node, r.vbucket);
+  });
+
+  std::vector<std::vector<std::size_t>> lanes{};
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    const auto& current = placements[order[i]];
+    if (i == 0 || placements[order[i - 1]].bucket != current.bucket ||
+        placements[order[i - 1]].node != current.node) {
+      lanes.emplace_back();
+    }
+    lanes.back().push_back(order[i]);
+  }
+  return lanes;
+}
+
+unstaging_pipeline::unstaging_pipeline(std::vector<std::vector<std::size_t>> lanes,
+                                       std::size_t window,
+                                       unstage_function&& unstage,
+                                       done_handler&& callback)
+  : lanes_{ std::move(lanes) }
+  , positions_(lanes_.size(), 0)
+  , window_{ std::max<std::size_t>(window, 1) }
+  , unstage_{ std::move(unstage) }
+  , callback_{ std::move(callback) }
+{
+  for (const auto& lane : lanes_) {
+    remaining_ += lane.size();
+  }
+}
+
+void
+unstaging_pipeline::start()
+{
+  dispatch();
+}
+
+void
+unstaging_pipeline::on_unstaged(std::exception_ptr exc)
+{
+  {
+    const std::scoped_lock lock(mutex_);
+    --in_flight_;
+    if (exc && !error_) {
+      error_ = std::move(exc);
+    }
+  }
+  dispatch();
+}
+
+void
+unstaging_pipeline::dispatch()
+{
+  std::unique_lock lock(mutex_);
+  if (dispatching_) {
+    // the thread that is dispatching will notice the free slot
+    return;
+  }
+  dispatching_ = true;
+  while (!error_ && in_flight_ < window_) {
+    const auto index = next_locked();
+    if (index == no_mutation) {
+      break;
+    }
+    ++in_flight_;
+    lock.unlock();
+    try {
+      unstage_(index, [self = shared_from_this()](std::exception_ptr exc) {
+        self->on_unstaged(std::move(exc));
+      });
+      lock.lock();
+    } catch (...) {
+      lock.lock();
+      --in_flight_;
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+  }
+  dispatching_ = false;
+
+  if (in_flight_ > 0 || (remaining_ > 0 && !error_) || !callback_) {
+    return;
+  }
+  auto callback = std::move(callback_);
+  auto error = error_;
+  lock.unlock();
+  callback(std::move(error));
+}
+
+auto
+unstaging_pipeline::next_locked() -> std::size_t
+{
+  if (remaining_ == 0) {
+    return no_mutation;
+  }
+  for (std::size_t i = 0; i < lanes_.size(); ++i) {
+    const auto lane = (next_lane_ + i) % lanes_.size();
+    if (positions_[lane] < lanes_[lane].size()) {
+      next_lane_ = lane + 1;
+      --remaining_;
+      return lanes_[lane][positions_[lane]++];
+    }
+  }
+  return no_mutation;
+}
+} // namespace couchbase::core::transactions
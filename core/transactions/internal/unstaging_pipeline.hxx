@@ -0,0 +1,93 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/utils/movable_function.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace couchbase::core::transactions
+{
+/**
+ * Location of the staged mutation in the cluster.
+ */
+struct unstaging_placement {
+  /** identifies the bucket (any value that is the same for all documents of the bucket) */
+  std::size_t bucket{ 0 };
+  /** index of the node in the bucket configuration, or max() if it is not known */
+  std::size_t node{ std::numeric_limits<std::size_t>::max() };
+  std::uint16_t vbucket{ 0 };
+};
+
+/**
+ * Groups the mutations into lanes, one lane per node of each bucket. The mutations of the lane are
+ * ordered by vBucket, otherwise the order of the staging is preserved.
+ *
+ * @return indexes of the mutations for each lane
+ */
+auto
+unstaging_lanes(const std::vector<unstaging_placement>& placements)
+  -> std::vector<std::vector<std::size_t>>;
+
+/**
+ * Unstages the mutations of the transaction without blocking the caller.
+ *
+ * The lanes are drained round-robin, so that requests to all nodes are interleaved, and at most
+ * `window` mutations are unstaged at any moment: each completion starts the next mutation. After
+ * the first failure no more mutations are started, and once the in-flight mutations have finished,
+ * the callback receives the first error.
+ */
+class unstaging_pipeline : public std::enable_shared_from_this<unstaging_pipeline>
+{
+public:
+  using done_handler = utils::movable_function<void(std::exception_ptr)>;
+  using unstage_function = utils::movable_function<void(std::size_t index, done_handler&& done)>;
+
+  unstaging_pipeline(std::vector<std::vector<std::size_t>> lanes,
+                     std::size_t window,
+                     unstage_function&& unstage,
+                     done_handler&& callback);
+
+  void start();
+
+private:
+  void on_unstaged(std::exception_ptr exc);
+  void dispatch();
+  auto next_locked() -> std::size_t;
+
+  static constexpr std::size_t no_mutation{ std::numeric_limits<std::size_t>::max() };
+
+  std::mutex mutex_{};
+  std::vector<std::vector<std::size_t>> lanes_;
+  std::vector<std::size_t> positions_;
+  std::size_t next_lane_{ 0 };
+  std::size_t remaining_{ 0 };
+  std::size_t in_flight_{ 0 };
+  std::size_t window_;
+  bool dispatching_{ false };
+  std::exception_ptr error_{};
+  unstage_function unstage_;
+  done_handler callback_;
+};
+} // namespace couchbase::core::transactions
@@ -23,6 +23,7 @@
 #include "core/impl/subdoc/path_flags.hxx"
 #include "core/logger/logger.hxx"
 #include "core/operations.hxx"
+#include "core/topology/configuration.hxx"
 #include "core/transactions/internal/logging.hxx"
 #include "internal/transaction_context.hxx"
 #include "internal/transaction_fields.hxx"
@@ -33,6 +34,10 @@
 #include <asio/bind_executor.hpp>
 #include <asio/post.hpp>
 
+#include <algorithm>
+#include <future>
+#include <string_view>
+
 namespace couchbase::core::transactions
 {
 staged_mutation::staged_mutation(staged_mutation_type type,
@@ -129,40 +134,6 @@ staged_mutation::cas(couchbase::cas cas)
   cas_ = cas;
 }
 
-auto
-unstaging_state::wait_until_unstage_possible() -> bool
-{
-  std::unique_lock lock(mutex_);
-  auto success = cv_.wait_for(lock, ctx_->overall()->remaining(), [this] {
-    return (in_flight_count_ < MAX_PARALLELISM) || abort_;
-  });
-  if (!abort_) {
-    if (success) {
-      in_flight_count_++;
-    } else {
-      abort_ = true;
-    }
-  }
-  return !abort_;
-}
-
-void
-unstaging_state::notify_unstage_complete()
-{
-  const std::scoped_lock lock(mutex_);
-  in_flight_count_--;
-  cv_.notify_one();
-}
-
-void
-unstaging_state::notify_unstage_error()
-{
-  const std::scoped_lock lock(mutex_);
-  abort_ = true;
-  in_flight_count_--;
-  cv_.notify_all();
-}
-
 auto
 staged_mutation_queue::empty() -> bool
 {
@@ -298,182 +269,155 @@ staged_mutation_queue::iterate(const std::function<void(staged_mutation&)>& op)
 void
 staged_mutation_queue::commit(const std::shared_ptr<attempt_context_impl>& ctx)
 {
-  CB_ATTEMPT_CTX_LOG_TRACE(ctx, "committing staged mutations...");
   const std::scoped_lock<std::mutex> lock(mutex_);
-
-  unstaging_state state{ ctx };
-  std::vector<std::future<void>> futures{};
-  futures.reserve(queue_.size());
-
-  bool aborted = false;
-
-  for (auto& item : queue_) {
-    aborted = !state.wait_until_unstage_possible();
-    if (aborted) {
-      // Do not commit any more mutations
-      break;
+  auto barrier = std::make_shared<std::promise<void>>();
+  auto future = barrier->get_future();
+  commit(ctx, [barrier](std::exception_ptr exc) {
+    if (exc) {
+      return barrier->set_exception(std::move(exc));
     }
+    barrier->set_value();
+  });
+  future.get();
+}
 
-    auto barrier = std::make_shared<std::promise<void>>();
-    auto future = barrier->get_future();
-
+void
+staged_mutation_queue::commit(const std::shared_ptr<attempt_context_impl>& ctx,
+                              utils::movable_function<void(std::exception_ptr)>&& callback)
+{
+  CB_ATTEMPT_CTX_LOG_TRACE(ctx, "committing staged mutations...");
+  auto unstage_item = [this, ctx](std::size_t index, unstaging_pipeline::done_handler&& done) {
+    auto& item = queue_[index];
     try {
-      auto timer = std::make_shared<asio::steady_timer>(ctx->cluster_ref().io_context());
-      async_constant_delay delay(timer);
-
+      async_constant_delay delay(ctx->cluster_ref().io_context());
       switch (item.type()) {
         case staged_mutation_type::REMOVE:
-          remove_doc(ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-            if (exc) {
-              state.notify_unstage_error();
-              barrier->set_exception(exc);
-            } else {
-              state.notify_unstage_complete();
-              barrier->set_value();
-            }
-          });
-          break;
+          return remove_doc(ctx, item, delay, std::move(done));
         case staged_mutation_type::INSERT:
         case staged_mutation_type::REPLACE:
-          commit_doc(ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-            if (exc) {
-              state.notify_unstage_error();
-              barrier->set_exception(exc);
-            } else {
-              state.notify_unstage_complete();
-              barrier->set_value();
-            }
-          });
-          break;
+          return commit_doc(ctx, item, delay, std::move(done));
       }
     } catch (...) {
-      // This should not happen, but catching it to ensure that we wait for in-flight operations
+      // This should not happen, but failing the mutation ensures that the rest of the commit is
+      // aborted once the in-flight operations have finished
       CB_ATTEMPT_CTX_LOG_ERROR(ctx,
                                "caught exception while trying to initiate commit for {}. Aborting "
-                               "rest of commit and waiting for "
-                               "in-flight rollback operations to finish",
+                               "rest of commit and waiting for in-flight operations to finish",
                                item.id());
-      aborted = true;
-      break;
-    }
-
-#ifdef __clang_analyzer__
-    // TODO(CXXCBC-549): clang-tidy reports potential memory leak here
-    [[clang::suppress]]
-#endif
-    futures.push_back(std::move(future));
-  }
-
-  std::exception_ptr exc{};
-  for (auto& future : futures) {
-    try {
-      future.get();
-    } catch (...) {
-      if (!exc) {
-        exc = std::current_exception();
-      }
+      done(std::make_exception_ptr(transaction_operation_failed(FAIL_OTHER, "commit aborted")
+                                     .no_rollback()
+                                     .failed_post_commit()));
     }
-  }
-  if (exc) {
-    rethrow_exception(exc);
-  }
-  if (aborted) {
-    // Commit was aborted but no exception was raised from the futures (possibly timeout during
-    // wait_until_unstage_possible())
-    throw transaction_operation_failed(FAIL_OTHER, "commit aborted")
-      .no_rollback()
-      .failed_post_commit();
-  }
+  };
+  unstage(ctx, std::move(unstage_item), std::move(callback));
 }
 
 void
 staged_mutation_queue::rollback(const std::shared_ptr<attempt_context_impl>& ctx)
 {
-  CB_ATTEMPT_CTX_LOG_TRACE(ctx, "rolling back staged mutations...");
   const std::scoped_lock<std::mutex> lock(mutex_);
-
-  unstaging_state state{ ctx };
-  std::vector<std::future<void>> futures{};
-  futures.reserve(queue_.size());
-
-  bool aborted = false;
-
-  for (auto& item : queue_) {
-    aborted = !state.wait_until_unstage_possible();
-    if (aborted) {
-      // Do not roll back any more mutations
-      break;
+  auto barrier = std::make_shared<std::promise<void>>();
+  auto future = barrier->get_future();
+  rollback(ctx, [barrier](std::exception_ptr exc) {
+    if (exc) {
+      return barrier->set_exception(std::move(exc));
     }
+    barrier->set_value();
+  });
+  future.get();
+}
 
-    auto barrier = std::make_shared<std::promise<void>>();
-    auto future = barrier->get_future();
-
+void
+staged_mutation_queue::rollback(const std::shared_ptr<attempt_context_impl>& ctx,
+                                utils::movable_function<void(std::exception_ptr)>&& callback)
+{
+  CB_ATTEMPT_CTX_LOG_TRACE(ctx, "rolling back staged mutations...");
+  auto unstage_item = [this, ctx](std::size_t index, unstaging_pipeline::done_handler&& done) {
+    const auto& item = queue_[index];
     try {
-      auto timer = std::make_shared<asio::steady_timer>(ctx->cluster_ref().io_context());
-      async_exp_delay delay(timer);
-
+      async_exp_delay delay(ctx->cluster_ref().io_context());
       switch (item.type()) {
         case staged_mutation_type::INSERT:
-          rollback_insert(ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-            if (exc) {
-              state.notify_unstage_error();
-              barrier->set_exception(exc);
-            } else {
-              state.notify_unstage_complete();
-              barrier->set_value();
-            }
-          });
-          break;
+          return rollback_insert(ctx, item, delay, std::move(done));
         case staged_mutation_type::REMOVE:
         case staged_mutation_type::REPLACE:
-          rollback_remove_or_replace(
-            ctx, item, delay, [&state, barrier](const std::exception_ptr& exc) {
-              if (exc) {
-                state.notify_unstage_error();
-                barrier->set_exception(exc);
-              } else {
-                state.notify_unstage_complete();
-                barrier->set_value();
-              }
-            });
-          break;
+          return rollback_remove_or_replace(ctx, item, delay, std::move(done));
       }
     } catch (...) {
-      // This should not happen, but catching it to ensure that we wait for in-flight operations
+      // This should not happen, but failing the mutation ensures that the rest of the rollback is
+      // aborted once the in-flight operations have finished
       CB_ATTEMPT_CTX_LOG_ERROR(ctx,
                                "caught exception while trying to initiate rollback for {}. "
-                               "Aborting rollback and waiting for "
-                               "in-flight rollback operations to finish",
+                               "Aborting rollback and waiting for in-flight operations to finish",
                                item.id());
-      aborted = true;
-      break;
+      done(std::make_exception_ptr(
+        transaction_operation_failed(FAIL_OTHER, "rollback aborted").no_rollback()));
     }
+  };
+  unstage(ctx, std::move(unstage_item), std::move(callback));
+}
 
-#ifdef __clang_analyzer__
-    // TODO(CXXCBC-549): clang-tidy reports potential memory leak here
-    [[clang::suppress]]
-#endif
-    futures.push_back(std::move(future));
-  }
-
-  std::exception_ptr exc{};
-  for (auto& future : futures) {
-    try {
-      future.get();
-    } catch (...) {
-      if (!exc) {
-        exc = std::current_exception();
-      }
+void
+staged_mutation_queue::unstage(const std::shared_ptr<attempt_context_impl>& ctx,
+                               unstaging_pipeline::unstage_function&& unstage_item,
+                               utils::movable_function<void(std::exception_ptr)>&& callback)
+{
+  auto placements = std::make_shared<std::vector<unstaging_placement>>(queue_.size());
+  std::vector<std::string_view> buckets{};
+  for (std::size_t i = 0; i < queue_.size(); ++i) {
+    const auto& bucket = queue_[i].id().bucket();
+    auto known = std::find(buckets.begin(), buckets.end(), bucket);
+    (*placements)[i].bucket = static_cast<std::size_t>(std::distance(buckets.begin(), known));
+    if (known == buckets.end()) {
+      buckets.emplace_back(bucket);
     }
   }
-  if (exc) {
-    rethrow_exception(exc);
-  }
-  if (aborted) {
-    // Rollback was aborted but no exception was raised from the futures (possibly timeout during
-    // wait_until_unstage_possible())
-    throw transaction_operation_failed(FAIL_OTHER, "rollback aborted").no_rollback();
+
+  auto start_pipeline = [ctx,
+                         placements,
+                         unstage_item = std::move(unstage_item),
+                         callback = std::move(callback)]() mutable {
+    auto pipeline = std::make_shared<unstaging_pipeline>(unstaging_lanes(*placements),
+                                                         ctx->overall()->config().unstaging_window,
+                                                         std::move(unstage_item),
+                                                         std::move(callback));
+    pipeline->start();
+  };
+  locate(ctx, placements, 0, std::move(start_pipeline));
+}
+
+void
+staged_mutation_queue::locate(const std::shared_ptr<attempt_context_impl>& ctx,
+                              std::shared_ptr<std::vector<unstaging_placement>> placements,
+                              std::size_t bucket_index,
+                              utils::movable_function<void()>&& callback)
+{
+  auto first = std::find_if(placements->begin(), placements->end(), [bucket_index](const auto& p) {
+    return p.bucket == bucket_index;
+  });
+  if (first == placements->end()) {
+    // the buckets are numbered sequentially, so all of them have been located
+    return callback();
   }
+  const auto& bucket = queue_[static_cast<std::size_t>(first - placements->begin())].id().bucket();
+  ctx->cluster_ref().with_bucket_configuration(
+    bucket,
+    [this, ctx, placements, bucket_index, callback = std::move(callback)](
+      std::error_code ec, const std::shared_ptr<topology::configuration>& config) mutable {
+      if (!ec && config && config->vbmap.has_value()) {
+        for (std::size_t i = 0; i < queue_.size(); ++i) {
+          auto& placement = (*placements)[i];
+          if (placement.bucket != bucket_index) {
+            continue;
+          }
+          auto [vbucket, node] = config->map_key(queue_[i].id().key(), 0);
+          placement.vbucket = vbucket;
+          placement.node = node.value_or(placement.node);
+        }
+      }
+      // without configuration the mutations of the bucket are unstaged in the staging order
+      locate(ctx, std::move(placements), bucket_index + 1, std::move(callback));
+    });
 }
 
 void
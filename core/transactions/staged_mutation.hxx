@@ -17,6 +17,7 @@
 #pragma once
 
 #include "attempt_context_impl.hxx"
+#include "internal/unstaging_pipeline.hxx"
 #include "internal/utils.hxx"
 #include "transaction_get_result.hxx"
 #include "uid_generator.hxx"
@@ -77,20 +78,6 @@ private:
   std::string operation_id_;
 };
 
-struct unstaging_state {
-  static constexpr std::size_t MAX_PARALLELISM{ 1000 };
-
-  std::shared_ptr<attempt_context_impl> ctx_;
-  std::mutex mutex_{};
-  std::condition_variable cv_{};
-  std::atomic_size_t in_flight_count_{ 0 };
-  bool abort_{ false };
-
-  auto wait_until_unstage_possible() -> bool;
-  void notify_unstage_complete();
-  void notify_unstage_error();
-};
-
 class staged_mutation_queue
 {
 private:
@@ -160,12 +147,29 @@ private:
                                   async_exp_delay& delay,
                                   utils::movable_function<void(std::exception_ptr)> callback);
 
+  void unstage(const std::shared_ptr<attempt_context_impl>& ctx,
+               unstaging_pipeline::unstage_function&& unstage_item,
+               utils::movable_function<void(std::exception_ptr)>&& callback);
+  void locate(const std::shared_ptr<attempt_context_impl>& ctx,
+              std::shared_ptr<std::vector<unstaging_placement>> placements,
+              std::size_t bucket_index,
+              utils::movable_function<void()>&& callback);
+
 public:
   auto empty() -> bool;
   void add(staged_mutation&& mutation);
   void extract_to(const std::string& prefix, core::operations::mutate_in_request& req);
   void commit(const std::shared_ptr<attempt_context_impl>& ctx);
   void rollback(const std::shared_ptr<attempt_context_impl>& ctx);
+
+  /**
+   * Unstages the mutations without blocking, the callback is invoked once all of them are done.
+   * The queue must not be modified until then.
+   */
+  void commit(const std::shared_ptr<attempt_context_impl>& ctx,
+              utils::movable_function<void(std::exception_ptr)>&& callback);
+  void rollback(const std::shared_ptr<attempt_context_impl>& ctx,
+                utils::movable_function<void(std::exception_ptr)>&& callback);
   void iterate(const std::function<void(staged_mutation&)>&);
   void remove_any(const core::document_id&);
 
@@ -37,7 +37,8 @@ transaction_options::apply(const transactions_config::built& conf) const
            cleanup_hooks_ ? cleanup_hooks_ : conf.cleanup_hooks,
            metadata_collection_ ? metadata_collection_ : conf.metadata_collection,
            query_config,
-           conf.cleanup_config };
+           conf.cleanup_config,
+           conf.unstaging_window };
 }
 
 auto
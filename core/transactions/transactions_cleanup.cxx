@@ -21,6 +21,7 @@
 #include "uid_generator.hxx"
 
 #include "internal/client_record.hxx"
+#include "internal/known_atrs.hxx"
 #include "internal/logging.hxx"
 #include "internal/transaction_fields.hxx"
 #include "internal/transactions_cleanup.hxx"
@@ -31,7 +32,11 @@
 
 #include <couchbase/fmt/transaction_keyspace.hxx>
 
+#include <asio/steady_timer.hpp>
+
+#include <algorithm>
 #include <functional>
+#include <future>
 #include <memory>
 #include <utility>
 
@@ -82,10 +87,302 @@ parse_mutation_cas(const std::string& cas) -> std::uint64_t
 
 // TODO(CXXCBC-549)
 const std::string CLIENT_RECORD_DOC_ID = "_txn:client-record"; // NOLINT(cert-err58-cpp)
-} // namespace
 
 constexpr auto SAFETY_MARGIN_EXPIRY_MS = 2000;
 
+using client_record_callback =
+  utils::movable_function<void(std::exception_ptr, std::optional<client_record_details>)>;
+
+// everything the client record operations need, so that they do not depend on the lifetime of the
+// transactions_cleanup
+struct client_record_context {
+  core::cluster cluster;
+  std::shared_ptr<cleanup_testing_hooks> hooks;
+  couchbase::durability_level level;
+  std::chrono::milliseconds cleanup_window;
+  couchbase::transactions::transaction_keyspace keyspace;
+  std::string uuid;
+
+  [[nodiscard]] auto record_id() const -> document_id
+  {
+    return { keyspace.bucket, keyspace.scope, keyspace.collection, CLIENT_RECORD_DOC_ID };
+  }
+};
+
+void
+read_client_record(const std::shared_ptr<const client_record_context>& ctx,
+                   client_record_callback&& callback);
+
+void
+create_client_record(const std::shared_ptr<const client_record_context>& ctx,
+                     utils::movable_function<void(std::exception_ptr)>&& callback)
+{
+  ctx->hooks->client_record_before_create(
+    ctx->keyspace.bucket,
+    [ctx, callback = std::move(callback)](std::optional<error_class> ec) mutable {
+      if (ec) {
+        return callback(std::make_exception_ptr(
+          client_error(*ec, "client_record_before_create hook raised error")));
+      }
+      core::operations::mutate_in_request req{ ctx->record_id() };
+      req.store_semantics = couchbase::store_semantics::insert;
+      req.specs =
+        couchbase::mutate_in_specs{
+          couchbase::mutate_in_specs::insert("records.clients", tao::json::empty_object)
+            .xattr()
+            .create_path(),
+          // subdoc::opcode::set_doc used in replace w/ empty path
+          // ExtBinaryMetadata
+          couchbase::mutate_in_specs::replace_raw({}, std::vector<std::byte>{ std::byte{ 0x00 } }),
+        }
+          .specs();
+      wrap_durable_request(req, ctx->level);
+      ctx->cluster.execute(req, [callback = std::move(callback)](auto&& resp) mutable {
+        std::exception_ptr err{};
+        try {
+          auto res = result::create_from_subdoc_response(resp);
+          validate_operation_result(res);
+        } catch (const client_error& e) {
+          CB_LOST_ATTEMPT_CLEANUP_LOG_TRACE("create_client_record got error {}", e.what());
+          if (e.ec() == FAIL_DOC_ALREADY_EXISTS) {
+            CB_LOST_ATTEMPT_CLEANUP_LOG_TRACE("client record already exists, moving on");
+          } else {
+            err = std::current_exception();
+          }
+        } catch (...) {
+          err = std::current_exception();
+        }
+        callback(err);
+      });
+    });
+}
+
+void
+recreate_client_record(const std::shared_ptr<const client_record_context>& ctx,
+                       client_record_callback&& callback)
+{
+  CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("client record not found, creating new one");
+  create_client_record(ctx,
+                       [ctx, callback = std::move(callback)](std::exception_ptr err) mutable {
+                         if (err) {
+                           return callback(err, {});
+                         }
+                         read_client_record(ctx, std::move(callback));
+                       });
+}
+
+auto
+parse_client_record(const result& res, const std::string& uuid) -> client_record_details
+{
+  client_record_details details;
+  std::vector<std::string> active_client_uids;
+  auto hlc = res.values[1].content_as();
+  auto now_ms = now_ns_from_vbucket(hlc) / 1000000;
+  details.override_enabled = false;
+  details.override_expires = 0;
+  if (res.values[0].status == subdoc_result::status_type::success) {
+    auto records = res.values[0].content_as();
+    CB_LOST_ATTEMPT_CLEANUP_LOG_TRACE("client records: {}", core::utils::json::generate(records));
+    for (const auto& [key, value] : records.get_object()) {
+      if (key == "override") {
+        for (const auto& [over_ride, param] : value.get_object()) {
+          if (over_ride == "enabled") {
+            details.override_enabled = param.get_boolean();
+          } else if (over_ride == "expires") {
+            details.override_expires = param.as<std::uint64_t>();
+          }
+        }
+      } else if (key == "clients") {
+        for (const auto& [other_client_uuid, cl] : value.get_object()) {
+          const std::uint64_t heartbeat_ms = parse_mutation_cas(cl.at("heartbeat_ms").get_string());
+          auto expires_ms = cl.at("expires_ms").as<std::uint64_t>();
+          auto expired_period =
+            static_cast<std::int64_t>(now_ms) - static_cast<std::int64_t>(heartbeat_ms);
+          const bool has_expired =
+            expired_period >= static_cast<std::int64_t>(expires_ms) && now_ms > heartbeat_ms;
+          if (has_expired && other_client_uuid != uuid) {
+            details.expired_client_ids.push_back(other_client_uuid);
+          } else {
+            active_client_uids.push_back(other_client_uuid);
+          }
+        }
+      }
+    }
+  }
+  if (std::find(active_client_uids.begin(), active_client_uids.end(), uuid) ==
+      active_client_uids.end()) {
+    active_client_uids.push_back(uuid);
+  }
+  std::sort(active_client_uids.begin(), active_client_uids.end());
+  auto this_idx =
+    std::distance(active_client_uids.begin(),
+                  std::find(active_client_uids.begin(), active_client_uids.end(), uuid));
+  details.num_active_clients = static_cast<std::uint32_t>(active_client_uids.size());
+  details.index_of_this_client = static_cast<std::uint32_t>(this_idx);
+  details.num_expired_clients = static_cast<std::uint32_t>(details.expired_client_ids.size());
+  details.num_existing_clients = details.num_expired_clients + details.num_active_clients;
+  details.client_uuid = uuid;
+  details.cas_now_nanos = now_ms * 1000000;
+  details.override_active =
+    (details.override_enabled && details.override_expires > details.cas_now_nanos);
+  CB_LOST_ATTEMPT_CLEANUP_LOG_TRACE("client details {}", details);
+  return details;
+}
+
+void
+update_client_record(const std::shared_ptr<const client_record_context>& ctx,
+                     client_record_details details,
+                     client_record_callback&& callback)
+{
+  ctx->hooks->client_record_before_update(
+    ctx->keyspace.bucket,
+    [ctx, details = std::move(details), callback = std::move(callback)](
+      std::optional<error_class> ec) mutable {
+      if (ec) {
+        return callback(std::make_exception_ptr(
+                          client_error(*ec, "client_record_before_update hook raised error")),
+                        {});
+      }
+      // update client record, maybe cleanup some as well...
+      core::operations::mutate_in_request mutate_req{ ctx->record_id() };
+      auto mut_specs = couchbase::mutate_in_specs{
+        couchbase::mutate_in_specs::upsert(
+          fmt::format("records.clients.{}.heartbeat_ms", ctx->uuid), subdoc::mutate_in_macro::cas)
+          .xattr()
+          .create_path(),
+        couchbase::mutate_in_specs::upsert(fmt::format("records.clients.{}.expires_ms", ctx->uuid),
+                                           (ctx->cleanup_window.count() / 2) +
+                                             SAFETY_MARGIN_EXPIRY_MS)
+          .xattr()
+          .create_path(),
+        couchbase::mutate_in_specs::upsert(fmt::format("records.clients.{}.num_atrs", ctx->uuid),
+                                           atr_ids::all().size())
+          .xattr()
+          .create_path(),
+      };
+      for (std::size_t idx = 0;
+           idx < std::min(details.expired_client_ids.size(), static_cast<std::size_t>(12));
+           idx++) {
+        CB_LOST_ATTEMPT_CLEANUP_LOG_TRACE(
+          "adding {} to list of clients to be removed when updating this client",
+          details.expired_client_ids[idx]);
+        mut_specs.push_back(couchbase::mutate_in_specs::remove(
+                              fmt::format("records.clients.{}", details.expired_client_ids[idx]))
+                              .xattr());
+      }
+      mutate_req.specs = mut_specs.specs();
+      wrap_durable_request(mutate_req, ctx->level);
+      CB_LOST_ATTEMPT_CLEANUP_LOG_TRACE("updating record");
+      ctx->cluster.execute(
+        mutate_req,
+        [ctx, details = std::move(details), callback = std::move(callback)](auto&& resp) mutable {
+          std::exception_ptr err{};
+          bool missing = false;
+          try {
+            auto res = result::create_from_subdoc_response(resp);
+            validate_operation_result(res);
+            // just update the cas, and return the details
+            details.cas_now_nanos = res.cas;
+          } catch (const client_error& e) {
+            missing = e.ec() == FAIL_DOC_NOT_FOUND;
+            err = std::current_exception();
+          } catch (...) {
+            err = std::current_exception();
+          }
+          if (missing) {
+            return recreate_client_record(ctx, std::move(callback));
+          }
+          if (err) {
+            return callback(err, {});
+          }
+          CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("get_active_clients found {}", details);
+          callback({}, std::move(details));
+        });
+    });
+}
+
+void
+read_client_record(const std::shared_ptr<const client_record_context>& ctx,
+                   client_record_callback&& callback)
+{
+  ctx->hooks->client_record_before_get(
+    ctx->keyspace.bucket,
+    [ctx, callback = std::move(callback)](std::optional<error_class> ec) mutable {
+      if (ec) {
+        return callback(
+          std::make_exception_ptr(client_error(*ec, "client_record_before_get hook raised error")),
+          {});
+      }
+      core::operations::lookup_in_request req{ ctx->record_id() };
+      req.specs =
+        lookup_in_specs{
+          lookup_in_specs::get("records").xattr(),
+          lookup_in_specs::get(subdoc::lookup_in_macro::vbucket).xattr(),
+        }
+          .specs();
+      ctx->cluster.execute(req, [ctx, callback = std::move(callback)](auto&& resp) mutable {
+        std::optional<client_record_details> details{};
+        std::exception_ptr err{};
+        bool missing = false;
+        try {
+          auto res = result::create_from_subdoc_response(resp);
+          validate_operation_result(res);
+          details = parse_client_record(res, ctx->uuid);
+        } catch (const client_error& e) {
+          missing = e.ec() == FAIL_DOC_NOT_FOUND;
+          err = std::current_exception();
+        } catch (...) {
+          err = std::current_exception();
+        }
+        if (missing) {
+          return recreate_client_record(ctx, std::move(callback));
+        }
+        if (err) {
+          return callback(err, {});
+        }
+        if (details->override_active) {
+          CB_LOST_ATTEMPT_CLEANUP_LOG_TRACE("override enabled, will not update record");
+          return callback({}, std::move(details));
+        }
+        update_client_record(ctx, std::move(details.value()), std::move(callback));
+      });
+    });
+}
+
+void
+log_cleanup_failure(const std::exception_ptr& err)
+{
+  try {
+    std::rethrow_exception(err);
+  } catch (const std::exception& e) {
+    CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR("cleanup failed with {}, trying again in 3 sec...",
+                                      e.what());
+  } catch (...) {
+    CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR("cleanup failed, trying again in 3 sec...");
+  }
+}
+} // namespace
+
+struct transactions_cleanup::collection_cleanup {
+  collection_cleanup(asio::io_context& ctx, couchbase::transactions::transaction_keyspace ks)
+    : keyspace{ std::move(ks) }
+    , timer{ ctx }
+  {
+  }
+
+  couchbase::transactions::transaction_keyspace keyspace;
+  asio::steady_timer timer;
+  bool pass_running{ false };
+  std::vector<std::string> atr_keys{};
+  std::size_t next_atr{ 0 };
+  std::size_t in_flight{ 0 };
+  std::size_t unchanged_atrs{ 0 };
+  std::chrono::steady_clock::time_point pass_start{};
+  std::chrono::steady_clock::duration atr_interval{};
+  // ATRs without lost attempts, that do not have to be read again until they change
+  known_atrs known{};
+};
+
 template<class R, class P>
 auto
 transactions_cleanup::interruptable_wait(std::chrono::duration<R, P> time) -> bool
@@ -101,91 +398,248 @@ transactions_cleanup::interruptable_wait(std::chrono::duration<R, P> time) -> bo
   return running_;
 }
 
+template<typename Handler>
+auto
+transactions_cleanup::guarded(Handler&& handler)
+{
+  return [lifetime = lifetime_, handler = std::forward<Handler>(handler)](auto&&... args) mutable {
+    const std::scoped_lock lock(lifetime->mutex);
+    if (lifetime->alive) {
+      handler(std::forward<decltype(args)>(args)...);
+    }
+  };
+}
+
+// Lost attempts are looked for in passes over the ATRs of the collection, that this client is
+// responsible for. Each pass is spread over the cleanup window, and driven by the timer on the I/O
+// executor. Only the attempts, that have already expired, are handed over to lost_attempts_loop().
+//
+// Must be called while holding the lifetime lock.
 void
 transactions_cleanup::clean_collection(
   const couchbase::transactions::transaction_keyspace& keyspace)
 {
-  // first make sure the collection is in the list
-  while (is_running()) {
-    {
-      const std::scoped_lock<std::mutex> lock(mutex_);
-      if (collections_.end() == std::find(collections_.begin(), collections_.end(), keyspace)) {
-        CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG(
-          "cleanup for {} ending, no longer in collection cleanup list", keyspace);
-        return;
-      }
-    }
-    CB_LOST_ATTEMPT_CLEANUP_LOG_INFO("cleanup for {} starting", keyspace);
-    // we are running, and collection is in the list, so lets clean it.
-    try {
-      auto details = get_active_clients(keyspace, client_uuid_);
-
-      auto all_atrs = atr_ids::all();
+  CB_LOST_ATTEMPT_CLEANUP_LOG_INFO("cleanup for {} starting", keyspace);
+  auto cleanup = std::make_shared<collection_cleanup>(cluster_.io_context(), keyspace);
+  collection_cleanups_.emplace_back(cleanup);
+  start_pass(cleanup);
+}
 
-      const auto cleanup_window = std::chrono::duration_cast<std::chrono::microseconds>(
-        config_.cleanup_config.cleanup_window);
-      auto start = std::chrono::steady_clock::now();
+void
+transactions_cleanup::start_pass(const std::shared_ptr<collection_cleanup>& cleanup)
+{
+  get_active_clients(
+    cleanup->keyspace,
+    client_uuid_,
+    guarded([this, cleanup](std::exception_ptr err, std::optional<client_record_details> details) {
+      if (err) {
+        // we must have gotten an exception trying to get the client records
+        log_cleanup_failure(err);
+        return schedule_pass(cleanup, std::chrono::steady_clock::now() + std::chrono::seconds(3));
+      }
+      const auto& all_atrs = atr_ids::all();
+      const std::size_t stride = std::max<std::size_t>(1, details->num_active_clients);
+      cleanup->atr_keys.clear();
+      for (std::size_t idx = details->index_of_this_client; idx < all_atrs.size(); idx += stride) {
+        cleanup->atr_keys.emplace_back(all_atrs[idx]);
+      }
       CB_LOST_ATTEMPT_CLEANUP_LOG_INFO(
         "{} active clients (including this one), {} ATRs to check in {}ms",
-        details.num_active_clients,
-        all_atrs.size(),
+        details->num_active_clients,
+        cleanup->atr_keys.size(),
         config_.cleanup_config.cleanup_window.count());
 
-      for (auto it = all_atrs.begin() + details.index_of_this_client; it < all_atrs.end();
-           it += details.num_active_clients) {
-        auto atrs_left_for_this_client =
-          std::distance(it, all_atrs.end()) /
-          std::max<decltype(it)::difference_type>(1, details.num_active_clients);
-        const auto now = std::chrono::steady_clock::now();
-        const auto elapsed_in_cleanup_window =
-          std::chrono::duration_cast<std::chrono::microseconds>(now - start);
-        const auto remaining_in_cleanup_window = cleanup_window - elapsed_in_cleanup_window;
-        const auto budget_for_this_atr = std::chrono::microseconds(
-          remaining_in_cleanup_window.count() /
-          std::max<decltype(it)::difference_type>(1, atrs_left_for_this_client));
-        // clean the ATR entry
-        std::string atr_id = *it;
-        if (!is_running()) {
-          CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("cleanup of {} complete", keyspace);
+      cleanup->pass_running = true;
+      cleanup->pass_start = std::chrono::steady_clock::now();
+      const auto number_of_atrs = std::max<std::size_t>(1, cleanup->atr_keys.size());
+      cleanup->atr_interval =
+        std::chrono::steady_clock::duration(config_.cleanup_config.cleanup_window) /
+        static_cast<std::chrono::steady_clock::rep>(number_of_atrs);
+      cleanup->next_atr = 0;
+      cleanup->unchanged_atrs = 0;
+      dispatch_atr_fetches(cleanup);
+    }));
+}
+
+void
+transactions_cleanup::schedule_pass(const std::shared_ptr<collection_cleanup>& cleanup,
+                                    std::chrono::steady_clock::time_point at)
+{
+  cleanup->pass_running = false;
+  cleanup->timer.expires_at(at);
+  cleanup->timer.async_wait(guarded([this, cleanup](std::error_code ec) {
+    if (ec == asio::error::operation_aborted || cleanup->pass_running) {
+      return;
+    }
+    start_pass(cleanup);
+  }));
+}
+
+void
+transactions_cleanup::dispatch_atr_fetches(const std::shared_ptr<collection_cleanup>& cleanup)
+{
+  if (!cleanup->pass_running) {
+    return;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  while (cleanup->in_flight < max_concurrent_atr_fetches_ &&
+         cleanup->next_atr < cleanup->atr_keys.size()) {
+    // the ATRs are spread evenly over the cleanup window, but the pass catches up with concurrent
+    // fetches when it falls behind the schedule
+    const auto due = cleanup->pass_start +
+                     cleanup->atr_interval *
+                       static_cast<std::chrono::steady_clock::rep>(cleanup->next_atr);
+    if (due > now) {
+      cleanup->timer.expires_at(due);
+      cleanup->timer.async_wait(guarded([this, cleanup](std::error_code ec) {
+        if (ec == asio::error::operation_aborted) {
           return;
         }
+        dispatch_atr_fetches(cleanup);
+      }));
+      return;
+    }
+    ++cleanup->in_flight;
+    fetch_atr(cleanup, cleanup->atr_keys[cleanup->next_atr++]);
+  }
+  if (cleanup->pass_running && cleanup->next_atr == cleanup->atr_keys.size() &&
+      cleanup->in_flight == 0) {
+    CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("cleanup of {} complete, {} of {} ATRs unchanged",
+                                      cleanup->keyspace,
+                                      cleanup->unchanged_atrs,
+                                      cleanup->atr_keys.size());
+    const auto pass_end =
+      cleanup->pass_start +
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        config_.cleanup_config.cleanup_window);
+    schedule_pass(cleanup, std::max(now, pass_end));
+  }
+}
 
-        try {
-          handle_atr_cleanup({ keyspace.bucket, keyspace.scope, keyspace.collection, atr_id });
-        } catch (const std::exception& e) {
-          CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR(
-            "cleanup of atr {} failed with {}, moving on", atr_id, e.what());
-        }
+void
+transactions_cleanup::fetch_atr(const std::shared_ptr<collection_cleanup>& cleanup,
+                                const std::string& atr_key)
+{
+  const core::document_id atr_id{
+    cleanup->keyspace.bucket, cleanup->keyspace.scope, cleanup->keyspace.collection, atr_key
+  };
+  auto read_atr = [this, cleanup, atr_id]() {
+    active_transaction_record::get_atr(
+      cluster_,
+      atr_id,
+      guarded([this, cleanup, atr_key = atr_id.key()](
+                std::error_code ec, std::optional<active_transaction_record> atr) {
+        on_atr_fetched(cleanup, atr_key, ec, std::move(atr));
+      }));
+  };
+
+  const auto known_cas = cleanup->known.cas_to_probe(atr_key, std::chrono::steady_clock::now());
+  if (!known_cas) {
+    return read_atr();
+  }
+  // fast path: the CAS tells whether the attempts have to be read and checked again
+  core::operations::lookup_in_request req{ atr_id };
+  req.specs =
+    lookup_in_specs{
+      lookup_in_specs::exists(ATR_FIELD_ATTEMPTS).xattr(),
+    }
+      .specs();
+  cluster_.execute(
+    req,
+    guarded([this, cleanup, known_cas = known_cas.value(), read_atr](
+              const core::operations::lookup_in_response& resp) {
+      if (!resp.ctx.ec() && resp.cas.value() == known_cas) {
+        ++cleanup->unchanged_atrs;
+        return on_atr_done(cleanup);
+      }
+      read_atr();
+    }));
+}
 
-        const auto atr_end = std::chrono::steady_clock::now();
-        const auto atr_used = std::chrono::duration_cast<std::chrono::microseconds>(atr_end - now);
-        const auto atr_left = budget_for_this_atr - atr_used;
-
-        // Too verbose to log, but leaving here commented as it may be useful later for internal
-        // debugging
-        /*CB_LOST_ATTEMPT_CLEANUP_LOG_INFO("{} {} atrs_left_for_this_client={}
-           elapsed_in_cleanup_window={}us " "remaining_in_cleanup_window={}us
-           budget_for_this_atr={}us atr_used={}us atr_left={}us", bucket_name, atr_id,
-           atrs_left_for_this_client, elapsed_in_cleanup_window.count(),
-                                    remaining_in_cleanup_window.count(),
-                                    budget_for_this_atr.count(),
-                                    atr_used.count(),
-                                    atr_left.count());*/
-
-        if (atr_left.count() > 0 &&
-            atr_left.count() < 1000000000) { // safety check protects against bugs
-          if (!interruptable_wait(atr_left)) {
-            return;
-          }
-        }
+void
+transactions_cleanup::on_atr_fetched(const std::shared_ptr<collection_cleanup>& cleanup,
+                                     const std::string& atr_key,
+                                     std::error_code ec,
+                                     std::optional<active_transaction_record> atr)
+{
+  cleanup->known.forget(atr_key);
+  if (ec) {
+    CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR(
+      "cleanup of atr {} failed with {}, moving on", atr_key, ec.message());
+    return on_atr_done(cleanup);
+  }
+  if (!atr) {
+    return on_atr_done(cleanup);
+  }
+
+  std::optional<std::chrono::milliseconds> recheck_in{};
+  std::size_t number_of_lost_attempts = 0;
+  for (const auto& entry : atr->entries()) {
+    auto time_until_expired = entry.time_until_expired(atr_cleanup_entry::safety_margin_ms());
+    if (!time_until_expired) {
+      continue;
+    }
+    if (time_until_expired.value() == std::chrono::milliseconds::zero()) {
+      ++number_of_lost_attempts;
+      const std::scoped_lock lock(mutex_);
+      // the next pass finds the attempt again, if the worker has not cleaned it up yet
+      if (!queued_attempts_.insert(entry.attempt_id()).second) {
+        continue;
+      }
+      const auto& keyspace = cleanup->keyspace;
+      lost_attempts_.push_back({
+        entry,
+        { keyspace.bucket, keyspace.scope, keyspace.collection, atr_key },
+      });
+    } else if (!recheck_in || time_until_expired.value() < recheck_in.value()) {
+      recheck_in = time_until_expired;
+    }
+  }
+  if (number_of_lost_attempts > 0) {
+    CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG(
+      "found {} lost attempts in atr {}", number_of_lost_attempts, atr_key);
+    lost_attempts_cv_.notify_one();
+  } else {
+    cleanup->known.remember(atr_key, atr->cas(), recheck_in, std::chrono::steady_clock::now());
+  }
+  on_atr_done(cleanup);
+}
+
+void
+transactions_cleanup::on_atr_done(const std::shared_ptr<collection_cleanup>& cleanup)
+{
+  --cleanup->in_flight;
+  dispatch_atr_fetches(cleanup);
+}
+
+void
+transactions_cleanup::lost_attempts_loop()
+{
+  CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("lost attempts loop starting...");
+  while (true) {
+    std::optional<lost_attempt> attempt{};
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      lost_attempts_cv_.wait(lock, [this]() {
+        return !running_ || !lost_attempts_.empty();
+      });
+      if (!running_) {
+        CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("stopping - {} lost attempts on queue",
+                                          lost_attempts_.size());
+        return;
       }
-    } catch (const std::exception& ex) {
-      CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR("cleanup failed with {}, trying again in 3 sec...",
-                                        ex.what());
-      // we must have gotten an exception trying to get the client records.   Let's wait 3 sec and
-      // try again
-      std::this_thread::sleep_for(std::chrono::seconds(3));
+      attempt.emplace(std::move(lost_attempts_.front()));
+      lost_attempts_.pop_front();
     }
+    atr_cleanup_entry cleanup_entry(attempt->entry, attempt->atr_id, *this);
+    try {
+      cleanup_entry.clean();
+    } catch (const std::exception& e) {
+      CB_LOST_ATTEMPT_CLEANUP_LOG_ERROR(
+        "cleanup of {} failed: {}, moving on", cleanup_entry, e.what());
+    }
+    const std::scoped_lock lock(mutex_);
+    queued_attempts_.erase(attempt->entry.attempt_id());
   }
 }
 
@@ -225,199 +679,42 @@ transactions_cleanup::handle_atr_cleanup(const core::document_id& atr_id,
   return stats;
 }
 
-void
-transactions_cleanup::create_client_record(
-  const couchbase::transactions::transaction_keyspace& keyspace)
-
+auto
+transactions_cleanup::get_active_clients(
+  const couchbase::transactions::transaction_keyspace& keyspace,
+  const std::string& uuid) -> client_record_details
 {
-  try {
-    auto id =
-      document_id(keyspace.bucket, keyspace.scope, keyspace.collection, CLIENT_RECORD_DOC_ID);
-    core::operations::mutate_in_request req{ id };
-    req.store_semantics = couchbase::store_semantics::insert;
-    req.specs =
-      couchbase::mutate_in_specs{
-        couchbase::mutate_in_specs::insert("records.clients", tao::json::empty_object)
-          .xattr()
-          .create_path(),
-        // subdoc::opcode::set_doc used in replace w/ empty path
-        // ExtBinaryMetadata
-        couchbase::mutate_in_specs::replace_raw({}, std::vector<std::byte>{ std::byte{ 0x00 } }),
+  auto barrier = std::make_shared<std::promise<client_record_details>>();
+  auto f = barrier->get_future();
+  get_active_clients(
+    keyspace,
+    uuid,
+    [barrier](std::exception_ptr err, std::optional<client_record_details> details) {
+      if (err) {
+        return barrier->set_exception(err);
       }
-        .specs();
-    wrap_durable_request(req, config_);
-    auto barrier = std::make_shared<std::promise<result>>();
-    auto f = barrier->get_future();
-    auto ec = wait_for_hook([this, bucket = keyspace.bucket](auto handler) mutable {
-      return config_.cleanup_hooks->client_record_before_create(bucket, std::move(handler));
+      barrier->set_value(std::move(details.value()));
     });
-    if (ec) {
-      throw client_error(*ec, "client_record_before_create hook raised error");
-    }
-    cluster_.execute(req, [barrier](auto&& resp) {
-      barrier->set_value(result::create_from_subdoc_response(resp));
-    });
-    wrap_operation_future(f);
-
-  } catch (const client_error& e) {
-    CB_LOST_ATTEMPT_CLEANUP_LOG_TRACE("create_client_record got error {}", e.what());
-    auto ec = e.ec();
-    switch (ec) {
-      case FAIL_DOC_ALREADY_EXISTS:
-        CB_LOST_ATTEMPT_CLEANUP_LOG_TRACE("client record already exists, moving on");
-        return;
-      default:
-        throw;
-    }
-  }
+  return f.get();
 }
 
-auto
+void
 transactions_cleanup::get_active_clients(
   const couchbase::transactions::transaction_keyspace& keyspace,
-  const std::string& uuid) -> client_record_details
+  const std::string& uuid,
+  utils::movable_function<void(std::exception_ptr, std::optional<client_record_details>)>&&
+    callback)
 {
-  client_record_details details;
   // Write our client record, return details.
-  try {
-    auto id =
-      document_id{ keyspace.bucket, keyspace.scope, keyspace.collection, CLIENT_RECORD_DOC_ID };
-    core::operations::lookup_in_request req{ id };
-    req.specs =
-      lookup_in_specs{
-        lookup_in_specs::get("records").xattr(),
-        lookup_in_specs::get(subdoc::lookup_in_macro::vbucket).xattr(),
-      }
-        .specs();
-    auto barrier = std::make_shared<std::promise<result>>();
-    auto f = barrier->get_future();
-    auto ec = wait_for_hook([this, bucket = keyspace.bucket](auto handler) mutable {
-      return config_.cleanup_hooks->client_record_before_get(bucket, std::move(handler));
-    });
-    if (ec) {
-      throw client_error(*ec, "client_record_before_get hook raised error");
-    }
-    cluster_.execute(req, [barrier](auto&& resp) {
-      barrier->set_value(result::create_from_subdoc_response(resp));
-    });
-    auto res = wrap_operation_future(f);
-
-    std::vector<std::string> active_client_uids;
-    auto hlc = res.values[1].content_as();
-    auto now_ms = now_ns_from_vbucket(hlc) / 1000000;
-    details.override_enabled = false;
-    details.override_expires = 0;
-    if (res.values[0].status == subdoc_result::status_type::success) {
-      auto records = res.values[0].content_as();
-      CB_LOST_ATTEMPT_CLEANUP_LOG_TRACE("client records: {}", core::utils::json::generate(records));
-      for (const auto& [key, value] : records.get_object()) {
-        if (key == "override") {
-          for (const auto& [over_ride, param] : value.get_object()) {
-            if (over_ride == "enabled") {
-              details.override_enabled = param.get_boolean();
-            } else if (over_ride == "expires") {
-              details.override_expires = param.as<std::uint64_t>();
-            }
-          }
-        } else if (key == "clients") {
-          for (const auto& [other_client_uuid, cl] : value.get_object()) {
-            const std::uint64_t heartbeat_ms =
-              parse_mutation_cas(cl.at("heartbeat_ms").get_string());
-            auto expires_ms = cl.at("expires_ms").as<std::uint64_t>();
-            auto expired_period =
-              static_cast<std::int64_t>(now_ms) - static_cast<std::int64_t>(heartbeat_ms);
-            const bool has_expired =
-              expired_period >= static_cast<std::int64_t>(expires_ms) && now_ms > heartbeat_ms;
-            if (has_expired && other_client_uuid != uuid) {
-              details.expired_client_ids.push_back(other_client_uuid);
-            } else {
-              active_client_uids.push_back(other_client_uuid);
-            }
-          }
-        }
-      }
-    }
-    if (std::find(active_client_uids.begin(), active_client_uids.end(), uuid) ==
-        active_client_uids.end()) {
-      active_client_uids.push_back(uuid);
-    }
-    std::sort(active_client_uids.begin(), active_client_uids.end());
-    auto this_idx =
-      std::distance(active_client_uids.begin(),
-                    std::find(active_client_uids.begin(), active_client_uids.end(), uuid));
-    details.num_active_clients = static_cast<std::uint32_t>(active_client_uids.size());
-    details.index_of_this_client = static_cast<std::uint32_t>(this_idx);
-    details.num_active_clients = static_cast<std::uint32_t>(active_client_uids.size());
-    details.num_expired_clients = static_cast<std::uint32_t>(details.expired_client_ids.size());
-    details.num_existing_clients = details.num_expired_clients + details.num_active_clients;
-    details.client_uuid = uuid;
-    details.cas_now_nanos = now_ms * 1000000;
-    details.override_active =
-      (details.override_enabled && details.override_expires > details.cas_now_nanos);
-    CB_LOST_ATTEMPT_CLEANUP_LOG_TRACE("client details {}", details);
-    if (details.override_active) {
-      CB_LOST_ATTEMPT_CLEANUP_LOG_TRACE("override enabled, will not update record");
-      return details;
-    }
-
-    // update client record, maybe cleanup some as well...
-    core::operations::mutate_in_request mutate_req{ id };
-    auto mut_specs = couchbase::mutate_in_specs{
-      couchbase::mutate_in_specs::upsert(fmt::format("records.clients.{}.heartbeat_ms", uuid),
-                                         subdoc::mutate_in_macro::cas)
-        .xattr()
-        .create_path(),
-      couchbase::mutate_in_specs::upsert(fmt::format("records.clients.{}.expires_ms", uuid),
-                                         (config_.cleanup_config.cleanup_window.count() / 2) +
-                                           SAFETY_MARGIN_EXPIRY_MS)
-        .xattr()
-        .create_path(),
-      couchbase::mutate_in_specs::upsert(fmt::format("records.clients.{}.num_atrs", uuid),
-                                         atr_ids::all().size())
-        .xattr()
-        .create_path(),
-    };
-    for (std::size_t idx = 0;
-         idx < std::min(details.expired_client_ids.size(), static_cast<std::size_t>(12));
-         idx++) {
-      CB_LOST_ATTEMPT_CLEANUP_LOG_TRACE(
-        "adding {} to list of clients to be removed when updating this client",
-        details.expired_client_ids[idx]);
-      mut_specs.push_back(couchbase::mutate_in_specs::remove(
-                            fmt::format("records.clients.{}", details.expired_client_ids[idx]))
-                            .xattr());
-    }
-    mutate_req.specs = mut_specs.specs();
-    ec = wait_for_hook([this, bucket = keyspace.bucket](auto handler) mutable {
-      return config_.cleanup_hooks->client_record_before_update(bucket, std::move(handler));
-    });
-    if (ec) {
-      throw client_error(*ec, "client_record_before_update hook raised error");
-    }
-    wrap_durable_request(mutate_req, config_);
-    auto mutate_barrier = std::make_shared<std::promise<result>>();
-    auto mutate_f = mutate_barrier->get_future();
-    CB_LOST_ATTEMPT_CLEANUP_LOG_TRACE("updating record");
-    cluster_.execute(mutate_req, [mutate_barrier](auto&& resp) {
-      mutate_barrier->set_value(result::create_from_subdoc_response(resp));
-    });
-    res = wrap_operation_future(mutate_f);
-
-    // just update the cas, and return the details
-    details.cas_now_nanos = res.cas;
-    CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("get_active_clients found {}", details);
-    return details;
-  } catch (const client_error& e) {
-    auto ec = e.ec();
-    switch (ec) {
-      case FAIL_DOC_NOT_FOUND:
-        CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("client record not found, creating new one");
-        create_client_record(keyspace);
-        return get_active_clients(keyspace, uuid);
-      default:
-        throw;
-    }
-  }
+  read_client_record(std::make_shared<const client_record_context>(client_record_context{
+                       cluster_,
+                       config_.cleanup_hooks,
+                       config_.level,
+                       config_.cleanup_config.cleanup_window,
+                       keyspace,
+                       uuid,
+                     }),
+                     std::move(callback));
 }
 
 void
@@ -579,19 +876,20 @@ transactions_cleanup::add_attempt(const std::shared_ptr<attempt_context>& ctx)
 void
 transactions_cleanup::add_collection(const couchbase::transactions::transaction_keyspace& keyspace)
 {
-
   if (keyspace.valid() && config_.cleanup_config.cleanup_lost_attempts) {
-    std::unique_lock<std::mutex> lock(mutex_);
-
-    auto it = std::find(collections_.begin(), collections_.end(), keyspace);
-    if (it == collections_.end()) {
+    {
+      const std::scoped_lock<std::mutex> lock(mutex_);
+      auto it = std::find(collections_.begin(), collections_.end(), keyspace);
+      if (it != collections_.end()) {
+        return;
+      }
       collections_.emplace_back(keyspace);
-      // start cleaning right away
-      lost_attempt_cleanup_workers_.emplace_back([this, keyspace = collections_.back()]() {
-        this->clean_collection(keyspace);
-      });
     }
-    lock.unlock();
+    // start cleaning right away
+    const std::scoped_lock lock(lifetime_->mutex);
+    if (lifetime_->alive) {
+      clean_collection(keyspace);
+    }
     CB_ATTEMPT_CLEANUP_LOG_DEBUG("added {} to lost transaction cleanup", keyspace);
   }
 }
@@ -599,13 +897,28 @@ transactions_cleanup::add_collection(const couchbase::transactions::transaction_
 void
 transactions_cleanup::start()
 {
-  running_ =
-    config_.cleanup_config.cleanup_client_attempts || config_.cleanup_config.cleanup_lost_attempts;
+  {
+    const std::scoped_lock<std::mutex> lock(mutex_);
+    running_ = config_.cleanup_config.cleanup_client_attempts ||
+               config_.cleanup_config.cleanup_lost_attempts;
+  }
+  lifetime_ = std::make_shared<lifetime>();
   if (config_.cleanup_config.cleanup_client_attempts) {
     cleanup_thr_ = std::thread([this] {
       attempts_loop();
     });
   }
+  if (config_.cleanup_config.cleanup_lost_attempts) {
+    lost_attempts_thr_ = std::thread([this] {
+      lost_attempts_loop();
+    });
+    // collections, that have been added before the restart, need to be scanned again
+    const auto known_collections = collections();
+    const std::scoped_lock lock(lifetime_->mutex);
+    for (const auto& keyspace : known_collections) {
+      clean_collection(keyspace);
+    }
+  }
   if (config_.metadata_collection) {
     add_collection({ config_.metadata_collection->bucket,
                      config_.metadata_collection->scope,
@@ -623,16 +936,23 @@ transactions_cleanup::stop()
     const std::unique_lock<std::mutex> lock(mutex_);
     running_ = false;
     cv_.notify_all();
+    lost_attempts_cv_.notify_all();
+  }
+  if (lifetime_) {
+    const std::scoped_lock lock(lifetime_->mutex);
+    lifetime_->alive = false;
+    for (const auto& cleanup : collection_cleanups_) {
+      cleanup->timer.cancel();
+    }
+    collection_cleanups_.clear();
   }
   if (cleanup_thr_.joinable()) {
     cleanup_thr_.join();
     CB_ATTEMPT_CLEANUP_LOG_DEBUG("cleanup attempt thread closed");
   }
-  for (auto& t : lost_attempt_cleanup_workers_) {
-    CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("shutting down all lost attempt threads...");
-    if (t.joinable()) {
-      t.join();
-    }
+  if (lost_attempts_thr_.joinable()) {
+    CB_LOST_ATTEMPT_CLEANUP_LOG_DEBUG("shutting down lost attempts thread...");
+    lost_attempts_thr_.join();
   }
 }
 
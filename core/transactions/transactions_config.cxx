@@ -35,6 +35,7 @@ transactions_config::~transactions_config() = default;
 transactions_config::transactions_config(transactions_config&& c) noexcept
   : level_(c.level_)
   , timeout_(c.timeout_)
+  , unstaging_window_(c.unstaging_window_)
   , attempt_context_hooks_(c.attempt_context_hooks_)
   , cleanup_hooks_(c.cleanup_hooks_)
   , metadata_collection_(std::move(c.metadata_collection_))
@@ -46,6 +47,7 @@ transactions_config::transactions_config(transactions_config&& c) noexcept
 transactions_config::transactions_config(const transactions_config& config)
   : level_(config.durability_level())
   , timeout_(config.timeout())
+  , unstaging_window_(config.unstaging_window())
   , attempt_context_hooks_(std::make_shared<core::transactions::attempt_context_testing_hooks>(
       config.attempt_context_hooks()))
   , cleanup_hooks_(
@@ -62,6 +64,7 @@ transactions_config::operator=(const transactions_config& c) -> transactions_con
   if (this != &c) {
     level_ = c.level_;
     timeout_ = c.timeout_;
+    unstaging_window_ = c.unstaging_window_;
     attempt_context_hooks_ = c.attempt_context_hooks_;
     cleanup_hooks_ = c.cleanup_hooks_;
     query_config_ = c.query_config_;
@@ -80,7 +83,8 @@ transactions_config::build() const -> transactions_config::built
            cleanup_hooks_,
            metadata_collection_,
            query_config_.build(),
-           cleanup_config_.build() };
+           cleanup_config_.build(),
+           unstaging_window_ };
 }
 
 } // namespace couchbase::transactions
@@ -0,0 +1,173 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace couchbase::core::utils
+{
+/**
+ * Associates values (e.g. response handlers) with opaque identifiers of the in-flight requests.
+ *
+ * Opaques are allocated sequentially by the session, so at any moment the in-flight opaques occupy
+ * a narrow window and map onto distinct slots of the ring indexed by "opaque % Capacity". Each
+ * slot is guarded by its own spin flag, so insert, lookup and removal do not allocate and do not
+ * contend with operations on other opaques. When the slot is still held by a straggler (for
+ * example, a request with a very long timeout), the value goes to the overflow map, which is
+ * only consulted when it is not empty.
+ */
+template<typename Value, std::size_t Capacity = 1024>
+class concurrent_opaque_table
+{
+  static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0,
+                "Capacity must be a power of two");
+
+public:
+  concurrent_opaque_table() = default;
+  concurrent_opaque_table(const concurrent_opaque_table&) = delete;
+  concurrent_opaque_table(concurrent_opaque_table&&) = delete;
+  auto operator=(const concurrent_opaque_table&) -> concurrent_opaque_table& = delete;
+  auto operator=(concurrent_opaque_table&&) -> concurrent_opaque_table& = delete;
+  ~concurrent_opaque_table() = default;
+
+  /**
+   * @return false if the opaque is already registered (the value is not replaced in this case)
+   */
+  auto try_emplace(std::uint32_t opaque, Value&& value) -> bool
+  {
+    {
+      auto& slot = slot_for(opaque);
+      const slot_guard guard(slot);
+      if (!slot.occupied) {
+        slot.occupied = true;
+        slot.opaque = opaque;
+        slot.value = std::move(value);
+        return true;
+      }
+      if (slot.opaque == opaque) {
+        return false;
+      }
+    }
+    const std::scoped_lock lock(overflow_mutex_);
+    auto [_, inserted] = overflow_.try_emplace(opaque, std::move(value));
+    overflow_size_.store(overflow_.size(), std::memory_order_release);
+    return inserted;
+  }
+
+  /**
+   * Removes value associated with the opaque and returns it to the caller.
+   */
+  auto take(std::uint32_t opaque) -> std::optional<Value>
+  {
+    {
+      auto& slot = slot_for(opaque);
+      const slot_guard guard(slot);
+      if (slot.occupied && slot.opaque == opaque) {
+        slot.occupied = false;
+        return std::exchange(slot.value, Value{});
+      }
+    }
+    if (overflow_size_.load(std::memory_order_acquire) == 0) {
+      return {};
+    }
+    const std::scoped_lock lock(overflow_mutex_);
+    auto it = overflow_.find(opaque);
+    if (it == overflow_.end()) {
+      return {};
+    }
+    auto value = std::move(it->second);
+    overflow_.erase(it);
+    overflow_size_.store(overflow_.size(), std::memory_order_release);
+    return value;
+  }
+
+  /**
+   * Removes all values from the table and returns them to the caller.
+   */
+  auto take_all() -> std::vector<std::pair<std::uint32_t, Value>>
+  {
+    std::vector<std::pair<std::uint32_t, Value>> values;
+    for (std::size_t i = 0; i < Capacity; ++i) {
+      auto& slot = slots_[i];
+      const slot_guard guard(slot);
+      if (slot.occupied) {
+        slot.occupied = false;
+        values.emplace_back(slot.opaque, std::exchange(slot.value, Value{}));
+      }
+    }
+    const std::scoped_lock lock(overflow_mutex_);
+    for (auto& [opaque, value] : overflow_) {
+      values.emplace_back(opaque, std::move(value));
+    }
+    overflow_.clear();
+    overflow_size_.store(0, std::memory_order_release);
+    return values;
+  }
+
+private:
+  struct slot {
+    std::atomic_flag busy = ATOMIC_FLAG_INIT;
+    bool occupied{ false };
+    std::uint32_t opaque{ 0 };
+    Value value{};
+  };
+
+  class slot_guard
+  {
+  public:
+    explicit slot_guard(slot& s)
+      : slot_{ s }
+    {
+      while (slot_.busy.test_and_set(std::memory_order_acquire)) {
+        std::this_thread::yield();
+      }
+    }
+
+    slot_guard(const slot_guard&) = delete;
+    slot_guard(slot_guard&&) = delete;
+    auto operator=(const slot_guard&) -> slot_guard& = delete;
+    auto operator=(slot_guard&&) -> slot_guard& = delete;
+
+    ~slot_guard()
+    {
+      slot_.busy.clear(std::memory_order_release);
+    }
+
+  private:
+    slot& slot_;
+  };
+
+  auto slot_for(std::uint32_t opaque) -> slot&
+  {
+    return slots_[opaque & (Capacity - 1)];
+  }
+
+  std::unique_ptr<slot[]> slots_{ std::make_unique<slot[]>(Capacity) };
+  std::atomic_size_t overflow_size_{ 0 };
+  std::mutex overflow_mutex_{};
+  std::map<std::uint32_t, Value> overflow_{};
+};
+} // namespace couchbase::core::utils
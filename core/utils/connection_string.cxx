@@ -354,6 +354,33 @@ parse_option(std::chrono::milliseconds& receiver,
     }
   }
 }
+
+void
+parse_option(std::chrono::microseconds& receiver,
+             const std::string& name,
+             const std::string& value,
+             std::vector<std::string>& warnings)
+{
+  try {
+    receiver = std::chrono::duration_cast<std::chrono::microseconds>(parse_duration(value));
+  } catch (const duration_parse_error&) {
+    try {
+      receiver = std::chrono::microseconds(std::stoull(value, nullptr, 10));
+    } catch (const std::invalid_argument& ex1) {
+      warnings.push_back(fmt::format(
+        R"(unable to parse "{}" parameter in connection string (value "{}" is not a number): {})",
+        name,
+        value,
+        ex1.what()));
+    } catch (const std::out_of_range& ex2) {
+      warnings.push_back(fmt::format(
+        R"(unable to parse "{}" parameter in connection string (value "{}" is out of range): {})",
+        name,
+        value,
+        ex2.what()));
+    }
+  }
+}
 #endif
 
 void
@@ -536,6 +563,35 @@ extract_options(connection_string& connstr)
        * The period of time an HTTP connection can be idle before it is forcefully disconnected.
        */
       parse_option(connstr.options.idle_http_connection_timeout, name, value, connstr.warnings);
+    } else if (name == "min_http_connections_per_node") {
+      /**
+       * The number of HTTP connections to the query, search and analytics services, that are
+       * opened to every node in the background after each configuration update.
+       */
+      parse_option(connstr.options.min_http_connections_per_node, name, value, connstr.warnings);
+    } else if (name == "write_coalescing_threshold") {
+      /**
+       * Number of bytes the KV connection accumulates before flushing them to the socket, when
+       * "write_coalescing_delay" is set.
+       */
+      parse_option(connstr.options.write_coalescing_threshold, name, value, connstr.warnings);
+    } else if (name == "write_coalescing_delay") {
+      /**
+       * The maximum period of time the KV connection holds outgoing requests to coalesce them
+       * into a single write (integer value is interpreted as microseconds).
+       */
+      parse_option(connstr.options.write_coalescing_delay, name, value, connstr.warnings);
+    } else if (name == "query_cache_max_entries") {
+      /**
+       * The maximum number of prepared N1QL statements kept in the cache. 0 disables the limit.
+       */
+      parse_option(connstr.options.query_cache_max_entries, name, value, connstr.warnings);
+    } else if (name == "query_cache_max_bytes") {
+      /**
+       * The maximum size of prepared N1QL statements and their plans kept in the cache. 0
+       * disables the limit.
+       */
+      parse_option(connstr.options.query_cache_max_bytes, name, value, connstr.warnings);
     } else if (name == "bootstrap_timeout") {
       /**
        * The period of time allocated to complete bootstrap
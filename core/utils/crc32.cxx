@@ -0,0 +1,299 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/* The crc32 functions and data was originally written by Spencer
+ * Garrett <srg@quick.com> and was gleaned from the PostgreSQL source
+ * tree via the files contrib/ltree/crc32.[ch] and from FreeBSD at
+ * src/usr.bin/cksum/crc32.c.
+ *
+ * The carry-less multiplication folding follows "Fast CRC Computation for Generic Polynomials
+ * Using PCLMULQDQ Instruction" by V. Gopal, E. Ozturk, et al. (Intel, 2009).
+ */
+
+#include "crc32.hxx"
+
+#include <array>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define COUCHBASE_CXX_CLIENT_CRC32_PCLMUL 1
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define COUCHBASE_CXX_CLIENT_CRC32_TARGET
+#else
+#define COUCHBASE_CXX_CLIENT_CRC32_TARGET __attribute__((target("sse2,pclmul")))
+#endif
+#elif defined(__aarch64__) && !defined(__ARM_BIG_ENDIAN) &&                                        \
+  (defined(__GNUC__) || defined(__clang__))
+#define COUCHBASE_CXX_CLIENT_CRC32_ARMV8 1
+#include <arm_acle.h>
+#if defined(__ARM_FEATURE_CRC32)
+#define COUCHBASE_CXX_CLIENT_CRC32_TARGET
+#elif defined(__clang__)
+#define COUCHBASE_CXX_CLIENT_CRC32_TARGET __attribute__((target("crc")))
+#else
+#define COUCHBASE_CXX_CLIENT_CRC32_TARGET __attribute__((target("+crc")))
+#endif
+#if defined(__linux__) && !defined(__ARM_FEATURE_CRC32)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace couchbase::core::utils
+{
+namespace
+{
+constexpr std::array<std::uint32_t, 256> crc32tab{ {
+  0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3,
+  0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988, 0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91,
+  0x1db71064, 0x6ab020f2, 0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
+  0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9, 0xfa0f3d63, 0x8d080df5,
+  0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172, 0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b,
+  0x35b5a8fa, 0x42b2986c, 0xdbbbc9d6, 0xacbcf940, 0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
+  0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423, 0xcfba9599, 0xb8bda50f,
+  0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924, 0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d,
+  0x76dc4190, 0x01db7106, 0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
+  0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818, 0x7f6a0dbb, 0x086d3d2d, 0x91646c97, 0xe6635c01,
+  0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e, 0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457,
+  0x65b0d9c6, 0x12b7e950, 0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
+  0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2, 0x4adfa541, 0x3dd895d7, 0xa4d1c46d, 0xd3d6f4fb,
+  0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0, 0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9,
+  0x5005713c, 0x270241aa, 0xbe0b1010, 0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
+  0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17, 0x2eb40d81, 0xb7bd5c3b, 0xc0ba6cad,
+  0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a, 0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683,
+  0xe3630b12, 0x94643b84, 0x0d6d6a3e, 0x7a6a5aa8, 0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
+  0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb, 0x196c3671, 0x6e6b06e7,
+  0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc, 0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5,
+  0xd6d6a3e8, 0xa1d1937e, 0x38d8c2c4, 0x4fdff252, 0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
+  0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55, 0x316e8eef, 0x4669be79,
+  0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236, 0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f,
+  0xc5ba3bbe, 0xb2bd0b28, 0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
+  0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a, 0x9c0906a9, 0xeb0e363f, 0x72076785, 0x05005713,
+  0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38, 0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21,
+  0x86d3d2d4, 0xf1d4e242, 0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
+  0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c, 0x8f659eff, 0xf862ae69, 0x616bffd3, 0x166ccf45,
+  0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2, 0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db,
+  0xaed16a4a, 0xd9d65adc, 0x40df0b66, 0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
+  0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693, 0x54de5729, 0x23d967bf,
+  0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d,
+} };
+
+using slicing_tables = std::array<std::array<std::uint32_t, 256>, 8>;
+
+constexpr auto
+make_slicing_tables() -> slicing_tables
+{
+  slicing_tables tables{};
+  tables[0] = crc32tab;
+  for (std::size_t i = 0; i < 256; ++i) {
+    for (std::size_t t = 1; t < tables.size(); ++t) {
+      const auto previous = tables[t - 1][i];
+      tables[t][i] = (previous >> 8) ^ tables[0][previous & 0xff];
+    }
+  }
+  return tables;
+}
+
+constexpr slicing_tables crc32_slicing_tables{ make_slicing_tables() };
+
+inline auto
+load_le32(const std::byte* data) -> std::uint32_t
+{
+  return std::to_integer<std::uint32_t>(data[0]) | (std::to_integer<std::uint32_t>(data[1]) << 8) |
+         (std::to_integer<std::uint32_t>(data[2]) << 16) |
+         (std::to_integer<std::uint32_t>(data[3]) << 24);
+}
+
+#if defined(COUCHBASE_CXX_CLIENT_CRC32_PCLMUL)
+inline auto
+load_128(const std::byte* data) -> __m128i
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+}
+
+/*
+ * Multiplies both halves of the accumulator by the folding constants and adds the next block.
+ */
+COUCHBASE_CXX_CLIENT_CRC32_TARGET inline auto
+fold_128(__m128i acc, __m128i constants, __m128i next) -> __m128i
+{
+  const __m128i lo = _mm_clmulepi64_si128(acc, constants, 0x00);
+  const __m128i hi = _mm_clmulepi64_si128(acc, constants, 0x11);
+  return _mm_xor_si128(_mm_xor_si128(hi, next), lo);
+}
+
+/*
+ * Folds 64-byte blocks in four lanes, then the lanes and the rest of 16-byte blocks into a single
+ * 128-bit value, and finally reduces it to 32 bits with Barrett reduction. Requires at least 64
+ * bytes, only whole 16-byte blocks are consumed, the caller handles the tail.
+ */
+COUCHBASE_CXX_CLIENT_CRC32_TARGET auto
+update_pclmul(std::uint32_t crc, const std::byte* data, std::size_t length) -> std::uint32_t
+{
+  // bit-reflected constants k1..k5 and the polynomial with its Barrett constant (mu)
+  alignas(16) static constexpr std::uint64_t k1k2[] = { 0x0154442bd4, 0x01c6e41596 };
+  alignas(16) static constexpr std::uint64_t k3k4[] = { 0x01751997d0, 0x00ccaa009e };
+  alignas(16) static constexpr std::uint64_t k5k0[] = { 0x0163cd6124, 0x0000000000 };
+  alignas(16) static constexpr std::uint64_t poly[] = { 0x01db710641, 0x01f7011641 };
+
+  __m128i x1 = load_128(data);
+  __m128i x2 = load_128(data + 16);
+  __m128i x3 = load_128(data + 32);
+  __m128i x4 = load_128(data + 48);
+  x1 = _mm_xor_si128(x1, _mm_cvtsi32_si128(static_cast<int>(crc)));
+  __m128i x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k1k2));
+  data += 64;
+  length -= 64;
+
+  while (length >= 64) {
+    x1 = fold_128(x1, x0, load_128(data));
+    x2 = fold_128(x2, x0, load_128(data + 16));
+    x3 = fold_128(x3, x0, load_128(data + 32));
+    x4 = fold_128(x4, x0, load_128(data + 48));
+    data += 64;
+    length -= 64;
+  }
+
+  x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(k3k4));
+  x1 = fold_128(x1, x0, x2);
+  x1 = fold_128(x1, x0, x3);
+  x1 = fold_128(x1, x0, x4);
+  while (length >= 16) {
+    x1 = fold_128(x1, x0, load_128(data));
+    data += 16;
+    length -= 16;
+  }
+
+  // fold 128 bits to 64 bits
+  const __m128i mask = _mm_setr_epi32(~0, 0, ~0, 0);
+  x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  x0 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(k5k0));
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_xor_si128(_mm_clmulepi64_si128(_mm_and_si128(x1, mask), x0, 0x00), x2);
+
+  // Barrett reduction to 32 bits
+  x0 = _mm_load_si128(reinterpret_cast<const __m128i*>(poly));
+  x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), x0, 0x10);
+  x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return static_cast<std::uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(x1, 4)));
+}
+#elif defined(COUCHBASE_CXX_CLIENT_CRC32_ARMV8)
+COUCHBASE_CXX_CLIENT_CRC32_TARGET auto
+update_armv8(std::uint32_t crc, const std::byte* data, std::size_t length) -> std::uint32_t
+{
+  while (length >= 8) {
+    std::uint64_t word{};
+    std::memcpy(&word, data, sizeof(word));
+    crc = __crc32d(crc, word);
+    data += 8;
+    length -= 8;
+  }
+  while (length > 0) {
+    crc = __crc32b(crc, std::to_integer<std::uint8_t>(*data));
+    ++data;
+    --length;
+  }
+  return crc;
+}
+#endif
+
+auto
+detect_hardware_support() -> bool
+{
+#if defined(COUCHBASE_CXX_CLIENT_CRC32_PCLMUL)
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4]{};
+  __cpuid(info, 1);
+  return (info[2] & (1 << 1)) != 0; // ECX.PCLMULQDQ
+#else
+  return __builtin_cpu_supports("pclmul") != 0;
+#endif
+#elif defined(COUCHBASE_CXX_CLIENT_CRC32_ARMV8)
+#if defined(__ARM_FEATURE_CRC32) || defined(__APPLE__)
+  return true;
+#elif defined(__linux__)
+  return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+#else
+  return false;
+#endif
+#else
+  return false;
+#endif
+}
+
+using update_function = auto (*)(std::uint32_t, const std::byte*, std::size_t) -> std::uint32_t;
+
+auto
+select_implementation() -> update_function
+{
+  if (crc32_detail::has_hardware_support()) {
+    return &crc32_detail::update_hardware;
+  }
+  return &crc32_detail::update_slicing_by_8;
+}
+} // namespace
+
+namespace crc32_detail
+{
+auto
+update_bytewise(std::uint32_t crc, const std::byte* data, std::size_t length) -> std::uint32_t
+{
+  for (std::size_t i = 0; i < length; ++i) {
+    crc = (crc >> 8) ^ crc32tab[(crc ^ std::to_integer<std::uint32_t>(data[i])) & 0xff];
+  }
+  return crc;
+}
+
+auto
+update_slicing_by_8(std::uint32_t crc, const std::byte* data, std::size_t length) -> std::uint32_t
+{
+  const auto& t = crc32_slicing_tables;
+  while (length >= 8) {
+    const std::uint32_t one = load_le32(data) ^ crc;
+    const std::uint32_t two = load_le32(data + 4);
+    crc = t[7][one & 0xff] ^ t[6][(one >> 8) & 0xff] ^ t[5][(one >> 16) & 0xff] ^ t[4][one >> 24] ^
+          t[3][two & 0xff] ^ t[2][(two >> 8) & 0xff] ^ t[1][(two >> 16) & 0xff] ^ t[0][two >> 24];
+    data += 8;
+    length -= 8;
+  }
+  return update_bytewise(crc, data, length);
+}
+
+auto
+has_hardware_support() -> bool
+{
+  static const bool supported = detect_hardware_support();
+  return supported;
+}
+
+auto
+update_hardware(std::uint32_t crc, const std::byte* data, std::size_t length) -> std::uint32_t
+{
+#if defined(COUCHBASE_CXX_CLIENT_CRC32_PCLMUL)
+  // folding pays off only for several blocks, short keys are faster with tables
+  if (length >= 64) {
+    const std::size_t folded = length & ~std::size_t{ 15 };
+    crc = update_pclmul(crc, data, folded);
+    data += folded;
+    length -= folded;
+  }
+  return update_slicing_by_8(crc, data, length);
+#elif defined(COUCHBASE_CXX_CLIENT_CRC32_ARMV8)
+  return update_armv8(crc, data, length);
+#else
+  return update_slicing_by_8(crc, data, length);
+#endif
+}
+} // namespace crc32_detail
+
+auto
+crc32_update(std::uint32_t crc, const std::byte* data, std::size_t length) -> std::uint32_t
+{
+  static const update_function update = select_implementation();
+  return update(crc, data, length);
+}
+} // namespace couchbase::core::utils
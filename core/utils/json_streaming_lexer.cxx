@@ -17,6 +17,7 @@
 
 #include "json_streaming_lexer.hxx"
 #include "core/logger/logger.hxx"
+#include "json_structural_lexer.hxx"
 
 #include "third_party/jsonsl/jsonsl.h"
 
@@ -401,8 +402,17 @@ initial_action_push_callback(jsonsl_t lexer,
 }
 } // namespace
 
-json::streaming_lexer::streaming_lexer(const std::string& pointer_expression, std::uint32_t depth)
+json::streaming_lexer::streaming_lexer(const std::string& pointer_expression,
+                                       std::uint32_t depth,
+                                       streaming_lexer_backend backend)
 {
+  if (backend == streaming_lexer_backend::structural) {
+    if (auto key = detail::structural_lexer::rowset_key(pointer_expression, depth); key) {
+      structural_ = std::make_shared<detail::structural_lexer>(std::move(key.value()));
+      return;
+    }
+  }
+
   jsonsl_error_t error = JSONSL_ERROR_SUCCESS;
   jsonsl_jpr_t ptr = jsonsl_jpr_new(pointer_expression.c_str(), &error);
   if (ptr == nullptr) {
@@ -426,6 +436,9 @@ json::streaming_lexer::streaming_lexer(const std::string& pointer_expression, st
 void
 streaming_lexer::feed(std::string_view data)
 {
+  if (structural_) {
+    return structural_->feed(data);
+  }
   impl_->buffer_.append(data);
   jsonsl_feed(impl_->lexer_, data.data(), data.size());
 
@@ -440,6 +453,9 @@ void
 streaming_lexer::on_metadata_header_complete(
   utils::movable_function<void(std::error_code, std::string&&)> handler)
 {
+  if (structural_) {
+    return structural_->on_metadata_header_complete(std::move(handler));
+  }
   impl_->on_meta_header_complete_ = std::move(handler);
 }
 
@@ -447,12 +463,18 @@ void
 streaming_lexer::on_complete(
   std::function<void(std::error_code, std::size_t, std::string&&)> handler)
 {
+  if (structural_) {
+    return structural_->on_complete(std::move(handler));
+  }
   impl_->on_complete_ = std::move(handler);
 }
 
 void
 streaming_lexer::on_row(std::function<stream_control(std::string&&)> handler)
 {
+  if (structural_) {
+    return structural_->on_row(std::move(handler));
+  }
   impl_->on_row_ = std::move(handler);
 }
 } // namespace couchbase::core::utils::json
@@ -33,8 +33,24 @@ namespace couchbase::core::utils::json
 namespace detail
 {
 struct streaming_lexer_impl;
+class structural_lexer;
 } // namespace detail
 
+enum class streaming_lexer_backend {
+  /**
+   * jsonsl state machine, that visits every byte of the stream and supports any pointer expression.
+   * This is the default.
+   */
+  jsonsl,
+
+  /**
+   * vectorized structural indexing, that supports only pointer expressions in form of "/<key>/^"
+   * with depth 4 (which covers query, analytics, search, view and columnar rows). For other
+   * expressions the lexer falls back to jsonsl. Has to be requested explicitly.
+   */
+  structural,
+};
+
 /**
  * The streaming JSON lexer consumes chunks of data, and invokes given handler for each "row", and
  * "complete".
@@ -47,10 +63,13 @@ public:
   /**
    * @param pointer_expression expression that describes where the "row" objects are located.
    * @param depth stop emitting JSON events starting from this depth. Level 1 is root of the object.
+   * @param backend implementation of the lexer.
    *
    * @throws std::invalid_argument if pointer cannot be created from the expression.
    */
-  streaming_lexer(const std::string& pointer_expression, std::uint32_t depth);
+  streaming_lexer(const std::string& pointer_expression,
+                  std::uint32_t depth,
+                  streaming_lexer_backend backend = streaming_lexer_backend::jsonsl);
 
   void feed(std::string_view data);
 
@@ -63,5 +82,6 @@ public:
 
 private:
   std::shared_ptr<detail::streaming_lexer_impl> impl_{};
+  std::shared_ptr<detail::structural_lexer> structural_{};
 };
 } // namespace couchbase::core::utils::json
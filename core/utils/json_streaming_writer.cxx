@@ -0,0 +1,185 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "json_streaming_writer.hxx"
+
+namespace couchbase::core::utils::json
+{
+namespace
+{
+auto
+needs_escape(char c) -> bool
+{
+  return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+} // namespace
+
+streaming_writer::streaming_writer(std::string& output)
+  : output_{ output }
+{
+}
+
+void
+streaming_writer::begin_object()
+{
+  separate();
+  output_.push_back('{');
+  needs_separator_ = false;
+}
+
+void
+streaming_writer::end_object()
+{
+  output_.push_back('}');
+  needs_separator_ = true;
+}
+
+void
+streaming_writer::begin_array()
+{
+  separate();
+  output_.push_back('[');
+  needs_separator_ = false;
+}
+
+void
+streaming_writer::end_array()
+{
+  output_.push_back(']');
+  needs_separator_ = true;
+}
+
+void
+streaming_writer::key(std::string_view name)
+{
+  separate();
+  write_string(name);
+  output_.push_back(':');
+  needs_separator_ = false;
+}
+
+void
+streaming_writer::value(std::string_view string)
+{
+  separate();
+  write_string(string);
+}
+
+void
+streaming_writer::value(const char* string)
+{
+  value(std::string_view{ string });
+}
+
+void
+streaming_writer::value(bool boolean)
+{
+  separate();
+  output_.append(boolean ? "true" : "false");
+}
+
+void
+streaming_writer::null()
+{
+  separate();
+  output_.append("null");
+}
+
+void
+streaming_writer::raw_value(std::string_view encoded)
+{
+  separate();
+  output_.append(encoded);
+}
+
+void
+streaming_writer::raw_value(const json_string& encoded)
+{
+  if (encoded.is_binary() && !encoded.bytes().empty()) {
+    const auto& bytes = encoded.bytes();
+    return raw_value(
+      std::string_view{ reinterpret_cast<const char*>(bytes.data()), bytes.size() });
+  }
+  if (encoded.is_string() && !encoded.str().empty()) {
+    return raw_value(encoded.str());
+  }
+  null();
+}
+
+auto
+streaming_writer::size() const -> std::size_t
+{
+  return output_.size();
+}
+
+void
+streaming_writer::separate()
+{
+  if (needs_separator_) {
+    output_.push_back(',');
+  }
+  needs_separator_ = true;
+}
+
+void
+streaming_writer::write_string(std::string_view string)
+{
+  static constexpr std::string_view hex_digits{ "0123456789abcdef" };
+
+  output_.push_back('"');
+  std::size_t run_begin{ 0 };
+  for (std::size_t i = 0; i < string.size(); ++i) {
+    const char c = string[i];
+    if (!needs_escape(c)) {
+      continue;
+    }
+    output_.append(string.substr(run_begin, i - run_begin));
+    run_begin = i + 1;
+    switch (c) {
+      case '"':
+        output_.append("\\\"");
+        break;
+      case '\\':
+        output_.append("\\\\");
+        break;
+      case '\b':
+        output_.append("\\b");
+        break;
+      case '\f':
+        output_.append("\\f");
+        break;
+      case '\n':
+        output_.append("\\n");
+        break;
+      case '\r':
+        output_.append("\\r");
+        break;
+      case '\t':
+        output_.append("\\t");
+        break;
+      default: {
+        const auto code = static_cast<unsigned char>(c);
+        output_.append("\\u00");
+        output_.push_back(hex_digits[code >> 4U]);
+        output_.push_back(hex_digits[code & 0x0fU]);
+      } break;
+    }
+  }
+  output_.append(string.substr(run_begin));
+  output_.push_back('"');
+}
+} // namespace couchbase::core::utils::json
@@ -0,0 +1,116 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "core/json_string.hxx"
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace couchbase::core::utils::json
+{
+/**
+ * Writes JSON directly into the output string without building a DOM.
+ *
+ * The writer only inserts separators, so it is up to the caller to open and close containers in
+ * the right order, and to write the key before every member of the object. The values, that are
+ * already encoded (e.g. query parameters), are spliced in verbatim and are not validated.
+ */
+class streaming_writer
+{
+public:
+  explicit streaming_writer(std::string& output);
+
+  void begin_object();
+  void end_object();
+  void begin_array();
+  void end_array();
+
+  void key(std::string_view name);
+
+  void value(std::string_view string);
+  void value(const char* string);
+  void value(bool boolean);
+  void null();
+
+  template<typename Integer,
+           std::enable_if_t<std::is_integral_v<Integer> && !std::is_same_v<Integer, bool>, int> = 0>
+  void value(Integer number)
+  {
+    separate();
+    std::array<char, 24> digits{};
+    auto result = std::to_chars(digits.data(), digits.data() + digits.size(), number);
+    output_.append(digits.data(), result.ptr);
+  }
+
+  /**
+   * Splices the value, that is already encoded as JSON.
+   */
+  void raw_value(std::string_view encoded);
+
+  /**
+   * Splices the value, that is already encoded as JSON. The empty value is written as null.
+   */
+  void raw_value(const json_string& encoded);
+
+  template<typename Value>
+  void member(std::string_view name, Value&& content)
+  {
+    key(name);
+    value(std::forward<Value>(content));
+  }
+
+  /**
+   * @return the number of bytes in the output, so that the caller could refer to the part of the
+   * document later.
+   */
+  [[nodiscard]] auto size() const -> std::size_t;
+
+private:
+  void separate();
+  void write_string(std::string_view string);
+
+  std::string& output_;
+  /** whether the next value or key has to be preceded by comma */
+  bool needs_separator_{ false };
+};
+
+/**
+ * @return true if the options contain the member with the given name, so that the caller should
+ * not write its own value for it.
+ */
+template<typename Options>
+auto
+has_member(const Options& options, std::string_view name) -> bool
+{
+  if (options.empty()) {
+    return false;
+  }
+  if constexpr (std::is_same_v<typename Options::key_compare, std::less<>>) {
+    return options.find(name) != options.end();
+  } else {
+    return options.find(std::string{ name }) != options.end();
+  }
+}
+} // namespace couchbase::core::utils::json
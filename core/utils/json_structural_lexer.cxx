@@ -0,0 +1,341 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "json_structural_lexer.hxx"
+
+#include <couchbase/error_codes.hxx>
+
+namespace couchbase::core::utils::json::detail
+{
+namespace
+{
+/**
+ * The same limit of nesting as the jsonsl lexer has.
+ */
+constexpr std::size_t max_levels{ 512 };
+
+/**
+ * The elements of the rowset are located at this level (root is level 1), and the lexer emits
+ * them as whole rows, so the pointer expressions with other depths are left for jsonsl.
+ */
+constexpr std::uint32_t rows_depth{ 4 };
+
+void
+noop_on_complete(std::error_code /* ec */,
+                 std::size_t /* number_of_rows */,
+                 std::string&& /* meta */)
+{ /* do nothing */
+}
+
+auto
+noop_on_row(std::string&& /* row */) -> stream_control
+{
+  return stream_control::next_row;
+}
+
+void
+noop_on_meta_header_complete(std::error_code /* ec */, std::string&& /* meta_header */)
+{ /* do nothing */
+}
+
+auto
+is_whitespace(char c) -> bool
+{
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+} // namespace
+
+structural_lexer::structural_lexer(std::string rowset_key)
+  : rowset_key_{ std::move(rowset_key) }
+  , on_meta_header_complete_{ noop_on_meta_header_complete }
+  , on_complete_{ noop_on_complete }
+  , on_row_{ noop_on_row }
+{
+}
+
+auto
+structural_lexer::rowset_key(const std::string& pointer_expression,
+                             std::uint32_t depth) -> std::optional<std::string>
+{
+  static constexpr std::string_view wildcard_suffix{ "/^" };
+  if (depth != rows_depth || pointer_expression.size() <= 1 + wildcard_suffix.size() ||
+      pointer_expression.front() != '/' ||
+      pointer_expression.compare(pointer_expression.size() - wildcard_suffix.size(),
+                                 wildcard_suffix.size(),
+                                 wildcard_suffix) != 0) {
+    return {};
+  }
+  auto key = pointer_expression.substr(1, pointer_expression.size() - 1 - wildcard_suffix.size());
+  // nested paths, escape sequences and keys, that have to be escaped in JSON, are left for jsonsl
+  for (const char c : key) {
+    if (c == '/' || c == '~' || c == '%' || c == '"' || c == '\\' ||
+        static_cast<unsigned char>(c) < 0x20) {
+      return {};
+    }
+  }
+  return key;
+}
+
+void
+structural_lexer::feed(std::string_view data)
+{
+  if (finished_) {
+    return;
+  }
+  const auto chunk_begin = min_pos_ + buffer_.size();
+  const auto chunk_end = chunk_begin + data.size();
+  buffer_.append(data);
+
+  index_.clear();
+  scanner_.scan(data, index_);
+  if (!root_found_) {
+    find_root(chunk_end);
+  }
+  for (const auto offset : index_) {
+    if (finished_) {
+      return;
+    }
+    process(chunk_begin + offset);
+  }
+  if (finished_) {
+    return;
+  }
+  // the row might be a number or a literal, that does not have structural characters
+  find_scalar_row(chunk_end);
+
+  if (consumed_ > min_pos_) {
+    buffer_.erase(0, consumed_ - min_pos_);
+    min_pos_ = consumed_;
+  }
+}
+
+void
+structural_lexer::on_metadata_header_complete(
+  utils::movable_function<void(std::error_code, std::string&&)> handler)
+{
+  on_meta_header_complete_ = std::move(handler);
+}
+
+void
+structural_lexer::on_complete(
+  std::function<void(std::error_code, std::size_t, std::string&&)> handler)
+{
+  on_complete_ = std::move(handler);
+}
+
+void
+structural_lexer::on_row(std::function<stream_control(std::string&&)> handler)
+{
+  on_row_ = std::move(handler);
+}
+
+void
+structural_lexer::process(std::size_t position)
+{
+  const char c = at(position);
+  const auto depth = containers_.size();
+
+  if (c == '"') {
+    in_string_ = !in_string_;
+    if (in_string_) {
+      string_begin_ = position;
+      if (in_rowset_ && depth == 2) {
+        begin_row(position);
+      }
+    } else if (depth == 1) {
+      key_matches_ = region(string_begin_ + 1, position) == rowset_key_;
+    } else if (in_rowset_ && depth == 2) {
+      end_row(position + 1);
+    }
+    return;
+  }
+
+  switch (c) {
+    case '{':
+    case '[':
+      if (in_rowset_ && depth == 2) {
+        begin_row(position);
+      } else if (c == '[' && depth == 1 && key_matches_ && !rowset_found_) {
+        rowset_found_ = true;
+        in_rowset_ = true;
+        separator_end_ = position + 1;
+      }
+      if (depth == max_levels) {
+        return fail(errc::streaming_json_lexer::levels_exceeded);
+      }
+      containers_.push_back(c);
+      return;
+
+    case '}':
+    case ']':
+      if (depth == 0 || containers_.back() != (c == '}' ? '{' : '[')) {
+        return fail(errc::streaming_json_lexer::bracket_mismatch);
+      }
+      if (in_rowset_ && depth == 2) {
+        end_scalar_row(position);
+      }
+      containers_.pop_back();
+      if (in_rowset_ && depth == 3) {
+        end_row(position + 1);
+      } else if (in_rowset_ && depth == 2) {
+        end_rowset(position);
+      } else if (depth == 1) {
+        complete();
+      }
+      return;
+
+    case ',':
+      if (in_rowset_ && depth == 2) {
+        end_scalar_row(position);
+        separator_end_ = position + 1;
+      }
+      return;
+
+    default:
+      return;
+  }
+}
+
+void
+structural_lexer::find_root(std::size_t end)
+{
+  for (auto position = min_pos_; position < end; ++position) {
+    const char c = at(position);
+    if (is_whitespace(c)) {
+      continue;
+    }
+    if (c == '{') {
+      root_found_ = true;
+    } else {
+      fail(errc::streaming_json_lexer::root_is_not_an_object);
+    }
+    return;
+  }
+}
+
+void
+structural_lexer::find_scalar_row(std::size_t end)
+{
+  if (!in_rowset_ || containers_.size() != 2 || row_begin_ || !separator_end_) {
+    return;
+  }
+  for (auto position = separator_end_.value(); position < end; ++position) {
+    if (!is_whitespace(at(position))) {
+      return begin_row(position);
+    }
+  }
+  separator_end_ = end;
+}
+
+void
+structural_lexer::end_scalar_row(std::size_t end)
+{
+  find_scalar_row(end);
+  if (!row_begin_) {
+    return;
+  }
+  auto row_end = end;
+  while (row_end > row_begin_.value() && is_whitespace(at(row_end - 1))) {
+    --row_end;
+  }
+  end_row(row_end);
+}
+
+void
+structural_lexer::begin_row(std::size_t position)
+{
+  row_begin_ = position;
+  separator_end_.reset();
+  if (meta_header_found_) {
+    return;
+  }
+  meta_header_found_ = true;
+  // nothing has been consumed before the first row
+  meta_buffer_.assign(region(0, position));
+  auto meta_header = meta_buffer_;
+  on_meta_header_complete_({}, std::move(meta_header));
+  on_meta_header_complete_ = noop_on_meta_header_complete;
+}
+
+void
+structural_lexer::end_row(std::size_t end)
+{
+  ++number_of_rows_;
+  if (emit_next_row_) {
+    auto rc = on_row_(std::string(region(row_begin_.value(), end)));
+    emit_next_row_ = rc == stream_control::next_row;
+    if (!emit_next_row_) {
+      on_row_ = noop_on_row;
+    }
+  }
+  row_begin_.reset();
+  consumed_ = end;
+}
+
+void
+structural_lexer::end_rowset(std::size_t position)
+{
+  in_rowset_ = false;
+  separator_end_.reset();
+  if (!meta_header_found_) {
+    // the header will be reported along with the trailer
+    meta_header_found_ = true;
+    meta_buffer_.assign(region(0, position));
+  }
+  trailer_begin_ = position;
+  consumed_ = position;
+}
+
+void
+structural_lexer::complete()
+{
+  finished_ = true;
+  // the trailer includes the rest of the last chunk after the root object
+  meta_buffer_.append(region(trailer_begin_, min_pos_ + buffer_.size()));
+
+  auto meta_header = meta_buffer_;
+  on_meta_header_complete_({}, std::move(meta_header));
+  on_meta_header_complete_ = noop_on_meta_header_complete;
+
+  on_complete_({}, number_of_rows_, std::move(meta_buffer_));
+  on_complete_ = noop_on_complete;
+}
+
+void
+structural_lexer::fail(std::error_code ec)
+{
+  finished_ = true;
+
+  on_meta_header_complete_(ec, {});
+  on_meta_header_complete_ = noop_on_meta_header_complete;
+
+  on_complete_(ec, number_of_rows_, {});
+  on_complete_ = noop_on_complete;
+}
+
+auto
+structural_lexer::at(std::size_t position) const -> char
+{
+  return buffer_[position - min_pos_];
+}
+
+auto
+structural_lexer::region(std::size_t begin, std::size_t end) const -> std::string_view
+{
+  return std::string_view{ buffer_ }.substr(begin - min_pos_, end - begin);
+}
+} // namespace couchbase::core::utils::json::detail
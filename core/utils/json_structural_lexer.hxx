@@ -0,0 +1,113 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include "json_stream_control.hxx"
+#include "json_structural_scanner.hxx"
+#include "movable_function.hxx"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+namespace couchbase::core::utils::json::detail
+{
+/**
+ * Backend of the streaming_lexer, that walks over the positions of the structural characters found
+ * by structural_scanner, instead of visiting every byte of the stream.
+ *
+ * It only supports pointer expressions in form of "/<key>/^", i.e. the rows are elements of the
+ * array, that is the value of the top-level key. The rows are not validated, so the consumers have
+ * to parse them anyway, but the nesting of the brackets is checked.
+ */
+class structural_lexer
+{
+public:
+  explicit structural_lexer(std::string rowset_key);
+
+  /**
+   * @return the key of the rowset array if the expression and depth can be handled by this
+   * lexer, or empty optional otherwise.
+   */
+  static auto rowset_key(const std::string& pointer_expression, std::uint32_t depth)
+    -> std::optional<std::string>;
+
+  void feed(std::string_view data);
+
+  void on_metadata_header_complete(
+    utils::movable_function<void(std::error_code ec, std::string&& meta_header)> handler);
+  void on_complete(
+    std::function<void(std::error_code ec, std::size_t number_of_rows, std::string&& meta)>
+      handler);
+  void on_row(std::function<stream_control(std::string&& row)> handler);
+
+private:
+  void process(std::size_t position);
+  void find_root(std::size_t end);
+  void find_scalar_row(std::size_t end);
+  void end_scalar_row(std::size_t end);
+  void begin_row(std::size_t position);
+  void end_row(std::size_t end);
+  void end_rowset(std::size_t position);
+  void complete();
+  void fail(std::error_code ec);
+  [[nodiscard]] auto at(std::size_t position) const -> char;
+  [[nodiscard]] auto region(std::size_t begin, std::size_t end) const -> std::string_view;
+
+  std::string rowset_key_;
+  structural_scanner scanner_{};
+  std::vector<std::size_t> index_{};
+
+  /** the stream starting from the absolute position min_pos_ */
+  std::string buffer_{};
+  std::size_t min_pos_{ 0 };
+  /** everything before this (absolute) position will not be used anymore */
+  std::size_t consumed_{ 0 };
+
+  /** opening brackets of the containers, the first one is the root object */
+  std::string containers_{};
+  bool root_found_{ false };
+  bool in_string_{ false };
+  std::size_t string_begin_{ 0 };
+  /** whether the last string of the root object was equal to the rowset key */
+  bool key_matches_{ false };
+
+  bool rowset_found_{ false };
+  bool in_rowset_{ false };
+  /** position, where the row might start after opening bracket of the rowset or the comma */
+  std::optional<std::size_t> separator_end_{};
+  std::optional<std::size_t> row_begin_{};
+  std::size_t number_of_rows_{ 0 };
+  bool emit_next_row_{ true };
+
+  std::string meta_buffer_{};
+  bool meta_header_found_{ false };
+  /** position of the closing bracket of the rowset, where the metadata trailer starts */
+  std::size_t trailer_begin_{ 0 };
+  bool finished_{ false };
+
+  utils::movable_function<void(std::error_code, std::string&&)> on_meta_header_complete_;
+  std::function<void(std::error_code, std::size_t, std::string&&)> on_complete_;
+  std::function<stream_control(std::string&&)> on_row_;
+};
+} // namespace couchbase::core::utils::json::detail
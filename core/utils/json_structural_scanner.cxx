@@ -0,0 +1,245 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+/*
+ * The escape and string masks are computed with the carry-less bit manipulations described in
+ * "Parsing Gigabytes of JSON per Second" by G. Langdale and D. Lemire (VLDB Journal, 2019).
+ */
+
+#include "json_structural_scanner.hxx"
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define COUCHBASE_CXX_CLIENT_JSON_SCANNER_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) && !defined(__ARM_BIG_ENDIAN) &&                                        \
+  (defined(__GNUC__) || defined(__clang__))
+#define COUCHBASE_CXX_CLIENT_JSON_SCANNER_NEON 1
+#include <arm_neon.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace couchbase::core::utils::json
+{
+namespace
+{
+constexpr std::uint64_t even_bits{ 0x5555555555555555ULL };
+
+auto
+is_structural(char c) -> bool
+{
+  return c == '{' || c == '}' || c == '[' || c == ']' || c == ',' || c == ':';
+}
+
+auto
+trailing_zeroes(std::uint64_t mask) -> std::size_t
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index{ 0 };
+  _BitScanForward64(&index, mask);
+  return index;
+#else
+  return static_cast<std::size_t>(__builtin_ctzll(mask));
+#endif
+}
+
+/**
+ * Sets every bit between the pairs of set bits, including the opening bit of the pair.
+ */
+auto
+prefix_xor(std::uint64_t mask) -> std::uint64_t
+{
+  mask ^= mask << 1;
+  mask ^= mask << 2;
+  mask ^= mask << 4;
+  mask ^= mask << 8;
+  mask ^= mask << 16;
+  mask ^= mask << 32;
+  return mask;
+}
+
+/**
+ * Returns the mask of the characters, that follow odd-length sequences of backslashes.
+ */
+auto
+find_escaped(std::uint64_t backslash, std::uint64_t& prev_escaped) -> std::uint64_t
+{
+  if (backslash == 0) {
+    const auto escaped = prev_escaped;
+    prev_escaped = 0;
+    return escaped;
+  }
+  // the backslash, that is escaped itself, does not start the escape sequence
+  backslash &= ~prev_escaped;
+  const std::uint64_t follows_escape = backslash << 1 | prev_escaped;
+  // sequences that start on odd positions overflow into the next even position, so they flip
+  // the sense of the even bits for the characters after them
+  const std::uint64_t odd_sequence_starts = backslash & ~even_bits & ~follows_escape;
+  const std::uint64_t sequences_starting_on_even_bits = odd_sequence_starts + backslash;
+  prev_escaped = sequences_starting_on_even_bits < backslash ? 1 : 0;
+  const std::uint64_t invert_mask = sequences_starting_on_even_bits << 1;
+  return (even_bits ^ invert_mask) & follows_escape;
+}
+
+#if defined(COUCHBASE_CXX_CLIENT_JSON_SCANNER_NEON)
+auto
+to_bitmask(uint8x16_t m0, uint8x16_t m1, uint8x16_t m2, uint8x16_t m3) -> std::uint64_t
+{
+  const uint8x16_t bits{ 0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80,
+                         0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80 };
+  uint8x16_t sum0 = vpaddq_u8(vandq_u8(m0, bits), vandq_u8(m1, bits));
+  const uint8x16_t sum1 = vpaddq_u8(vandq_u8(m2, bits), vandq_u8(m3, bits));
+  sum0 = vpaddq_u8(sum0, sum1);
+  sum0 = vpaddq_u8(sum0, sum0);
+  return vgetq_lane_u64(vreinterpretq_u64_u8(sum0), 0);
+}
+#endif
+} // namespace
+
+namespace json_structural_scanner_detail
+{
+auto
+classify_bytewise(const char* block) -> block_masks
+{
+  block_masks masks{};
+  for (std::size_t i = 0; i < structural_scanner::block_size; ++i) {
+    const std::uint64_t bit = 1ULL << i;
+    if (block[i] == '"') {
+      masks.quote |= bit;
+    } else if (block[i] == '\\') {
+      masks.backslash |= bit;
+    } else if (is_structural(block[i])) {
+      masks.structural |= bit;
+    }
+  }
+  return masks;
+}
+
+auto
+classify(const char* block) -> block_masks
+{
+#if defined(COUCHBASE_CXX_CLIENT_JSON_SCANNER_SSE2)
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  // '[' and ']' differ from '{' and '}' only by the 0x20 bit
+  const __m128i case_bit = _mm_set1_epi8(0x20);
+  const __m128i open = _mm_set1_epi8('{');
+  const __m128i close = _mm_set1_epi8('}');
+  const __m128i comma = _mm_set1_epi8(',');
+  const __m128i colon = _mm_set1_epi8(':');
+
+  block_masks masks{};
+  for (std::size_t i = 0; i < structural_scanner::block_size / 16; ++i) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16 * i));
+    const __m128i folded = _mm_or_si128(chunk, case_bit);
+    const __m128i structural =
+      _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(folded, open), _mm_cmpeq_epi8(folded, close)),
+                   _mm_or_si128(_mm_cmpeq_epi8(chunk, comma), _mm_cmpeq_epi8(chunk, colon)));
+    const auto shift = 16 * i;
+    masks.quote |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(
+                     _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, quote))))
+                   << shift;
+    masks.backslash |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(
+                         _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, backslash))))
+                       << shift;
+    masks.structural |=
+      static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(structural)))
+      << shift;
+  }
+  return masks;
+#elif defined(COUCHBASE_CXX_CLIENT_JSON_SCANNER_NEON)
+  const uint8x16_t quote = vdupq_n_u8('"');
+  const uint8x16_t backslash = vdupq_n_u8('\\');
+  // '[' and ']' differ from '{' and '}' only by the 0x20 bit
+  const uint8x16_t case_bit = vdupq_n_u8(0x20);
+  const uint8x16_t open = vdupq_n_u8('{');
+  const uint8x16_t close = vdupq_n_u8('}');
+  const uint8x16_t comma = vdupq_n_u8(',');
+  const uint8x16_t colon = vdupq_n_u8(':');
+
+  uint8x16_t quotes[4];
+  uint8x16_t backslashes[4];
+  uint8x16_t structurals[4];
+  for (std::size_t i = 0; i < 4; ++i) {
+    const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const std::uint8_t*>(block + 16 * i));
+    const uint8x16_t folded = vorrq_u8(chunk, case_bit);
+    quotes[i] = vceqq_u8(chunk, quote);
+    backslashes[i] = vceqq_u8(chunk, backslash);
+    structurals[i] = vorrq_u8(vorrq_u8(vceqq_u8(folded, open), vceqq_u8(folded, close)),
+                              vorrq_u8(vceqq_u8(chunk, comma), vceqq_u8(chunk, colon)));
+  }
+  return {
+    to_bitmask(quotes[0], quotes[1], quotes[2], quotes[3]),
+    to_bitmask(backslashes[0], backslashes[1], backslashes[2], backslashes[3]),
+    to_bitmask(structurals[0], structurals[1], structurals[2], structurals[3]),
+  };
+#else
+  return classify_bytewise(block);
+#endif
+}
+} // namespace json_structural_scanner_detail
+
+auto
+structural_scanner::scan_block(const char* block) -> std::uint64_t
+{
+  const auto masks = json_structural_scanner_detail::classify(block);
+  const auto escaped = find_escaped(masks.backslash, prev_escaped_);
+  const auto quote = masks.quote & ~escaped;
+  const auto in_string = prefix_xor(quote) ^ prev_in_string_;
+  prev_in_string_ = (in_string >> 63) != 0 ? ~0ULL : 0ULL;
+  return quote | (masks.structural & ~in_string & ~escaped);
+}
+
+auto
+structural_scanner::scan_byte(char c) -> bool
+{
+  if (prev_escaped_ != 0) {
+    prev_escaped_ = 0;
+    return false;
+  }
+  if (c == '\\') {
+    prev_escaped_ = 1;
+    return false;
+  }
+  if (c == '"') {
+    prev_in_string_ = ~prev_in_string_;
+    return true;
+  }
+  return prev_in_string_ == 0 && is_structural(c);
+}
+
+void
+structural_scanner::scan(std::string_view data, std::vector<std::size_t>& index)
+{
+  std::size_t offset{ 0 };
+  for (; offset + block_size <= data.size(); offset += block_size) {
+    auto mask = scan_block(data.data() + offset);
+    while (mask != 0) {
+      index.push_back(offset + trailing_zeroes(mask));
+      mask &= mask - 1;
+    }
+  }
+  // the tail is shorter than the block, so the state of the block scanner is advanced byte by byte
+  for (; offset < data.size(); ++offset) {
+    if (scan_byte(data[offset])) {
+      index.push_back(offset);
+    }
+  }
+}
+} // namespace couchbase::core::utils::json
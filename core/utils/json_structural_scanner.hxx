@@ -0,0 +1,77 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace couchbase::core::utils::json
+{
+/**
+ * Finds positions of the structural characters of the JSON stream, i.e. unescaped quotes, and
+ * brackets, braces, commas and colons outside of the strings.
+ *
+ * The input is classified 64 bytes at a time (SSE2 on x86-64, NEON on ARMv8, portable code
+ * otherwise) into bitmasks, and the escaped characters and string ranges are derived from the
+ * masks with carries across the blocks, so the stream might be split at arbitrary positions.
+ */
+class structural_scanner
+{
+public:
+  static constexpr std::size_t block_size{ 64 };
+
+  /**
+   * Appends offsets of the structural characters of the data (relative to its beginning) to the
+   * index.
+   */
+  void scan(std::string_view data, std::vector<std::size_t>& index);
+
+private:
+  auto scan_block(const char* block) -> std::uint64_t;
+  auto scan_byte(char c) -> bool;
+
+  /** whether the first character of the next block is escaped */
+  std::uint64_t prev_escaped_{ 0 };
+  /** all ones if the previous block ended inside the string */
+  std::uint64_t prev_in_string_{ 0 };
+};
+
+namespace json_structural_scanner_detail
+{
+struct block_masks {
+  std::uint64_t quote{ 0 };
+  std::uint64_t backslash{ 0 };
+  /** brackets, braces, commas and colons */
+  std::uint64_t structural{ 0 };
+};
+
+/**
+ * Reference implementation that classifies the block byte by byte.
+ */
+auto
+classify_bytewise(const char* block) -> block_masks;
+
+/**
+ * Classifies the block with vector instructions if they are available on the platform.
+ */
+auto
+classify(const char* block) -> block_masks;
+} // namespace json_structural_scanner_detail
+} // namespace couchbase::core::utils::json
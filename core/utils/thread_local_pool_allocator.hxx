@@ -0,0 +1,155 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace couchbase::core::utils
+{
+/**
+ * Caches up to MaxCached freed blocks of the given size for the current thread.
+ *
+ * Any block might be returned to any thread: blocks are plain allocations of the same size, so the
+ * caches only decide when the memory goes back to the global allocator.
+ */
+template<std::size_t BlockSize, std::size_t MaxCached>
+class thread_local_block_cache
+{
+public:
+  static auto allocate() -> void*
+  {
+    if (destroyed()) {
+      return ::operator new(BlockSize);
+    }
+    auto& blocks = local().blocks_;
+    if (blocks.empty()) {
+      return ::operator new(BlockSize);
+    }
+    auto* block = blocks.back();
+    blocks.pop_back();
+    return block;
+  }
+
+  static void deallocate(void* block)
+  {
+    if (destroyed()) {
+      // the thread is exiting, and its cache has already been released
+      return ::operator delete(block);
+    }
+    auto& blocks = local().blocks_;
+    if (blocks.size() < MaxCached) {
+      blocks.push_back(block);
+      return;
+    }
+    ::operator delete(block);
+  }
+
+  thread_local_block_cache(const thread_local_block_cache&) = delete;
+  thread_local_block_cache(thread_local_block_cache&&) = delete;
+  auto operator=(const thread_local_block_cache&) -> thread_local_block_cache& = delete;
+  auto operator=(thread_local_block_cache&&) -> thread_local_block_cache& = delete;
+
+  ~thread_local_block_cache()
+  {
+    destroyed() = true;
+    for (auto* block : blocks_) {
+      ::operator delete(block);
+    }
+  }
+
+private:
+  thread_local_block_cache()
+  {
+    blocks_.reserve(MaxCached);
+  }
+
+  static auto destroyed() -> bool&
+  {
+    // trivially destructible, so it can be checked even after the cache is gone
+    thread_local bool flag{ false };
+    return flag;
+  }
+
+  static auto local() -> thread_local_block_cache&
+  {
+    thread_local thread_local_block_cache cache{};
+    return cache;
+  }
+
+  std::vector<void*> blocks_{};
+};
+
+/**
+ * Allocator for std::allocate_shared (or containers of single elements), that takes the storage of
+ * the objects from the per-thread block caches instead of the global allocator.
+ */
+template<typename T, std::size_t MaxCached = 1024>
+class thread_local_pool_allocator
+{
+public:
+  using value_type = T;
+
+  template<typename U>
+  struct rebind {
+    using other = thread_local_pool_allocator<U, MaxCached>;
+  };
+
+  thread_local_pool_allocator() noexcept = default;
+
+  template<typename U>
+  thread_local_pool_allocator(const thread_local_pool_allocator<U, MaxCached>& /* other */) noexcept
+  {
+  }
+
+  [[nodiscard]] auto allocate(std::size_t n) -> T*
+  {
+    if (n != 1 || alignof(T) > alignof(std::max_align_t)) {
+      return std::allocator<T>{}.allocate(n);
+    }
+    return static_cast<T*>(cache::allocate());
+  }
+
+  void deallocate(T* pointer, std::size_t n) noexcept
+  {
+    if (n != 1 || alignof(T) > alignof(std::max_align_t)) {
+      return std::allocator<T>{}.deallocate(pointer, n);
+    }
+    cache::deallocate(pointer);
+  }
+
+  template<typename U>
+  auto operator==(const thread_local_pool_allocator<U, MaxCached>& /* other */) const noexcept
+    -> bool
+  {
+    return true;
+  }
+
+  template<typename U>
+  auto operator!=(const thread_local_pool_allocator<U, MaxCached>& /* other */) const noexcept
+    -> bool
+  {
+    return false;
+  }
+
+private:
+  using cache = thread_local_block_cache<sizeof(T), MaxCached>;
+};
+} // namespace couchbase::core::utils
@@ -47,6 +47,9 @@
 
 #include <future>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -156,6 +159,39 @@ public:
   [[nodiscard]] auto get(std::string document_id, const get_options& options = {}) const
     -> std::future<std::pair<error, get_result>>;
 
+  /**
+   * Fetches a batch of full documents from this collection.
+   *
+   * The requests are grouped by the node that owns the document, the requests of each node are
+   * written to its connection at once, and the handler is invoked once all of them have completed.
+   *
+   * @param document_ids the document ids which are used to uniquely identify documents.
+   * @param options options to customize the get requests.
+   * @param handler the handler that implements @ref get_multi_handler. The results are in the
+   * same order as document_ids, and each of them carries its own error.
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  void get_multi(std::vector<std::string> document_ids,
+                 const get_options& options,
+                 get_multi_handler&& handler) const;
+
+  /**
+   * Fetches a batch of full documents from this collection.
+   *
+   * @param document_ids the document ids which are used to uniquely identify documents.
+   * @param options options to customize the get requests.
+   * @return future object that carries results of the operations in the same order as
+   * document_ids
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  [[nodiscard]] auto get_multi(std::vector<std::string> document_ids,
+                               const get_options& options = {}) const
+    -> std::future<get_multi_result>;
+
   /**
    * Fetches a full document and resets its expiration time to the value provided.
    *
@@ -516,6 +552,81 @@ public:
       std::move(document_id), create_encode_fn<Transcoder, Document>(std::move(document)), options);
   }
 
+  /**
+   * Upserts a batch of encoded documents which might or might not exist yet.
+   *
+   * The requests are grouped by the node that owns the document, the requests of each node are
+   * written to its connection at once, and the handler is invoked once all of them have completed.
+   *
+   * @param documents pairs of document id and encoded content of the document to upsert.
+   * @param options custom options to customize the upsert behavior.
+   * @param handler callable that implements @ref upsert_multi_handler. The results are in the
+   * same order as documents, and each of them carries its own error.
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  void upsert_multi(std::vector<std::pair<std::string, codec::encoded_value>> documents,
+                    const upsert_options& options,
+                    upsert_multi_handler&& handler) const;
+
+  /**
+   * Upserts a batch of documents which might or might not exist yet.
+   *
+   * @tparam Transcoder type of the transcoder that will be used to encode the documents
+   * @tparam Document type of the document
+   *
+   * @param documents pairs of document id and content of the document to upsert.
+   * @param options custom options to customize the upsert behavior.
+   * @param handler callable that implements @ref upsert_multi_handler
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  template<typename Transcoder = codec::default_json_transcoder, typename Document>
+  void upsert_multi(std::vector<std::pair<std::string, Document>> documents,
+                    const upsert_options& options,
+                    upsert_multi_handler&& handler) const
+  {
+    return upsert_multi(
+      create_encode_fns<Transcoder, Document>(std::move(documents)), options, std::move(handler));
+  }
+
+  /**
+   * Upserts a batch of encoded documents which might or might not exist yet.
+   *
+   * @param documents pairs of document id and encoded content of the document to upsert.
+   * @param options custom options to customize the upsert behavior.
+   * @return future object that carries results of the operations in the same order as documents
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  [[nodiscard]] auto upsert_multi(
+    std::vector<std::pair<std::string, codec::encoded_value>> documents,
+    const upsert_options& options) const -> std::future<upsert_multi_result>;
+
+  /**
+   * Upserts a batch of documents which might or might not exist yet.
+   *
+   * @tparam Transcoder type of the transcoder that will be used to encode the documents
+   * @tparam Document type of the document
+   *
+   * @param documents pairs of document id and content of the document to upsert.
+   * @param options custom options to customize the upsert behavior.
+   * @return future object that carries results of the operations in the same order as documents
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  template<typename Transcoder = codec::default_json_transcoder, typename Document>
+  [[nodiscard]] auto upsert_multi(std::vector<std::pair<std::string, Document>> documents,
+                                  const upsert_options& options = {}) const
+    -> std::future<upsert_multi_result>
+  {
+    return upsert_multi(create_encode_fns<Transcoder, Document>(std::move(documents)), options);
+  }
+
   /**
    * Inserts an encoded body of the document which does not exist yet with custom options.
    *
@@ -765,6 +876,39 @@ public:
   [[nodiscard]] auto remove(std::string document_id, const remove_options& options = {}) const
     -> std::future<std::pair<error, mutation_result>>;
 
+  /**
+   * Removes a batch of documents from a collection.
+   *
+   * The requests are grouped by the node that owns the document, the requests of each node are
+   * written to its connection at once, and the handler is invoked once all of them have completed.
+   *
+   * @param document_ids the document ids which are used to uniquely identify documents.
+   * @param options custom options to customize the remove behavior.
+   * @param handler callable that implements @ref remove_multi_handler. The results are in the
+   * same order as document_ids, and each of them carries its own error.
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  void remove_multi(std::vector<std::string> document_ids,
+                    const remove_options& options,
+                    remove_multi_handler&& handler) const;
+
+  /**
+   * Removes a batch of documents from a collection.
+   *
+   * @param document_ids the document ids which are used to uniquely identify documents.
+   * @param options custom options to customize the remove behavior.
+   * @return future object that carries results of the operations in the same order as
+   * document_ids
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  [[nodiscard]] auto remove_multi(std::vector<std::string> document_ids,
+                                  const remove_options& options = {}) const
+    -> std::future<remove_multi_result>;
+
   /**
    * Performs mutations to document fragments
    *
@@ -1114,6 +1258,20 @@ private:
     }
   }
 
+  template<typename Transcoder, typename Document>
+  [[nodiscard]] auto create_encode_fns(
+    std::vector<std::pair<std::string, Document>> documents) const
+    -> std::vector<std::pair<std::string, std::function<codec::encoded_value()>>>
+  {
+    std::vector<std::pair<std::string, std::function<codec::encoded_value()>>> encode_fns;
+    encode_fns.reserve(documents.size());
+    for (auto& [document_id, document] : documents) {
+      encode_fns.emplace_back(std::move(document_id),
+                              create_encode_fn<Transcoder, Document>(std::move(document)));
+    }
+    return encode_fns;
+  }
+
   void replace(std::string document_id,
                std::function<codec::encoded_value()> document_fn,
                const replace_options& options,
@@ -1134,6 +1292,15 @@ private:
               const upsert_options& options) const
     -> std::future<std::pair<error, mutation_result>>;
 
+  void upsert_multi(
+    std::vector<std::pair<std::string, std::function<codec::encoded_value()>>> documents,
+    const upsert_options& options,
+    upsert_multi_handler&& handler) const;
+
+  auto upsert_multi(
+    std::vector<std::pair<std::string, std::function<codec::encoded_value()>>> documents,
+    const upsert_options& options) const -> std::future<upsert_multi_result>;
+
   void insert(std::string document_id,
               std::function<codec::encoded_value()> document_fn,
               const insert_options& options,
@@ -40,5 +40,49 @@ auto
 decrypt(std::vector<std::byte> key,
         std::vector<std::byte> ciphertext,
         std::vector<std::byte> associated_data) -> std::pair<error, std::vector<std::byte>>;
+
+/**
+ * Field of a document for encrypt_fields()
+ */
+struct plaintext_field {
+  std::vector<std::byte> iv;
+  std::vector<std::byte> plaintext;
+  std::vector<std::byte> associated_data{};
+};
+
+/**
+ * Field of a document for decrypt_fields()
+ */
+struct ciphertext_field {
+  std::vector<std::byte> ciphertext;
+  std::vector<std::byte> associated_data{};
+};
+
+/**
+ * Encrypts all fields of a document, that use the same key, in one call.
+ *
+ * The cipher and HMAC contexts of the key are kept per thread and reused for every field, so that
+ * the key setup is not repeated for each of them.
+ *
+ * @return ciphertexts in the order of the fields, or the error of the first field that failed
+ *
+ * @since 1.3.1
+ * @internal
+ */
+auto
+encrypt_fields(const std::vector<std::byte>& key, const std::vector<plaintext_field>& fields)
+  -> std::pair<error, std::vector<std::vector<std::byte>>>;
+
+/**
+ * Decrypts all fields of a document, that use the same key, in one call.
+ *
+ * @return plaintexts in the order of the fields, or the error of the first field that failed
+ *
+ * @since 1.3.1
+ * @internal
+ */
+auto
+decrypt_fields(const std::vector<std::byte>& key, const std::vector<ciphertext_field>& fields)
+  -> std::pair<error, std::vector<std::vector<std::byte>>>;
 } // namespace aead_aes_256_cbc_hmac_sha512
 } // namespace couchbase::crypto::internal
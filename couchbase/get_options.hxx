@@ -25,6 +25,8 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
+#include <vector>
 
 namespace couchbase
 {
@@ -109,4 +111,21 @@ private:
  * @uncommitted
  */
 using get_handler = std::function<void(error, get_result)>;
+
+/**
+ * Results of the @ref collection#get_multi() operation, in the same order as the requested
+ * document IDs.
+ *
+ * @since 1.3.1
+ * @volatile
+ */
+using get_multi_result = std::vector<std::pair<error, get_result>>;
+
+/**
+ * The signature for the handler of the @ref collection#get_multi() operation
+ *
+ * @since 1.3.1
+ * @volatile
+ */
+using get_multi_handler = std::function<void(get_multi_result)>;
 } // namespace couchbase
@@ -84,6 +84,30 @@ public:
     return *this;
   }
 
+  /**
+   * Keeps warm HTTP connections to the query, search and analytics services.
+   *
+   * After bootstrap and after every topology change, the SDK opens connections in the background,
+   * until every node has at least the given number of connections for each of these services, so
+   * that the first requests do not wait for TCP and TLS handshakes. The warm connections are still
+   * closed after the idle HTTP connection timeout.
+   *
+   * @param number_of_connections minimum number of connections per node and service (zero
+   * disables warming).
+   * @return this object for chaining purposes.
+   *
+   * @see idle_http_connection_timeout
+   *
+   * @volatile This option is considered unstable and may change in future releases.
+   *
+   * @since 1.3.1
+   */
+  auto min_http_connections_per_node(std::size_t number_of_connections) -> network_options&
+  {
+    min_http_connections_per_node_ = number_of_connections;
+    return *this;
+  }
+
   auto force_ip_protocol(ip_protocol protocol) -> network_options&
   {
     ip_protocol_ = protocol;
@@ -130,6 +154,53 @@ public:
     return *this;
   }
 
+  /**
+   * Sets the number of threads used to drive network I/O.
+   *
+   * By default all sockets, timers and callbacks of the cluster share a single I/O thread. When
+   * more than one thread is requested, the SDK creates a separate I/O context for each extra thread
+   * and spreads KV and HTTP connections across them, so that traffic to different nodes and
+   * buckets is processed in parallel. Bootstrap, configuration polling and deadlines stay on the
+   * first thread.
+   *
+   * @param number_of_threads number of I/O threads (zero is treated as one).
+   * @return this object for chaining purposes.
+   *
+   * @volatile This option is considered unstable and may change in future releases.
+   *
+   * @since 1.3.1
+   */
+  auto io_threads(std::size_t number_of_threads) -> network_options&
+  {
+    io_threads_ = number_of_threads == 0 ? 1 : number_of_threads;
+    return *this;
+  }
+
+  /**
+   * Enables coalescing of outgoing KV requests.
+   *
+   * By default the KV connection writes requests to the socket as soon as they are scheduled (the
+   * requests scheduled while the previous write is in progress are still sent together). With
+   * coalescing enabled, the connection holds outgoing requests for up to the given delay, unless
+   * at least the given number of bytes has been accumulated, so that they are sent with fewer
+   * system calls. This trades a little latency for throughput.
+   *
+   * @param threshold_bytes number of bytes that triggers the write before the delay expires.
+   * @param max_delay the maximum time the requests are held (zero disables coalescing).
+   * @return this object for chaining purposes.
+   *
+   * @volatile This option is considered unstable and may change in future releases.
+   *
+   * @since 1.3.1
+   */
+  auto write_coalescing(std::size_t threshold_bytes, std::chrono::microseconds max_delay)
+    -> network_options&
+  {
+    write_coalescing_threshold_ = threshold_bytes;
+    write_coalescing_delay_ = max_delay;
+    return *this;
+  }
+
   struct built {
     std::string network;
     std::string server_group;
@@ -139,7 +210,11 @@ public:
     std::chrono::milliseconds config_poll_interval;
     std::chrono::milliseconds idle_http_connection_timeout;
     std::optional<std::size_t> max_http_connections;
+    std::size_t min_http_connections_per_node;
     bool enable_lazy_connections;
+    std::size_t io_threads;
+    std::size_t write_coalescing_threshold;
+    std::chrono::microseconds write_coalescing_delay;
   };
 
   [[nodiscard]] auto build() const -> built
@@ -153,7 +228,11 @@ public:
       config_poll_interval_,
       idle_http_connection_timeout_,
       max_http_connections_,
+      min_http_connections_per_node_,
       enable_lazy_connections_,
+      io_threads_,
+      write_coalescing_threshold_,
+      write_coalescing_delay_,
     };
   }
 
@@ -167,6 +246,10 @@ private:
   std::chrono::milliseconds config_poll_floor_{ default_config_poll_floor };
   std::chrono::milliseconds idle_http_connection_timeout_{ default_idle_http_connection_timeout };
   std::optional<std::size_t> max_http_connections_{};
+  std::size_t min_http_connections_per_node_{ 0 };
   bool enable_lazy_connections_{ false };
+  std::size_t io_threads_{ 1 };
+  std::size_t write_coalescing_threshold_{ 0 };
+  std::chrono::microseconds write_coalescing_delay_{ 0 };
 };
 } // namespace couchbase
@@ -0,0 +1,169 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#pragma once
+
+#include <couchbase/codec/encoded_value.hxx>
+#include <couchbase/error.hxx>
+#include <couchbase/query_meta_data.hxx>
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace couchbase
+{
+#ifndef COUCHBASE_CXX_CLIENT_DOXYGEN
+class internal_query_row_stream;
+#endif
+
+/**
+ * The signature for the handler of the @ref query_row_stream#next_row() operation.
+ *
+ * Empty row means that the stream has been exhausted.
+ *
+ * @since 1.3.1
+ * @volatile
+ */
+using query_row_handler = std::function<void(error, std::optional<codec::binary>)>;
+
+/**
+ * The signature for the handler of the @ref query_row_stream#next_rows() operation.
+ *
+ * Empty batch means that the stream has been exhausted.
+ *
+ * @since 1.3.1
+ * @volatile
+ */
+using query_rows_handler = std::function<void(error, std::vector<codec::binary>)>;
+
+/**
+ * Rows of @ref cluster#query_stream() and @ref scope#query_stream() calls, delivered as they are
+ * received from the query service.
+ *
+ * Only a bounded number of rows is buffered by the stream. When the consumer falls behind, the
+ * library stops reading the response from the socket until the buffered rows are taken, so that
+ * results of any size could be processed in constant memory. Note that the timeout of the query
+ * covers the whole stream, including the time spent waiting for the consumer.
+ *
+ * Only one @ref next_row() or @ref next_rows() request might be outstanding at a time. A stream,
+ * that has not been opened (for instance because the query has failed), completes every request
+ * for rows with errc::common::request_canceled.
+ *
+ * @since 1.3.1
+ * @volatile
+ */
+class query_row_stream
+{
+public:
+  /**
+   * @since 1.3.1
+   * @internal
+   */
+  query_row_stream() = default;
+
+  /**
+   * @since 1.3.1
+   * @internal
+   */
+  explicit query_row_stream(std::shared_ptr<internal_query_row_stream> internal);
+
+  /**
+   * Fetches the next row.
+   *
+   * @param handler callable that implements @ref query_row_handler
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  void next_row(query_row_handler&& handler) const;
+
+  /**
+   * Fetches the next row.
+   *
+   * @return future object that carries the result of the operation
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  [[nodiscard]] auto next_row() const
+    -> std::future<std::pair<error, std::optional<codec::binary>>>;
+
+  /**
+   * Fetches the rows, that are already received, but not more than the given number. Waits for
+   * the next row if none has been received yet.
+   *
+   * @param max_rows maximum number of rows in the batch
+   * @param handler callable that implements @ref query_rows_handler
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  void next_rows(std::size_t max_rows, query_rows_handler&& handler) const;
+
+  /**
+   * Fetches the rows, that are already received, but not more than the given number.
+   *
+   * @param max_rows maximum number of rows in the batch
+   * @return future object that carries the result of the operation
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  [[nodiscard]] auto next_rows(std::size_t max_rows) const
+    -> std::future<std::pair<error, std::vector<codec::binary>>>;
+
+  /**
+   * Returns the metadata of the query, that becomes available once the last row has been received.
+   *
+   * @return response metadata, or empty optional if the response has not been received completely
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  [[nodiscard]] auto meta_data() const -> std::optional<query_meta_data>;
+
+  /**
+   * Stops the query. The rows, that are not yet taken, are discarded, and the connection is
+   * closed, unless the response has been already received. The pending and all further requests
+   * for rows complete with errc::common::request_canceled.
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  void cancel();
+
+private:
+  std::shared_ptr<internal_query_row_stream> internal_{};
+};
+
+/**
+ * The signature for the handler of the @ref cluster#query_stream() and @ref scope#query_stream()
+ * operations.
+ *
+ * The handler is invoked when the first row has been received, or when the query has completed
+ * without rows. In the latter case the error of the query is reported to the handler.
+ *
+ * @since 1.3.1
+ * @volatile
+ */
+using query_stream_handler = std::function<void(error, query_row_stream)>;
+} // namespace couchbase
@@ -27,6 +27,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 namespace couchbase
@@ -101,4 +102,21 @@ private:
  * @uncommitted
  */
 using remove_handler = std::function<void(error, mutation_result)>;
+
+/**
+ * Results of the @ref collection#remove_multi() operation, in the same order as the requested
+ * document IDs.
+ *
+ * @since 1.3.1
+ * @volatile
+ */
+using remove_multi_result = std::vector<std::pair<error, mutation_result>>;
+
+/**
+ * The signature for the handler of the @ref collection#remove_multi() operation
+ *
+ * @since 1.3.1
+ * @volatile
+ */
+using remove_multi_handler = std::function<void(remove_multi_result)>;
 } // namespace couchbase
@@ -120,6 +120,26 @@ public:
     return self();
   }
 
+  /**
+   * Lets the library adjust the number of partitions scanned concurrently on each node, based on
+   * the observed latency and throughput of the batches. The value of @ref concurrency() is then
+   * only the initial number of concurrent partition scans. Defaults to false.
+   *
+   * Note that the order of the partitions is not deterministic with adaptive concurrency, so it
+   * should not be used with seeded sampling scans, that must return the same items.
+   *
+   * @param enabled whether the concurrency should be adjusted adaptively
+   * @return the options builder for chaining purposes.
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  auto adaptive_concurrency(bool enabled) -> scan_options&
+  {
+    adaptive_concurrency_ = enabled;
+    return self();
+  }
+
   /**
    * Immutable value object representing consistent options.
    *
@@ -132,6 +152,7 @@ public:
     std::optional<std::uint32_t> batch_byte_limit;
     std::optional<std::uint32_t> batch_item_limit;
     std::optional<std::uint16_t> concurrency;
+    bool adaptive_concurrency;
   };
 
   /**
@@ -147,8 +168,10 @@ public:
    */
   [[nodiscard]] auto build() const -> built
   {
-    return { build_common_options(), ids_only_,         mutation_state_,
-             batch_byte_limit_,      batch_item_limit_, concurrency_ };
+    return {
+      build_common_options(), ids_only_,    mutation_state_,       batch_byte_limit_,
+      batch_item_limit_,      concurrency_, adaptive_concurrency_,
+    };
   }
 
 private:
@@ -157,6 +180,7 @@ private:
   std::optional<std::uint32_t> batch_byte_limit_{};
   std::optional<std::uint32_t> batch_item_limit_{};
   std::optional<std::uint16_t> concurrency_{};
+  bool adaptive_concurrency_{ false };
 };
 
 /**
@@ -20,6 +20,7 @@
 #include <couchbase/analytics_options.hxx>
 #include <couchbase/collection.hxx>
 #include <couchbase/query_options.hxx>
+#include <couchbase/query_row_stream.hxx>
 #include <couchbase/scope_search_index_manager.hxx>
 #include <couchbase/search_options.hxx>
 #include <couchbase/search_query.hxx>
@@ -113,6 +114,39 @@ public:
   [[nodiscard]] auto query(std::string statement, const query_options& options = {}) const
     -> std::future<std::pair<error, query_result>>;
 
+  /**
+   * Performs a query against the query (N1QL) services, and streams the rows as they are received.
+   *
+   * Unlike @ref query(), the rows are not collected in memory. The stream pauses reading of the
+   * response when the consumer falls behind.
+   *
+   * @param statement the N1QL query statement.
+   * @param options options to customize the query request.
+   * @param handler the handler that implements @ref query_stream_handler
+   *
+   * @exception errc::common::ambiguous_timeout
+   * @exception errc::common::unambiguous_timeout
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  void query_stream(std::string statement,
+                    const query_options& options,
+                    query_stream_handler&& handler) const;
+
+  /**
+   * Performs a query against the query (N1QL) services, and streams the rows as they are received.
+   *
+   * @param statement the N1QL query statement.
+   * @param options options to customize the query request.
+   * @return future object that carries the stream of rows
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  [[nodiscard]] auto query_stream(std::string statement, const query_options& options = {}) const
+    -> std::future<std::pair<error, query_row_stream>>;
+
   /**
    * Performs a request against the full text search services.
    *
@@ -22,6 +22,7 @@
 #include <couchbase/transactions/transactions_query_config.hxx>
 
 #include <chrono>
+#include <cstddef>
 #include <memory>
 #include <optional>
 
@@ -104,6 +105,37 @@ public:
     return *this;
   }
 
+  /**
+   * @brief Get the maximum number of documents unstaged concurrently.
+   *
+   * When the transaction commits or rolls back, the staged documents are unstaged in parallel.
+   * This is the size of the window of unstaging requests that may be in flight at any moment.
+   *
+   * @return maximum number of documents unstaged concurrently.
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  [[nodiscard]] auto unstaging_window() const -> std::size_t
+  {
+    return unstaging_window_;
+  }
+
+  /**
+   * @brief Set the maximum number of documents unstaged concurrently.
+   *
+   * @param window desired number of in-flight unstaging requests, zero is treated as one.
+   * @return reference to this, so calls can be chained.
+   *
+   * @since 1.3.1
+   * @volatile
+   */
+  auto unstaging_window(std::size_t window) -> transactions_config&
+  {
+    unstaging_window_ = window;
+    return *this;
+  }
+
   /**
    * Set the transaction's metadata collection.
    *
@@ -219,6 +251,7 @@ public:
     std::optional<couchbase::transactions::transaction_keyspace> metadata_collection;
     transactions_query_config::built query_config;
     transactions_cleanup_config::built cleanup_config;
+    std::size_t unstaging_window{ 1000 };
   };
 
   /** @internal */
@@ -227,6 +260,7 @@ public:
 private:
   couchbase::durability_level level_{ couchbase::durability_level::majority };
   std::chrono::nanoseconds timeout_{ std::chrono::seconds(15) };
+  std::size_t unstaging_window_{ 1000 };
   std::shared_ptr<core::transactions::attempt_context_testing_hooks> attempt_context_hooks_;
   std::shared_ptr<core::transactions::cleanup_testing_hooks> cleanup_hooks_;
   std::optional<couchbase::transactions::transaction_keyspace> metadata_collection_;
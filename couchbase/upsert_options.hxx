@@ -27,6 +27,7 @@
 #include <functional>
 #include <memory>
 #include <optional>
+#include <utility>
 #include <vector>
 
 namespace couchbase
@@ -136,4 +137,20 @@ private:
  * @uncommitted
  */
 using upsert_handler = std::function<void(error, mutation_result)>;
+
+/**
+ * Results of the @ref collection#upsert_multi() operation, in the same order as the documents.
+ *
+ * @since 1.3.1
+ * @volatile
+ */
+using upsert_multi_result = std::vector<std::pair<error, mutation_result>>;
+
+/**
+ * The signature for the handler of the @ref collection#upsert_multi() operation
+ *
+ * @since 1.3.1
+ * @volatile
+ */
+using upsert_multi_handler = std::function<void(upsert_multi_result)>;
 } // namespace couchbase
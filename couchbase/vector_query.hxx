@@ -22,6 +22,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <vector>
 
 namespace couchbase
 {
@@ -50,6 +51,28 @@ public:
     }
   }
 
+  /**
+   * Creates a vector query from single-precision embedding.
+   *
+   * The vector is sent to the server as a base64-encoded sequence of little-endian IEEE 754
+   * floats, which is several times more compact than the JSON array of decimal numbers.
+   *
+   * @param vector_field_name the document field that contains the vector
+   * @param vector_query the vector query to run. Cannot be empty.
+   *
+   * @snippet{trimleft} test/test_unit_search.cxx float-vector-query
+   * @since 1.3.1
+   * @volatile
+   */
+  vector_query(std::string vector_field_name, std::vector<float> vector_query)
+    : vector_field_name_{ std::move(vector_field_name) }
+    , float_vector_query_{ std::move(vector_query) }
+  {
+    if (float_vector_query_.value().empty()) {
+      throw std::invalid_argument("the vector_query cannot be empty");
+    }
+  }
+
   /**
    * Creates a vector query
    *
@@ -135,6 +158,7 @@ private:
   std::string vector_field_name_;
   std::uint32_t num_candidates_{ 3 };
   std::optional<std::vector<double>> vector_query_{};
+  std::optional<std::vector<float>> float_vector_query_{};
   std::optional<std::string> base64_vector_query_{};
   std::optional<double> boost_{};
   std::shared_ptr<search_query> prefilter_{};
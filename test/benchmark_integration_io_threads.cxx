@@ -0,0 +1,87 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper_integration.hxx"
+
+#include <couchbase/codec/tao_json_serializer.hxx>
+
+#include <tao/json/value.hpp>
+
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::size_t number_of_keys{ 64 };
+constexpr std::size_t operations_per_batch{ 2'048 };
+
+void
+run_get_batch(const couchbase::collection& collection, const std::vector<std::string>& keys)
+{
+  std::vector<std::future<std::pair<couchbase::error, couchbase::get_result>>> futures;
+  futures.reserve(operations_per_batch);
+  for (std::size_t i = 0; i < operations_per_batch; ++i) {
+    futures.emplace_back(collection.get(keys[i % keys.size()], {}));
+  }
+  for (auto& f : futures) {
+    const auto [err, _] = f.get();
+    REQUIRE_SUCCESS(err.ec());
+  }
+}
+} // namespace
+
+TEST_CASE("benchmark: concurrent gets with multiple I/O threads", "[benchmark]")
+{
+  test::utils::integration_test_guard integration;
+
+  const auto max_io_threads =
+    std::max(std::size_t{ 1 }, std::size_t{ std::thread::hardware_concurrency() });
+
+  std::vector<std::string> keys;
+  {
+    auto cluster = integration.public_cluster();
+    auto collection = cluster.bucket(integration.ctx.bucket).default_collection();
+    const tao::json::value value = {
+      { "a", 1.0 },
+      { "b", 2.0 },
+    };
+    for (std::size_t i = 0; i < number_of_keys; ++i) {
+      keys.emplace_back(test::utils::uniq_id("io_threads"));
+      const auto [err, _] = collection.upsert(keys.back(), value).get();
+      REQUIRE_SUCCESS(err.ec());
+    }
+    cluster.close().get();
+  }
+
+  for (std::size_t io_threads = 1; io_threads <= max_io_threads; io_threads *= 2) {
+    auto cluster = integration.public_cluster([io_threads](couchbase::cluster_options& options) {
+      options.network().io_threads(io_threads);
+    });
+    auto collection = cluster.bucket(integration.ctx.bucket).default_collection();
+    // establish connections to all nodes before measuring
+    run_get_batch(collection, keys);
+
+    BENCHMARK(fmt::format("{} gets with {} I/O thread(s)", operations_per_batch, io_threads))
+    {
+      run_get_batch(collection, keys);
+    };
+
+    cluster.close().get();
+  }
+}
@@ -0,0 +1,56 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper_integration.hxx"
+
+#include <couchbase/codec/tao_json_serializer.hxx>
+#include <couchbase/transactions.hxx>
+
+#include <tao/json/value.hpp>
+
+#include <memory>
+
+TEST_CASE("benchmark: commit transaction with many mutations", "[benchmark]")
+{
+  test::utils::integration_test_guard integration;
+
+  auto cluster = integration.public_cluster();
+  auto collection = cluster.bucket(integration.ctx.bucket).default_collection();
+
+  const tao::json::value value = {
+    { "a", 1.0 },
+    { "b", 2.0 },
+  };
+
+  for (const std::size_t number_of_mutations : { 10, 100, 1'000 }) {
+    BENCHMARK(fmt::format("transaction with {} inserts", number_of_mutations))
+    {
+      auto [tx_err, result] = cluster.transactions()->run(
+        [&](std::shared_ptr<couchbase::transactions::attempt_context> ctx) -> couchbase::error {
+          for (std::size_t i = 0; i < number_of_mutations; ++i) {
+            auto [e, _] = ctx->insert(collection, test::utils::uniq_id("txn_benchmark"), value);
+            if (e) {
+              return e;
+            }
+          }
+          return {};
+        });
+      REQUIRE_SUCCESS(tx_err.ec());
+      REQUIRE(result.unstaging_complete);
+    };
+  }
+}
@@ -0,0 +1,53 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/utils/crc32.hxx"
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+TEST_CASE("benchmark: crc32 of document keys", "[benchmark]")
+{
+  using namespace couchbase::core::utils;
+
+  std::vector<std::byte> key(250);
+  for (std::size_t i = 0; i < key.size(); ++i) {
+    key[i] = static_cast<std::byte>('a' + i % 26);
+  }
+
+  for (const auto key_length : std::vector<std::size_t>{ 8, 16, 32, 64, 128, 250 }) {
+    BENCHMARK(fmt::format("byte-at-a-time, {} bytes", key_length))
+    {
+      return crc32_detail::update_bytewise(UINT32_MAX, key.data(), key_length);
+    };
+    BENCHMARK(fmt::format("slicing-by-8, {} bytes", key_length))
+    {
+      return crc32_detail::update_slicing_by_8(UINT32_MAX, key.data(), key_length);
+    };
+    if (crc32_detail::has_hardware_support()) {
+      BENCHMARK(fmt::format("hardware, {} bytes", key_length))
+      {
+        return crc32_detail::update_hardware(UINT32_MAX, key.data(), key_length);
+      };
+    }
+  }
+}
@@ -0,0 +1,112 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/crypto/cbcrypto.h"
+#include "core/utils/binary.hxx"
+
+#include <couchbase/crypto/internal.hxx>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace aead = couchbase::crypto::internal::aead_aes_256_cbc_hmac_sha512;
+namespace crypto = couchbase::core::crypto;
+
+namespace
+{
+auto
+make_fields(std::size_t number_of_fields) -> std::vector<aead::plaintext_field>
+{
+  std::vector<aead::plaintext_field> fields{};
+  for (std::size_t i = 0; i < number_of_fields; ++i) {
+    auto [err, iv] = couchbase::crypto::internal::generate_initialization_vector();
+    REQUIRE_SUCCESS(err.ec());
+    const std::string value = "\"value of the encrypted field number " + std::to_string(i) + "\"";
+    fields.push_back({ iv, couchbase::core::utils::to_binary(value) });
+  }
+  return fields;
+}
+} // namespace
+
+TEST_CASE("benchmark: encrypt and decrypt fields of a document", "[benchmark]")
+{
+  std::vector<std::byte> key{ 64 };
+  for (std::size_t i = 0; i < key.size(); ++i) {
+    key[i] = static_cast<std::byte>(i);
+  }
+
+  for (const std::size_t number_of_fields : { 1U, 10U, 100U }) {
+    const auto fields = make_fields(number_of_fields);
+    auto [err, ciphertexts] = aead::encrypt_fields(key, fields);
+    REQUIRE_SUCCESS(err.ec());
+    std::vector<aead::ciphertext_field> encrypted_fields{};
+    for (const auto& ciphertext : ciphertexts) {
+      encrypted_fields.push_back({ ciphertext });
+    }
+
+    // the key setup for every field, the way it was done before the contexts were cached
+    BENCHMARK("encrypt " + std::to_string(number_of_fields) + " fields with new contexts")
+    {
+      const std::string_view key_bytes{ reinterpret_cast<const char*>(key.data()), key.size() };
+      std::size_t size{ 0 };
+      for (const auto& field : fields) {
+        crypto::cipher_context context{ crypto::Cipher::AES_256_cbc,
+                                        key_bytes.substr(32),
+                                        crypto::Algorithm::ALG_SHA512,
+                                        key_bytes.substr(0, 32) };
+        const auto ciphertext = context.encrypt(
+          { reinterpret_cast<const char*>(field.iv.data()), field.iv.size() },
+          { reinterpret_cast<const char*>(field.plaintext.data()), field.plaintext.size() });
+        size += ciphertext.size() + context.hmac({ ciphertext }).size();
+      }
+      return size;
+    };
+
+    BENCHMARK("encrypt " + std::to_string(number_of_fields) + " fields one by one")
+    {
+      std::size_t size{ 0 };
+      for (const auto& field : fields) {
+        auto [e, ciphertext] = aead::encrypt(key, field.iv, field.plaintext, field.associated_data);
+        size += ciphertext.size();
+      }
+      return size;
+    };
+
+    BENCHMARK("encrypt " + std::to_string(number_of_fields) + " fields in bulk")
+    {
+      return aead::encrypt_fields(key, fields).second.size();
+    };
+
+    BENCHMARK("decrypt " + std::to_string(number_of_fields) + " fields one by one")
+    {
+      std::size_t size{ 0 };
+      for (const auto& field : encrypted_fields) {
+        auto [e, plaintext] = aead::decrypt(key, field.ciphertext, field.associated_data);
+        size += plaintext.size();
+      }
+      return size;
+    };
+
+    BENCHMARK("decrypt " + std::to_string(number_of_fields) + " fields in bulk")
+    {
+      return aead::decrypt_fields(key, encrypted_fields).second.size();
+    };
+  }
+}
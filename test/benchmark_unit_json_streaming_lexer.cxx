@@ -0,0 +1,119 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "test/utils/test_data.hxx"
+
+#include "core/utils/json_streaming_lexer.hxx"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+using couchbase::core::utils::json::streaming_lexer_backend;
+
+namespace
+{
+constexpr std::size_t rows_per_response{ 500 };
+/** the size of the chunks, that the HTTP session usually reads from the socket */
+constexpr std::size_t chunk_size{ 16 * 1024 };
+
+/**
+ * Builds the query response, where every row is the document from the fixture.
+ */
+auto
+make_response(const std::string& document) -> std::string
+{
+  std::string response{
+    R"({"requestID": "2640a5b5-2e67-44e7-86ec-31cc388b7427", "signature": {"*":"*"}, "results": [)"
+  };
+  for (std::size_t i = 0; i < rows_per_response; ++i) {
+    if (i > 0) {
+      response += ",\n";
+    }
+    response += document;
+  }
+  response += R"(], "status": "success", "metrics": {"resultCount": 500}})";
+  return response;
+}
+
+auto
+lex(streaming_lexer_backend backend, std::string_view response) -> std::size_t
+{
+  couchbase::core::utils::json::streaming_lexer lexer("/results/^", 4, backend);
+  std::size_t number_of_rows{ 0 };
+  std::size_t size_of_rows{ 0 };
+  lexer.on_row([&size_of_rows](std::string&& row) {
+    size_of_rows += row.size();
+    return couchbase::core::utils::json::stream_control::next_row;
+  });
+  lexer.on_complete(
+    [&number_of_rows](std::error_code ec, std::size_t rows, std::string&& /* meta */) {
+      REQUIRE_SUCCESS(ec);
+      number_of_rows = rows;
+    });
+  for (std::size_t offset = 0; offset < response.size(); offset += chunk_size) {
+    lexer.feed(response.substr(offset, chunk_size));
+  }
+  REQUIRE(size_of_rows > 0);
+  return number_of_rows;
+}
+
+auto
+megabytes_per_second(streaming_lexer_backend backend, std::string_view response) -> double
+{
+  constexpr std::size_t iterations{ 20 };
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < iterations; ++i) {
+    REQUIRE(lex(backend, response) == rows_per_response);
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(response.size() * iterations) / (1024.0 * 1024.0) / elapsed.count();
+}
+} // namespace
+
+TEST_CASE("benchmark: stream rows of the query response", "[benchmark]")
+{
+  for (const auto* fixture : {
+         "sample_vector_index_params.json",
+         "sample_vector_index_with_nested_properties_params.json",
+         "search_beers_dataset.json",
+         "search_beers_index_params.json",
+         "travel_sample_index_params.json",
+         "travel_sample_index_params_v6.json",
+       }) {
+    const auto response = make_response(test::utils::read_test_data(fixture));
+
+    const auto jsonsl_rate = megabytes_per_second(streaming_lexer_backend::jsonsl, response);
+    const auto structural_rate =
+      megabytes_per_second(streaming_lexer_backend::structural, response);
+    WARN(fixture << " (" << response.size() << " bytes), MiB/sec with jsonsl: " << jsonsl_rate
+                 << ", with structural scanner: " << structural_rate);
+
+    BENCHMARK(std::string{ "jsonsl: " } + fixture)
+    {
+      return lex(streaming_lexer_backend::jsonsl, response);
+    };
+
+    BENCHMARK(std::string{ "structural: " } + fixture)
+    {
+      return lex(streaming_lexer_backend::structural, response);
+    };
+  }
+}
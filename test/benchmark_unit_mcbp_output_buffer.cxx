@@ -0,0 +1,62 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/io/mcbp_output_buffer.hxx"
+
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+using couchbase::core::io::mcbp_output_buffer;
+
+auto
+make_request(std::size_t size, std::uint8_t fill) -> std::vector<std::byte>
+{
+  return std::vector<std::byte>(size, std::byte{ fill });
+}
+} // namespace
+
+TEST_CASE("benchmark: mcbp_output_buffer small requests", "[benchmark]")
+{
+  // GET request with 16-byte key: 24-byte header + collection ID + key
+  const std::size_t number_of_requests = 10'000;
+  const std::size_t request_size = 24 + 1 + 16;
+
+  BENCHMARK("buffer per request")
+  {
+    std::vector<std::vector<std::byte>> output;
+    for (std::size_t i = 0; i < number_of_requests; ++i) {
+      output.emplace_back(make_request(request_size, 0x42));
+    }
+    return output.size();
+  };
+
+  mcbp_output_buffer output;
+  BENCHMARK("pooled chunks")
+  {
+    for (std::size_t i = 0; i < number_of_requests; ++i) {
+      output.append(make_request(request_size, 0x42));
+    }
+    output.start_write();
+    auto size = output.in_flight().size();
+    output.complete_write();
+    return size;
+  };
+}
@@ -0,0 +1,89 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/io/mcbp_parser.hxx"
+#include "core/protocol/magic.hxx"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+using couchbase::core::io::mcbp_message;
+using couchbase::core::io::mcbp_parser;
+
+// Wire image of the pipelined GET responses: 4 bytes of flags in extras, followed by the value.
+auto
+make_get_responses(std::size_t number_of_frames, std::size_t value_size) -> std::vector<std::byte>
+{
+  const auto bodylen = static_cast<std::uint32_t>(4 + value_size);
+  std::vector<std::byte> header(24, std::byte{ 0x00 });
+  header[0] =
+    std::byte{ static_cast<std::uint8_t>(couchbase::core::protocol::magic::client_response) };
+  header[4] = std::byte{ 0x04 }; // extlen
+  header[8] = std::byte{ static_cast<std::uint8_t>(bodylen >> 24U) };
+  header[9] = std::byte{ static_cast<std::uint8_t>(bodylen >> 16U) };
+  header[10] = std::byte{ static_cast<std::uint8_t>(bodylen >> 8U) };
+  header[11] = std::byte{ static_cast<std::uint8_t>(bodylen) };
+
+  std::vector<std::byte> wire;
+  wire.reserve(number_of_frames * (header.size() + bodylen));
+  for (std::size_t i = 0; i < number_of_frames; ++i) {
+    wire.insert(wire.end(), header.begin(), header.end());
+    wire.insert(wire.end(), 4, std::byte{ 0x00 });
+    wire.insert(wire.end(), value_size, std::byte{ 0x2a });
+  }
+  return wire;
+}
+
+// Feeds the wire image in chunks of the given size (as the socket would) and returns number of
+// the frames parsed.
+auto
+parse_in_chunks(mcbp_parser& parser, const std::vector<std::byte>& wire, std::size_t chunk_size)
+  -> std::size_t
+{
+  std::size_t frames = 0;
+  for (auto it = wire.begin(); it != wire.end();) {
+    auto chunk_end = it + static_cast<std::ptrdiff_t>(std::min(
+                            chunk_size, static_cast<std::size_t>(std::distance(it, wire.end()))));
+    parser.feed(it, chunk_end);
+    it = chunk_end;
+    mcbp_message msg;
+    while (parser.next(msg) == mcbp_parser::result::ok) {
+      ++frames;
+    }
+  }
+  return frames;
+}
+} // namespace
+
+TEST_CASE("benchmark: mcbp_parser pipelined GET responses", "[benchmark]")
+{
+  // small documents, so that a single 16 KiB read carries a few hundred of frames
+  const std::size_t number_of_frames = 10'000;
+  auto wire = make_get_responses(number_of_frames, 16);
+
+  BENCHMARK("parse 10k pipelined GET responses in 16 KiB reads")
+  {
+    mcbp_parser parser;
+    return parse_in_chunks(parser, wire, 16 * 1024);
+  };
+}
@@ -0,0 +1,74 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/cluster_label_listener.hxx"
+#include "core/metrics/logging_meter.hxx"
+#include "core/metrics/logging_meter_options.hxx"
+#include "core/metrics/meter_wrapper.hxx"
+#include "core/tracing/constants.hxx"
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <asio/io_context.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+TEST_CASE("benchmark: logging_meter records from multiple threads", "[benchmark]")
+{
+  asio::io_context ctx{};
+  couchbase::core::metrics::logging_meter_options options{};
+  auto meter = std::make_shared<couchbase::core::metrics::logging_meter>(ctx, options);
+  auto wrapper = couchbase::core::metrics::meter_wrapper::create(
+    meter, std::make_shared<couchbase::core::cluster_label_listener>());
+
+  const auto number_of_threads =
+    std::max(std::size_t{ 2 }, std::size_t{ std::thread::hardware_concurrency() });
+
+  auto record_from_threads = [&](std::size_t operations_per_thread) {
+    std::vector<std::thread> threads{};
+    threads.reserve(number_of_threads);
+    for (std::size_t t = 0; t < number_of_threads; ++t) {
+      threads.emplace_back([&wrapper, operations_per_thread, t]() {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < operations_per_thread; ++i) {
+          couchbase::core::metrics::metric_attributes attrs{
+            couchbase::core::tracing::service::key_value,
+            (i + t) % 2 == 0 ? "get" : "upsert",
+            {},
+          };
+          wrapper->record_value(std::move(attrs), start);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  };
+
+  // warm up the recorders for every operation
+  record_from_threads(1'000);
+
+  BENCHMARK(fmt::format("record 10000 operations on each of {} threads", number_of_threads))
+  {
+    return record_from_threads(10'000);
+  };
+}
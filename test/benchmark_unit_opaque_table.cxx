@@ -0,0 +1,125 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/utils/concurrent_opaque_table.hxx"
+#include "core/utils/movable_function.hxx"
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+constexpr std::uint32_t in_flight_per_thread{ 1'024 };
+constexpr std::uint32_t operations_per_thread{ 64 * in_flight_per_thread };
+
+/*
+ * Emulates the pattern of the KV session: every writer thread keeps a window of in-flight
+ * opaques, and the handler for the oldest opaque is taken out once the window is full.
+ */
+template<typename Insert, typename Take>
+auto
+run_opaque_workload(std::size_t number_of_threads, Insert&& insert, Take&& take) -> std::size_t
+{
+  std::atomic_uint32_t next_opaque{ 0 };
+  std::atomic_size_t handled{ 0 };
+  std::vector<std::thread> threads;
+  threads.reserve(number_of_threads);
+  for (std::size_t t = 0; t < number_of_threads; ++t) {
+    threads.emplace_back([&]() {
+      std::vector<std::uint32_t> window(in_flight_per_thread);
+      for (std::uint32_t i = 0; i < operations_per_thread; ++i) {
+        auto& slot = window[i % in_flight_per_thread];
+        if (i >= in_flight_per_thread && take(slot)) {
+          handled.fetch_add(1, std::memory_order_relaxed);
+        }
+        slot = next_opaque.fetch_add(1, std::memory_order_relaxed);
+        insert(slot);
+      }
+      for (auto opaque : window) {
+        if (take(opaque)) {
+          handled.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return handled;
+}
+} // namespace
+
+TEST_CASE("benchmark: concurrent opaque table under contention", "[benchmark]")
+{
+  using handler_type = couchbase::core::utils::movable_function<void(std::uint32_t)>;
+  const auto number_of_threads = std::max(2U, std::thread::hardware_concurrency());
+
+  BENCHMARK(fmt::format("std::map with mutex, {} threads", number_of_threads))
+  {
+    std::mutex mutex;
+    std::map<std::uint32_t, handler_type> handlers;
+    return run_opaque_workload(
+      number_of_threads,
+      [&](std::uint32_t opaque) {
+        const std::scoped_lock lock(mutex);
+        handlers.try_emplace(opaque, [](std::uint32_t) {
+        });
+      },
+      [&](std::uint32_t opaque) {
+        handler_type handler{};
+        {
+          const std::scoped_lock lock(mutex);
+          if (auto it = handlers.find(opaque); it != handlers.end()) {
+            handler = std::move(it->second);
+            handlers.erase(it);
+          }
+        }
+        if (handler) {
+          handler(opaque);
+          return true;
+        }
+        return false;
+      });
+  };
+
+  BENCHMARK(fmt::format("concurrent_opaque_table, {} threads", number_of_threads))
+  {
+    couchbase::core::utils::concurrent_opaque_table<handler_type> handlers{};
+    return run_opaque_workload(
+      number_of_threads,
+      [&](std::uint32_t opaque) {
+        handlers.try_emplace(opaque, [](std::uint32_t) {
+        });
+      },
+      [&](std::uint32_t opaque) {
+        if (auto handler = handlers.take(opaque); handler && *handler) {
+          (*handler)(opaque);
+          return true;
+        }
+        return false;
+      });
+  };
+}
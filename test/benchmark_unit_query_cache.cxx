@@ -0,0 +1,72 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/io/query_cache.hxx"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using couchbase::core::query_cache;
+
+auto
+statement(std::size_t index) -> std::string
+{
+  return "SELECT * FROM `default` WHERE id = " + std::to_string(index);
+}
+} // namespace
+
+TEST_CASE("benchmark: query_cache concurrent lookups", "[benchmark]")
+{
+  const std::size_t number_of_threads = std::max(4U, std::thread::hardware_concurrency());
+  const std::size_t number_of_statements = 256;
+  const std::size_t lookups_per_thread = 10'000;
+
+  query_cache cache;
+  for (std::size_t i = 0; i < number_of_statements; ++i) {
+    cache.put(statement(i), "prepared", "encoded-plan");
+  }
+  std::vector<std::string> statements;
+  for (std::size_t i = 0; i < number_of_statements; ++i) {
+    statements.emplace_back(statement(i));
+  }
+
+  BENCHMARK("lookups from all threads")
+  {
+    std::atomic_size_t found{ 0 };
+    std::vector<std::thread> threads;
+    for (std::size_t t = 0; t < number_of_threads; ++t) {
+      threads.emplace_back([&, t] {
+        for (std::size_t i = 0; i < lookups_per_thread; ++i) {
+          if (cache.get(statements[(t + i) % number_of_statements])) {
+            found.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    return found.load();
+  };
+}
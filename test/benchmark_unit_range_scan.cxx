@@ -0,0 +1,186 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/range_scan_load_balancer.hxx"
+#include "core/topology/configuration.hxx"
+
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace
+{
+constexpr std::int16_t number_of_nodes{ 3 };
+constexpr std::uint16_t number_of_vbuckets{ 1024 };
+constexpr std::size_t batches_per_vbucket{ 2 };
+constexpr std::size_t items_per_batch{ 50 };
+
+/**
+ * Mock KV node, that serves range scan batches in a limited number of parallel slots. The batches
+ * above the capacity are queued, like on a real node, that is fully loaded.
+ */
+class mock_kv_node
+{
+public:
+  mock_kv_node(asio::io_context& io, std::size_t capacity, std::chrono::microseconds service_time)
+    : io_{ io }
+    , capacity_{ capacity }
+    , service_time_{ service_time }
+  {
+  }
+
+  void range_scan_continue(std::function<void()>&& handler)
+  {
+    queue_.emplace_back(std::move(handler));
+    dispatch();
+  }
+
+private:
+  void dispatch()
+  {
+    while (busy_ < capacity_ && !queue_.empty()) {
+      ++busy_;
+      auto handler = std::move(queue_.front());
+      queue_.pop_front();
+      auto timer = std::make_shared<asio::steady_timer>(io_, service_time_);
+      timer->async_wait([this, timer, handler = std::move(handler)](std::error_code) {
+        --busy_;
+        handler();
+        dispatch();
+      });
+    }
+  }
+
+  asio::io_context& io_;
+  std::size_t capacity_;
+  std::chrono::microseconds service_time_;
+  std::size_t busy_{ 0 };
+  std::deque<std::function<void()>> queue_{};
+};
+
+/**
+ * Drives the streams over the mock nodes the same way as range_scan_orchestrator does.
+ */
+class scan_driver
+{
+public:
+  scan_driver(std::uint16_t concurrency, bool adaptive)
+    : concurrency_{ concurrency }
+    , adaptive_{ adaptive }
+  {
+    couchbase::core::topology::configuration::vbucket_map vbucket_map{};
+    for (std::uint16_t vbucket = 0; vbucket < number_of_vbuckets; ++vbucket) {
+      vbucket_map.push_back({ static_cast<std::int16_t>(vbucket % number_of_nodes) });
+    }
+    vbucket_map_ = vbucket_map;
+    balancer_ = std::make_unique<couchbase::core::range_scan_load_balancer>(vbucket_map_);
+    if (adaptive_) {
+      balancer_->enable_adaptive_concurrency(concurrency_, 16);
+    }
+    for (std::int16_t node = 0; node < number_of_nodes; ++node) {
+      nodes_.push_back(std::make_unique<mock_kv_node>(io_, 8, std::chrono::microseconds{ 50 }));
+    }
+  }
+
+  auto run() -> std::size_t
+  {
+    start_streams(adaptive_ ? std::numeric_limits<std::uint16_t>::max() : concurrency_);
+    io_.run();
+    return completed_vbuckets_;
+  }
+
+private:
+  void start_streams(std::uint16_t stream_count)
+  {
+    for (std::uint16_t started = 0; started < stream_count; ++started) {
+      auto vbucket = balancer_->select_vbucket();
+      if (!vbucket) {
+        return;
+      }
+      scan_batch(vbucket_map_[vbucket.value()][0], batches_per_vbucket);
+    }
+  }
+
+  void scan_batch(std::int16_t node, std::size_t batches_left)
+  {
+    auto start = std::chrono::steady_clock::now();
+    nodes_[static_cast<std::size_t>(node)]->range_scan_continue([this, node, batches_left, start] {
+      if (adaptive_) {
+        balancer_->notify_batch_completed(
+          node, std::chrono::steady_clock::now() - start, items_per_batch);
+      }
+      if (batches_left > 1) {
+        scan_batch(node, batches_left - 1);
+      } else {
+        balancer_->notify_stream_ended(node);
+        ++completed_vbuckets_;
+      }
+      if (adaptive_) {
+        // the limit of the node might have been raised
+        start_streams(std::numeric_limits<std::uint16_t>::max());
+      } else if (batches_left == 1) {
+        start_streams(1);
+      }
+    });
+  }
+
+  asio::io_context io_{};
+  std::uint16_t concurrency_;
+  bool adaptive_;
+  couchbase::core::topology::configuration::vbucket_map vbucket_map_{};
+  std::unique_ptr<couchbase::core::range_scan_load_balancer> balancer_{};
+  std::vector<std::unique_ptr<mock_kv_node>> nodes_{};
+  std::size_t completed_vbuckets_{ 0 };
+};
+} // namespace
+
+TEST_CASE("benchmark: full-collection range scan over mock KV nodes", "[benchmark]")
+{
+  BENCHMARK("fixed concurrency 1")
+  {
+    scan_driver driver{ 1, false };
+    REQUIRE(driver.run() == number_of_vbuckets);
+  };
+
+  BENCHMARK("fixed concurrency 16")
+  {
+    scan_driver driver{ 16, false };
+    REQUIRE(driver.run() == number_of_vbuckets);
+  };
+
+  BENCHMARK("adaptive concurrency starting from 1")
+  {
+    scan_driver driver{ 1, true };
+    REQUIRE(driver.run() == number_of_vbuckets);
+  };
+
+  BENCHMARK("adaptive concurrency starting from 16")
+  {
+    scan_driver driver{ 16, true };
+    REQUIRE(driver.run() == number_of_vbuckets);
+  };
+}
@@ -0,0 +1,146 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/crypto/cbcrypto.h"
+#include "core/platform/base64.h"
+#include "core/sasl/client.h"
+#include "core/sasl/scram-sha/salted_password_cache.h"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+using couchbase::core::crypto::Algorithm;
+using couchbase::core::sasl::mechanism::scram::derive_keys;
+using couchbase::core::sasl::mechanism::scram::derived_keys;
+using couchbase::core::sasl::mechanism::scram::salted_password_cache;
+
+namespace
+{
+constexpr unsigned int iteration_count{ 4096 };
+
+/**
+ * Server side of SCRAM-SHA512, that keeps StoredKey and ServerKey of the user like KV engine does.
+ */
+class mock_scram_server
+{
+public:
+  mock_scram_server(const std::string& password, std::string salt)
+    : salt_{ std::move(salt) }
+    , keys_{ derive_keys(Algorithm::ALG_SHA512, password, salt_, iteration_count) }
+  {
+  }
+
+  auto first(std::string_view client_first_message) -> std::string
+  {
+    client_first_message_bare_ = client_first_message.substr(3); // skip n,,
+    auto nonce = client_first_message_bare_.substr(client_first_message_bare_.find(",r=") + 3);
+    server_first_message_ = "r=" + nonce + "c0ffee,s=" + couchbase::core::base64::encode(salt_) +
+                            ",i=" + std::to_string(iteration_count);
+    return server_first_message_;
+  }
+
+  auto final(std::string_view client_final_message) -> std::string
+  {
+    const auto proof_position = client_final_message.find(",p=");
+    const auto auth_message = client_first_message_bare_ + "," + server_first_message_ + "," +
+                              std::string{ client_final_message.substr(0, proof_position) };
+
+    const auto proof = couchbase::core::base64::decode_to_string(
+      client_final_message.substr(proof_position + 3));
+    auto client_key = couchbase::core::crypto::CBC_HMAC(
+      Algorithm::ALG_SHA512, keys_.stored_key, auth_message);
+    for (std::size_t i = 0; i < client_key.size() && i < proof.size(); ++i) {
+      client_key[i] = static_cast<char>(client_key[i] ^ proof[i]);
+    }
+    if (couchbase::core::crypto::digest(Algorithm::ALG_SHA512, client_key) != keys_.stored_key) {
+      return "e=invalid-proof";
+    }
+    return "v=" + couchbase::core::base64::encode(couchbase::core::crypto::CBC_HMAC(
+                    Algorithm::ALG_SHA512, keys_.server_key, auth_message));
+  }
+
+private:
+  std::string salt_;
+  derived_keys keys_;
+  std::string client_first_message_bare_{};
+  std::string server_first_message_{};
+};
+
+auto
+handshake(mock_scram_server& server) -> bool
+{
+  couchbase::core::sasl::ClientContext client{ [] {
+                                                return std::string{ "Administrator" };
+                                              },
+                                               [] {
+                                                 return std::string{ "password" };
+                                               },
+                                               { "SCRAM-SHA512" } };
+  auto [start_error, client_first] = client.start();
+  auto [step_error, client_final] = client.step(server.first(client_first));
+  if (step_error != couchbase::core::sasl::error::CONTINUE) {
+    return false;
+  }
+  auto [final_error, ignored] = client.step(server.final(client_final));
+  return final_error == couchbase::core::sasl::error::OK;
+}
+
+template<typename Handshake>
+auto
+handshakes_per_second(Handshake&& handshake, std::size_t number_of_handshakes) -> double
+{
+  const auto start = std::chrono::steady_clock::now();
+  for (std::size_t i = 0; i < number_of_handshakes; ++i) {
+    REQUIRE(handshake());
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(number_of_handshakes) / elapsed.count();
+}
+} // namespace
+
+TEST_CASE("benchmark: SCRAM-SHA512 handshakes", "[benchmark]")
+{
+  mock_scram_server server{ "password", "NaCl of the cluster" };
+
+  // reconnection of many sessions: every handshake derives the salted password
+  auto uncached = [&server] {
+    salted_password_cache::instance().clear();
+    return handshake(server);
+  };
+  // reconnection of many sessions: only the first handshake derives the salted password
+  auto cached = [&server] {
+    return handshake(server);
+  };
+
+  const auto uncached_rate = handshakes_per_second(uncached, 100);
+  const auto cached_rate = handshakes_per_second(cached, 100);
+  WARN("handshakes/sec without cache: " << uncached_rate << ", with cache: " << cached_rate);
+
+  BENCHMARK("handshake without cache")
+  {
+    return uncached();
+  };
+
+  BENCHMARK("handshake with cache")
+  {
+    return cached();
+  };
+}
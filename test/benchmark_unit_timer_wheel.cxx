@@ -0,0 +1,72 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/io/timer_wheel.hxx"
+
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using couchbase::core::io::wheel_timer;
+
+TEST_CASE("benchmark: operation deadlines", "[benchmark]")
+{
+  // every operation arms its deadline and cancels it when the response arrives
+  const std::size_t number_of_operations = 10'000;
+  const auto timeout = std::chrono::milliseconds{ 2'500 };
+
+  asio::io_context ctx;
+
+  BENCHMARK("asio::steady_timer per operation")
+  {
+    std::vector<std::unique_ptr<asio::steady_timer>> timers;
+    timers.reserve(number_of_operations);
+    for (std::size_t i = 0; i < number_of_operations; ++i) {
+      auto& timer = timers.emplace_back(std::make_unique<asio::steady_timer>(ctx));
+      timer->expires_after(timeout);
+      timer->async_wait([](std::error_code /* ec */) {
+      });
+    }
+    for (auto& timer : timers) {
+      timer->cancel();
+    }
+    ctx.restart();
+    return ctx.run();
+  };
+
+  BENCHMARK("wheel_timer per operation")
+  {
+    std::vector<std::unique_ptr<wheel_timer>> timers;
+    timers.reserve(number_of_operations);
+    for (std::size_t i = 0; i < number_of_operations; ++i) {
+      auto& timer = timers.emplace_back(std::make_unique<wheel_timer>(ctx));
+      timer->expires_after(timeout);
+      timer->async_wait([](std::error_code /* ec */) {
+      });
+    }
+    for (auto& timer : timers) {
+      timer->cancel();
+    }
+    ctx.restart();
+    return ctx.run();
+  };
+}
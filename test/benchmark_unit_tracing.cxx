@@ -0,0 +1,79 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/cluster_label_listener.hxx"
+#include "core/tracing/constants.hxx"
+#include "core/tracing/threshold_logging_options.hxx"
+#include "core/tracing/threshold_logging_tracer.hxx"
+#include "core/tracing/tracer_wrapper.hxx"
+
+#include <spdlog/fmt/bundled/core.h>
+
+#include <asio/io_context.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+TEST_CASE("benchmark: threshold_logging_tracer spans from multiple threads", "[benchmark]")
+{
+  asio::io_context ctx{};
+  couchbase::core::tracing::threshold_logging_options options{};
+  options.key_value_threshold = std::chrono::milliseconds::zero();
+  auto tracer = std::make_shared<couchbase::core::tracing::threshold_logging_tracer>(ctx, options);
+  auto wrapper = couchbase::core::tracing::tracer_wrapper::create(
+    tracer, std::make_shared<couchbase::core::cluster_label_listener>());
+
+  const auto number_of_threads =
+    std::max(std::size_t{ 2 }, std::size_t{ std::thread::hardware_concurrency() });
+
+  auto trace_from_threads = [&](std::size_t operations_per_thread) {
+    std::vector<std::thread> threads{};
+    threads.reserve(number_of_threads);
+    for (std::size_t t = 0; t < number_of_threads; ++t) {
+      threads.emplace_back([&wrapper, operations_per_thread]() {
+        for (std::size_t i = 0; i < operations_per_thread; ++i) {
+          auto span = wrapper->create_span("get", nullptr);
+          span->add_tag(couchbase::core::tracing::attributes::op::service,
+                        couchbase::core::tracing::service::key_value);
+          auto dispatch =
+            wrapper->create_span(couchbase::core::tracing::operation::step_dispatch, span);
+          dispatch->add_tag(couchbase::core::tracing::attributes::dispatch::local_id,
+                            "66388CF5BFCF7522/18CC8791579B567C");
+          dispatch->add_tag(couchbase::core::tracing::attributes::dispatch::operation_id, "0x2a");
+          dispatch->add_tag(couchbase::core::tracing::attributes::dispatch::server_duration, 10);
+          dispatch->end();
+          span->end();
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  };
+
+  // warm up the per-thread span pools
+  trace_from_threads(1'000);
+
+  BENCHMARK(fmt::format("trace 10000 operations on each of {} threads", number_of_threads))
+  {
+    return trace_from_threads(10'000);
+  };
+}
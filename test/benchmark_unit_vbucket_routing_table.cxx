@@ -0,0 +1,86 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/topology/configuration.hxx"
+#include "core/topology/vbucket_routing_table.hxx"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace
+{
+using couchbase::core::topology::configuration;
+using couchbase::core::topology::vbucket_routing_table;
+
+auto
+make_vbucket_map(std::size_t number_of_vbuckets,
+                 std::size_t number_of_nodes,
+                 std::size_t number_of_replicas) -> configuration::vbucket_map
+{
+  configuration::vbucket_map vbmap(number_of_vbuckets);
+  for (std::size_t vbucket = 0; vbucket < number_of_vbuckets; ++vbucket) {
+    for (std::size_t i = 0; i <= number_of_replicas; ++i) {
+      vbmap[vbucket].push_back(static_cast<std::int16_t>((vbucket + i) % number_of_nodes));
+    }
+  }
+  return vbmap;
+}
+
+auto
+make_keys(std::size_t number_of_keys) -> std::vector<std::string>
+{
+  std::vector<std::string> keys;
+  keys.reserve(number_of_keys);
+  for (std::size_t i = 0; i < number_of_keys; ++i) {
+    keys.emplace_back("user::" + std::to_string(i));
+  }
+  return keys;
+}
+} // namespace
+
+TEST_CASE("benchmark: vbucket routing table lookup", "[benchmark]")
+{
+  auto config = std::make_shared<configuration>();
+  config->vbmap = make_vbucket_map(1024, 4, 2);
+  const auto keys = make_keys(1'000);
+
+  std::mutex config_mutex;
+  BENCHMARK("nested map under mutex")
+  {
+    std::size_t sum{ 0 };
+    for (const auto& key : keys) {
+      const std::scoped_lock lock(config_mutex);
+      sum += config->map_key(key, 0).second.value_or(0);
+    }
+    return sum;
+  };
+
+  auto routing_table = std::make_shared<const vbucket_routing_table>(config->vbmap.value());
+  BENCHMARK("flat routing table snapshot")
+  {
+    std::size_t sum{ 0 };
+    for (const auto& key : keys) {
+      const auto table = std::atomic_load(&routing_table);
+      sum += table->map_key(key, 0).second.value_or(0);
+    }
+    return sum;
+  };
+}
@@ -0,0 +1,87 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "benchmark_helper.hxx"
+
+#include "core/impl/encoded_search_query.hxx"
+#include "core/platform/base64.h"
+#include "core/utils/json.hxx"
+
+#include <couchbase/vector_query.hxx>
+#include <couchbase/vector_search.hxx>
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+template<typename Float>
+auto
+make_embedding(std::size_t dimensions) -> std::vector<Float>
+{
+  std::mt19937 generator{ 42 };
+  std::uniform_real_distribution<Float> distribution{ -1, 1 };
+  std::vector<Float> embedding(dimensions);
+  for (auto& value : embedding) {
+    value = distribution(generator);
+  }
+  return embedding;
+}
+
+/**
+ * Encodes the vector search the same way as the search request does before sending it.
+ */
+template<typename Float>
+auto
+encode(const std::vector<Float>& embedding) -> std::vector<std::byte>
+{
+  const couchbase::vector_search search{ couchbase::vector_query{ "embedding", embedding } };
+  auto encoded = search.encode();
+  REQUIRE_SUCCESS(encoded.ec);
+  return couchbase::core::utils::json::generate_binary(encoded.query);
+}
+} // namespace
+
+TEST_CASE("benchmark: encode vector query", "[benchmark]")
+{
+  for (const std::size_t dimensions : { 768U, 1536U, 3072U }) {
+    const auto doubles = make_embedding<double>(dimensions);
+    const auto floats = make_embedding<float>(dimensions);
+    WARN(dimensions << " dimensions, bytes in JSON array: " << encode(doubles).size()
+                    << ", bytes in base64: " << encode(floats).size());
+
+    BENCHMARK("JSON array: " + std::to_string(dimensions))
+    {
+      return encode(doubles);
+    };
+
+    BENCHMARK("base64: " + std::to_string(dimensions))
+    {
+      return encode(floats);
+    };
+
+    BENCHMARK("base64 of raw floats: " + std::to_string(dimensions))
+    {
+      return couchbase::core::base64::encode(
+        gsl::as_bytes(gsl::span{ floats.data(), floats.size() }));
+    };
+  }
+}
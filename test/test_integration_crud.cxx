@@ -1204,3 +1204,54 @@ TEST_CASE(
     REQUIRE(tao::json::empty_object == resp.content_as<tao::json::value>());
   }
 }
+
+TEST_CASE("integration: bulk operations with public API", "[integration]")
+{
+  test::utils::integration_test_guard integration;
+
+  auto cluster = integration.public_cluster();
+  auto collection = cluster.bucket(integration.ctx.bucket).default_collection();
+
+  std::vector<std::string> ids{};
+  std::vector<std::pair<std::string, tao::json::value>> documents{};
+  for (std::size_t i = 0; i < 20; ++i) {
+    ids.emplace_back(test::utils::uniq_id("bulk"));
+    documents.emplace_back(ids.back(), tao::json::value{ { "index", i } });
+  }
+  auto missing_id = test::utils::uniq_id("bulk_missing");
+
+  {
+    auto results = collection.upsert_multi(documents).get();
+    REQUIRE(results.size() == ids.size());
+    for (const auto& [err, resp] : results) {
+      REQUIRE_SUCCESS(err.ec());
+      REQUIRE_FALSE(resp.cas().empty());
+    }
+  }
+
+  {
+    auto keys = ids;
+    keys.push_back(missing_id);
+    auto results = collection.get_multi(keys).get();
+    REQUIRE(results.size() == keys.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+      const auto& [err, resp] = results[i];
+      REQUIRE_SUCCESS(err.ec());
+      REQUIRE(resp.content_as<tao::json::value>() == documents[i].second);
+    }
+    REQUIRE(results.back().first.ec() == couchbase::errc::key_value::document_not_found);
+  }
+
+  {
+    auto results = collection.remove_multi(ids).get();
+    REQUIRE(results.size() == ids.size());
+    for (const auto& [err, resp] : results) {
+      REQUIRE_SUCCESS(err.ec());
+    }
+  }
+
+  {
+    auto results = collection.get_multi({}).get();
+    REQUIRE(results.empty());
+  }
+}
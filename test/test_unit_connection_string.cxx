@@ -526,6 +526,27 @@ TEST_CASE("unit: connection string", "[unit]")
                            });
       CHECK(spec.options.key_value_timeout == std::chrono::milliseconds(4002));
 
+      spec = couchbase::core::utils::parse_connection_string(
+        "couchbase://127.0.0.1?write_coalescing_threshold=4096&write_coalescing_delay=50");
+      CHECK(spec.warnings.empty());
+      CHECK(spec.options.write_coalescing_threshold == 4096);
+      CHECK(spec.options.write_coalescing_delay == std::chrono::microseconds(50));
+
+      spec = couchbase::core::utils::parse_connection_string(
+        "couchbase://127.0.0.1?write_coalescing_delay=1ms");
+      CHECK(spec.options.write_coalescing_delay == std::chrono::microseconds(1'000));
+
+      spec = couchbase::core::utils::parse_connection_string(
+        "couchbase://127.0.0.1?min_http_connections_per_node=2");
+      CHECK(spec.warnings.empty());
+      CHECK(spec.options.min_http_connections_per_node == 2);
+
+      spec = couchbase::core::utils::parse_connection_string(
+        "couchbase://127.0.0.1?query_cache_max_entries=100&query_cache_max_bytes=65536");
+      CHECK(spec.warnings.empty());
+      CHECK(spec.options.query_cache_max_entries == 100);
+      CHECK(spec.options.query_cache_max_bytes == 65536);
+
       spec = couchbase::core::utils::parse_connection_string(
         "couchbase://"
         "127.0.0.1?user_agent_extra=couchnode%2F4.1.1%20(node%2F12.11."
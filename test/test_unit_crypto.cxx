@@ -18,6 +18,7 @@
 #include "test_helper.hxx"
 
 #include <couchbase/crypto/internal.hxx>
+#include <couchbase/error_codes.hxx>
 
 #include <algorithm>
 #include <vector>
@@ -115,3 +116,56 @@ TEST_CASE("unit: aead_aes_256_cbc_hmac_sha512", "[unit]")
     REQUIRE(plaintext == decrypted);
   }
 }
+
+TEST_CASE("unit: aead_aes_256_cbc_hmac_sha512 bulk operations", "[unit]")
+{
+  namespace aead = couchbase::crypto::internal::aead_aes_256_cbc_hmac_sha512;
+
+  std::vector<std::byte> key{ 64 };
+  for (std::size_t i = 0; i < key.size(); ++i) {
+    key[i] = static_cast<std::byte>(i);
+  }
+
+  std::vector<aead::plaintext_field> fields{};
+  for (std::size_t i = 0; i < 10; ++i) {
+    auto [err, iv] = couchbase::crypto::internal::generate_initialization_vector();
+    REQUIRE_SUCCESS(err.ec());
+    std::vector<std::byte> plaintext{ i * 7 };
+    std::fill(plaintext.begin(), plaintext.end(), static_cast<std::byte>('a' + i));
+    fields.push_back({ iv, plaintext, make_bytes({ 0x2a }) });
+  }
+
+  auto [err, ciphertexts] = aead::encrypt_fields(key, fields);
+  REQUIRE_SUCCESS(err.ec());
+  REQUIRE(ciphertexts.size() == fields.size());
+
+  std::vector<aead::ciphertext_field> encrypted{};
+  for (std::size_t i = 0; i < fields.size(); ++i) {
+    auto [single_err, single] =
+      aead::encrypt(key, fields[i].iv, fields[i].plaintext, fields[i].associated_data);
+    REQUIRE_SUCCESS(single_err.ec());
+    REQUIRE(single == ciphertexts[i]);
+    encrypted.push_back({ ciphertexts[i], fields[i].associated_data });
+  }
+
+  {
+    auto [decrypt_err, plaintexts] = aead::decrypt_fields(key, encrypted);
+    REQUIRE_SUCCESS(decrypt_err.ec());
+    REQUIRE(plaintexts.size() == fields.size());
+    for (std::size_t i = 0; i < fields.size(); ++i) {
+      REQUIRE(plaintexts[i] == fields[i].plaintext);
+    }
+  }
+
+  {
+    encrypted[3].ciphertext[20] ^= std::byte{ 0x01 };
+    auto [decrypt_err, plaintexts] = aead::decrypt_fields(key, encrypted);
+    REQUIRE(decrypt_err.ec() == couchbase::errc::field_level_encryption::invalid_ciphertext);
+    REQUIRE(plaintexts.empty());
+  }
+
+  {
+    auto [encrypt_err, result] = aead::encrypt_fields(std::vector<std::byte>{ 32 }, fields);
+    REQUIRE(encrypt_err.ec() == couchbase::errc::field_level_encryption::invalid_crypto_key);
+  }
+}
@@ -0,0 +1,273 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/operations/document_get_projected.hxx"
+#include "core/utils/binary.hxx"
+#include "core/utils/json.hxx"
+
+#include <couchbase/best_effort_retry_strategy.hxx>
+#include <couchbase/error_codes.hxx>
+
+#include <tao/json/value.hpp>
+
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using couchbase::core::operations::get_projected_request;
+using couchbase::core::operations::get_projected_response;
+using couchbase::core::operations::lookup_in_request;
+using couchbase::core::operations::lookup_in_response;
+
+namespace
+{
+auto
+make_request(std::size_t number_of_projections, bool with_expiry) -> get_projected_request
+{
+  get_projected_request request{
+    couchbase::core::document_id{ "default", "_default", "_default", "projected" },
+  };
+  for (std::size_t i = 0; i < number_of_projections; ++i) {
+    request.projections.emplace_back("field_" + std::to_string(i));
+  }
+  request.with_expiry = with_expiry;
+  return request;
+}
+
+/**
+ * Responds to the lookups like KV engine with the document, that has every field set to its index,
+ * flags 42 and expiry 1807056000.
+ */
+auto
+respond(const lookup_in_request& lookup,
+        std::error_code ec = {},
+        couchbase::cas cas = couchbase::cas{ 0xcafe }) -> lookup_in_response
+{
+  lookup_in_response response{
+    couchbase::core::make_subdocument_error_context(
+      couchbase::core::make_key_value_error_context(ec, lookup.id), ec, {}, {}, false),
+    cas,
+  };
+  if (ec) {
+    return response;
+  }
+  for (std::size_t i = 0; i < lookup.specs.size(); ++i) {
+    const auto& path = lookup.specs[i].path_;
+    lookup_in_response::entry entry{
+      path, {}, i, true, couchbase::core::protocol::subdoc_opcode::get,
+      couchbase::core::key_value_status_code::success,
+    };
+    if (path == "$document.flags") {
+      entry.value = couchbase::core::utils::to_binary("42");
+    } else if (path == "$document.exptime") {
+      entry.value = couchbase::core::utils::to_binary("1807056000");
+    } else if (path == "field_missing") {
+      entry.status = couchbase::core::key_value_status_code::subdoc_path_not_found;
+      entry.exists = false;
+    } else {
+      entry.value = couchbase::core::utils::to_binary(path.substr(path.find('_') + 1));
+    }
+    response.fields.emplace_back(std::move(entry));
+  }
+  return response;
+}
+
+/**
+ * Executes the lookups synchronously, and records the requests of the full document.
+ */
+struct mock_core {
+  void execute(lookup_in_request request,
+               couchbase::core::utils::movable_function<void(lookup_in_response)>&& handler)
+  {
+    ++lookups;
+    std::this_thread::sleep_for(lookup_duration);
+    auto cas = couchbase::cas{ modify_document_between_lookups ? lookups : 1 };
+    handler(respond(request, {}, cas));
+  }
+
+  void execute(get_projected_request request,
+               couchbase::core::utils::movable_function<void(get_projected_response)>&& handler)
+  {
+    ++full_document_requests;
+    full_document_timeout = request.timeout;
+    handler(get_projected_response{});
+  }
+
+  bool modify_document_between_lookups{ false };
+  std::chrono::milliseconds lookup_duration{ 0 };
+  std::uint64_t lookups{ 0 };
+  std::size_t full_document_requests{ 0 };
+  std::optional<std::chrono::milliseconds> full_document_timeout{};
+};
+} // namespace
+
+TEST_CASE("unit: get with projections splits oversized projections into lookups", "[unit]")
+{
+  SECTION("fits into single lookup")
+  {
+    REQUIRE_FALSE(make_request(15, false).requires_split());
+    REQUIRE_FALSE(make_request(14, true).requires_split());
+    REQUIRE(make_request(16, false).requires_split());
+    REQUIRE(make_request(15, true).requires_split());
+  }
+
+  SECTION("flags and expiry are fetched with the first lookup")
+  {
+    auto lookups = make_request(40, true).split_lookups();
+    REQUIRE(lookups.size() == 3);
+    REQUIRE(lookups[0].specs.size() == 16);
+    REQUIRE(lookups[1].specs.size() == 16);
+    REQUIRE(lookups[2].specs.size() == 10);
+    REQUIRE(lookups[0].specs[0].path_ == "$document.flags");
+    REQUIRE(lookups[0].specs[1].path_ == "$document.exptime");
+    REQUIRE(lookups[0].specs[2].path_ == "field_0");
+    REQUIRE(lookups[1].specs[0].path_ == "field_14");
+    REQUIRE(lookups[2].specs[9].path_ == "field_39");
+    for (const auto& lookup : lookups) {
+      REQUIRE(lookup.id.key() == "projected");
+    }
+  }
+
+  SECTION("lookups inherit timeout and retry strategy")
+  {
+    auto strategy = couchbase::make_best_effort_retry_strategy();
+    const get_projected_request request{
+      couchbase::core::document_id{ "default", "_default", "_default", "projected" },
+      {},
+      {},
+      make_request(40, false).projections,
+      false,
+      {},
+      false,
+      std::chrono::seconds{ 3 },
+      { strategy },
+    };
+    auto lookups = request.split_lookups();
+    REQUIRE(lookups.size() == 3);
+    for (const auto& lookup : lookups) {
+      REQUIRE(lookup.timeout == std::chrono::seconds{ 3 });
+      REQUIRE(lookup.retries.strategy() == strategy);
+    }
+  }
+}
+
+TEST_CASE("unit: get with projections merges lookups", "[unit]")
+{
+  auto request = make_request(20, true);
+  request.projections.emplace_back("field_missing");
+  auto lookups = request.split_lookups();
+
+  SECTION("all lookups succeeded")
+  {
+    std::vector<lookup_in_response> responses{};
+    for (const auto& lookup : lookups) {
+      responses.emplace_back(respond(lookup));
+    }
+    auto response = request.merge_lookups(responses);
+    REQUIRE(response.has_value());
+    REQUIRE_SUCCESS(response->ctx.ec());
+    REQUIRE(response->cas == couchbase::cas{ 0xcafe });
+    REQUIRE(response->flags == 42);
+    REQUIRE(response->expiry == 1807056000);
+
+    auto document = couchbase::core::utils::json::parse_binary(response->value);
+    REQUIRE(document.get_object().size() == 20);
+    for (std::size_t i = 0; i < 20; ++i) {
+      REQUIRE(document.at("field_" + std::to_string(i)).as<std::size_t>() == i);
+    }
+  }
+
+  SECTION("one of the lookups failed")
+  {
+    std::vector<lookup_in_response> responses{};
+    responses.emplace_back(respond(lookups[0]));
+    responses.emplace_back(respond(lookups[1], couchbase::errc::key_value::document_not_found));
+    auto response = request.merge_lookups(responses);
+    REQUIRE(response.has_value());
+    REQUIRE(response->ctx.ec() == couchbase::errc::key_value::document_not_found);
+  }
+
+  SECTION("document has been modified between lookups")
+  {
+    std::vector<lookup_in_response> responses{};
+    responses.emplace_back(respond(lookups[0], {}, couchbase::cas{ 1 }));
+    responses.emplace_back(respond(lookups[1], {}, couchbase::cas{ 2 }));
+    REQUIRE_FALSE(request.merge_lookups(responses).has_value());
+  }
+}
+
+TEST_CASE("unit: get with projections falls back to full document", "[unit]")
+{
+  auto core = std::make_shared<mock_core>();
+  auto request = make_request(30, false);
+
+  SECTION("document is stable")
+  {
+    std::optional<get_projected_response> result{};
+    request.execute(core, [&result](get_projected_response&& resp) {
+      result = std::move(resp);
+    });
+    REQUIRE(core->lookups == 2);
+    REQUIRE(core->full_document_requests == 0);
+    REQUIRE(result.has_value());
+    REQUIRE(result->flags == 42);
+  }
+
+  SECTION("document is modified concurrently")
+  {
+    core->modify_document_between_lookups = true;
+    bool completed{ false };
+    request.execute(core, [&completed](get_projected_response&& /* resp */) {
+      completed = true;
+    });
+    REQUIRE(core->lookups == 2);
+    REQUIRE(core->full_document_requests == 1);
+    REQUIRE(completed);
+  }
+
+  SECTION("full document is given the rest of the timeout")
+  {
+    core->modify_document_between_lookups = true;
+    core->lookup_duration = std::chrono::milliseconds{ 50 };
+    request.timeout = std::chrono::seconds{ 1 };
+    request.execute(core, [](get_projected_response&& /* resp */) {
+    });
+    REQUIRE(core->full_document_requests == 1);
+    REQUIRE(core->full_document_timeout.has_value());
+    REQUIRE(core->full_document_timeout.value() <= std::chrono::milliseconds{ 900 });
+    REQUIRE(core->full_document_timeout.value() > std::chrono::milliseconds{ 0 });
+  }
+
+  SECTION("timeout expires during the lookups")
+  {
+    core->modify_document_between_lookups = true;
+    core->lookup_duration = std::chrono::milliseconds{ 30 };
+    request.timeout = std::chrono::milliseconds{ 50 };
+    std::optional<get_projected_response> result{};
+    request.execute(core, [&result](get_projected_response&& resp) {
+      result = std::move(resp);
+    });
+    REQUIRE(core->full_document_requests == 0);
+    REQUIRE(result.has_value());
+    REQUIRE(result->ctx.ec() == couchbase::errc::common::unambiguous_timeout);
+  }
+}
@@ -0,0 +1,171 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/cluster_options.hxx"
+#include "core/io/http_context.hxx"
+#include "core/io/http_session.hxx"
+#include "core/io/http_session_pool.hxx"
+#include "core/origin.hxx"
+#include "core/topology/configuration.hxx"
+
+#include <asio/io_context.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace
+{
+class session_factory
+{
+public:
+  auto make(const std::string& hostname, const std::string& port, bool idle_timer_armed = true)
+    -> std::shared_ptr<couchbase::core::io::http_session>
+  {
+    auto session = std::make_shared<couchbase::core::io::http_session>(
+      couchbase::core::service_type::query,
+      "client",
+      "node-uuid",
+      ctx_,
+      origin_,
+      hostname,
+      port,
+      couchbase::core::http_context{
+        config_,
+        options_,
+        cache_,
+        hostname,
+        static_cast<std::uint16_t>(std::stoul(port)),
+        hostname,
+        static_cast<std::uint16_t>(std::stoul(port)),
+      });
+    if (idle_timer_armed) {
+      session->set_idle(std::chrono::hours{ 1 });
+    }
+    return session;
+  }
+
+private:
+  asio::io_context ctx_{};
+  couchbase::core::origin origin_{};
+  couchbase::core::topology::configuration config_{};
+  couchbase::core::cluster_options options_{};
+  couchbase::core::query_cache cache_{};
+};
+} // namespace
+
+TEST_CASE("unit: http_session_pool", "[unit]")
+{
+  session_factory factory{};
+  couchbase::core::io::http_session_pool pool{};
+  const auto node_a = couchbase::core::io::http_session_pool::node_address("node-a", "8093");
+  const auto node_b = couchbase::core::io::http_session_pool::node_address("node-b", "8093");
+  REQUIRE(node_a == "node-a:8093");
+
+  SECTION("empty pool")
+  {
+    REQUIRE(pool.check_out_idle() == nullptr);
+    REQUIRE(pool.check_out_idle(node_a) == nullptr);
+    REQUIRE(pool.number_of_sessions(node_a) == 0);
+  }
+
+  SECTION("check-outs without preferred node rotate over the nodes")
+  {
+    auto a1 = factory.make("node-a", "8093");
+    auto a2 = factory.make("node-a", "8093");
+    auto b1 = factory.make("node-b", "8093");
+    pool.set_idle(a1);
+    pool.set_idle(a2);
+    pool.set_idle(b1);
+    REQUIRE(pool.number_of_sessions(node_a) == 2);
+    REQUIRE(pool.number_of_sessions(node_b) == 1);
+
+    // the most recently used session of the node is taken first
+    REQUIRE(pool.check_out_idle() == a2);
+    REQUIRE(pool.check_out_idle() == b1);
+    REQUIRE(pool.check_out_idle() == a1);
+    REQUIRE(pool.check_out_idle() == nullptr);
+
+    // busy sessions are still counted
+    REQUIRE(pool.number_of_sessions(node_a) == 2);
+    REQUIRE(pool.number_of_sessions(node_b) == 1);
+  }
+
+  SECTION("check-out with preferred node")
+  {
+    auto a1 = factory.make("node-a", "8093");
+    auto b1 = factory.make("node-b", "8093");
+    pool.set_idle(a1);
+    pool.set_idle(b1);
+
+    REQUIRE(pool.check_out_idle(node_b) == b1);
+    REQUIRE(pool.check_out_idle(node_b) == nullptr);
+
+    b1->set_idle(std::chrono::hours{ 1 });
+    pool.set_idle(b1);
+    REQUIRE(pool.check_out_idle(node_b) == b1);
+    REQUIRE(pool.check_out_idle() == a1);
+  }
+
+  SECTION("sessions with expired idle timers are dropped")
+  {
+    auto expired = factory.make("node-a", "8093", false);
+    auto usable = factory.make("node-a", "8093");
+    pool.set_idle(usable);
+    pool.set_idle(expired);
+    REQUIRE(pool.number_of_sessions(node_a) == 2);
+
+    REQUIRE(pool.check_out_idle() == usable);
+    REQUIRE(pool.number_of_sessions(node_a) == 1);
+
+    auto another_expired = factory.make("node-b", "8093", false);
+    pool.set_idle(another_expired);
+    REQUIRE(pool.check_out_idle(node_b) == nullptr);
+    REQUIRE(pool.number_of_sessions(node_b) == 0);
+  }
+
+  SECTION("remove, remove_idle_if and drain")
+  {
+    auto a1 = factory.make("node-a", "8093");
+    auto a2 = factory.make("node-a", "8093");
+    auto b1 = factory.make("node-b", "8093");
+    pool.set_pending(a1);
+    pool.set_idle(a2);
+    pool.set_idle(b1);
+
+    REQUIRE(pool.remove(a1->id()) == a1);
+    REQUIRE(pool.remove(a1->id()) == nullptr);
+    REQUIRE(pool.number_of_sessions(node_a) == 1);
+
+    auto removed = pool.remove_idle_if([](const auto& session) {
+      return session.hostname() == "node-b";
+    });
+    REQUIRE(removed.size() == 1);
+    REQUIRE(removed.front() == b1);
+    REQUIRE(pool.number_of_sessions(node_b) == 0);
+    REQUIRE(pool.check_out_idle() == a2);
+
+    pool.set_busy(b1);
+    auto [idle, active] = pool.drain();
+    REQUIRE(idle.empty());
+    REQUIRE(active.size() == 2);
+    REQUIRE(pool.number_of_sessions(node_a) == 0);
+    REQUIRE(pool.check_out_idle() == nullptr);
+  }
+}
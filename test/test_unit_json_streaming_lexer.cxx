@@ -21,6 +21,10 @@
 #include "test_helper.hxx"
 
 #include "core/utils/json_streaming_lexer.hxx"
+#include "core/utils/json_structural_scanner.hxx"
+
+#include <random>
+#include <string_view>
 
 struct query_result {
   std::error_code ec{};
@@ -234,3 +238,160 @@ TEST_CASE("unit: json_streaming_lexer parse payload with missing results", "[uni
   REQUIRE(result.rows.empty());
   REQUIRE(result.meta == chunk);
 }
+
+namespace
+{
+struct lexer_result {
+  std::error_code ec{};
+  std::size_t number_of_rows{};
+  std::string meta{};
+  std::string meta_header{};
+  std::vector<std::string> rows{};
+  std::size_t number_of_completions{};
+};
+
+auto
+lex(couchbase::core::utils::json::streaming_lexer_backend backend,
+    std::string_view body,
+    std::size_t chunk_size) -> lexer_result
+{
+  couchbase::core::utils::json::streaming_lexer lexer("/results/^", 4, backend);
+  lexer_result result{};
+  lexer.on_metadata_header_complete([&result](std::error_code /* ec */, std::string&& meta_header) {
+    result.meta_header = std::move(meta_header);
+  });
+  lexer.on_row([&result](std::string&& row) {
+    result.rows.emplace_back(std::move(row));
+    return couchbase::core::utils::json::stream_control::next_row;
+  });
+  lexer.on_complete([&result](std::error_code ec, std::size_t number_of_rows, std::string&& meta) {
+    ++result.number_of_completions;
+    result.ec = ec;
+    result.number_of_rows = number_of_rows;
+    result.meta = std::move(meta);
+  });
+  for (std::size_t offset = 0; offset < body.size(); offset += chunk_size) {
+    lexer.feed(body.substr(offset, chunk_size));
+  }
+  return result;
+}
+
+/**
+ * Reference implementation of the structural scanner, that visits every byte.
+ */
+auto
+structural_offsets(std::string_view data) -> std::vector<std::size_t>
+{
+  std::vector<std::size_t> offsets{};
+  bool in_string{ false };
+  bool escaped{ false };
+  for (std::size_t i = 0; i < data.size(); ++i) {
+    if (escaped) {
+      escaped = false;
+    } else if (data[i] == '\\') {
+      escaped = true;
+    } else if (data[i] == '"') {
+      in_string = !in_string;
+      offsets.push_back(i);
+    } else if (!in_string && std::string_view{ "{}[],:" }.find(data[i]) != std::string_view::npos) {
+      offsets.push_back(i);
+    }
+  }
+  return offsets;
+}
+} // namespace
+
+TEST_CASE("unit: json_streaming_lexer backends produce the same rows and metadata", "[unit]")
+{
+  using couchbase::core::utils::json::streaming_lexer_backend;
+
+  const std::vector<std::string> bodies{
+    R"({"requestID": "2640a5b5", "signature": {"greeting":"string"}, "results": [
+{"greeting":"C++"}, {"greeting":"ruby"} ,
+null,1 , -2.5e10,false, "string \"row\" with [brackets], {braces} and \\", [1, [2, {"3": "]"}]], {}
+],
+"status": "success", "metrics": {"resultCount": 9}}
+)",
+    R"({"results": [], "status": "success"})",
+    R"(  {"results": [ ] , "errors": [{"code": 12003, "msg": "Keyspace not found"}]}  )",
+    R"({"metrics": {"results": [1, 2]}, "resul\"ts": [3], "results\\": [4],)"
+    R"( "results": [5, {"a\\":"\\\\\""}]})",
+    R"({"results": {"nested": [1, 2]}, "status": "success"})",
+    R"({"results": [1], "results": [2], "status": "success"})",
+    R"({"requestID": "d07c0cde", "status": "success"})",
+  };
+  for (const auto& body : bodies) {
+    for (const std::size_t chunk_size : { 1U, 3U, 7U, 63U, 64U, 65U, 4096U }) {
+      auto expected = lex(streaming_lexer_backend::jsonsl, body, chunk_size);
+      auto actual = lex(streaming_lexer_backend::structural, body, chunk_size);
+      INFO("body: " << body << ", chunk size: " << chunk_size);
+      REQUIRE_SUCCESS(expected.ec);
+      REQUIRE_SUCCESS(actual.ec);
+      REQUIRE(actual.number_of_completions == 1);
+      REQUIRE(actual.number_of_rows == expected.number_of_rows);
+      REQUIRE(actual.rows == expected.rows);
+      REQUIRE(actual.meta_header == expected.meta_header);
+      REQUIRE(actual.meta == expected.meta);
+    }
+  }
+}
+
+TEST_CASE("unit: json_streaming_lexer structural backend reports malformed payloads", "[unit]")
+{
+  using couchbase::core::utils::json::streaming_lexer_backend;
+
+  SECTION("root is not an object")
+  {
+    auto result = lex(streaming_lexer_backend::structural, R"( [{"results": []}])", 4);
+    REQUIRE(result.number_of_completions == 1);
+    REQUIRE(result.ec == couchbase::errc::streaming_json_lexer::root_is_not_an_object);
+  }
+
+  SECTION("bracket mismatch")
+  {
+    auto result = lex(streaming_lexer_backend::structural, R"({"results": [{"a": 1], 2]})", 4);
+    REQUIRE(result.number_of_completions == 1);
+    REQUIRE(result.ec == couchbase::errc::streaming_json_lexer::bracket_mismatch);
+    REQUIRE(result.meta.empty());
+  }
+}
+
+TEST_CASE("unit: json structural scanner", "[unit]")
+{
+  using couchbase::core::utils::json::structural_scanner;
+  namespace detail = couchbase::core::utils::json::json_structural_scanner_detail;
+
+  std::mt19937 gen{ 42 };
+  std::uniform_int_distribution<std::size_t> symbol{ 0, 9 };
+  const std::string_view alphabet{ "\"\\{}[],:a " };
+
+  for (std::size_t size : { 0U, 1U, 63U, 64U, 65U, 1000U, 4096U }) {
+    std::string data(size, ' ');
+    for (auto& c : data) {
+      c = alphabet[symbol(gen)];
+    }
+
+    for (std::size_t offset = 0; offset + structural_scanner::block_size <= size;
+         offset += structural_scanner::block_size) {
+      auto expected = detail::classify_bytewise(data.data() + offset);
+      auto actual = detail::classify(data.data() + offset);
+      REQUIRE(actual.quote == expected.quote);
+      REQUIRE(actual.backslash == expected.backslash);
+      REQUIRE(actual.structural == expected.structural);
+    }
+
+    for (std::size_t chunk_size : { 1U, 13U, 64U, 100U, 4096U }) {
+      structural_scanner scanner{};
+      std::vector<std::size_t> offsets{};
+      for (std::size_t offset = 0; offset < size; offset += chunk_size) {
+        std::vector<std::size_t> index{};
+        scanner.scan(std::string_view{ data }.substr(offset, chunk_size), index);
+        for (const auto i : index) {
+          offsets.push_back(offset + i);
+        }
+      }
+      INFO("size: " << size << ", chunk size: " << chunk_size);
+      REQUIRE(offsets == structural_offsets(data));
+    }
+  }
+}
@@ -0,0 +1,136 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/utils/json_streaming_writer.hxx"
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+using couchbase::core::utils::json::streaming_writer;
+
+TEST_CASE("unit: streaming JSON writer separates values", "[unit]")
+{
+  SECTION("empty containers")
+  {
+    std::string output{};
+    streaming_writer writer{ output };
+    writer.begin_object();
+    writer.key("object");
+    writer.begin_object();
+    writer.end_object();
+    writer.key("array");
+    writer.begin_array();
+    writer.end_array();
+    writer.end_object();
+    REQUIRE(output == R"({"object":{},"array":[]})");
+  }
+
+  SECTION("scalars")
+  {
+    std::string output{};
+    streaming_writer writer{ output };
+    writer.begin_array();
+    writer.value("string");
+    writer.value(true);
+    writer.value(false);
+    writer.null();
+    writer.value(std::numeric_limits<std::uint64_t>::max());
+    writer.value(std::numeric_limits<std::int64_t>::min());
+    writer.value(std::uint16_t{ 42 });
+    writer.end_array();
+    REQUIRE(output ==
+            R"(["string",true,false,null,18446744073709551615,-9223372036854775808,42])");
+  }
+
+  SECTION("nested containers")
+  {
+    std::string output{};
+    streaming_writer writer{ output };
+    writer.begin_object();
+    writer.member("a", 1);
+    writer.key("b");
+    writer.begin_array();
+    writer.begin_object();
+    writer.member("c", "d");
+    writer.end_object();
+    writer.begin_array();
+    writer.end_array();
+    writer.value(2);
+    writer.end_array();
+    writer.member("e", false);
+    writer.end_object();
+    REQUIRE(output == R"({"a":1,"b":[{"c":"d"},[],2],"e":false})");
+  }
+
+  SECTION("appends to existing output")
+  {
+    std::string output{ "prefix:" };
+    streaming_writer writer{ output };
+    writer.value("value");
+    REQUIRE(output == R"(prefix:"value")");
+    REQUIRE(writer.size() == output.size());
+  }
+}
+
+TEST_CASE("unit: streaming JSON writer escapes strings", "[unit]")
+{
+  std::string output{};
+  streaming_writer writer{ output };
+  writer.begin_object();
+  writer.member("quote\"key", std::string{ "back\\slash\n\r\t\b\f" } + '\0' + "\x1f end");
+  writer.member("utf-8", "\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82");
+  writer.end_object();
+  REQUIRE(output == R"({"quote\"key":"back\\slash\n\r\t\b\f\u0000\u001f end",)"
+                    "\"utf-8\":\"\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82\"}");
+}
+
+TEST_CASE("unit: streaming JSON writer splices encoded values", "[unit]")
+{
+  std::string output{};
+  streaming_writer writer{ output };
+  writer.begin_array();
+  writer.raw_value(R"({ "pretty": [1, 2] })");
+  writer.raw_value(couchbase::core::json_string{ std::string{ "\"string\"" } });
+  writer.raw_value(couchbase::core::json_string{ std::vector<std::byte>{
+    std::byte{ '4' },
+    std::byte{ '2' },
+  } });
+  writer.raw_value(couchbase::core::json_string{});
+  writer.end_array();
+  REQUIRE(output == R"([{ "pretty": [1, 2] },"string",42,null])");
+}
+
+TEST_CASE("unit: streaming JSON writer detects overridden members", "[unit]")
+{
+  const std::map<std::string, std::string> options{ { "timeout", "\"1s\"" } };
+  REQUIRE(couchbase::core::utils::json::has_member(options, "timeout"));
+  REQUIRE_FALSE(couchbase::core::utils::json::has_member(options, "args"));
+
+  const std::map<std::string, std::string, std::less<>> transparent_options{
+    { "args", "[]" },
+  };
+  REQUIRE(couchbase::core::utils::json::has_member(transparent_options, "args"));
+  REQUIRE_FALSE(couchbase::core::utils::json::has_member(transparent_options, "timeout"));
+
+  REQUIRE_FALSE(
+    couchbase::core::utils::json::has_member(std::map<std::string, std::string>{}, "timeout"));
+}
@@ -0,0 +1,302 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/app_telemetry_meter.hxx"
+#include "core/cluster_label_listener.hxx"
+#include "core/impl/bootstrap_state_listener.hxx"
+#include "core/io/mcbp_command.hxx"
+#include "core/io/mcbp_session.hxx"
+#include "core/metrics/meter_wrapper.hxx"
+#include "core/metrics/noop_meter.hxx"
+#include "core/operations/document_get.hxx"
+#include "core/origin.hxx"
+#include "core/orphan_reporter.hxx"
+#include "core/tracing/noop_tracer.hxx"
+#include "core/tracing/tracer_wrapper.hxx"
+#include "core/utils/connection_string.hxx"
+
+#include <couchbase/best_effort_retry_strategy.hxx>
+#include <couchbase/retry_reason.hxx>
+
+#include <asio/executor_work_guard.hpp>
+#include <asio/io_context.hpp>
+#include <asio/post.hpp>
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+
+namespace
+{
+using couchbase::core::io::mcbp_session;
+
+class stub_bootstrap_listener : public couchbase::core::impl::bootstrap_state_listener
+{
+public:
+  void report_bootstrap_error(const std::string& /*endpoint*/, std::error_code /*ec*/) override
+  {
+  }
+
+  void report_bootstrap_success(const std::vector<std::string>& /*endpoints*/) override
+  {
+  }
+
+  void register_config_listener(
+    std::shared_ptr<couchbase::core::config_listener> /*listener*/) override
+  {
+  }
+
+  void unregister_config_listener(
+    std::shared_ptr<couchbase::core::config_listener> /*listener*/) override
+  {
+  }
+};
+
+/**
+ * Provides everything mcbp_command needs from the bucket. The commands in these tests are never
+ * retried or remapped, so both entry points simply cancel the command.
+ */
+class fake_manager
+{
+public:
+  explicit fake_manager(asio::io_context& ctx)
+    : orphan_reporter_{ std::make_shared<couchbase::core::orphan_reporter>(
+        ctx, couchbase::core::orphan_reporter_options{}) }
+  {
+  }
+
+  [[nodiscard]] auto name() const -> const std::string&
+  {
+    return name_;
+  }
+
+  [[nodiscard]] auto log_prefix() const -> const std::string&
+  {
+    return name_;
+  }
+
+  [[nodiscard]] auto tracer() const -> std::shared_ptr<couchbase::core::tracing::tracer_wrapper>
+  {
+    return tracer_;
+  }
+
+  [[nodiscard]] auto meter() const -> std::shared_ptr<couchbase::core::metrics::meter_wrapper>
+  {
+    return meter_;
+  }
+
+  [[nodiscard]] auto orphan_reporter() const -> std::shared_ptr<couchbase::core::orphan_reporter>
+  {
+    return orphan_reporter_;
+  }
+
+  [[nodiscard]] auto app_telemetry_meter() const
+    -> std::shared_ptr<couchbase::core::app_telemetry_meter>
+  {
+    return app_telemetry_meter_;
+  }
+
+  [[nodiscard]] auto default_retry_strategy() const -> std::shared_ptr<couchbase::retry_strategy>
+  {
+    return couchbase::make_best_effort_retry_strategy();
+  }
+
+  void fetch_config()
+  {
+  }
+
+  template<typename Command>
+  void map_and_send(std::shared_ptr<Command> cmd)
+  {
+    cmd->cancel(couchbase::retry_reason::do_not_retry);
+  }
+
+  template<typename Command>
+  void schedule_for_retry(std::shared_ptr<Command> cmd, std::chrono::milliseconds /* duration */)
+  {
+    cmd->cancel(couchbase::retry_reason::do_not_retry);
+  }
+
+private:
+  std::string name_{ "fake-bucket" };
+  std::shared_ptr<couchbase::core::tracing::tracer_wrapper> tracer_{
+    couchbase::core::tracing::tracer_wrapper::create(
+      std::make_shared<couchbase::core::tracing::noop_tracer>(),
+      std::make_shared<couchbase::core::cluster_label_listener>())
+  };
+  std::shared_ptr<couchbase::core::metrics::meter_wrapper> meter_{
+    couchbase::core::metrics::meter_wrapper::create(
+      std::make_shared<couchbase::core::metrics::noop_meter>(),
+      std::make_shared<couchbase::core::cluster_label_listener>())
+  };
+  std::shared_ptr<couchbase::core::orphan_reporter> orphan_reporter_;
+  std::shared_ptr<couchbase::core::app_telemetry_meter> app_telemetry_meter_{
+    std::make_shared<couchbase::core::app_telemetry_meter>()
+  };
+};
+
+using get_command =
+  couchbase::core::operations::mcbp_command<fake_manager,
+                                            couchbase::core::operations::get_request>;
+
+// The session is never bootstrapped, so the commands stay in its pending buffer, and the test
+// plays the role of the server by completing them through mcbp_session::cancel().
+auto
+make_session(asio::io_context& io) -> mcbp_session
+{
+  auto origin = couchbase::core::origin(
+    couchbase::core::cluster_credentials{ "user", "pass" },
+    couchbase::core::utils::parse_connection_string("couchbase://127.0.0.1"));
+  return { "test-client-id",
+           "test-node-uuid",
+           io,
+           std::move(origin),
+           std::make_shared<stub_bootstrap_listener>(),
+           std::nullopt,
+           {} };
+}
+
+template<typename Function>
+void
+run_on(asio::io_context& ctx, Function&& function)
+{
+  std::promise<void> barrier;
+  asio::post(ctx, [&barrier, function = std::forward<Function>(function)]() mutable {
+    function();
+    barrier.set_value();
+  });
+  barrier.get_future().get();
+}
+} // namespace
+
+TEST_CASE("unit: mcbp_command completes once when the deadline races with another io_context",
+          "[unit]")
+{
+  asio::io_context command_ctx{};
+  asio::io_context session_ctx{};
+  auto command_guard = asio::make_work_guard(command_ctx);
+  auto session_guard = asio::make_work_guard(session_ctx);
+  std::thread command_thread([&command_ctx]() {
+    command_ctx.run();
+  });
+  std::thread session_thread([&session_ctx]() {
+    session_ctx.run();
+  });
+
+  auto manager = std::make_shared<fake_manager>(command_ctx);
+  auto session = make_session(session_ctx);
+
+  constexpr std::size_t number_of_commands{ 1'000 };
+  std::size_t completed_by_session{ 0 };
+  for (std::size_t i = 0; i < number_of_commands; ++i) {
+    couchbase::core::operations::get_request request{ couchbase::core::document_id{
+      "default", "_default", "_default", "key-" + std::to_string(i) } };
+    auto cmd =
+      std::make_shared<get_command>(command_ctx, manager, request, std::chrono::seconds{ 10 });
+    auto invocations = std::make_shared<std::atomic_int>(0);
+    auto last_error = std::make_shared<std::error_code>();
+
+    std::uint32_t opaque{};
+    run_on(command_ctx, [&]() {
+      cmd->start([invocations, last_error](std::error_code ec,
+                                           std::optional<couchbase::core::io::mcbp_message>&&) {
+        *last_error = ec;
+        ++*invocations;
+      });
+      cmd->send_to(session);
+      opaque = cmd->opaque_.value();
+    });
+
+    // The session completes the command on its own context, while the deadline (which is what
+    // cmd->cancel() is called from) fires on the context of the command.
+    std::promise<void> session_done;
+    std::promise<void> deadline_done;
+    std::atomic_bool session_completed{ false };
+    asio::post(session_ctx, [&]() {
+      session_completed = session.cancel(
+        opaque, asio::error::operation_aborted, couchbase::retry_reason::do_not_retry);
+      session_done.set_value();
+    });
+    asio::post(command_ctx, [&]() {
+      cmd->cancel(couchbase::retry_reason::do_not_retry);
+      deadline_done.set_value();
+    });
+    session_done.get_future().get();
+    deadline_done.get_future().get();
+
+    // The completion from the session might still be queued on the context of the command.
+    run_on(command_ctx, []() {
+    });
+
+    REQUIRE(invocations->load() == 1);
+    REQUIRE(*last_error == couchbase::errc::common::unambiguous_timeout);
+    REQUIRE_FALSE(cmd->handler_);
+    if (session_completed) {
+      ++completed_by_session;
+    }
+  }
+  INFO("completed by the session: " << completed_by_session << " of " << number_of_commands);
+
+  session.stop(couchbase::retry_reason::do_not_retry);
+  session_guard.reset();
+  command_guard.reset();
+  session_thread.join();
+  command_thread.join();
+}
+
+TEST_CASE("unit: mcbp_command completes on its own io_context", "[unit]")
+{
+  asio::io_context command_ctx{};
+  asio::io_context session_ctx{};
+  auto command_guard = asio::make_work_guard(command_ctx);
+  auto session_guard = asio::make_work_guard(session_ctx);
+  std::thread command_thread([&command_ctx]() {
+    command_ctx.run();
+  });
+  std::thread session_thread([&session_ctx]() {
+    session_ctx.run();
+  });
+
+  auto manager = std::make_shared<fake_manager>(command_ctx);
+  auto session = make_session(session_ctx);
+
+  couchbase::core::operations::get_request request{ couchbase::core::document_id{
+    "default", "_default", "_default", "key" } };
+  auto cmd =
+    std::make_shared<get_command>(command_ctx, manager, request, std::chrono::seconds{ 10 });
+  std::promise<std::thread::id> completed_on;
+  run_on(command_ctx, [&]() {
+    cmd->start(
+      [&completed_on](std::error_code, std::optional<couchbase::core::io::mcbp_message>&&) {
+        completed_on.set_value(std::this_thread::get_id());
+      });
+    cmd->send_to(session);
+  });
+
+  // closing the session completes its commands on the calling thread
+  session.stop(couchbase::retry_reason::do_not_retry);
+  REQUIRE(completed_on.get_future().get() == command_thread.get_id());
+
+  session_guard.reset();
+  command_guard.reset();
+  session_thread.join();
+  command_thread.join();
+}
@@ -0,0 +1,112 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/mcbp_output_buffer.hxx"
+
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+using couchbase::core::io::mcbp_output_buffer;
+
+auto
+make_request(std::size_t size, std::uint8_t fill) -> std::vector<std::byte>
+{
+  return std::vector<std::byte>(size, std::byte{ fill });
+}
+
+auto
+concatenate(const std::vector<std::vector<std::byte>>& buffers) -> std::vector<std::byte>
+{
+  std::vector<std::byte> result;
+  for (const auto& buffer : buffers) {
+    result.insert(result.end(), buffer.begin(), buffer.end());
+  }
+  return result;
+}
+} // namespace
+
+TEST_CASE("unit: mcbp_output_buffer packs small requests together", "[unit]")
+{
+  mcbp_output_buffer output;
+  CHECK_FALSE(output.start_write());
+
+  std::vector<std::byte> expected;
+  for (std::uint8_t i = 0; i < 100; ++i) {
+    auto request = make_request(std::size_t{ 24 } + i, i);
+    expected.insert(expected.end(), request.begin(), request.end());
+    output.append(std::move(request));
+  }
+  CHECK(output.pending_bytes() == expected.size());
+
+  REQUIRE(output.start_write());
+  CHECK(output.pending_bytes() == 0);
+  CHECK(output.in_flight().size() == 1);
+  CHECK(concatenate(output.in_flight()) == expected);
+
+  SECTION("only one write at a time")
+  {
+    output.append(make_request(24, 0xff));
+    CHECK_FALSE(output.start_write());
+    output.complete_write();
+    REQUIRE(output.start_write());
+    CHECK(concatenate(output.in_flight()) == make_request(24, 0xff));
+  }
+
+  SECTION("chunks are reused")
+  {
+    const auto* chunk = output.in_flight().front().data();
+    output.complete_write();
+    output.append(make_request(24, 0xff));
+    REQUIRE(output.start_write());
+    CHECK(output.in_flight().front().data() == chunk);
+  }
+}
+
+TEST_CASE("unit: mcbp_output_buffer keeps large requests in their own buffers", "[unit]")
+{
+  mcbp_output_buffer output;
+
+  output.append(make_request(24, 1));
+  auto large = make_request(mcbp_output_buffer::chunk_size, 2);
+  const auto* large_data = large.data();
+  output.append(std::move(large));
+  output.append(make_request(24, 3));
+
+  REQUIRE(output.start_write());
+  REQUIRE(output.in_flight().size() == 3);
+  CHECK(output.in_flight()[1].data() == large_data);
+
+  std::vector<std::byte> expected = make_request(24, 1);
+  auto tail = make_request(mcbp_output_buffer::chunk_size, 2);
+  expected.insert(expected.end(), tail.begin(), tail.end());
+  tail = make_request(24, 3);
+  expected.insert(expected.end(), tail.begin(), tail.end());
+  CHECK(concatenate(output.in_flight()) == expected);
+}
+
+TEST_CASE("unit: mcbp_output_buffer clears pending data", "[unit]")
+{
+  mcbp_output_buffer output;
+  output.append(make_request(24, 1));
+  output.clear_pending();
+  CHECK(output.pending_bytes() == 0);
+  CHECK_FALSE(output.start_write());
+}
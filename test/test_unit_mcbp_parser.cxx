@@ -19,8 +19,11 @@
 
 #include "core/io/mcbp_parser.hxx"
 #include "core/protocol/magic.hxx"
+#include "core/utils/byteswap.hxx"
 
+#include <algorithm>
 #include <array>
+#include <string>
 #include <vector>
 
 namespace
@@ -55,6 +58,10 @@ struct frame_builder {
   {
     return set(4, v);
   }
+  auto datatype(std::uint8_t v) -> frame_builder& // byte 5
+  {
+    return set(5, v);
+  }
   auto bodylen(std::uint32_t v) -> frame_builder& // bytes 8-11
   {
     return set(8, static_cast<std::uint8_t>(v >> 24U))
@@ -63,6 +70,77 @@ struct frame_builder {
       .set(11, static_cast<std::uint8_t>(v));
   }
 };
+
+// Wire image of the pipelined GET responses: 4 bytes of flags in extras, followed by the value.
+auto
+make_get_responses(std::size_t number_of_frames, std::size_t value_size) -> std::vector<std::byte>
+{
+  auto header = frame_builder{}
+                  .magic_byte(magic::client_response)
+                  .opcode(0x00)
+                  .extlen(0x04)
+                  .bodylen(static_cast<std::uint32_t>(4 + value_size))
+                  .bytes;
+  std::vector<std::byte> wire;
+  wire.reserve(number_of_frames * (header.size() + 4 + value_size));
+  for (std::size_t i = 0; i < number_of_frames; ++i) {
+    wire.insert(wire.end(), header.begin(), header.end());
+    wire.insert(wire.end(), 4, std::byte{ 0x00 });
+    wire.insert(wire.end(), value_size, std::byte{ 0x2a });
+  }
+  return wire;
+}
+
+// GET response with 4 bytes of flags and the value compressed with snappy. The compressed stream
+// consists of the varint-encoded length and a single literal element.
+auto
+make_compressed_get_response(const std::string& value) -> std::vector<std::byte>
+{
+  std::vector<std::byte> compressed{
+    std::byte{ static_cast<std::uint8_t>(value.size()) },
+    std::byte{ static_cast<std::uint8_t>((value.size() - 1) << 2U) },
+  };
+  for (const auto ch : value) {
+    compressed.emplace_back(static_cast<std::byte>(ch));
+  }
+  auto header = frame_builder{}
+                  .magic_byte(magic::client_response)
+                  .opcode(0x00)
+                  .extlen(0x04)
+                  .datatype(0x02) // snappy
+                  .bodylen(static_cast<std::uint32_t>(4 + compressed.size()))
+                  .bytes;
+  std::vector<std::byte> wire(header.begin(), header.end());
+  wire.insert(wire.end(), 4, std::byte{ 0x00 });
+  wire.insert(wire.end(), compressed.begin(), compressed.end());
+  return wire;
+}
+
+auto
+value_of(const mcbp_message& msg) -> std::string
+{
+  return { reinterpret_cast<const char*>(msg.body.data()) + 4, msg.body.size() - 4 };
+}
+
+// Feeds the wire image in chunks of the given size (as the socket would) and returns number of
+// the frames parsed.
+auto
+parse_in_chunks(mcbp_parser& parser, const std::vector<std::byte>& wire, std::size_t chunk_size)
+  -> std::size_t
+{
+  std::size_t frames = 0;
+  for (auto it = wire.begin(); it != wire.end();) {
+    auto chunk_end = it + static_cast<std::ptrdiff_t>(std::min(
+                            chunk_size, static_cast<std::size_t>(std::distance(it, wire.end()))));
+    parser.feed(it, chunk_end);
+    it = chunk_end;
+    mcbp_message msg;
+    while (parser.next(msg) == mcbp_parser::result::ok) {
+      ++frames;
+    }
+  }
+  return frames;
+}
 } // namespace
 
 TEST_CASE("unit: mcbp_parser rejects frame whose prefix exceeds the body", "[unit]")
@@ -136,3 +214,42 @@ TEST_CASE("unit: mcbp_parser accepts a well-formed frame (positive control)", "[
   CHECK(parser.next(msg) == mcbp_parser::result::ok);
   CHECK(msg.body.size() == 7);
 }
+
+TEST_CASE("unit: mcbp_parser handles frames split across reads", "[unit]")
+{
+  const std::size_t number_of_frames = 100;
+  const std::size_t value_size = 37;
+  auto wire = make_get_responses(number_of_frames, value_size);
+
+  for (const std::size_t chunk_size : std::vector<std::size_t>{ 1, 7, 24, 65, 16 * 1024 }) {
+    mcbp_parser parser;
+    CHECK(parse_in_chunks(parser, wire, chunk_size) == number_of_frames);
+    CHECK(parser.pending() == 0);
+  }
+
+  mcbp_parser parser;
+  parser.feed(wire.begin(), wire.end());
+  for (std::size_t i = 0; i < number_of_frames; ++i) {
+    mcbp_message msg;
+    REQUIRE(parser.next(msg) == mcbp_parser::result::ok);
+    CHECK(msg.body.size() == 4 + value_size);
+    CHECK(msg.body.back() == std::byte{ 0x2a });
+  }
+  mcbp_message msg;
+  CHECK(parser.next(msg) == mcbp_parser::result::need_data);
+}
+
+TEST_CASE("unit: mcbp_parser decompresses snappy values", "[unit]")
+{
+  const std::string value{ R"({"answer":42})" };
+  auto wire = make_compressed_get_response(value);
+
+  mcbp_parser parser;
+  parser.feed(wire.begin(), wire.end());
+
+  mcbp_message msg;
+  REQUIRE(parser.next(msg) == mcbp_parser::result::ok);
+  CHECK_FALSE(msg.is_compressed());
+  CHECK(value_of(msg) == value);
+  CHECK(couchbase::core::utils::byte_swap(msg.header.bodylen) == 4 + value.size());
+}
@@ -17,17 +17,24 @@
 
 #include "test_helper.hxx"
 
+#include "core/cluster_label_listener.hxx"
 #include "core/metrics/constants.hxx"
 #include "core/metrics/logging_meter.hxx"
 #include "core/metrics/logging_meter_options.hxx"
 #include "core/metrics/meter_wrapper.hxx"
 #include "core/tracing/constants.hxx"
+#include "core/utils/json.hxx"
 
 #include <couchbase/error_codes.hxx>
 #include <spdlog/fmt/bundled/printf.h>
 
 #include <asio/io_context.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
 TEST_CASE("unit: metric attributes encoding", "[unit]")
 {
   SECTION("all attributes set")
@@ -204,4 +211,93 @@ TEST_CASE("unit: logging_meter get_value_recorder", "[unit]")
     REQUIRE(query_recorder != nullptr);
     REQUIRE(kv_recorder != query_recorder);
   }
+
+  SECTION("pre-resolved operation recorder is the same instance")
+  {
+    auto recorder =
+      meter->get_value_recorder(couchbase::core::metrics::operation_meter_name, kv_get_tags);
+    REQUIRE(&meter->operation_recorder(couchbase::core::tracing::service::key_value, "get") ==
+            recorder.get());
+    auto upsert_recorder =
+      meter->get_value_recorder(couchbase::core::metrics::operation_meter_name, kv_upsert_tags);
+    REQUIRE(&meter->operation_recorder(couchbase::core::tracing::service::key_value, "upsert") ==
+            upsert_recorder.get());
+    REQUIRE(&meter->operation_recorder(couchbase::core::tracing::service::query, "get") !=
+            recorder.get());
+  }
+}
+
+TEST_CASE("unit: logging_meter reports every value recorded from multiple threads", "[unit]")
+{
+  asio::io_context ctx{};
+  couchbase::core::metrics::logging_meter_options options{};
+  auto meter = std::make_shared<couchbase::core::metrics::logging_meter>(ctx, options);
+
+  const auto number_of_threads =
+    std::max(std::size_t{ 4 }, std::size_t{ std::thread::hardware_concurrency() });
+  constexpr std::int64_t operations_per_thread{ 20'000 };
+
+  std::int64_t reported{ 0 };
+  auto collect_report = [&meter, &reported]() {
+    auto output = meter->flush_and_create_output();
+    if (!output) {
+      return;
+    }
+    const auto report = couchbase::core::utils::json::parse(output.value());
+    for (const auto& [operation, recorder] :
+         report.at("operations").at(couchbase::core::tracing::service::key_value).get_object()) {
+      reported += recorder.at("total_count").as<std::int64_t>();
+    }
+  };
+
+  std::atomic_bool recording{ true };
+  std::vector<std::thread> threads{};
+  threads.reserve(number_of_threads);
+  for (std::size_t t = 0; t < number_of_threads; ++t) {
+    threads.emplace_back([&meter, t]() {
+      for (std::int64_t i = 0; i < operations_per_thread; ++i) {
+        meter
+          ->operation_recorder(couchbase::core::tracing::service::key_value,
+                               (i + static_cast<std::int64_t>(t)) % 2 == 0 ? "get" : "upsert")
+          .record_value(i + 1);
+      }
+    });
+  }
+  // the reports are taken while the threads are still recording
+  std::thread reporter([&recording, &collect_report]() {
+    while (recording) {
+      collect_report();
+    }
+  });
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  recording = false;
+  reporter.join();
+  collect_report();
+
+  REQUIRE(reported == static_cast<std::int64_t>(number_of_threads) * operations_per_thread);
+
+  // every value is reported exactly once
+  reported = 0;
+  collect_report();
+  REQUIRE(reported == 0);
+}
+
+TEST_CASE("unit: logging_meter shares recorders between lookups", "[unit]")
+{
+  asio::io_context ctx{};
+  couchbase::core::metrics::logging_meter_options options{};
+  auto meter = std::make_shared<couchbase::core::metrics::logging_meter>(ctx, options);
+
+  REQUIRE(&meter->operation_recorder(couchbase::core::tracing::service::key_value, "get") ==
+          meter
+            ->get_value_recorder(couchbase::core::metrics::operation_meter_name,
+                                 {
+                                   { couchbase::core::tracing::attributes::op::service,
+                                     couchbase::core::tracing::service::key_value },
+                                   { couchbase::core::tracing::attributes::op::operation_name,
+                                     "get" },
+                                 })
+            .get());
 }
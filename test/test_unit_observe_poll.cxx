@@ -0,0 +1,100 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/impl/observe_poll.hxx"
+#include "core/impl/observe_seqno_coalescer.hxx"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+auto
+make_request(const std::string& key, std::uint16_t partition, std::size_t node_index = 0)
+  -> couchbase::core::impl::observe_seqno_request
+{
+  couchbase::core::document_id id{ "travel-sample", "_default", "_default", key };
+  id.node_index(node_index);
+  return { id, node_index == 0, 0xcafe, {}, partition };
+}
+} // namespace
+
+TEST_CASE("unit: observe poll interval grows exponentially", "[unit]")
+{
+  using couchbase::core::impl::next_observe_poll_interval;
+  using couchbase::core::impl::observe_poll_initial_interval;
+  using couchbase::core::impl::observe_poll_max_interval;
+
+  REQUIRE(observe_poll_initial_interval < std::chrono::milliseconds{ 1 });
+
+  auto interval = observe_poll_initial_interval;
+  std::vector<std::chrono::microseconds> intervals{ interval };
+  while (interval < observe_poll_max_interval) {
+    auto next = next_observe_poll_interval(interval);
+    REQUIRE(next > interval);
+    REQUIRE(next <= interval * 2);
+    interval = next;
+    intervals.push_back(interval);
+  }
+  REQUIRE(intervals.size() > 5);
+  REQUIRE(next_observe_poll_interval(observe_poll_max_interval) == observe_poll_max_interval);
+}
+
+TEST_CASE("unit: concurrent observers of the same vBucket copy share requests", "[unit]")
+{
+  using couchbase::core::impl::observe_seqno_coalescer;
+  using couchbase::core::impl::observe_seqno_response;
+
+  observe_seqno_coalescer coalescer{};
+  std::vector<std::uint64_t> seen{};
+  auto handler = [&seen](observe_seqno_response response) {
+    seen.push_back(response.current_sequence_number);
+  };
+
+  const auto first = observe_seqno_coalescer::key_for(make_request("foo", 42));
+  const auto same_vbucket = observe_seqno_coalescer::key_for(make_request("bar", 42));
+  const auto replica = observe_seqno_coalescer::key_for(make_request("foo", 42, 1));
+  const auto other_vbucket = observe_seqno_coalescer::key_for(make_request("baz", 7));
+
+  REQUIRE(coalescer.join(first, handler));
+  REQUIRE_FALSE(coalescer.join(same_vbucket, handler));
+  REQUIRE(coalescer.join(replica, handler));
+  REQUIRE(coalescer.join(other_vbucket, handler));
+  REQUIRE(coalescer.number_of_pending_requests() == 3);
+
+  observe_seqno_response response{};
+  response.current_sequence_number = 1;
+  coalescer.complete(first, response);
+  REQUIRE(seen == std::vector<std::uint64_t>{ 1, 1 });
+  REQUIRE(coalescer.number_of_pending_requests() == 2);
+
+  // completion of unknown or finished requests is ignored
+  coalescer.complete(first, response);
+  REQUIRE(seen.size() == 2);
+
+  // the next round sends the request again
+  REQUIRE(coalescer.join(same_vbucket, handler));
+  response.current_sequence_number = 2;
+  coalescer.complete(same_vbucket, response);
+  coalescer.complete(replica, response);
+  coalescer.complete(other_vbucket, response);
+  REQUIRE(seen == std::vector<std::uint64_t>{ 1, 1, 2, 2, 2 });
+  REQUIRE(coalescer.number_of_pending_requests() == 0);
+}
@@ -82,6 +82,96 @@ TEST_CASE("unit: query with read from replica", "[unit]")
   }
 }
 
+TEST_CASE("unit: query body is written without DOM", "[unit]")
+{
+  couchbase::core::topology::configuration config{};
+  auto ctx = make_http_context(config);
+
+  couchbase::core::io::http_request http_req;
+  couchbase::core::operations::query_request req{};
+  req.statement = R"(SELECT "\" \\ \n" FROM `travel-sample` WHERE id = $id)";
+  req.named_parameters["id"] = std::string{ R"({ "nested": [1, 2.5, "three"] })" };
+  req.named_parameters["$type"] = std::string{ R"("airline")" };
+  req.positional_parameters.emplace_back(std::string{ "42" });
+  req.positional_parameters.emplace_back(std::string{ "[true, null]" });
+  req.raw["timeout"] = std::string{ R"("1s")" };
+  req.raw["custom"] = std::string{ R"({"answer": 42})" };
+  req.mutation_state.emplace_back(11, 3, 5, "travel-sample");
+  req.mutation_state.emplace_back(11, 4, 5, "travel-sample");
+  req.mutation_state.emplace_back(22, 7, 6, "beer-sample");
+  http_req.client_context_id = "ctx-id";
+  http_req.timeout = std::chrono::seconds(10);
+
+  auto ec = req.encode_to(http_req, ctx);
+  REQUIRE_SUCCESS(ec);
+  REQUIRE(req.body_str == http_req.body);
+
+  auto body = couchbase::core::utils::json::parse(http_req.body);
+  const tao::json::value expected{
+    { "client_context_id", "ctx-id" },
+    { "statement", req.statement },
+    { "timeout", "1s" },
+    { "$id", { { "nested", tao::json::value::array({ 1, 2.5, "three" }) } } },
+    { "$type", "airline" },
+    { "args", tao::json::value::array({ 42, tao::json::value::array({ true, nullptr }) }) },
+    { "custom", { { "answer", 42 } } },
+    { "metrics", false },
+    { "scan_consistency", "at_plus" },
+    { "scan_vectors",
+      {
+        { "travel-sample", { { "5", tao::json::value::array({ 4, "11" }) } } },
+        { "beer-sample", { { "6", tao::json::value::array({ 7, "22" }) } } },
+      } },
+  };
+  REQUIRE(body == expected);
+}
+
+TEST_CASE("unit: raw options override the members of the query body", "[unit]")
+{
+  couchbase::core::topology::configuration config{};
+  auto ctx = make_http_context(config);
+
+  couchbase::core::io::http_request http_req;
+  couchbase::core::operations::query_request req{};
+  req.statement = "SELECT 1";
+  req.raw["client_context_id"] = std::string{ R"("raw-id")" };
+  req.raw["statement"] = std::string{ R"("SELECT 2")" };
+  http_req.client_context_id = "ctx-id";
+
+  REQUIRE_SUCCESS(req.encode_to(http_req, ctx));
+  // every member is written once, with the value from the raw options
+  REQUIRE(http_req.body.find("ctx-id") == std::string::npos);
+  REQUIRE(http_req.body.find("SELECT 1") == std::string::npos);
+  auto body = couchbase::core::utils::json::parse(http_req.body);
+  REQUIRE(body.get_object().at("client_context_id").get_string() == "raw-id");
+  REQUIRE(body.get_object().at("statement").get_string() == "SELECT 2");
+}
+
+TEST_CASE("unit: query request keeps the row callback when encoded again", "[unit]")
+{
+  couchbase::core::topology::configuration config{};
+  auto ctx = make_http_context(config);
+
+  int rows = 0;
+  couchbase::core::operations::query_request req{};
+  req.statement = "SELECT 1";
+  req.row_callback = [&rows](std::string /* row */) {
+    ++rows;
+    return couchbase::core::utils::json::stream_control::next_row;
+  };
+
+  // the command encodes the request again, when the prepared statement has to be retried
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    couchbase::core::io::http_request http_req;
+    REQUIRE_SUCCESS(req.encode_to(http_req, ctx));
+    REQUIRE(http_req.streaming.has_value());
+    REQUIRE(http_req.streaming->row_handler);
+    REQUIRE(http_req.streaming->row_handler("{}") ==
+            couchbase::core::utils::json::stream_control::next_row);
+  }
+  REQUIRE(rows == 2);
+}
+
 TEST_CASE("unit: Public API query options - add/clear parameters", "[unit]")
 {
   SECTION("positional parameters")
@@ -148,3 +238,48 @@ TEST_CASE("unit: Public API query options - add/clear parameters", "[unit]")
             });
   }
 }
+
+TEST_CASE("unit: query response rows are taken from the body verbatim", "[unit]")
+{
+  couchbase::core::operations::query_request req{};
+  req.statement = "SELECT * FROM `travel-sample`";
+
+  SECTION("rows and metadata")
+  {
+    couchbase::core::io::http_response encoded{};
+    encoded.status_code = 200;
+    encoded.body.append(R"({
+"requestID": "5b6bc0d1-9c45-4a1e-b7c1-6c0e5e1b3d2f",
+"signature": {"*":"*"},
+"results": [
+{"a": 1},
+{"b": [1, 2, {"c": "]}"}]},
+42
+],
+"status": "success",
+"metrics": {"elapsedTime": "1.2ms","executionTime": "1.1ms","resultCount": 3,"resultSize": 42}
+})");
+
+    auto resp = req.make_response({}, encoded);
+    REQUIRE_SUCCESS(resp.ctx.ec);
+    REQUIRE(resp.rows.size() == 3);
+    CHECK(resp.rows[0] == R"({"a": 1})");
+    CHECK(resp.rows[1] == R"({"b": [1, 2, {"c": "]}"}]})");
+    CHECK(resp.rows[2] == "42");
+    CHECK(resp.meta.request_id == "5b6bc0d1-9c45-4a1e-b7c1-6c0e5e1b3d2f");
+    CHECK(resp.meta.status == "success");
+    CHECK(resp.meta.signature == R"({"*":"*"})");
+    REQUIRE(resp.meta.metrics.has_value());
+    CHECK(resp.meta.metrics->result_count == 3);
+  }
+
+  SECTION("truncated body")
+  {
+    couchbase::core::io::http_response encoded{};
+    encoded.status_code = 200;
+    encoded.body.append(R"({"requestID": "42", "results": [{"a": 1},)");
+
+    auto resp = req.make_response({}, encoded);
+    CHECK(resp.ctx.ec == couchbase::errc::common::parsing_failure);
+  }
+}
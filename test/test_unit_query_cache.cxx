@@ -0,0 +1,249 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/query_cache.hxx"
+#include "core/metrics/constants.hxx"
+#include "core/metrics/logging_meter.hxx"
+#include "core/utils/json.hxx"
+
+#include <couchbase/metrics/meter.hxx>
+
+#include <asio/io_context.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+using couchbase::core::query_cache;
+
+class counting_recorder : public couchbase::metrics::value_recorder
+{
+public:
+  void record_value(std::int64_t value) override
+  {
+    total += value;
+  }
+
+  std::atomic_int64_t total{ 0 };
+};
+
+class counting_meter : public couchbase::metrics::meter
+{
+public:
+  auto get_value_recorder(const std::string& name,
+                          const std::map<std::string, std::string>& /* tags */)
+    -> std::shared_ptr<couchbase::metrics::value_recorder> override
+  {
+    auto& recorder = recorders[name];
+    if (!recorder) {
+      recorder = std::make_shared<counting_recorder>();
+    }
+    return recorder;
+  }
+
+  std::map<std::string, std::shared_ptr<counting_recorder>> recorders{};
+};
+
+auto
+statement(std::size_t index) -> std::string
+{
+  return "SELECT * FROM `default` WHERE id = " + std::to_string(index);
+}
+} // namespace
+
+TEST_CASE("unit: query_cache stores and erases prepared statements", "[unit]")
+{
+  query_cache cache;
+
+  CHECK_FALSE(cache.get(statement(1)).has_value());
+
+  cache.put(statement(1), "prepared-1");
+  cache.put(statement(2), "prepared-2", "encoded-plan-2");
+
+  auto entry = cache.get(statement(1));
+  REQUIRE(entry.has_value());
+  CHECK(entry->name == "prepared-1");
+  CHECK_FALSE(entry->plan.has_value());
+
+  entry = cache.get(statement(2));
+  REQUIRE(entry.has_value());
+  CHECK(entry->name == "prepared-2");
+  CHECK(entry->plan == "encoded-plan-2");
+
+  // existing entries are not replaced
+  cache.put(statement(1), "prepared-1-again");
+  CHECK(cache.get(statement(1))->name == "prepared-1");
+
+  cache.erase(statement(1));
+  CHECK_FALSE(cache.get(statement(1)).has_value());
+  CHECK(cache.get(statement(2)).has_value());
+
+  auto stats = cache.collect_stats();
+  CHECK(stats.hits == 4);
+  CHECK(stats.misses == 2);
+  CHECK(stats.evictions == 0);
+  CHECK(stats.entries == 1);
+}
+
+TEST_CASE("unit: query_cache evicts least recently used statements", "[unit]")
+{
+  SECTION("entries limit")
+  {
+    query_cache cache(query_cache::number_of_shards * 4, 0);
+    for (std::size_t i = 0; i < 1'000; ++i) {
+      cache.put(statement(i), "prepared");
+      // keep the first statement hot
+      CHECK(cache.get(statement(0)).has_value());
+    }
+    auto stats = cache.collect_stats();
+    CHECK(stats.entries <= query_cache::number_of_shards * 4);
+    CHECK(stats.evictions == 1'000 - stats.entries);
+    CHECK(cache.get(statement(0)).has_value());
+    CHECK(cache.get(statement(999)).has_value());
+  }
+
+  SECTION("bytes limit")
+  {
+    const std::string plan(1'000, 'p');
+    query_cache cache(0, query_cache::number_of_shards * 10'000);
+    for (std::size_t i = 0; i < 1'000; ++i) {
+      cache.put(statement(i), "prepared", plan);
+    }
+    auto stats = cache.collect_stats();
+    CHECK(stats.bytes <= query_cache::number_of_shards * 10'000);
+    CHECK(stats.evictions == 1'000 - stats.entries);
+  }
+
+  SECTION("shrinking limits")
+  {
+    query_cache cache;
+    for (std::size_t i = 0; i < 100; ++i) {
+      cache.put(statement(i), "prepared");
+    }
+    CHECK(cache.collect_stats().entries == 100);
+    cache.set_limits(query_cache::number_of_shards, 0);
+    auto stats = cache.collect_stats();
+    CHECK(stats.entries <= query_cache::number_of_shards);
+    CHECK(stats.evictions == 100 - stats.entries);
+  }
+}
+
+TEST_CASE("unit: query_cache reports to the meter", "[unit]")
+{
+  auto meter = std::make_shared<counting_meter>();
+  query_cache cache(query_cache::number_of_shards, 0);
+  cache.set_meter(meter);
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    cache.put(statement(i), "prepared");
+    cache.get(statement(i));
+    cache.get(statement(i + 1'000));
+  }
+
+  const auto stats = cache.collect_stats();
+  CHECK(meter->recorders[couchbase::core::metrics::query_cache_hits_meter_name]->total == 100);
+  CHECK(meter->recorders[couchbase::core::metrics::query_cache_misses_meter_name]->total == 100);
+  CHECK(meter->recorders[couchbase::core::metrics::query_cache_evictions_meter_name]->total ==
+        static_cast<std::int64_t>(stats.evictions));
+}
+
+TEST_CASE("unit: query_cache reports to the logging meter", "[unit]")
+{
+  asio::io_context ctx{};
+  auto meter = std::make_shared<couchbase::core::metrics::logging_meter>(
+    ctx, couchbase::core::metrics::logging_meter_options{});
+  query_cache cache(query_cache::number_of_shards, 0);
+  cache.set_meter(meter);
+
+  for (std::size_t i = 0; i < 100; ++i) {
+    cache.put(statement(i), "prepared");
+    cache.get(statement(i));
+    cache.get(statement(i + 1'000));
+  }
+
+  const auto stats = cache.collect_stats();
+  auto output = meter->flush_and_create_output();
+  REQUIRE(output.has_value());
+  const auto report = couchbase::core::utils::json::parse(output.value());
+  const auto& counters = report.at("counters");
+  CHECK(counters.at(couchbase::core::metrics::query_cache_hits_meter_name).as<std::int64_t>() ==
+        100);
+  CHECK(counters.at(couchbase::core::metrics::query_cache_misses_meter_name).as<std::int64_t>() ==
+        100);
+  CHECK(
+    counters.at(couchbase::core::metrics::query_cache_evictions_meter_name).as<std::int64_t>() ==
+    static_cast<std::int64_t>(stats.evictions));
+
+  // the counters are reported per emit interval
+  output = meter->flush_and_create_output();
+  REQUIRE(output.has_value());
+  CHECK(couchbase::core::utils::json::parse(output.value())
+          .at("counters")
+          .at(couchbase::core::metrics::query_cache_hits_meter_name)
+          .as<std::int64_t>() == 0);
+}
+
+TEST_CASE("unit: query_cache lookups from multiple threads", "[unit]")
+{
+  const std::size_t number_of_threads = std::max(4U, std::thread::hardware_concurrency());
+  const std::size_t number_of_statements = 256;
+  const std::size_t lookups_per_thread = 10'000;
+
+  auto meter = std::make_shared<counting_meter>();
+  query_cache cache;
+  cache.set_meter(meter);
+  for (std::size_t i = 0; i < number_of_statements; ++i) {
+    cache.put(statement(i), "prepared-" + std::to_string(i), "encoded-plan");
+  }
+
+  // assertions are not thread-safe, so the workers only count the results
+  std::atomic_size_t found{ 0 };
+  std::atomic_size_t mismatched{ 0 };
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < number_of_threads; ++t) {
+    threads.emplace_back([&, t] {
+      for (std::size_t i = 0; i < lookups_per_thread; ++i) {
+        const auto index = (t + i) % number_of_statements;
+        if (auto entry = cache.get(statement(index)); entry) {
+          found.fetch_add(1, std::memory_order_relaxed);
+          if (entry->name != "prepared-" + std::to_string(index) ||
+              entry->plan != "encoded-plan") {
+            mismatched.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto lookups = number_of_threads * lookups_per_thread;
+  CHECK(found == lookups);
+  CHECK(mismatched == 0);
+  CHECK(cache.collect_stats().hits == lookups);
+  CHECK(meter->recorders[couchbase::core::metrics::query_cache_hits_meter_name]->total ==
+        static_cast<std::int64_t>(lookups));
+}
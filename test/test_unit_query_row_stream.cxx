@@ -0,0 +1,226 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/impl/internal_query_row_stream.hxx"
+#include "core/utils/binary.hxx"
+
+#include <couchbase/error_codes.hxx>
+#include <couchbase/query_row_stream.hxx>
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace
+{
+auto
+to_string(const couchbase::codec::binary& row) -> std::string
+{
+  return { reinterpret_cast<const char*>(row.data()), row.size() };
+}
+
+struct opened_stream {
+  bool opened{ false };
+  couchbase::error err{};
+  couchbase::query_row_stream stream{};
+};
+
+auto
+open_stream(std::size_t high_watermark, const std::shared_ptr<opened_stream>& result)
+  -> std::shared_ptr<couchbase::internal_query_row_stream>
+{
+  auto internal = std::make_shared<couchbase::internal_query_row_stream>(high_watermark);
+  internal->on_open([result](auto err, auto stream) {
+    result->opened = true;
+    result->err = std::move(err);
+    result->stream = std::move(stream);
+  });
+  return internal;
+}
+} // namespace
+
+TEST_CASE("unit: query row stream delivers rows and metadata", "[unit]")
+{
+  auto result = std::make_shared<opened_stream>();
+  auto internal = open_stream(16, result);
+  REQUIRE_FALSE(result->opened);
+
+  REQUIRE(internal->on_row(R"({"id":1})") ==
+          couchbase::core::utils::json::stream_control::next_row);
+  REQUIRE(result->opened);
+  REQUIRE_FALSE(result->err);
+
+  std::optional<std::string> row{};
+  result->stream.next_row([&row](auto err, auto value) {
+    REQUIRE_FALSE(err);
+    REQUIRE(value.has_value());
+    row = to_string(value.value());
+  });
+  REQUIRE(row == R"({"id":1})");
+
+  // the handler waits for the next row
+  std::vector<std::string> batch{};
+  bool batch_delivered = false;
+  result->stream.next_rows(10, [&](auto err, auto rows) {
+    REQUIRE_FALSE(err);
+    for (const auto& r : rows) {
+      batch.emplace_back(to_string(r));
+    }
+    batch_delivered = true;
+  });
+  REQUIRE_FALSE(batch_delivered);
+  internal->on_row(R"({"id":2})");
+  REQUIRE(batch_delivered);
+  REQUIRE(batch == std::vector<std::string>{ R"({"id":2})" });
+
+  internal->on_row(R"({"id":3})");
+  REQUIRE_FALSE(result->stream.meta_data().has_value());
+  internal->on_complete({}, couchbase::query_meta_data{});
+  REQUIRE(result->stream.meta_data().has_value());
+
+  // buffered rows are still delivered after completion
+  auto [err, last] = result->stream.next_row().get();
+  REQUIRE_FALSE(err);
+  REQUIRE(last.has_value());
+  REQUIRE(to_string(last.value()) == R"({"id":3})");
+
+  auto [end_err, end] = result->stream.next_row().get();
+  REQUIRE_FALSE(end_err);
+  REQUIRE_FALSE(end.has_value());
+}
+
+TEST_CASE("unit: query row stream pauses reading when the consumer falls behind", "[unit]")
+{
+  auto result = std::make_shared<opened_stream>();
+  auto internal = open_stream(4, result);
+  const auto& flow_control = internal->flow_control();
+
+  int resumed = 0;
+  auto resume = [&resumed]() {
+    ++resumed;
+  };
+
+  for (int i = 0; i < 3; ++i) {
+    internal->on_row("{}");
+  }
+  REQUIRE(flow_control->wait_for_capacity(resume));
+  internal->on_row("{}");
+  REQUIRE_FALSE(flow_control->wait_for_capacity(resume));
+  REQUIRE(resumed == 0);
+
+  // draining to the low watermark (half of the high one) resumes reading
+  REQUIRE(result->stream.next_rows(1).get().second.size() == 1);
+  REQUIRE(resumed == 0);
+  REQUIRE(result->stream.next_rows(1).get().second.size() == 1);
+  REQUIRE(resumed == 1);
+  REQUIRE(flow_control->wait_for_capacity(resume));
+
+  auto [err, rows] = result->stream.next_rows(100).get();
+  REQUIRE_FALSE(err);
+  REQUIRE(rows.size() == 2);
+}
+
+TEST_CASE("unit: query row stream reports errors", "[unit]")
+{
+  SECTION("query fails before the first row")
+  {
+    auto result = std::make_shared<opened_stream>();
+    auto internal = open_stream(4, result);
+    internal->on_complete(couchbase::error{ couchbase::errc::common::parsing_failure },
+                          couchbase::query_meta_data{});
+    REQUIRE(result->opened);
+    REQUIRE(result->err.ec() == couchbase::errc::common::parsing_failure);
+    auto [err, row] = result->stream.next_row().get();
+    REQUIRE(err.ec() == couchbase::errc::common::parsing_failure);
+    REQUIRE_FALSE(row.has_value());
+  }
+
+  SECTION("concurrent requests for rows")
+  {
+    auto result = std::make_shared<opened_stream>();
+    auto internal = open_stream(4, result);
+    internal->on_row("{}");
+    result->stream.next_row().get();
+    auto pending = result->stream.next_row();
+    auto [err, row] = result->stream.next_row().get();
+    REQUIRE(err.ec() == couchbase::errc::common::invalid_argument);
+    internal->on_complete({}, couchbase::query_meta_data{});
+    REQUIRE_FALSE(pending.get().second.has_value());
+  }
+
+  SECTION("cancelled stream stops the lexer and unblocks the reader")
+  {
+    auto result = std::make_shared<opened_stream>();
+    auto internal = open_stream(1, result);
+    internal->on_row("{}");
+    bool resumed = false;
+    REQUIRE_FALSE(internal->flow_control()->wait_for_capacity([&resumed]() {
+      resumed = true;
+    }));
+    result->stream.cancel();
+    REQUIRE(resumed);
+    REQUIRE(internal->flow_control()->is_cancelled());
+    REQUIRE(internal->on_row("{}") == couchbase::core::utils::json::stream_control::stop);
+  }
+
+  SECTION("cancelled stream completes the waiting reader once")
+  {
+    auto result = std::make_shared<opened_stream>();
+    auto internal = open_stream(4, result);
+    internal->on_row("{}");
+    result->stream.next_row().get();
+
+    int invocations = 0;
+    couchbase::error pending_err{};
+    result->stream.next_rows(10, [&](auto err, auto rows) {
+      ++invocations;
+      pending_err = std::move(err);
+      REQUIRE(rows.empty());
+    });
+    REQUIRE(invocations == 0);
+    result->stream.cancel();
+    REQUIRE(invocations == 1);
+    REQUIRE(pending_err.ec() == couchbase::errc::common::request_canceled);
+
+    result->stream.cancel();
+    internal->on_complete({}, couchbase::query_meta_data{});
+    REQUIRE(invocations == 1);
+
+    auto [err, row] = result->stream.next_row().get();
+    REQUIRE(err.ec() == couchbase::errc::common::request_canceled);
+    REQUIRE_FALSE(row.has_value());
+  }
+}
+
+TEST_CASE("unit: query row stream that has not been opened", "[unit]")
+{
+  couchbase::query_row_stream stream{};
+  REQUIRE_FALSE(stream.meta_data().has_value());
+
+  auto [err, row] = stream.next_row().get();
+  REQUIRE(err.ec() == couchbase::errc::common::request_canceled);
+  REQUIRE_FALSE(row.has_value());
+
+  auto [batch_err, rows] = stream.next_rows(10).get();
+  REQUIRE(batch_err.ec() == couchbase::errc::common::request_canceled);
+  REQUIRE(rows.empty());
+
+  stream.cancel();
+}
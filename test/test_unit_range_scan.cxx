@@ -17,9 +17,13 @@
 
 #include "test_helper_integration.hxx"
 
+#include "core/range_scan_concurrency_controller.hxx"
 #include "core/range_scan_load_balancer.hxx"
 #include "core/topology/configuration.hxx"
 
+#include <algorithm>
+#include <chrono>
+
 TEST_CASE("unit: range scan load balancer", "[unit]")
 {
   // Create a vbucket map with 6 vbuckets distributed evenly across 3 nodes
@@ -104,3 +108,102 @@ TEST_CASE("unit: range scan load balancer", "[unit]")
     REQUIRE_FALSE(balancer.select_vbucket().has_value());
   }
 }
+
+TEST_CASE("unit: range scan load balancer with adaptive concurrency", "[unit]")
+{
+  std::vector<std::int16_t> vbucket_nodes{ 0, 0, 1, 1, 2, 2 };
+  couchbase::core::range_scan_load_balancer balancer{ {
+    { 0 },
+    { 0 },
+    { 1 },
+    { 1 },
+    { 2 },
+    { 2 },
+  } };
+  balancer.enable_adaptive_concurrency(3, 4);
+  REQUIRE(balancer.concurrency_limit(0) == 1);
+  REQUIRE(balancer.concurrency_limit(1) == 1);
+  REQUIRE(balancer.concurrency_limit(2) == 1);
+
+  // one stream per node is allowed initially
+  std::set<std::int16_t> nodes{};
+  for (auto i = 0; i < 3; i++) {
+    auto v = balancer.select_vbucket();
+    REQUIRE(v.has_value());
+    auto [_, inserted] = nodes.insert(vbucket_nodes[v.value()]);
+    REQUIRE(inserted);
+  }
+  REQUIRE_FALSE(balancer.select_vbucket().has_value());
+
+  balancer.notify_stream_ended(1);
+  auto v = balancer.select_vbucket();
+  REQUIRE(v.has_value());
+  REQUIRE(vbucket_nodes[v.value()] == 1);
+
+  // a fast batch raises the limit of the node
+  balancer.notify_batch_completed(2, std::chrono::milliseconds{ 1 }, 100);
+  REQUIRE(balancer.concurrency_limit(2) == 2);
+  v = balancer.select_vbucket();
+  REQUIRE(v.has_value());
+  REQUIRE(vbucket_nodes[v.value()] == 2);
+
+  balancer.notify_busy(2);
+  REQUIRE(balancer.concurrency_limit(2) == 1);
+}
+
+TEST_CASE("unit: range scan concurrency controller", "[unit]")
+{
+  using couchbase::core::range_scan_concurrency_controller;
+
+  SECTION("limit follows the capacity of the node")
+  {
+    // the node serves 4 batches in parallel, further batches are queued
+    constexpr std::uint16_t node_capacity{ 4 };
+    const auto latency_for = [](std::uint16_t concurrency) {
+      const auto queued = (concurrency + node_capacity - 1) / node_capacity;
+      return std::chrono::milliseconds{ 10 } * std::max(1, queued);
+    };
+
+    range_scan_concurrency_controller controller{ 1, 32 };
+    std::uint16_t max_seen{ 0 };
+    for (auto round = 0; round < 200; ++round) {
+      const auto limit = controller.limit();
+      for (std::uint16_t batch = 0; batch < limit; ++batch) {
+        controller.record_batch(latency_for(limit), 100);
+      }
+      if (round > 50) {
+        max_seen = std::max(max_seen, controller.limit());
+        REQUIRE(controller.limit() >= node_capacity - 1);
+      }
+    }
+    REQUIRE(max_seen <= node_capacity + 1);
+  }
+
+  SECTION("limit stays within bounds")
+  {
+    range_scan_concurrency_controller controller{ 0, 3 };
+    REQUIRE(controller.limit() == 1);
+    for (auto i = 0; i < 100; ++i) {
+      controller.record_batch(std::chrono::milliseconds{ 1 }, 10);
+    }
+    REQUIRE(controller.limit() == 3);
+
+    controller.record_busy();
+    REQUIRE(controller.limit() == 1);
+    controller.record_busy();
+    REQUIRE(controller.limit() == 1);
+  }
+
+  SECTION("growing latency lowers the limit")
+  {
+    range_scan_concurrency_controller controller{ 8, 8 };
+    for (auto i = 0; i < 8; ++i) {
+      controller.record_batch(std::chrono::milliseconds{ 1 }, 10);
+    }
+    REQUIRE(controller.limit() == 8);
+    for (auto i = 0; i < 8; ++i) {
+      controller.record_batch(std::chrono::milliseconds{ 10 }, 10);
+    }
+    REQUIRE(controller.limit() == 6);
+  }
+}
@@ -0,0 +1,88 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/crypto/cbcrypto.h"
+#include "core/platform/base64.h"
+#include "core/sasl/scram-sha/salted_password_cache.h"
+
+#include <string>
+
+using couchbase::core::crypto::Algorithm;
+using couchbase::core::sasl::Mechanism;
+using couchbase::core::sasl::mechanism::scram::derive_keys;
+using couchbase::core::sasl::mechanism::scram::salted_password_cache;
+
+TEST_CASE("unit: SCRAM derived keys match RFC 5802 example", "[unit]")
+{
+  const auto salt = couchbase::core::base64::decode_to_string("QSXCR+Q6sek8bf92");
+  const auto keys = derive_keys(Algorithm::ALG_SHA1, "pencil", salt, 4096);
+
+  const std::string auth_message = "n=user,r=fyko+d2lbbFgONRv9qkxdawL,"
+                                   "r=fyko+d2lbbFgONRv9qkxdawL3rfcNHYJY1ZVvWVs7j,"
+                                   "s=QSXCR+Q6sek8bf92,i=4096,"
+                                   "c=biws,r=fyko+d2lbbFgONRv9qkxdawL3rfcNHYJY1ZVvWVs7j";
+
+  auto client_signature =
+    couchbase::core::crypto::CBC_HMAC(Algorithm::ALG_SHA1, keys.stored_key, auth_message);
+  std::string proof(keys.client_key.size(), '\0');
+  for (std::size_t i = 0; i < proof.size(); ++i) {
+    proof[i] = static_cast<char>(keys.client_key[i] ^ client_signature[i]);
+  }
+  REQUIRE(couchbase::core::base64::encode(proof) == "v0X8v3Bz2T0CJGbJQyF0X+HI4Ts=");
+
+  auto server_signature =
+    couchbase::core::crypto::CBC_HMAC(Algorithm::ALG_SHA1, keys.server_key, auth_message);
+  REQUIRE(couchbase::core::base64::encode(server_signature) == "rmF9pqV8S7suAoZWja4dJRkFsKQ=");
+}
+
+TEST_CASE("unit: SCRAM salted password cache", "[unit]")
+{
+  salted_password_cache cache{};
+
+  const auto keys =
+    cache.get(Mechanism::SCRAM_SHA512, Algorithm::ALG_SHA512, "alice", "secret", "salt", 4096);
+  REQUIRE(keys);
+  REQUIRE(keys->salted_password ==
+          couchbase::core::crypto::PBKDF2_HMAC(Algorithm::ALG_SHA512, "secret", "salt", 4096));
+  REQUIRE(cache.size() == 1);
+
+  // the next handshake of the same user reuses the keys
+  REQUIRE(cache.get(Mechanism::SCRAM_SHA512, Algorithm::ALG_SHA512, "alice", "secret", "salt",
+                    4096) == keys);
+  REQUIRE(cache.size() == 1);
+
+  // any difference in the server parameters derives new keys
+  REQUIRE(cache.get(Mechanism::SCRAM_SHA512, Algorithm::ALG_SHA512, "alice", "secret", "pepper",
+                    4096) != keys);
+  REQUIRE(cache.get(Mechanism::SCRAM_SHA512, Algorithm::ALG_SHA512, "alice", "secret", "salt",
+                    10000) != keys);
+  REQUIRE(cache.get(Mechanism::SCRAM_SHA256, Algorithm::ALG_SHA256, "alice", "secret", "salt",
+                    4096) != keys);
+  REQUIRE(cache.size() == 4);
+
+  // updated credentials replace the entry
+  const auto updated = cache.get(
+    Mechanism::SCRAM_SHA512, Algorithm::ALG_SHA512, "alice", "new secret", "salt", 4096);
+  REQUIRE(updated != keys);
+  REQUIRE(updated->salted_password != keys->salted_password);
+  REQUIRE(cache.size() == 4);
+
+  cache.clear();
+  REQUIRE(cache.size() == 0);
+}
@@ -450,6 +450,26 @@ TEST_CASE("unit: vector query", "[unit]")
 )"_json);
 }
 
+TEST_CASE("unit: float vector query", "[unit]")
+{
+  //! [float-vector-query]
+  auto query = couchbase::vector_query("foo", std::vector<float>{ 0.5F, -2.5F, 0.15625F })
+                 .boost(0.5)
+                 .num_candidates(4);
+  //! [float-vector-query]
+  const auto encoded = query.encode();
+  REQUIRE_FALSE(encoded.ec);
+
+  REQUIRE(encoded.query == R"(
+{
+    "boost": 0.5,
+    "field": "foo",
+    "k": 4,
+    "vector_base64": "AAAAPwAAIMAAACA+"
+}
+)"_json);
+}
+
 TEST_CASE("unit: base64 vector query", "[unit]")
 {
   //! [base64-vector-query]
@@ -0,0 +1,128 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/io/timer_wheel.hxx"
+
+#include <asio/error.hpp>
+#include <asio/io_context.hpp>
+#include <asio/steady_timer.hpp>
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using couchbase::core::io::timer_wheel;
+using couchbase::core::io::wheel_timer;
+
+TEST_CASE("unit: wheel_timer fires after expiry", "[unit]")
+{
+  asio::io_context ctx;
+  const auto start = std::chrono::steady_clock::now();
+
+  std::vector<std::chrono::milliseconds> delays{
+    std::chrono::milliseconds{ 30 },
+    std::chrono::milliseconds{ 10 },
+    std::chrono::milliseconds{ 20 },
+    std::chrono::milliseconds{ 5 },
+  };
+  std::vector<std::unique_ptr<wheel_timer>> timers;
+  std::vector<std::chrono::milliseconds> fired;
+  for (const auto delay : delays) {
+    auto& timer = timers.emplace_back(std::make_unique<wheel_timer>(ctx));
+    timer->expires_after(delay);
+    CHECK(timer->expiry() >= start + delay);
+    timer->async_wait([&fired, &start, delay](std::error_code ec) {
+      REQUIRE_FALSE(ec);
+      CHECK(std::chrono::steady_clock::now() - start >= delay);
+      fired.push_back(delay);
+    });
+  }
+  CHECK(timer_wheel::of(ctx).size() == delays.size());
+
+  ctx.run();
+
+  CHECK(fired == std::vector<std::chrono::milliseconds>{
+                   std::chrono::milliseconds{ 5 },
+                   std::chrono::milliseconds{ 10 },
+                   std::chrono::milliseconds{ 20 },
+                   std::chrono::milliseconds{ 30 },
+                 });
+  CHECK(timer_wheel::of(ctx).size() == 0);
+}
+
+TEST_CASE("unit: wheel_timer aborts cancelled waits", "[unit]")
+{
+  asio::io_context ctx;
+
+  wheel_timer timer(ctx);
+  std::vector<std::error_code> results;
+
+  SECTION("cancel")
+  {
+    timer.expires_after(std::chrono::seconds{ 10 });
+    timer.async_wait([&results](std::error_code ec) {
+      results.push_back(ec);
+    });
+    CHECK(timer.cancel() == 1);
+    CHECK(timer.cancel() == 0);
+    ctx.run();
+    REQUIRE(results.size() == 1);
+    CHECK(results[0] == asio::error::operation_aborted);
+  }
+
+  SECTION("changing expiry")
+  {
+    timer.expires_after(std::chrono::seconds{ 10 });
+    timer.async_wait([&results](std::error_code ec) {
+      results.push_back(ec);
+    });
+    timer.expires_after(std::chrono::milliseconds{ 10 });
+    timer.async_wait([&results](std::error_code ec) {
+      results.push_back(ec);
+    });
+    ctx.run();
+    REQUIRE(results.size() == 2);
+    CHECK(results[0] == asio::error::operation_aborted);
+    CHECK_FALSE(results[1]);
+  }
+}
+
+TEST_CASE("unit: timer_wheel releases pending handlers on shutdown", "[unit]")
+{
+  struct command {
+    explicit command(asio::io_context& ctx)
+      : deadline{ ctx }
+    {
+    }
+
+    wheel_timer deadline;
+  };
+
+  auto ctx = std::make_unique<asio::io_context>();
+  auto cmd = std::make_shared<command>(*ctx);
+  cmd->deadline.expires_after(std::chrono::seconds{ 10 });
+  cmd->deadline.async_wait([cmd](std::error_code /* ec */) {
+  });
+  std::weak_ptr<command> weak_cmd = cmd;
+  cmd.reset();
+  CHECK_FALSE(weak_cmd.expired());
+
+  ctx.reset();
+  CHECK(weak_cmd.expired());
+}
@@ -0,0 +1,142 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/cluster_label_listener.hxx"
+#include "core/tracing/constants.hxx"
+#include "core/tracing/threshold_logging_options.hxx"
+#include "core/tracing/threshold_logging_tracer.hxx"
+#include "core/tracing/tracer_wrapper.hxx"
+#include "core/utils/json.hxx"
+#include "core/utils/thread_local_pool_allocator.hxx"
+
+#include <asio/io_context.hpp>
+#include <tao/json/value.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("unit: thread_local_pool_allocator reuses released blocks", "[unit]")
+{
+  struct payload {
+    std::uint64_t a{};
+    std::uint64_t b{};
+  };
+  couchbase::core::utils::thread_local_pool_allocator<payload, 4> allocator{};
+
+  auto* first = allocator.allocate(1);
+  allocator.deallocate(first, 1);
+  auto* second = allocator.allocate(1);
+  REQUIRE(first == second);
+  allocator.deallocate(second, 1);
+
+  // blocks released by other threads are cached by those threads
+  std::thread([&allocator]() {
+    auto* block = allocator.allocate(1);
+    allocator.deallocate(block, 1);
+  }).join();
+
+  auto shared = std::allocate_shared<payload>(allocator, payload{ 1, 2 });
+  REQUIRE(shared->a == 1);
+  REQUIRE(shared->b == 2);
+}
+
+TEST_CASE("unit: threshold_logging_tracer reports spans from multiple threads", "[unit]")
+{
+  asio::io_context ctx{};
+  const auto number_of_threads =
+    std::max(std::size_t{ 2 }, std::size_t{ std::thread::hardware_concurrency() });
+  constexpr std::size_t queries_per_thread{ 2 };
+  constexpr std::size_t gets_per_thread{ 1'000 };
+
+  couchbase::core::tracing::threshold_logging_options options{};
+  options.threshold_sample_size = number_of_threads * queries_per_thread;
+  options.key_value_threshold = std::chrono::milliseconds::zero();
+  options.query_threshold = std::chrono::milliseconds::zero();
+  auto tracer = std::make_shared<couchbase::core::tracing::threshold_logging_tracer>(ctx, options);
+  auto wrapper = couchbase::core::tracing::tracer_wrapper::create(
+    tracer, std::make_shared<couchbase::core::cluster_label_listener>());
+
+  std::vector<std::thread> threads{};
+  threads.reserve(number_of_threads);
+  for (std::size_t t = 0; t < number_of_threads; ++t) {
+    threads.emplace_back([&wrapper]() {
+      for (std::size_t i = 0; i < queries_per_thread; ++i) {
+        auto span = wrapper->create_span("query", nullptr);
+        span->add_tag(couchbase::core::tracing::attributes::op::service,
+                      couchbase::core::tracing::service::query);
+        std::this_thread::sleep_for(std::chrono::milliseconds{ 1 });
+        span->end();
+      }
+      for (std::size_t i = 0; i < gets_per_thread; ++i) {
+        auto span = wrapper->create_span("get", nullptr);
+        span->add_tag(couchbase::core::tracing::attributes::op::service,
+                      couchbase::core::tracing::service::key_value);
+        auto dispatch =
+          wrapper->create_span(couchbase::core::tracing::operation::step_dispatch, span);
+        dispatch->add_tag(couchbase::core::tracing::attributes::dispatch::local_id,
+                          "66388CF5BFCF7522/18CC8791579B567C");
+        dispatch->add_tag(couchbase::core::tracing::attributes::dispatch::server_duration, 10);
+        dispatch->end();
+        span->end();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  std::map<std::string, tao::json::value> reports{};
+  for (const auto& output : tracer->flush_and_create_output()) {
+    auto report = couchbase::core::utils::json::parse(output);
+    reports.try_emplace(report.at("service").get_string(), std::move(report));
+  }
+  REQUIRE(reports.size() == 2);
+
+  // every query exceeded the threshold, and all of them fit into the sample
+  const auto& query = reports.at("query");
+  REQUIRE(query.at("count").as<std::size_t>() == number_of_threads * queries_per_thread);
+  REQUIRE(query.at("top").get_array().size() == number_of_threads * queries_per_thread);
+  for (const auto& entry : query.at("top").get_array()) {
+    REQUIRE(entry.at("operation_name").get_string() == "query");
+    REQUIRE(entry.at("total_duration_us").as<std::int64_t>() >= 1'000);
+  }
+
+  // only the slowest of the key/value operations are kept, the slowest first
+  const auto& get = reports.at("kv");
+  REQUIRE(get.at("count").as<std::size_t>() == options.threshold_sample_size);
+  const auto& top = get.at("top").get_array();
+  REQUIRE(top.size() == options.threshold_sample_size);
+  for (std::size_t i = 0; i < top.size(); ++i) {
+    REQUIRE(top[i].at("operation_name").get_string() == "get");
+    REQUIRE(top[i].at("last_local_id").get_string() == "66388CF5BFCF7522/18CC8791579B567C");
+    REQUIRE(top[i].at("last_server_duration_us").as<std::uint64_t>() == 10);
+    if (i > 0) {
+      REQUIRE(top[i - 1].at("total_duration_us").as<std::int64_t>() >=
+              top[i].at("total_duration_us").as<std::int64_t>());
+    }
+  }
+
+  // the report takes the spans out of the tracer
+  REQUIRE(tracer->flush_and_create_output().empty());
+}
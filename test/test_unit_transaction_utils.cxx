@@ -16,14 +16,22 @@
 
 #include "test_helper.hxx"
 
+#include "core/transactions/internal/atr_entry.hxx"
 #include "core/transactions/internal/exceptions_internal.hxx"
+#include "core/transactions/internal/known_atrs.hxx"
+#include "core/transactions/internal/unstaging_pipeline.hxx"
 #include "core/transactions/internal/utils.hxx"
 
 #include <core/transactions/transaction_get_result.hxx>
 #include <couchbase/transactions/transaction_get_result.hxx>
 
+#include <future>
 #include <iostream>
 #include <limits>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <stdexcept>
 #include <thread>
 
 #if defined(__GNUC__)
@@ -365,3 +373,240 @@ TEST_CASE("transaction_get_result: can convert core transaction_get_result to "
     REQUIRE(final_public_res.id().empty());
   }
 }
+
+TEST_CASE("unstaging: mutations grouped into lanes by node and vbucket", "[unit]")
+{
+  const std::vector<unstaging_placement> placements{
+    { 0, 1, 10 }, { 0, 0, 7 }, { 0, 1, 3 }, { 1, 1, 3 }, { 0, 0, 7 }, { 0, 0, 2 },
+  };
+  const auto lanes = unstaging_lanes(placements);
+  REQUIRE(lanes.size() == 3);
+  REQUIRE(lanes[0] == std::vector<std::size_t>{ 5, 1, 4 });
+  REQUIRE(lanes[1] == std::vector<std::size_t>{ 2, 0 });
+  REQUIRE(lanes[2] == std::vector<std::size_t>{ 3 });
+
+  REQUIRE(unstaging_lanes({}).empty());
+}
+
+TEST_CASE("unstaging: pipeline respects the window", "[unit]")
+{
+  std::vector<std::vector<std::size_t>> lanes{ { 0, 2, 4 }, { 1, 3 } };
+  std::vector<unstaging_pipeline::done_handler> pending{};
+  std::vector<std::size_t> started{};
+  std::optional<std::exception_ptr> result{};
+
+  auto pipeline = std::make_shared<unstaging_pipeline>(
+    lanes,
+    2,
+    [&](std::size_t index, unstaging_pipeline::done_handler&& done) {
+      started.push_back(index);
+      pending.emplace_back(std::move(done));
+    },
+    [&](std::exception_ptr exc) {
+      result = exc;
+    });
+  pipeline->start();
+
+  // lanes are interleaved, and only two mutations are in flight
+  REQUIRE(started == std::vector<std::size_t>{ 0, 1 });
+  while (!pending.empty()) {
+    REQUIRE_FALSE(result.has_value());
+    auto done = std::move(pending.front());
+    pending.erase(pending.begin());
+    done({});
+    REQUIRE(pending.size() <= 2);
+  }
+  REQUIRE(started == std::vector<std::size_t>{ 0, 1, 2, 3, 4 });
+  REQUIRE(result.has_value());
+  REQUIRE_FALSE(result.value());
+}
+
+TEST_CASE("unstaging: pipeline stops after the first error", "[unit]")
+{
+  std::vector<unstaging_pipeline::done_handler> pending{};
+  std::size_t started{ 0 };
+  std::optional<std::exception_ptr> result{};
+
+  auto pipeline = std::make_shared<unstaging_pipeline>(
+    std::vector<std::vector<std::size_t>>{ { 0, 1, 2, 3, 4, 5 } },
+    3,
+    [&](std::size_t /* index */, unstaging_pipeline::done_handler&& done) {
+      ++started;
+      pending.emplace_back(std::move(done));
+    },
+    [&](std::exception_ptr exc) {
+      result = exc;
+    });
+  pipeline->start();
+  REQUIRE(started == 3);
+
+  pending[1](std::make_exception_ptr(std::runtime_error("first")));
+  pending[0](std::make_exception_ptr(std::runtime_error("second")));
+  REQUIRE(started == 3);
+  REQUIRE_FALSE(result.has_value());
+
+  // the callback waits for the in-flight mutation
+  pending[2]({});
+  REQUIRE(result.has_value());
+  REQUIRE_THROWS_WITH(std::rethrow_exception(result.value()), "first");
+}
+
+TEST_CASE("unstaging: pipeline with synchronous and concurrent completions", "[unit]")
+{
+  constexpr std::size_t number_of_mutations{ 5000 };
+
+  SECTION("synchronous")
+  {
+    std::size_t started{ 0 };
+    bool completed{ false };
+    auto pipeline = std::make_shared<unstaging_pipeline>(
+      std::vector<std::vector<std::size_t>>{ std::vector<std::size_t>(number_of_mutations) },
+      1,
+      [&](std::size_t /* index */, unstaging_pipeline::done_handler&& done) {
+        ++started;
+        done({});
+      },
+      [&](std::exception_ptr exc) {
+        REQUIRE_FALSE(exc);
+        completed = true;
+      });
+    pipeline->start();
+    REQUIRE(started == number_of_mutations);
+    REQUIRE(completed);
+  }
+
+  SECTION("from multiple threads")
+  {
+    std::vector<std::vector<std::size_t>> lanes(4);
+    for (std::size_t i = 0; i < number_of_mutations; ++i) {
+      lanes[i % lanes.size()].push_back(i);
+    }
+    std::mutex mutex;
+    std::set<std::size_t> seen{};
+    auto barrier = std::make_shared<std::promise<std::exception_ptr>>();
+    auto f = barrier->get_future();
+    auto pipeline = std::make_shared<unstaging_pipeline>(
+      lanes,
+      64,
+      [&](std::size_t index, unstaging_pipeline::done_handler&& done) {
+        {
+          const std::scoped_lock lock(mutex);
+          seen.insert(index);
+        }
+        if (index % 100 == 0) {
+          std::thread([done = std::move(done)]() mutable {
+            done({});
+          }).detach();
+        } else {
+          done({});
+        }
+      },
+      [barrier](std::exception_ptr exc) {
+        barrier->set_value(exc);
+      });
+    pipeline->start();
+    REQUIRE(f.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    REQUIRE_FALSE(f.get());
+    const std::scoped_lock lock(mutex);
+    REQUIRE(seen.size() == number_of_mutations);
+  }
+}
+
+namespace
+{
+// ATR entry of the attempt that started at start_ms, as seen in the ATR with the given CAS (the
+// CAS holds the time of the last ATR mutation in nanoseconds)
+auto
+make_atr_entry(std::optional<std::uint64_t> start_ms, std::uint64_t cas_ms) -> atr_entry
+{
+  return { "default", "_txn:atr-0-#0", "attempt-id", attempt_state::PENDING, start_ms, {}, {}, {},
+           {}, 100, {}, {}, {}, {}, cas_ms * 1'000'000, {} };
+}
+} // namespace
+
+TEST_CASE("atr_entry: time until the attempt expires", "[unit]")
+{
+  SECTION("not expired")
+  {
+    const auto entry = make_atr_entry(1'000, 1'050);
+    REQUIRE_FALSE(entry.has_expired());
+    REQUIRE(entry.time_until_expired() == chrono::milliseconds(51));
+
+    // the attempt expires as soon as the ATR is mutated after that time
+    REQUIRE_FALSE(make_atr_entry(1'000, 1'100).has_expired());
+    REQUIRE(make_atr_entry(1'000, 1'100).time_until_expired() == chrono::milliseconds(1));
+  }
+
+  SECTION("expired")
+  {
+    for (const std::uint64_t cas_ms : { 1'101U, 1'200U, 100'000U }) {
+      const auto entry = make_atr_entry(1'000, cas_ms);
+      REQUIRE(entry.has_expired());
+      REQUIRE(entry.time_until_expired() == chrono::milliseconds::zero());
+    }
+  }
+
+  SECTION("safety margin")
+  {
+    const auto entry = make_atr_entry(1'000, 1'200);
+    REQUIRE_FALSE(entry.has_expired(1'500));
+    REQUIRE(entry.time_until_expired(1'500) == chrono::milliseconds(1'401));
+    REQUIRE(make_atr_entry(1'000, 2'601).has_expired(1'500));
+    REQUIRE(make_atr_entry(1'000, 2'601).time_until_expired(1'500) ==
+            chrono::milliseconds::zero());
+  }
+
+  SECTION("clock skew")
+  {
+    // the clock of the client that started the attempt is ahead of the server
+    const auto entry = make_atr_entry(5'000, 1'000);
+    REQUIRE_FALSE(entry.has_expired());
+    REQUIRE(entry.time_until_expired() == chrono::milliseconds(4'101));
+    REQUIRE_FALSE(make_atr_entry(5'000, 5'100).has_expired());
+    REQUIRE(make_atr_entry(5'000, 5'101).has_expired());
+    REQUIRE(make_atr_entry(5'000, 5'101).time_until_expired() == chrono::milliseconds::zero());
+  }
+
+  SECTION("never expires without start time")
+  {
+    const auto entry = make_atr_entry({}, 100'000);
+    REQUIRE_FALSE(entry.has_expired());
+    REQUIRE_FALSE(entry.time_until_expired().has_value());
+  }
+}
+
+TEST_CASE("known_atrs: unchanged ATRs are only probed", "[unit]")
+{
+  const auto now = known_atrs::clock::now();
+  known_atrs known{};
+  REQUIRE_FALSE(known.cas_to_probe("_txn:atr-0-#0", now).has_value());
+
+  SECTION("until the earliest attempt expires")
+  {
+    known.remember("_txn:atr-0-#0", 42, chrono::milliseconds(50), now);
+    REQUIRE(known.cas_to_probe("_txn:atr-0-#0", now) == 42);
+    REQUIRE(known.cas_to_probe("_txn:atr-0-#0", now + chrono::milliseconds(49)) == 42);
+    REQUIRE_FALSE(known.cas_to_probe("_txn:atr-0-#0", now + chrono::milliseconds(50)).has_value());
+    REQUIRE_FALSE(known.cas_to_probe("_txn:atr-1-#0", now).has_value());
+  }
+
+  SECTION("forever without pending attempts")
+  {
+    known.remember("_txn:atr-0-#0", 42, {}, now);
+    REQUIRE(known.cas_to_probe("_txn:atr-0-#0", now + chrono::hours(24 * 365)) == 42);
+  }
+
+  SECTION("with the CAS of the last read")
+  {
+    known.remember("_txn:atr-0-#0", 42, chrono::milliseconds(50), now);
+    known.remember("_txn:atr-0-#0", 43, {}, now);
+    REQUIRE(known.cas_to_probe("_txn:atr-0-#0", now + chrono::milliseconds(50)) == 43);
+  }
+
+  SECTION("until the ATR is read again")
+  {
+    known.remember("_txn:atr-0-#0", 42, {}, now);
+    known.forget("_txn:atr-0-#0");
+    REQUIRE_FALSE(known.cas_to_probe("_txn:atr-0-#0", now).has_value());
+  }
+}
@@ -24,6 +24,8 @@
 #include "core/meta/version.hxx"
 #include "core/platform/base64.h"
 #include "core/utils/concurrent_fixed_priority_queue.hxx"
+#include "core/utils/concurrent_opaque_table.hxx"
+#include "core/utils/crc32.hxx"
 #include "core/utils/join_strings.hxx"
 #include "core/utils/json.hxx"
 #include "core/utils/movable_function.hxx"
@@ -37,6 +39,12 @@
 #include "include_ssl/crypto.h"
 #include <tao/json.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <random>
+#include <thread>
+
 TEST_CASE("unit: transformer to deduplicate JSON keys", "[unit]")
 {
   using Catch::Matchers::ContainsSubstring;
@@ -195,6 +203,24 @@ TEST_CASE("unit: base64", "[unit]")
   REQUIRE(couchbase::core::base64::encode(std::vector{ std::byte{ 255 } }, false) == "/w==");
   REQUIRE(couchbase::core::base64::encode(std::vector{ std::byte{ 255 } }, true) == "/w==\n");
 
+  SECTION("appending encoder agrees with pretty-printed one")
+  {
+    // cover vectorized blocks along with every remainder
+    std::vector<std::byte> blob{};
+    for (std::size_t size = 0; size < 200; ++size) {
+      auto pretty = couchbase::core::base64::encode(blob, true);
+      pretty.erase(std::remove(pretty.begin(), pretty.end(), '\n'), pretty.end());
+      REQUIRE(couchbase::core::base64::encode(blob, false) == pretty);
+
+      std::string appended{ "prefix:" };
+      couchbase::core::base64::encode_to(blob, appended);
+      REQUIRE(appended == "prefix:" + pretty);
+      REQUIRE(couchbase::core::base64::decode(appended.substr(7)) == blob);
+
+      blob.push_back(static_cast<std::byte>((size * 37 + 11) & 0xff));
+    }
+  }
+
   std::array binary{
     std::byte{ 0x00 }, std::byte{ 0x01 }, std::byte{ 0x02 }, std::byte{ 0x03 }, std::byte{ 0x04 },
     std::byte{ 0x05 }, std::byte{ 0x06 }, std::byte{ 0x07 }, std::byte{ 0x08 }, std::byte{ 0x09 },
@@ -353,6 +379,151 @@ TEST_CASE("unit: concurrent fixed queue", "[unit]")
   REQUIRE(queue.empty());
 }
 
+TEST_CASE("unit: concurrent opaque table", "[unit]")
+{
+  couchbase::core::utils::concurrent_opaque_table<std::string, 4> table{};
+
+  REQUIRE_FALSE(table.take(42).has_value());
+
+  SECTION("take returns value only once")
+  {
+    REQUIRE(table.try_emplace(1, "one"));
+    REQUIRE_FALSE(table.try_emplace(1, "uno"));
+    REQUIRE(table.take(1) == "one");
+    REQUIRE_FALSE(table.take(1).has_value());
+  }
+
+  SECTION("colliding opaques go to overflow")
+  {
+    REQUIRE(table.try_emplace(1, "one"));
+    REQUIRE(table.try_emplace(5, "five"));
+    REQUIRE(table.try_emplace(9, "nine"));
+    REQUIRE_FALSE(table.try_emplace(5, "cinco"));
+    REQUIRE_FALSE(table.take(13).has_value());
+    REQUIRE(table.take(5) == "five");
+    REQUIRE(table.take(1) == "one");
+    REQUIRE(table.take(9) == "nine");
+  }
+
+  SECTION("take all values")
+  {
+    for (std::uint32_t opaque = 0; opaque < 10; ++opaque) {
+      REQUIRE(table.try_emplace(opaque, std::to_string(opaque)));
+    }
+    auto values = table.take_all();
+    REQUIRE(values.size() == 10);
+    std::map<std::uint32_t, std::string> sorted(values.begin(), values.end());
+    REQUIRE(sorted.size() == 10);
+    for (const auto& [opaque, value] : sorted) {
+      REQUIRE(value == std::to_string(opaque));
+    }
+  }
+
+  REQUIRE(table.take_all().empty());
+}
+
+namespace
+{
+constexpr std::uint32_t in_flight_per_thread{ 1'024 };
+constexpr std::uint32_t operations_per_thread{ 64 * in_flight_per_thread };
+
+/*
+ * Emulates the pattern of the KV session: every writer thread keeps a window of in-flight
+ * opaques, and the handler for the oldest opaque is taken out once the window is full.
+ */
+template<typename Insert, typename Take>
+void
+run_opaque_workload(std::size_t number_of_threads, Insert&& insert, Take&& take)
+{
+  std::atomic_uint32_t next_opaque{ 0 };
+  std::atomic_size_t handled{ 0 };
+  std::vector<std::thread> threads;
+  threads.reserve(number_of_threads);
+  for (std::size_t t = 0; t < number_of_threads; ++t) {
+    threads.emplace_back([&]() {
+      std::vector<std::uint32_t> window(in_flight_per_thread);
+      for (std::uint32_t i = 0; i < operations_per_thread; ++i) {
+        auto& slot = window[i % in_flight_per_thread];
+        if (i >= in_flight_per_thread && take(slot)) {
+          handled.fetch_add(1, std::memory_order_relaxed);
+        }
+        slot = next_opaque.fetch_add(1, std::memory_order_relaxed);
+        insert(slot);
+      }
+      for (auto opaque : window) {
+        if (take(opaque)) {
+          handled.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  REQUIRE(handled == number_of_threads * operations_per_thread);
+}
+} // namespace
+
+TEST_CASE("unit: concurrent opaque table from multiple threads", "[unit]")
+{
+  const auto number_of_threads = std::max(2U, std::thread::hardware_concurrency());
+  couchbase::core::utils::concurrent_opaque_table<std::uint32_t> table{};
+  // assertions are not thread-safe, so the workers only count the failures
+  std::atomic_size_t rejected{ 0 };
+  std::atomic_size_t mismatched{ 0 };
+  run_opaque_workload(
+    number_of_threads,
+    [&](std::uint32_t opaque) {
+      if (!table.try_emplace(opaque, opaque)) {
+        rejected.fetch_add(1, std::memory_order_relaxed);
+      }
+    },
+    [&](std::uint32_t opaque) {
+      auto value = table.take(opaque);
+      if (value && *value != opaque) {
+        mismatched.fetch_add(1, std::memory_order_relaxed);
+      }
+      return value.has_value();
+    });
+  REQUIRE(rejected == 0);
+  REQUIRE(mismatched == 0);
+  REQUIRE(table.take_all().empty());
+}
+
+TEST_CASE("unit: crc32", "[unit]")
+{
+  using namespace couchbase::core::utils;
+
+  const std::string check{ "123456789" };
+  const auto* check_data = reinterpret_cast<const std::byte*>(check.data());
+  REQUIRE(~crc32_update(UINT32_MAX, check_data, check.size()) == 0xcbf43926);
+
+  // vBucket hash must stay stable, otherwise keys will be routed to wrong partitions
+  REQUIRE(hash_crc32("foo", 3) == 3187);
+  REQUIRE(hash_crc32("hello", 5) == 13840);
+  const std::string long_key{
+    "a-key-that-is-longer-than-sixty-four-bytes-to-exercise-the-folding-path"
+  };
+  REQUIRE(hash_crc32(long_key.data(), long_key.size()) == 22294);
+
+  std::mt19937 gen{ 42 };
+  std::vector<std::byte> data(1'024 + 16);
+  for (auto& byte : data) {
+    byte = static_cast<std::byte>(gen());
+  }
+  for (std::size_t offset = 0; offset < 16; ++offset) {
+    for (std::size_t length = 0; length <= 1'024; ++length) {
+      const auto* begin = data.data() + offset;
+      const auto expected = crc32_detail::update_bytewise(UINT32_MAX, begin, length);
+      REQUIRE(crc32_detail::update_slicing_by_8(UINT32_MAX, begin, length) == expected);
+      REQUIRE(crc32_update(UINT32_MAX, begin, length) == expected);
+      if (crc32_detail::has_hardware_support()) {
+        REQUIRE(crc32_detail::update_hardware(UINT32_MAX, begin, length) == expected);
+      }
+    }
+  }
+}
+
 #if 0
 // This test is commented out because, it is not necessary to run it with the suite, but it still useful for debugging.
 
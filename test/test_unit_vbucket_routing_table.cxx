@@ -0,0 +1,95 @@
+/* -*- Mode: C++; tab-width: 4; c-basic-offset: 4; indent-tabs-mode: nil -*- */
+/*
+ *   Copyright 2026 Couchbase, Inc.
+ *
+ *   Licensed under the Apache License, Version 2.0 (the "License");
+ *   you may not use this file except in compliance with the License.
+ *   You may obtain a copy of the License at
+ *
+ *       http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *   Unless required by applicable law or agreed to in writing, software
+ *   distributed under the License is distributed on an "AS IS" BASIS,
+ *   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *   See the License for the specific language governing permissions and
+ *   limitations under the License.
+ */
+
+#include "test_helper.hxx"
+
+#include "core/topology/configuration.hxx"
+#include "core/topology/vbucket_routing_table.hxx"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+using couchbase::core::topology::configuration;
+using couchbase::core::topology::vbucket_routing_table;
+
+auto
+make_vbucket_map(std::size_t number_of_vbuckets,
+                 std::size_t number_of_nodes,
+                 std::size_t number_of_replicas) -> configuration::vbucket_map
+{
+  configuration::vbucket_map vbmap(number_of_vbuckets);
+  for (std::size_t vbucket = 0; vbucket < number_of_vbuckets; ++vbucket) {
+    for (std::size_t i = 0; i <= number_of_replicas; ++i) {
+      vbmap[vbucket].push_back(static_cast<std::int16_t>((vbucket + i) % number_of_nodes));
+    }
+  }
+  return vbmap;
+}
+
+auto
+make_keys(std::size_t number_of_keys) -> std::vector<std::string>
+{
+  std::vector<std::string> keys;
+  keys.reserve(number_of_keys);
+  for (std::size_t i = 0; i < number_of_keys; ++i) {
+    keys.emplace_back("user::" + std::to_string(i));
+  }
+  return keys;
+}
+} // namespace
+
+TEST_CASE("unit: vbucket routing table matches configuration", "[unit]")
+{
+  configuration config{};
+  config.vbmap = make_vbucket_map(1024, 4, 2);
+  const vbucket_routing_table table{ config.vbmap.value() };
+
+  CHECK(table.number_of_vbuckets() == 1024);
+  CHECK(table.entries_per_vbucket() == 3);
+
+  for (const auto& key : make_keys(1'000)) {
+    for (std::size_t index = 0; index < 3; ++index) {
+      CHECK(table.map_key(key, index) == config.map_key(key, index));
+    }
+  }
+  for (std::uint16_t vbucket = 0; vbucket < 1024; ++vbucket) {
+    CHECK(table.server_by_vbucket(vbucket, 0) == config.server_by_vbucket(vbucket, 0));
+  }
+}
+
+TEST_CASE("unit: vbucket routing table handles missing servers", "[unit]")
+{
+  const configuration::vbucket_map vbmap{
+    { 0, 1 },
+    { 1, -1 },
+    { 0 },
+  };
+  const vbucket_routing_table table{ vbmap };
+
+  CHECK(table.entries_per_vbucket() == 2);
+  CHECK(table.server_by_vbucket(0, 1) == 1);
+  CHECK_FALSE(table.server_by_vbucket(1, 1).has_value());
+  CHECK_FALSE(table.server_by_vbucket(2, 1).has_value());
+  CHECK_FALSE(table.server_by_vbucket(0, 2).has_value());
+  CHECK_FALSE(table.server_by_vbucket(3, 0).has_value());
+
+  const vbucket_routing_table empty{ {} };
+  CHECK(empty.map_key(std::string{ "foo" }, 0) ==
+        std::pair<std::uint16_t, std::optional<std::size_t>>{ 0, std::nullopt });
+}
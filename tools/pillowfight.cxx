@@ -44,6 +44,7 @@
 #include <numeric>
 #include <random>
 #include <thread>
+#include <type_traits>
 
 namespace cbc
 {
@@ -305,6 +306,22 @@ random_text(std::size_t length) -> std::string
   return text;
 }
 
+void
+record_operation(std::chrono::system_clock::duration latency,
+                 const couchbase::error& err,
+                 bool verbose)
+{
+  hdr_record_value_atomic(histogram, latency.count());
+  ++total;
+  if (err.ec()) {
+    const std::scoped_lock lock(errors_mutex);
+    ++errors[err.ec()];
+    if (verbose) {
+      fmt::print(stderr, "\r\033[K{}\n", err.ctx().to_json());
+    }
+  }
+}
+
 class pillowfight_app : public CLI::App
 {
 public:
@@ -352,6 +369,10 @@ public:
       ->default_val(default_operation_batch_size);
     add_option("--batch-wait", batch_wait_, "Time to wait after the batch.")
       ->default_val(default_batch_wait);
+    add_flag("--bulk",
+             bulk_,
+             "Dispatch KV operations of the batch with get_multi, upsert_multi and remove_multi "
+             "(replaces and inserts are sent as upserts, latency is measured per batch).");
     add_option("--query-statement",
                query_statement_,
                "The N1QL query statement to use ({bucket_name}, {scope_name} and {collection_name} "
@@ -399,11 +420,12 @@ public:
                "| Version: {}\n"
                "| Connection String: {}\n"
                "| Ratio: {} (Get:Replace:Delete:Insert:Query)\n"
-               "| Batch size: {}\n",
+               "| Batch size: {}{}\n",
                couchbase::core::meta::sdk_semver(),
                connection_string,
                operation_generator::parse(operation_ratio_string_).to_string(),
-               operation_batch_size_);
+               operation_batch_size_,
+               bulk_ ? " (bulk)" : "");
 
     auto [connect_err, cluster] =
       couchbase::cluster::connect(connection_string, cluster_options).get();
@@ -516,8 +538,13 @@ private:
         std::pair<std::chrono::system_clock::time_point,
                   std::variant<std::future<std::pair<couchbase::error, couchbase::mutation_result>>,
                                std::future<std::pair<couchbase::error, couchbase::get_result>>,
-                               std::future<std::pair<couchbase::error, couchbase::query_result>>>>>
+                               std::future<std::pair<couchbase::error, couchbase::query_result>>,
+                               std::future<couchbase::upsert_multi_result>,
+                               std::future<couchbase::get_multi_result>>>>
         futures;
+      std::vector<std::string> bulk_gets;
+      std::vector<std::pair<std::string, std::vector<std::byte>>> bulk_upserts;
+      std::vector<std::string> bulk_removes;
 
       auto known_keys_distribution =
         std::uniform_int_distribution<std::size_t>(0, known_keys.size() - 1);
@@ -526,6 +553,24 @@ private:
         std::string document_id = (operation != operation::cmd_insert && !known_keys.empty())
                                     ? known_keys[known_keys_distribution(gen)]
                                     : uniq_id("id");
+        if (bulk_) {
+          switch (operation) {
+            case operation::cmd_get:
+              bulk_gets.emplace_back(std::move(document_id));
+              continue;
+            case operation::cmd_insert:
+              known_keys.push_back(document_id);
+              [[fallthrough]];
+            case operation::cmd_replace:
+              bulk_upserts.emplace_back(std::move(document_id), json_doc);
+              continue;
+            case operation::cmd_delete:
+              bulk_removes.emplace_back(std::move(document_id));
+              continue;
+            case operation::cmd_query:
+              break;
+          }
+        }
         switch (operation) {
           case operation::cmd_get:
             futures.emplace_back(std::chrono::system_clock::now(), collection.get(document_id));
@@ -548,6 +593,18 @@ private:
             break;
         }
       }
+      if (!bulk_gets.empty()) {
+        futures.emplace_back(std::chrono::system_clock::now(),
+                             collection.get_multi(std::move(bulk_gets)));
+      }
+      if (!bulk_upserts.empty()) {
+        futures.emplace_back(std::chrono::system_clock::now(),
+                             collection.upsert_multi<raw_json_transcoder>(std::move(bulk_upserts)));
+      }
+      if (!bulk_removes.empty()) {
+        futures.emplace_back(std::chrono::system_clock::now(),
+                             collection.remove_multi(std::move(bulk_removes)));
+      }
 
       for (auto&& [start, future] : futures) {
         std::visit(
@@ -559,15 +616,15 @@ private:
                 return;
               }
             }
-            auto [err, resp] = f.get();
-            hdr_record_value_atomic(histogram, (std::chrono::system_clock::now() - start).count());
-            ++total;
-            if (err.ec()) {
-              const std::scoped_lock lock(errors_mutex);
-              ++errors[err.ec()];
-              if (verbose) {
-                fmt::print(stderr, "\r\033[K{}\n", err.ctx().to_json());
+            auto result = f.get();
+            const auto latency = std::chrono::system_clock::now() - start;
+            if constexpr (std::is_same_v<decltype(result), couchbase::get_multi_result> ||
+                          std::is_same_v<decltype(result), couchbase::upsert_multi_result>) {
+              for (const auto& [err, resp] : result) {
+                record_operation(latency, err, verbose);
               }
+            } else {
+              record_operation(latency, result.first, verbose);
             }
           },
           std::move(future));
@@ -660,6 +717,7 @@ private:
   bool incompressible_body_{};
   std::size_t document_body_size_{};
   std::size_t operations_limit_{};
+  bool bulk_{ false };
 };
 } // namespace
 